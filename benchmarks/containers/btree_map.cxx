@@ -0,0 +1,79 @@
+module;
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/benchmark/catch_benchmark.hpp"
+#include <map>
+
+module atom_core.benchmarks:btree_map;
+
+import atom_core;
+
+using namespace atom;
+
+TEST_CASE("atom_core.btree_map", "[benchmark]")
+{
+    constexpr i64 count = 100'000;
+
+    btree_map<i64, i64> map;
+    std::map<i64, i64> std_map;
+    for (i64 i = 0; i < count; i++)
+    {
+        i64 key = (i * 7919) % count;
+        map.emplace(key, i);
+        std_map.emplace(key, i);
+    }
+
+    BENCHMARK("btree_map::emplace")
+    {
+        btree_map<i64, i64> result;
+        for (i64 i = 0; i < count; i++)
+            result.emplace((i * 7919) % count, i);
+
+        return result.get_count();
+    };
+
+    BENCHMARK("std::map::emplace")
+    {
+        std::map<i64, i64> result;
+        for (i64 i = 0; i < count; i++)
+            result.emplace((i * 7919) % count, i);
+
+        return result.size();
+    };
+
+    BENCHMARK("btree_map::find")
+    {
+        i64 sum = 0;
+        for (i64 i = 0; i < count; i++)
+            sum += *map.find((i * 31) % count);
+
+        return sum;
+    };
+
+    BENCHMARK("std::map::find")
+    {
+        i64 sum = 0;
+        for (i64 i = 0; i < count; i++)
+            sum += std_map.find((i * 31) % count)->second;
+
+        return sum;
+    };
+
+    BENCHMARK("btree_map::for_each_in_range")
+    {
+        i64 sum = 0;
+        map.for_each_in_range(i64(count / 4), i64(count * 3 / 4),
+            [&](i64 key, i64 value) { sum += value; });
+
+        return sum;
+    };
+
+    BENCHMARK("std::map range")
+    {
+        i64 sum = 0;
+        auto end = std_map.lower_bound(count * 3 / 4);
+        for (auto it = std_map.lower_bound(count / 4); it != end; ++it)
+            sum += it->second;
+
+        return sum;
+    };
+}
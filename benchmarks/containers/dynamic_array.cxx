@@ -0,0 +1,120 @@
+module;
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/benchmark/catch_benchmark.hpp"
+
+module atom_core.benchmarks:dynamic_array;
+
+import atom_core;
+
+using namespace atom;
+
+TEST_CASE("atom_core.dynamic_array", "[benchmark]")
+{
+    constexpr usize count = 10'000;
+
+    dynamic_array<i64> source;
+    std::vector<i64> std_source;
+    for (usize i = 0; i < count; i++)
+    {
+        source.emplace_last(i64(i));
+        std_source.push_back(i64(i));
+    }
+
+    BENCHMARK("dynamic_array::emplace_last")
+    {
+        dynamic_array<i64> arr;
+        for (usize i = 0; i < count; i++)
+            arr.emplace_last(i64(i));
+
+        return arr.get_count();
+    };
+
+    BENCHMARK("std::vector::push_back")
+    {
+        std::vector<i64> vec;
+        for (usize i = 0; i < count; i++)
+            vec.push_back(i64(i));
+
+        return vec.size();
+    };
+
+    BENCHMARK("dynamic_array::insert_range_last")
+    {
+        dynamic_array<i64> arr;
+        arr.insert_range_last(source);
+        return arr.get_count();
+    };
+
+    BENCHMARK("std::vector::insert last")
+    {
+        std::vector<i64> vec;
+        vec.insert(vec.end(), std_source.begin(), std_source.end());
+        return vec.size();
+    };
+
+    BENCHMARK("dynamic_array::insert_range_at middle")
+    {
+        dynamic_array<i64> arr = source;
+        arr.insert_range_at(arr.get_count() / 2, source);
+        return arr.get_count();
+    };
+
+    BENCHMARK("std::vector::insert middle")
+    {
+        std::vector<i64> vec = std_source;
+        vec.insert(vec.begin() + vec.size() / 2, std_source.begin(), std_source.end());
+        return vec.size();
+    };
+
+    BENCHMARK("dynamic_array::remove_at first")
+    {
+        dynamic_array<i64> arr = source;
+        for (usize i = 0; i < 100; i++)
+            arr.remove_at(0);
+
+        return arr.get_count();
+    };
+
+    BENCHMARK("std::vector::erase first")
+    {
+        std::vector<i64> vec = std_source;
+        for (usize i = 0; i < 100; i++)
+            vec.erase(vec.begin());
+
+        return vec.size();
+    };
+
+    // the bounds check in `get_at` is a debug contract, so in release builds this should match
+    // the raw loop below unless `expects` contracts are configured at `audit` level.
+    BENCHMARK("dynamic_array::get_at loop")
+    {
+        i64 sum = 0;
+        for (usize i = 0; i < source.get_count(); i++)
+            sum += source.get_at(i);
+
+        return sum;
+    };
+
+    BENCHMARK("raw pointer loop")
+    {
+        const i64* data = source.get_data();
+        i64 sum = 0;
+        for (usize i = 0; i < source.get_count(); i++)
+            sum += data[i];
+
+        return sum;
+    };
+
+    BENCHMARK("contract_expects bounds checked loop")
+    {
+        const i64* data = source.get_data();
+        i64 sum = 0;
+        for (usize i = 0; i < source.get_count(); i++)
+        {
+            contract_expects(i < source.get_count());
+            sum += data[i];
+        }
+
+        return sum;
+    };
+}
@@ -0,0 +1,61 @@
+module;
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/benchmark/catch_benchmark.hpp"
+#include <variant>
+
+module atom_core.benchmarks:variant;
+
+import atom_core;
+
+using namespace atom;
+
+TEST_CASE("atom_core.variant", "[benchmark]")
+{
+    constexpr usize count = 1'000;
+
+    std::vector<variant<i32, i64, f64>> values;
+    std::vector<std::variant<i32, i64, f64>> std_values;
+    for (usize i = 0; i < count; i++)
+    {
+        switch (i % 3)
+        {
+            case 0:
+                values.emplace_back(i32(i));
+                std_values.emplace_back(i32(i));
+                break;
+            case 1:
+                values.emplace_back(i64(i));
+                std_values.emplace_back(i64(i));
+                break;
+            default:
+                values.emplace_back(f64(i));
+                std_values.emplace_back(f64(i));
+                break;
+        }
+    }
+
+    BENCHMARK("variant visit")
+    {
+        f64 sum = 0;
+        for (const auto& value : values)
+        {
+            switch (value.get_index())
+            {
+                case 0:  sum += value.get<i32>(); break;
+                case 1:  sum += value.get<i64>(); break;
+                default: sum += value.get<f64>(); break;
+            }
+        }
+
+        return sum;
+    };
+
+    BENCHMARK("std::visit")
+    {
+        f64 sum = 0;
+        for (const auto& value : std_values)
+            std::visit([&](const auto& val) { sum += val; }, value);
+
+        return sum;
+    };
+}
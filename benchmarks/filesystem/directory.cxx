@@ -0,0 +1,52 @@
+module;
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/benchmark/catch_benchmark.hpp"
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+
+module atom_core.benchmarks:directory;
+
+import atom_core;
+
+using namespace atom;
+
+TEST_CASE("atom_core.directory", "[benchmark]")
+{
+    std::filesystem::path root = std::filesystem::temp_directory_path() / "atom_core_bench_dir";
+    std::filesystem::remove_all(root);
+
+    for (usize i = 0; i < 100; i++)
+    {
+        std::filesystem::path dir = root / std::to_string(i);
+        std::filesystem::create_directories(dir);
+
+        for (usize j = 0; j < 100; j++)
+            std::ofstream{ dir / std::to_string(j) };
+    }
+
+    std::string root_str = root.string();
+    string_view root_path{ root_str.c_str() };
+
+    BENCHMARK("filesystem::walk_directory")
+    {
+        std::atomic<usize> count = 0;
+        filesystem::walk_directory(
+            root_path, filesystem::walk_options{}, [&](const filesystem::walk_entry& entry) {
+                count.fetch_add(1, std::memory_order_relaxed);
+            });
+
+        return count.load();
+    };
+
+    BENCHMARK("std::filesystem::recursive_directory_iterator")
+    {
+        usize count = 0;
+        for (const auto& entry : std::filesystem::recursive_directory_iterator{ root })
+            count++;
+
+        return count;
+    };
+
+    std::filesystem::remove_all(root);
+}
@@ -0,0 +1,78 @@
+module;
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/benchmark/catch_benchmark.hpp"
+#include <filesystem>
+#include <fstream>
+
+module atom_core.benchmarks:file;
+
+import atom_core;
+
+using namespace atom;
+
+TEST_CASE("atom_core.file", "[benchmark]")
+{
+    constexpr usize size = 1024 * 1024;
+
+    std::string path_str = (std::filesystem::temp_directory_path() / "atom_core_bench_file").string();
+    string_view path{ path_str.c_str() };
+
+    std::vector<byte> data(size, byte('a'));
+    memory_view bytes{ data.data(), data.size() };
+
+    BENCHMARK("filesystem::write_file_bytes")
+    {
+        return filesystem::write_file_bytes(path, bytes).is_value();
+    };
+
+    BENCHMARK("std::ofstream::write")
+    {
+        std::ofstream out{ path_str, std::ios::binary | std::ios::trunc };
+        out.write(reinterpret_cast<const char*>(data.data()), data.size());
+        return out.good();
+    };
+
+    BENCHMARK("filesystem::read_file_bytes")
+    {
+        return filesystem::read_file_bytes(path).get_value().get_size();
+    };
+
+    BENCHMARK("std::ifstream::read")
+    {
+        std::ifstream in{ path_str, std::ios::binary };
+        std::vector<char> content(size);
+        in.read(content.data(), content.size());
+        return in.gcount();
+    };
+
+    filesystem::file file =
+        filesystem::file::open(path, filesystem::file::open_flags::read).get_value();
+    std::vector<byte> block(4096);
+
+    BENCHMARK("filesystem::file::read_at")
+    {
+        usize total = 0;
+        mut_memory_view buf{ block.data(), block.size() };
+        for (usize offset = 0; offset < size; offset += 64 * 1024)
+            total += file.read_at(offset, buf).get_value();
+
+        return total;
+    };
+
+    BENCHMARK("std::ifstream::seekg + read")
+    {
+        std::ifstream in{ path_str, std::ios::binary };
+        usize total = 0;
+        for (usize offset = 0; offset < size; offset += 64 * 1024)
+        {
+            in.seekg(offset);
+            in.read(reinterpret_cast<char*>(block.data()), block.size());
+            total += in.gcount();
+        }
+
+        return total;
+    };
+
+    file.close();
+    std::filesystem::remove(path_str);
+}
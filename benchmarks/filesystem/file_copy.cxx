@@ -0,0 +1,49 @@
+module;
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/benchmark/catch_benchmark.hpp"
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+module atom_core.benchmarks:file_copy;
+
+import atom_core;
+
+using namespace atom;
+
+TEST_CASE("atom_core.file_copy", "[benchmark]")
+{
+    std::filesystem::path dir = std::filesystem::temp_directory_path() / "atom_core_bench_copy";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+
+    std::filesystem::path from = dir / "from";
+    std::filesystem::path to = dir / "to";
+    std::ofstream{ from, std::ios::binary } << std::string(64 * 1024 * 1024, 'x');
+
+    std::string from_str = from.string();
+    std::string to_str = to.string();
+    string_view from_path{ from_str.c_str() };
+    string_view to_path{ to_str.c_str() };
+
+    BENCHMARK("filesystem::copy_file")
+    {
+        return filesystem::copy_file(from_path, to_path).get_value();
+    };
+
+    BENCHMARK("std::filesystem::copy_file")
+    {
+        return std::filesystem::copy_file(
+            from, to, std::filesystem::copy_options::overwrite_existing);
+    };
+
+    BENCHMARK("std::ifstream + std::ofstream")
+    {
+        std::ifstream in{ from, std::ios::binary };
+        std::ofstream out{ to, std::ios::binary | std::ios::trunc };
+        out << in.rdbuf();
+        return out.good();
+    };
+
+    std::filesystem::remove_all(dir);
+}
@@ -0,0 +1,34 @@
+module;
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/benchmark/catch_benchmark.hpp"
+#include <filesystem>
+#include <string>
+
+module atom_core.benchmarks:log;
+
+import atom_core;
+
+using namespace atom;
+
+TEST_CASE("atom_core.log", "[benchmark]")
+{
+    filesystem::file sink = filesystem::file::open(string_view{ "/dev/null" },
+        filesystem::file::open_flags::write)
+                                .get_value();
+
+    log::start(log::options{ .sink = &sink, .block_when_full = true });
+
+    std::string name = "request";
+
+    BENCHMARK("log::info")
+    {
+        log::info("handled {} {} in {}us", name, 1234, 56.7);
+    };
+
+    BENCHMARK("filesystem::file::write_line_fmt")
+    {
+        sink.write_line_fmt("handled {} {} in {}us", name, 1234, 56.7);
+    };
+
+    log::start();
+}
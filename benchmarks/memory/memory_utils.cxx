@@ -0,0 +1,55 @@
+module;
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/benchmark/catch_benchmark.hpp"
+#include <cstring>
+
+module atom_core.benchmarks:memory_utils;
+
+import atom_core;
+
+using namespace atom;
+
+TEST_CASE("atom_core.memory_utils", "[benchmark]")
+{
+    constexpr usize size = 64 * 1024;
+
+    std::vector<byte> src(size, byte(1));
+    std::vector<byte> dest(size, byte(0));
+    std::vector<byte> mem(size + 64, byte(2));
+
+    BENCHMARK("memory_utils::copy_to")
+    {
+        memory_utils::copy_to(src.data(), size, dest.data(), size);
+        return dest[size / 2];
+    };
+
+    BENCHMARK("std::memcpy")
+    {
+        std::memcpy(dest.data(), src.data(), size);
+        return dest[size / 2];
+    };
+
+    BENCHMARK("memory_utils::shift_fwd")
+    {
+        memory_utils::shift_fwd(mem.data(), size, 64);
+        return mem[size / 2];
+    };
+
+    BENCHMARK("std::memmove")
+    {
+        std::memmove(mem.data() + 64, mem.data(), size);
+        return mem[size / 2];
+    };
+
+    BENCHMARK("memory_utils::rotate_fwd")
+    {
+        memory_utils::rotate_fwd(mem.data(), size, 100);
+        return mem[size / 2];
+    };
+
+    BENCHMARK("std::rotate")
+    {
+        std::rotate(mem.data(), mem.data() + size - 100, mem.data() + size);
+        return mem[size / 2];
+    };
+}
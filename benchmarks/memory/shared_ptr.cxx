@@ -0,0 +1,37 @@
+module;
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/benchmark/catch_benchmark.hpp"
+
+module atom_core.benchmarks:shared_ptr;
+
+import atom_core;
+
+using namespace atom;
+
+TEST_CASE("atom_core.shared_ptr", "[benchmark]")
+{
+    shared_ptr<i64> ptr = make_shared<i64>(i64(10));
+    std::shared_ptr<i64> std_ptr = std::make_shared<i64>(i64(10));
+
+    BENCHMARK("shared_ptr copy")
+    {
+        shared_ptr<i64> copy = ptr;
+        return copy.get_count();
+    };
+
+    BENCHMARK("std::shared_ptr copy")
+    {
+        std::shared_ptr<i64> copy = std_ptr;
+        return copy.use_count();
+    };
+
+    BENCHMARK("make_shared")
+    {
+        return make_shared<i64>(i64(10));
+    };
+
+    BENCHMARK("std::make_shared")
+    {
+        return std::make_shared<i64>(i64(10));
+    };
+}
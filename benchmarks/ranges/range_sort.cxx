@@ -0,0 +1,52 @@
+module;
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/benchmark/catch_benchmark.hpp"
+#include <algorithm>
+#include <vector>
+
+module atom_core.benchmarks:range_sort;
+
+import atom_core;
+
+using namespace atom;
+
+TEST_CASE("atom_core.range_sort", "[benchmark]")
+{
+    constexpr usize count = 1'000'000;
+
+    std::vector<u64> values;
+    u64 state = 42;
+    for (usize i = 0; i < count; i++)
+    {
+        state = state * 6364136223846793005 + 1442695040888963407;
+        values.push_back(state >> 16);
+    }
+
+    BENCHMARK("ranges::sort")
+    {
+        std::vector<u64> copy = values;
+        ranges::sort(copy);
+        return copy[0];
+    };
+
+    BENCHMARK("ranges::radix_sort")
+    {
+        std::vector<u64> copy = values;
+        ranges::radix_sort(copy);
+        return copy[0];
+    };
+
+    BENCHMARK("std::sort")
+    {
+        std::vector<u64> copy = values;
+        std::sort(copy.begin(), copy.end());
+        return copy[0];
+    };
+
+    BENCHMARK("ranges::partial_sort")
+    {
+        std::vector<u64> copy = values;
+        ranges::partial_sort(copy, 1'000);
+        return copy[0];
+    };
+}
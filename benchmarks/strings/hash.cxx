@@ -0,0 +1,26 @@
+module;
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/benchmark/catch_benchmark.hpp"
+
+module atom_core.benchmarks:hash;
+
+import atom_core;
+
+using namespace atom;
+
+TEST_CASE("atom_core.hash", "[benchmark]")
+{
+    const char* text = "the quick brown fox jumps over the lazy dog, again and again.";
+    string str{ create_from_raw, text };
+    std::string std_str{ text };
+
+    BENCHMARK("std::hash<atom::string>")
+    {
+        return std::hash<string>()(str);
+    };
+
+    BENCHMARK("std::hash<std::string>")
+    {
+        return std::hash<std::string>()(std_str);
+    };
+}
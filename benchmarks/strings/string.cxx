@@ -0,0 +1,42 @@
+module;
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/benchmark/catch_benchmark.hpp"
+#include <format>
+#include <iterator>
+
+module atom_core.benchmarks:string;
+
+import atom_core;
+
+using namespace atom;
+
+TEST_CASE("atom_core.string", "[benchmark]")
+{
+    BENCHMARK("string::format")
+    {
+        return string::format("id: {}, count: {}, name: {}", 1024, 42u, "benchmark");
+    };
+
+    BENCHMARK("std::format")
+    {
+        return std::format("id: {}, count: {}, name: {}", 1024, 42u, "benchmark");
+    };
+
+    BENCHMARK("string::format_to")
+    {
+        string out;
+        for (i32 i = 0; i < 100; i++)
+            string::format_to(out, "{},", i);
+
+        return out.get_count();
+    };
+
+    BENCHMARK("std::format_to")
+    {
+        std::string out;
+        for (i32 i = 0; i < 100; i++)
+            std::format_to(std::back_inserter(out), "{},", i);
+
+        return out.size();
+    };
+}
@@ -0,0 +1,30 @@
+module;
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/benchmark/catch_benchmark.hpp"
+
+module atom_core.benchmarks:string_builder;
+
+import atom_core;
+
+using namespace atom;
+
+TEST_CASE("atom_core.string_builder", "[benchmark]")
+{
+    BENCHMARK("string::insert_range_last")
+    {
+        string out;
+        for (i32 i = 0; i < 100000; i++)
+            out.insert_range_last(string_view{ "a line of a generated report\n" });
+
+        return out.get_count();
+    };
+
+    BENCHMARK("string_builder::append")
+    {
+        string_builder builder;
+        for (i32 i = 0; i < 100000; i++)
+            builder.append(string_view{ "a line of a generated report\n" });
+
+        return builder.to_string().get_count();
+    };
+}
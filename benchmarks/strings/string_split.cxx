@@ -0,0 +1,38 @@
+module;
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/benchmark/catch_benchmark.hpp"
+#include <string>
+
+module atom_core.benchmarks:string_split;
+
+import atom_core;
+
+using namespace atom;
+
+TEST_CASE("atom_core.string_split", "[benchmark]")
+{
+    std::string csv;
+    for (usize i = 0; i < 4'096; i++)
+        csv += "2024-01-01,some name,12345,67.89,another longer field value\n";
+
+    BENCHMARK("strings::split, lines and fields")
+    {
+        usize count = 0;
+        for (const string_view& line : strings::split_lines(csv))
+        {
+            for (const string_view& field : strings::split(line, ','))
+                count += field.get_count();
+        }
+
+        return count;
+    };
+
+    BENCHMARK("strings::tokenize")
+    {
+        usize count = 0;
+        for (const string_view& token : strings::tokenize(csv, string_view{ ",\n " }))
+            count += token.get_count();
+
+        return count;
+    };
+}
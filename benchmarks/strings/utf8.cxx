@@ -0,0 +1,36 @@
+module;
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/benchmark/catch_benchmark.hpp"
+#include <string>
+
+module atom_core.benchmarks:utf8;
+
+import atom_core;
+
+using namespace atom;
+
+TEST_CASE("atom_core.utf8", "[benchmark]")
+{
+    std::string ascii;
+    std::string mixed;
+    for (usize i = 0; i < 16'384; i++)
+    {
+        ascii += "the quick brown fox jumps over the lazy dog. ";
+        mixed += "h\xC3\xA9llo w\xC3\xB6rld \xE2\x82\xAC \xF0\x9F\x98\x80 ";
+    }
+
+    BENCHMARK("utf8::is_valid, ascii")
+    {
+        return utf8::is_valid(ascii);
+    };
+
+    BENCHMARK("utf8::is_valid, mixed")
+    {
+        return utf8::is_valid(mixed);
+    };
+
+    BENCHMARK("utf8::count_code_points, mixed")
+    {
+        return utf8::count_code_points(mixed);
+    };
+}
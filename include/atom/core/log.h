@@ -0,0 +1,29 @@
+#pragma once
+#include "atom/core/preprocessors.h"
+
+/// ------------------------------------------------------------------------------------------------
+/// logging macros for `atom::log`.
+///
+/// unlike calling `atom::log::info()` and others directly, these don't evaluate the args when the
+/// level is disabled, either at compile time by `atom::log::min_level` or at runtime by
+/// `atom::log::set_level()`.
+///
+/// ATOM_LOG_INFO("listening on port {}", port);
+/// ATOM_LOG(warn, "retrying {}", get_name());
+/// ------------------------------------------------------------------------------------------------
+#define ATOM_LOG(LEVEL, ...)                                                                       \
+    do                                                                                             \
+    {                                                                                              \
+        if constexpr (::atom::log::level::LEVEL >= ::atom::log::min_level)                         \
+        {                                                                                          \
+            if (::atom::log::is_enabled(::atom::log::level::LEVEL))                                \
+                ::atom::log::write<::atom::log::level::LEVEL>(__VA_ARGS__);                        \
+        }                                                                                          \
+    } while (false)
+
+#define ATOM_LOG_TRACE(...) ATOM_LOG(trace, __VA_ARGS__)
+#define ATOM_LOG_DEBUG(...) ATOM_LOG(debug, __VA_ARGS__)
+#define ATOM_LOG_INFO(...) ATOM_LOG(info, __VA_ARGS__)
+#define ATOM_LOG_WARN(...) ATOM_LOG(warn, __VA_ARGS__)
+#define ATOM_LOG_ERROR(...) ATOM_LOG(error, __VA_ARGS__)
+#define ATOM_LOG_FATAL(...) ATOM_LOG(fatal, __VA_ARGS__)
@@ -143,3 +143,57 @@
 #else
 #    define ATOM_ATTR_NO_UNIQUE_ADDRESS [[no_unique_address]]
 #endif
+
+/// ------------------------------------------------------------------------------------------------
+/// `ATOM_ATTR_COLD`, `ATOM_ATTR_NOINLINE` and `ATOM_ATTR_ALWAYS_INLINE`
+///
+/// used to keep failure paths out of hot code.
+/// ------------------------------------------------------------------------------------------------
+#if defined(ATOM_COMPILER_CLANG) or defined(ATOM_COMPILER_GNUC)
+#    define ATOM_ATTR_COLD [[gnu::cold]]
+#    define ATOM_ATTR_NOINLINE [[gnu::noinline]]
+#    define ATOM_ATTR_ALWAYS_INLINE [[gnu::always_inline]] inline
+#elif defined(ATOM_COMPILER_MSVC)
+#    define ATOM_ATTR_COLD
+#    define ATOM_ATTR_NOINLINE __declspec(noinline)
+#    define ATOM_ATTR_ALWAYS_INLINE __forceinline
+#else
+#    define ATOM_ATTR_COLD
+#    define ATOM_ATTR_NOINLINE
+#    define ATOM_ATTR_ALWAYS_INLINE inline
+#endif
+
+/// ------------------------------------------------------------------------------------------------
+/// contract levels.
+///
+/// each contract category can be configured by defining `ATOM_CONTRACTS_EXPECTS_LEVEL`,
+/// `ATOM_CONTRACTS_ASSERTS_LEVEL` or `ATOM_CONTRACTS_ENSURES_LEVEL` to one of the levels below.
+///
+/// \par levels
+/// - `ATOM_CONTRACTS_LEVEL_OFF`: no checks are compiled.
+/// - `ATOM_CONTRACTS_LEVEL_DEFAULT`: only non debug checks are compiled.
+/// - `ATOM_CONTRACTS_LEVEL_AUDIT`: debug checks are compiled too.
+///
+/// if not defined, levels default to `audit` in debug mode and `default` in release mode.
+/// ------------------------------------------------------------------------------------------------
+#define ATOM_CONTRACTS_LEVEL_OFF 0
+#define ATOM_CONTRACTS_LEVEL_DEFAULT 1
+#define ATOM_CONTRACTS_LEVEL_AUDIT 2
+
+#if defined(ATOM_MODE_DEBUG)
+#    define _ATOM_CONTRACTS_LEVEL_FOR_MODE ATOM_CONTRACTS_LEVEL_AUDIT
+#else
+#    define _ATOM_CONTRACTS_LEVEL_FOR_MODE ATOM_CONTRACTS_LEVEL_DEFAULT
+#endif
+
+#if !defined(ATOM_CONTRACTS_EXPECTS_LEVEL)
+#    define ATOM_CONTRACTS_EXPECTS_LEVEL _ATOM_CONTRACTS_LEVEL_FOR_MODE
+#endif
+
+#if !defined(ATOM_CONTRACTS_ASSERTS_LEVEL)
+#    define ATOM_CONTRACTS_ASSERTS_LEVEL _ATOM_CONTRACTS_LEVEL_FOR_MODE
+#endif
+
+#if !defined(ATOM_CONTRACTS_ENSURES_LEVEL)
+#    define ATOM_CONTRACTS_ENSURES_LEVEL _ATOM_CONTRACTS_LEVEL_FOR_MODE
+#endif
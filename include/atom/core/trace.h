@@ -0,0 +1,29 @@
+#pragma once
+#include "atom/core/preprocessors.h"
+
+/// ------------------------------------------------------------------------------------------------
+/// instrumentation macros for `atom::trace`.
+///
+/// these expand to nothing unless `ATOM_TRACE_ENABLED` is defined, so instrumented code has no
+/// cost when tracing is disabled. names must be string literals or have static storage duration.
+///
+/// ATOM_TRACE_ZONE("name");          // records a zone until the end of the enclosing scope.
+/// ATOM_TRACE_FUNCTION();            // records a zone named after the enclosing function.
+/// ATOM_TRACE_COUNTER("name", value) // records the value of a counter.
+/// ------------------------------------------------------------------------------------------------
+#define _ATOM_TRACE_CAT(A, B) ATOM_CAT(A, B)
+
+#if defined(ATOM_TRACE_ENABLED)
+#    define ATOM_TRACE_ZONE(NAME)                                                                  \
+        ::atom::trace::zone _ATOM_TRACE_CAT(_atom_trace_zone_, __LINE__)                           \
+        {                                                                                          \
+            NAME                                                                                   \
+        }
+
+#    define ATOM_TRACE_FUNCTION() ATOM_TRACE_ZONE(__func__)
+#    define ATOM_TRACE_COUNTER(NAME, VALUE) ::atom::trace::record_counter(NAME, VALUE)
+#else
+#    define ATOM_TRACE_ZONE(NAME)
+#    define ATOM_TRACE_FUNCTION()
+#    define ATOM_TRACE_COUNTER(NAME, VALUE)
+#endif
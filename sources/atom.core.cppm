@@ -13,6 +13,8 @@ export import :time;
 export import :hash;
 export import :filesystem;
 export import :io;
+export import :trace;
+export import :log;
 
 export import :memory_utils;
 export import :lock_guard;
@@ -27,6 +29,11 @@ export import :default_mem_allocator;
 export import :legacy_mem_allocator;
 export import :function_box;
 export import :dynamic_buffer;
+export import :std_mem_allocator_adapter;
+export import :tracking_allocator;
+export import :reclaim;
+export import :ebr;
+export import :hazard_ptr;
 
 export
 {
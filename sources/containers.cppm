@@ -6,3 +6,11 @@ export import :containers.buf_array;
 export import :containers.array_slice;
 export import :containers.array_view;
 export import :containers.unordered_map;
+export import :containers.sorted_flat_set;
+export import :containers.sorted_flat_map;
+export import :containers.btree_map;
+export import :containers.btree_set;
+export import :containers.index_iterator;
+export import :containers.ring_buffer;
+export import :containers.deque;
+export import :containers.segmented_array;
@@ -47,6 +47,14 @@ namespace atom
 
         constexpr ~array_slice() = default;
 
+        /// ----------------------------------------------------------------------------------------
+        /// initializes with `count` values starting at `data`.
+        /// ----------------------------------------------------------------------------------------
+        constexpr array_slice(create_from_raw_tag, value_type* data, usize count)
+            : _data{ data }
+            , _count{ count }
+        {}
+
         /// ----------------------------------------------------------------------------------------
         /// initializes with array range `range`.
         /// ----------------------------------------------------------------------------------------
@@ -41,6 +41,14 @@ namespace atom
         constexpr array_view(this_type&& that) = default;
         constexpr array_view& operator=(this_type&& that) = default;
 
+        /// ----------------------------------------------------------------------------------------
+        /// initializes with `count` values starting at `data`.
+        /// ----------------------------------------------------------------------------------------
+        constexpr array_view(create_from_raw_tag, const value_type* data, usize count)
+            : _data{ data }
+            , _count{ count }
+        {}
+
         /// ----------------------------------------------------------------------------------------
         ///
         /// ----------------------------------------------------------------------------------------
@@ -0,0 +1,1179 @@
+export module atom_core:containers.btree_impl;
+
+import std;
+import :core;
+import :types;
+import :contracts;
+import :containers.dynamic_array;
+import :containers.sorted_flat_set;
+
+#include "atom/core/preprocessors.h"
+
+namespace atom
+{
+    /// --------------------------------------------------------------------------------------------
+    /// count of keys per node, so that keys of a node span about 4 cache lines.
+    /// --------------------------------------------------------------------------------------------
+    template <typename key_type>
+    consteval auto _btree_get_node_capacity() -> usize
+    {
+        usize capacity = 256 / sizeof(key_type);
+        return capacity < 8 ? 8 : capacity > 64 ? 64 : capacity;
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// returns `true` if keys in a node can be searched by counting the keys less than the key.
+    /// --------------------------------------------------------------------------------------------
+    template <typename key_type, typename other_key_type, typename comparer_type>
+    consteval auto _btree_can_count_search() -> bool
+    {
+        return (std::is_integral_v<key_type> or std::is_floating_point_v<key_type>)
+               and std::is_same_v<key_type, other_key_type>
+               and (std::is_same_v<comparer_type, std::less<>>
+                    or std::is_same_v<comparer_type, std::less<key_type>>);
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// returns the index of the first key in `keys` which is not less than `key`.
+    ///
+    /// for arithmetic keys this counts the keys less than `key` over the whole node. the loop has
+    /// no branch depending on the keys, so compilers vectorize it and a node is searched with a
+    /// few simd compares, which is faster than a binary search at these sizes.
+    /// --------------------------------------------------------------------------------------------
+    template <typename key_type, typename other_key_type, typename comparer_type>
+    constexpr auto _btree_lower_bound(const key_type* keys, usize count, const other_key_type& key,
+        const comparer_type& comparer) -> usize
+    {
+        if constexpr (_btree_can_count_search<key_type, other_key_type, comparer_type>())
+        {
+            usize index = 0;
+            for (usize i = 0; i < count; i++)
+                index += usize(keys[i] < key);
+
+            return index;
+        }
+        else
+        {
+            return _flat_lower_bound(keys, count, key, comparer);
+        }
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// returns the index of the first key in `keys` which is greater than `key`.
+    /// --------------------------------------------------------------------------------------------
+    template <typename key_type, typename other_key_type, typename comparer_type>
+    constexpr auto _btree_upper_bound(const key_type* keys, usize count, const other_key_type& key,
+        const comparer_type& comparer) -> usize
+    {
+        if constexpr (_btree_can_count_search<key_type, other_key_type, comparer_type>())
+        {
+            usize index = 0;
+            for (usize i = 0; i < count; i++)
+                index += usize(not(key < keys[i]));
+
+            return index;
+        }
+        else
+        {
+            if (count == 0)
+                return 0;
+
+            const key_type* base = keys;
+            while (count > 1)
+            {
+                usize half = count / 2;
+                base = comparer(key, base[half]) ? base : base + half;
+                count -= half;
+            }
+
+            return usize(base - keys) + usize(not comparer(key, *base));
+        }
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// values of a leaf. empty for sets.
+    /// --------------------------------------------------------------------------------------------
+    template <typename value_type, usize capacity>
+    class _btree_leaf_values
+    {
+    public:
+        value_type items[capacity];
+    };
+
+    template <usize capacity>
+    class _btree_leaf_values<void, capacity>
+    {};
+
+    /// --------------------------------------------------------------------------------------------
+    /// leaf node, holds the keys and values. leaves are linked in key order.
+    ///
+    /// keys and values are kept in separate arrays, so searching a leaf only touches its keys.
+    /// --------------------------------------------------------------------------------------------
+    template <typename key_type, typename value_type>
+    class alignas(64) _btree_leaf
+    {
+    public:
+        static constexpr usize capacity = _btree_get_node_capacity<key_type>();
+
+    public:
+        usize count = 0;
+        _btree_leaf* prev = nullptr;
+        _btree_leaf* next = nullptr;
+        key_type keys[capacity];
+        ATOM_ATTR_NO_UNIQUE_ADDRESS _btree_leaf_values<value_type, capacity> values;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// inner node, `keys[i]` separates `children[i]` and `children[i + 1]`. every key in
+    /// `children[i]` is less than `keys[i]` and every key in `children[i + 1]` is not.
+    /// --------------------------------------------------------------------------------------------
+    template <typename key_type>
+    class alignas(64) _btree_inner
+    {
+    public:
+        static constexpr usize capacity = _btree_get_node_capacity<key_type>();
+
+    public:
+        usize count = 0;
+        key_type keys[capacity];
+        void* children[capacity + 1];
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// pool of nodes of one type, allocated in blocks from `allocator_type`.
+    ///
+    /// nodes are aligned to cache lines, and freed nodes are kept in a free list to be reused.
+    /// --------------------------------------------------------------------------------------------
+    template <typename node_type, typename allocator_type>
+    class _btree_node_pool
+    {
+        using this_type = _btree_node_pool;
+
+        static constexpr usize _nodes_per_block = 16;
+        static constexpr usize _node_align = alignof(node_type);
+
+    public:
+        _btree_node_pool() = default;
+
+        _btree_node_pool(const this_type& that) = delete;
+        _btree_node_pool& operator=(const this_type& that) = delete;
+
+        _btree_node_pool(this_type&& that)
+            : _allocator{ move(that._allocator) }
+            , _blocks{ that._blocks }
+            , _free_list{ that._free_list }
+            , _block_nodes{ that._block_nodes }
+            , _block_used{ that._block_used }
+        {
+            that._blocks = nullptr;
+            that._free_list = nullptr;
+            that._block_nodes = nullptr;
+            that._block_used = _nodes_per_block;
+        }
+
+        _btree_node_pool& operator=(this_type&& that)
+        {
+            release_all();
+
+            _allocator = move(that._allocator);
+            _blocks = that._blocks;
+            _free_list = that._free_list;
+            _block_nodes = that._block_nodes;
+            _block_used = that._block_used;
+
+            that._blocks = nullptr;
+            that._free_list = nullptr;
+            that._block_nodes = nullptr;
+            that._block_used = _nodes_per_block;
+            return *this;
+        }
+
+        ~_btree_node_pool()
+        {
+            release_all();
+        }
+
+    public:
+        auto alloc_node() -> node_type*
+        {
+            void* mem = nullptr;
+            if (_free_list != nullptr)
+            {
+                mem = _free_list;
+                _free_list = *static_cast<void**>(mem);
+            }
+            else
+            {
+                if (_block_used == _nodes_per_block)
+                    _alloc_block();
+
+                mem = _block_nodes + _block_used * sizeof(node_type);
+                _block_used++;
+            }
+
+            return std::construct_at(static_cast<node_type*>(mem));
+        }
+
+        auto dealloc_node(node_type* node) -> void
+        {
+            std::destroy_at(node);
+
+            void* mem = node;
+            *static_cast<void**>(mem) = _free_list;
+            _free_list = mem;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// releases every block. nodes must already be destroyed.
+        /// ----------------------------------------------------------------------------------------
+        auto release_all() -> void
+        {
+            while (_blocks != nullptr)
+            {
+                void* next = *static_cast<void**>(_blocks);
+                _allocator.dealloc(_blocks);
+                _blocks = next;
+            }
+
+            _free_list = nullptr;
+            _block_nodes = nullptr;
+            _block_used = _nodes_per_block;
+        }
+
+    private:
+        auto _alloc_block() -> void
+        {
+            usize size = sizeof(void*) + _node_align + _nodes_per_block * sizeof(node_type);
+            byte* block = static_cast<byte*>(_allocator.alloc(size));
+            contract_asserts(block != nullptr, "out of memory.");
+
+            // blocks are linked through their first word.
+            *reinterpret_cast<void**>(block) = _blocks;
+            _blocks = block;
+
+            usize nodes_addr = reinterpret_cast<usize>(block + sizeof(void*));
+            nodes_addr = (nodes_addr + _node_align - 1) & ~(_node_align - 1);
+            _block_nodes = reinterpret_cast<byte*>(nodes_addr);
+            _block_used = 0;
+        }
+
+    private:
+        ATOM_ATTR_NO_UNIQUE_ADDRESS allocator_type _allocator;
+        void* _blocks = nullptr;
+        void* _free_list = nullptr;
+        byte* _block_nodes = nullptr;
+        usize _block_used = _nodes_per_block;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// forward iterator over the entries of a btree, in key order.
+    /// --------------------------------------------------------------------------------------------
+    template <typename leaf_type>
+    class _btree_iterator
+    {
+        using this_type = _btree_iterator;
+
+    public:
+        constexpr _btree_iterator()
+            : _leaf{ nullptr }
+            , _index{ 0 }
+        {}
+
+        constexpr _btree_iterator(leaf_type* leaf, usize index)
+            : _leaf{ leaf }
+            , _index{ index }
+        {}
+
+    public:
+        constexpr auto get_key() const -> const auto&
+        {
+            return _leaf->keys[_index];
+        }
+
+        constexpr auto get_value() const -> auto&
+        {
+            return _leaf->values.items[_index];
+        }
+
+        constexpr auto operator*() const -> const auto&
+        {
+            return get_key();
+        }
+
+        constexpr auto operator++() -> this_type&
+        {
+            _index++;
+            if (_index == _leaf->count)
+            {
+                _leaf = _leaf->next;
+                _index = 0;
+            }
+
+            return *this;
+        }
+
+        constexpr auto operator++(int) -> this_type
+        {
+            this_type copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        constexpr auto operator==(const this_type& that) const -> bool
+        {
+            return _leaf == that._leaf and _index == that._index;
+        }
+
+        constexpr auto is_end() const -> bool
+        {
+            return _leaf == nullptr;
+        }
+
+        constexpr auto get_leaf() const -> leaf_type*
+        {
+            return _leaf;
+        }
+
+        constexpr auto get_index() const -> usize
+        {
+            return _index;
+        }
+
+    private:
+        leaf_type* _leaf;
+        usize _index;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// b+ tree, implementation of `btree_map` and `btree_set`. `value_type` is `void` for sets.
+    ///
+    /// keys and values live only in leaves, inner nodes hold copies of keys to route searches.
+    /// --------------------------------------------------------------------------------------------
+    template <typename in_key_type, typename in_value_type, typename in_comparer_type,
+        typename in_allocator_type>
+    class _btree_impl
+    {
+        using this_type = _btree_impl;
+
+    public:
+        using key_type = in_key_type;
+        using value_type = in_value_type;
+        using comparer_type = in_comparer_type;
+        using allocator_type = in_allocator_type;
+        using leaf_type = _btree_leaf<key_type, value_type>;
+        using inner_type = _btree_inner<key_type>;
+        using iterator_type = _btree_iterator<const leaf_type>;
+        using mut_iterator_type = _btree_iterator<leaf_type>;
+
+        static constexpr bool is_set = std::is_same_v<value_type, void>;
+        static constexpr usize leaf_capacity = leaf_type::capacity;
+        static constexpr usize inner_capacity = inner_type::capacity;
+
+    private:
+        static constexpr usize _leaf_min_count = leaf_capacity / 4;
+        static constexpr usize _inner_min_count = inner_capacity / 4;
+
+        // nodes have at least 2 children, so this is enough for any count of keys.
+        static constexpr usize _max_height = 64;
+
+    public:
+        _btree_impl() = default;
+
+        _btree_impl(const this_type& that)
+            : _comparer{ that._comparer }
+        {
+            for (const leaf_type* leaf = that._first_leaf; leaf != nullptr; leaf = leaf->next)
+            {
+                leaf_type* copy = _append_leaf();
+                copy->count = leaf->count;
+                std::copy(leaf->keys, leaf->keys + leaf->count, copy->keys);
+
+                if constexpr (not is_set)
+                {
+                    std::copy(
+                        leaf->values.items, leaf->values.items + leaf->count, copy->values.items);
+                }
+            }
+
+            _count = that._count;
+            _build_inner_levels();
+        }
+
+        _btree_impl(this_type&& that)
+            : _leaf_pool{ move(that._leaf_pool) }
+            , _inner_pool{ move(that._inner_pool) }
+            , _root{ that._root }
+            , _first_leaf{ that._first_leaf }
+            , _last_leaf{ that._last_leaf }
+            , _height{ that._height }
+            , _count{ that._count }
+            , _comparer{ move(that._comparer) }
+        {
+            that._root = nullptr;
+            that._first_leaf = nullptr;
+            that._last_leaf = nullptr;
+            that._height = 0;
+            that._count = 0;
+        }
+
+        _btree_impl& operator=(const this_type& that)
+        {
+            if (this != &that)
+            {
+                this_type copy{ that };
+                *this = move(copy);
+            }
+
+            return *this;
+        }
+
+        _btree_impl& operator=(this_type&& that)
+        {
+            if (this == &that)
+                return *this;
+
+            remove_all();
+
+            _leaf_pool = move(that._leaf_pool);
+            _inner_pool = move(that._inner_pool);
+            _root = that._root;
+            _first_leaf = that._first_leaf;
+            _last_leaf = that._last_leaf;
+            _height = that._height;
+            _count = that._count;
+            _comparer = move(that._comparer);
+
+            that._root = nullptr;
+            that._first_leaf = nullptr;
+            that._last_leaf = nullptr;
+            that._height = 0;
+            that._count = 0;
+            return *this;
+        }
+
+        ~_btree_impl()
+        {
+            remove_all();
+        }
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// builds the tree from sorted and unique keys, filling leaves completely. `value_it` is
+        /// ignored for sets.
+        ///
+        /// \pre the tree is empty.
+        /// ----------------------------------------------------------------------------------------
+        template <typename key_iterator_type, typename key_iterator_end_type,
+            typename value_iterator_type>
+        auto bulk_load(key_iterator_type key_it, key_iterator_end_type key_it_end,
+            value_iterator_type value_it) -> void
+        {
+            contract_debug_expects(_root == nullptr, "the tree is not empty.");
+
+            leaf_type* leaf = nullptr;
+            const key_type* last_key = nullptr;
+            for (; key_it != key_it_end; ++key_it)
+            {
+                if (leaf == nullptr or leaf->count == leaf_capacity)
+                    leaf = _append_leaf();
+
+                leaf->keys[leaf->count] = *key_it;
+
+                contract_debug_expects(
+                    last_key == nullptr or _comparer(*last_key, leaf->keys[leaf->count]),
+                    "keys are not sorted or unique.");
+
+                last_key = &leaf->keys[leaf->count];
+
+                if constexpr (not is_set)
+                {
+                    leaf->values.items[leaf->count] = *value_it;
+                    ++value_it;
+                }
+
+                leaf->count++;
+                _count++;
+            }
+
+            // move keys from the previous leaf, so the last leaf is not underfull.
+            if (leaf != nullptr and leaf->prev != nullptr and leaf->count < _leaf_min_count)
+            {
+                leaf_type* prev = leaf->prev;
+                usize move_count = _leaf_min_count - leaf->count;
+                _leaf_shift_right(leaf, 0, move_count);
+                _leaf_move_range(prev, prev->count - move_count, move_count, leaf, 0);
+                prev->count -= move_count;
+                leaf->count += move_count;
+            }
+
+            _build_inner_levels();
+        }
+
+        template <typename other_key_type>
+        auto find(const other_key_type& key) const -> iterator_type
+        {
+            leaf_type* leaf = _find_leaf(key);
+            if (leaf == nullptr)
+                return iterator_type();
+
+            usize index = _btree_lower_bound(leaf->keys, leaf->count, key, _comparer);
+            if (index < leaf->count and _flat_is_equivalent(leaf->keys[index], key, _comparer))
+                return iterator_type(leaf, index);
+
+            return iterator_type();
+        }
+
+        template <typename other_key_type>
+        auto find(const other_key_type& key) -> mut_iterator_type
+        {
+            iterator_type it = static_cast<const this_type&>(*this).find(key);
+            return _to_mut(it);
+        }
+
+        template <typename other_key_type>
+        auto lower_bound(const other_key_type& key) const -> iterator_type
+        {
+            leaf_type* leaf = _find_leaf(key);
+            if (leaf == nullptr)
+                return iterator_type();
+
+            usize index = _btree_lower_bound(leaf->keys, leaf->count, key, _comparer);
+            return _make_iterator(leaf, index);
+        }
+
+        template <typename other_key_type>
+        auto upper_bound(const other_key_type& key) const -> iterator_type
+        {
+            leaf_type* leaf = _find_leaf(key);
+            if (leaf == nullptr)
+                return iterator_type();
+
+            usize index = _btree_upper_bound(leaf->keys, leaf->count, key, _comparer);
+            return _make_iterator(leaf, index);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// calls `action` with each entry whose key is in range `[from, to)`, in key order.
+        /// ----------------------------------------------------------------------------------------
+        template <typename other_key_type, typename action_type>
+        auto for_each_in_range(
+            const other_key_type& from, const other_key_type& to, action_type&& action) const
+            -> void
+        {
+            leaf_type* leaf = _find_leaf(from);
+            if (leaf == nullptr)
+                return;
+
+            usize index = _btree_lower_bound(leaf->keys, leaf->count, from, _comparer);
+            for (; leaf != nullptr; leaf = leaf->next, index = 0)
+            {
+                for (; index < leaf->count; index++)
+                {
+                    if (not _comparer(leaf->keys[index], to))
+                        return;
+
+                    if constexpr (is_set)
+                        action(leaf->keys[index]);
+                    else
+                        action(leaf->keys[index], leaf->values.items[index]);
+                }
+            }
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// inserts `key` with value constructed from `args` if `key` is not present. if `key` is
+        /// present and `assign` is `true`, assigns the value instead.
+        ///
+        /// \returns `true` if `key` was inserted.
+        /// ----------------------------------------------------------------------------------------
+        template <bool assign, typename other_key_type, typename... arg_types>
+        auto insert(other_key_type&& key, arg_types&&... args) -> bool
+        {
+            if (_root == nullptr)
+            {
+                _root = _append_leaf();
+                _height = 0;
+            }
+
+            inner_type* path[_max_height];
+            usize path_indices[_max_height];
+
+            void* node = _root;
+            for (usize depth = 0; depth < _height; depth++)
+            {
+                inner_type* inner = static_cast<inner_type*>(node);
+                usize index = _btree_upper_bound(inner->keys, inner->count, key, _comparer);
+                path[depth] = inner;
+                path_indices[depth] = index;
+                node = inner->children[index];
+            }
+
+            leaf_type* leaf = static_cast<leaf_type*>(node);
+            usize index = _btree_lower_bound(leaf->keys, leaf->count, key, _comparer);
+            if (index < leaf->count and _flat_is_equivalent(leaf->keys[index], key, _comparer))
+            {
+                if constexpr (assign and not is_set)
+                    leaf->values.items[index] = value_type(forward<arg_types>(args)...);
+
+                return false;
+            }
+
+            _count++;
+
+            if (leaf->count < leaf_capacity)
+            {
+                _leaf_insert_at(
+                    leaf, index, forward<other_key_type>(key), forward<arg_types>(args)...);
+                return true;
+            }
+
+            // keys inserted in increasing order always go at the end of the last leaf, keep the
+            // full leaf as it is in that case, so such leaves end up completely filled.
+            usize split_index = leaf->next == nullptr and index == leaf_capacity
+                                    ? leaf_capacity
+                                    : leaf_capacity / 2;
+
+            leaf_type* right = _split_leaf(leaf, split_index);
+            if (index >= split_index)
+            {
+                _leaf_insert_at(right, index - split_index, forward<other_key_type>(key),
+                    forward<arg_types>(args)...);
+            }
+            else
+            {
+                _leaf_insert_at(leaf, index, forward<other_key_type>(key),
+                    forward<arg_types>(args)...);
+            }
+
+            key_type separator = right->keys[0];
+            void* new_child = right;
+
+            for (usize depth = _height; depth > 0; depth--)
+            {
+                inner_type* parent = path[depth - 1];
+                usize child_index = path_indices[depth - 1];
+
+                if (parent->count < inner_capacity)
+                {
+                    _inner_insert_at(parent, child_index, move(separator), new_child);
+                    return true;
+                }
+
+                inner_type* right_inner = _inner_pool.alloc_node();
+                usize mid = inner_capacity / 2;
+                key_type up_separator = move(parent->keys[mid]);
+
+                usize right_count = inner_capacity - mid - 1;
+                std::move(parent->keys + mid + 1, parent->keys + inner_capacity, right_inner->keys);
+                std::copy(parent->children + mid + 1, parent->children + inner_capacity + 1,
+                    right_inner->children);
+                right_inner->count = right_count;
+                parent->count = mid;
+
+                if (child_index <= mid)
+                {
+                    _inner_insert_at(parent, child_index, move(separator), new_child);
+                }
+                else
+                {
+                    _inner_insert_at(
+                        right_inner, child_index - mid - 1, move(separator), new_child);
+                }
+
+                separator = move(up_separator);
+                new_child = right_inner;
+            }
+
+            inner_type* root = _inner_pool.alloc_node();
+            root->count = 1;
+            root->keys[0] = move(separator);
+            root->children[0] = _root;
+            root->children[1] = new_child;
+            _root = root;
+            _height++;
+            return true;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// removes `key` if present.
+        ///
+        /// \returns `true` if `key` was removed.
+        /// ----------------------------------------------------------------------------------------
+        template <typename other_key_type>
+        auto remove(const other_key_type& key) -> bool
+        {
+            if (_root == nullptr)
+                return false;
+
+            inner_type* path[_max_height];
+            usize path_indices[_max_height];
+
+            void* node = _root;
+            for (usize depth = 0; depth < _height; depth++)
+            {
+                inner_type* inner = static_cast<inner_type*>(node);
+                usize index = _btree_upper_bound(inner->keys, inner->count, key, _comparer);
+                path[depth] = inner;
+                path_indices[depth] = index;
+                node = inner->children[index];
+            }
+
+            leaf_type* leaf = static_cast<leaf_type*>(node);
+            usize index = _btree_lower_bound(leaf->keys, leaf->count, key, _comparer);
+            if (index == leaf->count or not _flat_is_equivalent(leaf->keys[index], key, _comparer))
+                return false;
+
+            _leaf_remove_at(leaf, index);
+            _count--;
+
+            if (_height == 0)
+            {
+                if (leaf->count == 0)
+                {
+                    _unlink_leaf(leaf);
+                    _leaf_pool.dealloc_node(leaf);
+                    _root = nullptr;
+                }
+
+                return true;
+            }
+
+            if (leaf->count >= _leaf_min_count)
+                return true;
+
+            if (not _fix_leaf(leaf, path[_height - 1], path_indices[_height - 1]))
+                return true;
+
+            for (usize depth = _height - 1; depth > 0; depth--)
+            {
+                inner_type* inner = path[depth];
+                if (inner->count >= _inner_min_count)
+                    return true;
+
+                if (not _fix_inner(inner, path[depth - 1], path_indices[depth - 1]))
+                    return true;
+            }
+
+            inner_type* root = static_cast<inner_type*>(_root);
+            if (root->count == 0)
+            {
+                _root = root->children[0];
+                _inner_pool.dealloc_node(root);
+                _height--;
+            }
+
+            return true;
+        }
+
+        auto remove_all() -> void
+        {
+            if (_root != nullptr)
+            {
+                // trivially destructible nodes don't need to be visited, the blocks are released
+                // as a whole.
+                if constexpr (not type_info<leaf_type>::is_trivially_destructible()
+                              or not type_info<inner_type>::is_trivially_destructible())
+                {
+                    _destroy_node(_root, _height);
+                }
+            }
+
+            _leaf_pool.release_all();
+            _inner_pool.release_all();
+            _root = nullptr;
+            _first_leaf = nullptr;
+            _last_leaf = nullptr;
+            _height = 0;
+            _count = 0;
+        }
+
+        auto get_iterator() const -> iterator_type
+        {
+            return iterator_type(_first_leaf, 0);
+        }
+
+        auto get_iterator_end() const -> iterator_type
+        {
+            return iterator_type();
+        }
+
+        auto get_iterator() -> mut_iterator_type
+        {
+            return mut_iterator_type(_first_leaf, 0);
+        }
+
+        auto get_iterator_end() -> mut_iterator_type
+        {
+            return mut_iterator_type();
+        }
+
+        auto get_count() const -> usize
+        {
+            return _count;
+        }
+
+        auto get_height() const -> usize
+        {
+            return _root == nullptr ? 0 : _height + 1;
+        }
+
+    private:
+        template <typename other_key_type>
+        auto _find_leaf(const other_key_type& key) const -> leaf_type*
+        {
+            if (_root == nullptr)
+                return nullptr;
+
+            void* node = _root;
+            for (usize depth = 0; depth < _height; depth++)
+            {
+                inner_type* inner = static_cast<inner_type*>(node);
+                usize index = _btree_upper_bound(inner->keys, inner->count, key, _comparer);
+                node = inner->children[index];
+            }
+
+            return static_cast<leaf_type*>(node);
+        }
+
+        auto _make_iterator(leaf_type* leaf, usize index) const -> iterator_type
+        {
+            if (index == leaf->count)
+                return iterator_type(leaf->next, 0);
+
+            return iterator_type(leaf, index);
+        }
+
+        static auto _to_mut(iterator_type it) -> mut_iterator_type
+        {
+            return mut_iterator_type(const_cast<leaf_type*>(it.get_leaf()), it.get_index());
+        }
+
+        auto _append_leaf() -> leaf_type*
+        {
+            leaf_type* leaf = _leaf_pool.alloc_node();
+            leaf->prev = _last_leaf;
+
+            if (_last_leaf != nullptr)
+                _last_leaf->next = leaf;
+            else
+                _first_leaf = leaf;
+
+            _last_leaf = leaf;
+            return leaf;
+        }
+
+        auto _unlink_leaf(leaf_type* leaf) -> void
+        {
+            if (leaf->prev != nullptr)
+                leaf->prev->next = leaf->next;
+            else
+                _first_leaf = leaf->next;
+
+            if (leaf->next != nullptr)
+                leaf->next->prev = leaf->prev;
+            else
+                _last_leaf = leaf->prev;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// builds inner levels over the linked leaves, distributing children evenly.
+        /// ----------------------------------------------------------------------------------------
+        auto _build_inner_levels() -> void
+        {
+            _root = _first_leaf;
+            _height = 0;
+
+            if (_first_leaf == nullptr or _first_leaf == _last_leaf)
+                return;
+
+            dynamic_array<void*> nodes;
+            dynamic_array<const key_type*> min_keys;
+            for (leaf_type* leaf = _first_leaf; leaf != nullptr; leaf = leaf->next)
+            {
+                nodes.emplace_last(leaf);
+                min_keys.emplace_last(&leaf->keys[0]);
+            }
+
+            while (nodes.get_count() > 1)
+            {
+                usize child_count = nodes.get_count();
+                usize parent_count = (child_count + inner_capacity) / (inner_capacity + 1);
+
+                dynamic_array<void*> parents;
+                dynamic_array<const key_type*> parent_min_keys;
+                parents.reserve(parent_count);
+                parent_min_keys.reserve(parent_count);
+
+                usize child_index = 0;
+                for (usize i = 0; i < parent_count; i++)
+                {
+                    usize count = child_count / parent_count + (i < child_count % parent_count);
+                    inner_type* inner = _inner_pool.alloc_node();
+
+                    inner->children[0] = nodes.get_at(child_index);
+                    for (usize j = 1; j < count; j++)
+                    {
+                        inner->keys[j - 1] = *min_keys.get_at(child_index + j);
+                        inner->children[j] = nodes.get_at(child_index + j);
+                    }
+
+                    inner->count = count - 1;
+                    parents.emplace_last(inner);
+                    parent_min_keys.emplace_last(min_keys.get_at(child_index));
+                    child_index += count;
+                }
+
+                nodes = move(parents);
+                min_keys = move(parent_min_keys);
+                _height++;
+            }
+
+            _root = nodes.get_at(0);
+        }
+
+        auto _destroy_node(void* node, usize height) -> void
+        {
+            if (height == 0)
+            {
+                _leaf_pool.dealloc_node(static_cast<leaf_type*>(node));
+                return;
+            }
+
+            inner_type* inner = static_cast<inner_type*>(node);
+            for (usize i = 0; i <= inner->count; i++)
+                _destroy_node(inner->children[i], height - 1);
+
+            _inner_pool.dealloc_node(inner);
+        }
+
+        template <typename other_key_type, typename... arg_types>
+        auto _leaf_insert_at(
+            leaf_type* leaf, usize index, other_key_type&& key, arg_types&&... args) -> void
+        {
+            _leaf_shift_right(leaf, index, 1);
+            leaf->keys[index] = key_type(forward<other_key_type>(key));
+
+            if constexpr (not is_set)
+                leaf->values.items[index] = value_type(forward<arg_types>(args)...);
+
+            leaf->count++;
+        }
+
+        auto _leaf_remove_at(leaf_type* leaf, usize index) -> void
+        {
+            std::move(leaf->keys + index + 1, leaf->keys + leaf->count, leaf->keys + index);
+            leaf->keys[leaf->count - 1] = key_type();
+
+            if constexpr (not is_set)
+            {
+                std::move(leaf->values.items + index + 1, leaf->values.items + leaf->count,
+                    leaf->values.items + index);
+                leaf->values.items[leaf->count - 1] = value_type();
+            }
+
+            leaf->count--;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// shifts entries from `index` to the right by `count`.
+        /// ----------------------------------------------------------------------------------------
+        static auto _leaf_shift_right(leaf_type* leaf, usize index, usize count) -> void
+        {
+            std::move_backward(
+                leaf->keys + index, leaf->keys + leaf->count, leaf->keys + leaf->count + count);
+
+            if constexpr (not is_set)
+            {
+                std::move_backward(leaf->values.items + index, leaf->values.items + leaf->count,
+                    leaf->values.items + leaf->count + count);
+            }
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// moves `count` entries from `index` of `from` to `dest_index` of `dest`. doesn't update
+        /// counts.
+        /// ----------------------------------------------------------------------------------------
+        static auto _leaf_move_range(
+            leaf_type* from, usize index, usize count, leaf_type* dest, usize dest_index) -> void
+        {
+            std::move(from->keys + index, from->keys + index + count, dest->keys + dest_index);
+
+            if constexpr (not is_set)
+            {
+                std::move(from->values.items + index, from->values.items + index + count,
+                    dest->values.items + dest_index);
+            }
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// moves entries from `index` into a new leaf linked after `leaf`.
+        /// ----------------------------------------------------------------------------------------
+        auto _split_leaf(leaf_type* leaf, usize index) -> leaf_type*
+        {
+            leaf_type* right = _leaf_pool.alloc_node();
+            _leaf_move_range(leaf, index, leaf->count - index, right, 0);
+            right->count = leaf->count - index;
+            leaf->count = index;
+
+            right->prev = leaf;
+            right->next = leaf->next;
+            if (leaf->next != nullptr)
+                leaf->next->prev = right;
+            else
+                _last_leaf = right;
+
+            leaf->next = right;
+            return right;
+        }
+
+        static auto _inner_insert_at(
+            inner_type* inner, usize index, key_type&& key, void* right_child) -> void
+        {
+            std::move_backward(
+                inner->keys + index, inner->keys + inner->count, inner->keys + inner->count + 1);
+            std::copy_backward(inner->children + index + 1, inner->children + inner->count + 1,
+                inner->children + inner->count + 2);
+
+            inner->keys[index] = move(key);
+            inner->children[index + 1] = right_child;
+            inner->count++;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// removes the key at `index` and the child on its right.
+        /// ----------------------------------------------------------------------------------------
+        static auto _inner_remove_at(inner_type* inner, usize index) -> void
+        {
+            std::move(inner->keys + index + 1, inner->keys + inner->count, inner->keys + index);
+            std::copy(inner->children + index + 2, inner->children + inner->count + 1,
+                inner->children + index + 1);
+
+            inner->count--;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// fixes underfull `leaf`, which is child `index` of `parent`, by borrowing from or merging
+        /// with a sibling.
+        ///
+        /// \returns `true` if a node was merged, so `parent` lost a key.
+        /// ----------------------------------------------------------------------------------------
+        auto _fix_leaf(leaf_type* leaf, inner_type* parent, usize index) -> bool
+        {
+            leaf_type* left = index > 0 ? static_cast<leaf_type*>(parent->children[index - 1])
+                                        : nullptr;
+            leaf_type* right = index < parent->count
+                                   ? static_cast<leaf_type*>(parent->children[index + 1])
+                                   : nullptr;
+
+            if (left != nullptr and left->count > _leaf_min_count)
+            {
+                _leaf_shift_right(leaf, 0, 1);
+                _leaf_move_range(left, left->count - 1, 1, leaf, 0);
+                left->count--;
+                leaf->count++;
+                parent->keys[index - 1] = leaf->keys[0];
+                return false;
+            }
+
+            if (right != nullptr and right->count > _leaf_min_count)
+            {
+                _leaf_move_range(right, 0, 1, leaf, leaf->count);
+                leaf->count++;
+                _leaf_move_range(right, 1, right->count - 1, right, 0);
+                right->count--;
+                parent->keys[index] = right->keys[0];
+                return false;
+            }
+
+            if (left != nullptr)
+            {
+                _leaf_move_range(leaf, 0, leaf->count, left, left->count);
+                left->count += leaf->count;
+                _unlink_leaf(leaf);
+                _leaf_pool.dealloc_node(leaf);
+                _inner_remove_at(parent, index - 1);
+            }
+            else
+            {
+                _leaf_move_range(right, 0, right->count, leaf, leaf->count);
+                leaf->count += right->count;
+                _unlink_leaf(right);
+                _leaf_pool.dealloc_node(right);
+                _inner_remove_at(parent, index);
+            }
+
+            return true;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// fixes underfull `inner`, which is child `index` of `parent`, by rotating a key through
+        /// `parent` or merging with a sibling.
+        ///
+        /// \returns `true` if a node was merged, so `parent` lost a key.
+        /// ----------------------------------------------------------------------------------------
+        auto _fix_inner(inner_type* inner, inner_type* parent, usize index) -> bool
+        {
+            inner_type* left = index > 0 ? static_cast<inner_type*>(parent->children[index - 1])
+                                         : nullptr;
+            inner_type* right = index < parent->count
+                                    ? static_cast<inner_type*>(parent->children[index + 1])
+                                    : nullptr;
+
+            if (left != nullptr and left->count > _inner_min_count)
+            {
+                std::move_backward(
+                    inner->keys, inner->keys + inner->count, inner->keys + inner->count + 1);
+                std::copy_backward(inner->children, inner->children + inner->count + 1,
+                    inner->children + inner->count + 2);
+
+                inner->keys[0] = move(parent->keys[index - 1]);
+                inner->children[0] = left->children[left->count];
+                parent->keys[index - 1] = move(left->keys[left->count - 1]);
+                left->count--;
+                inner->count++;
+                return false;
+            }
+
+            if (right != nullptr and right->count > _inner_min_count)
+            {
+                inner->keys[inner->count] = move(parent->keys[index]);
+                inner->children[inner->count + 1] = right->children[0];
+                parent->keys[index] = move(right->keys[0]);
+
+                std::move(right->keys + 1, right->keys + right->count, right->keys);
+                std::copy(right->children + 1, right->children + right->count + 1, right->children);
+                right->count--;
+                inner->count++;
+                return false;
+            }
+
+            if (left == nullptr)
+            {
+                left = inner;
+                inner = right;
+                index++;
+            }
+
+            // merge `inner` into `left`, pulling down the separating key.
+            left->keys[left->count] = move(parent->keys[index - 1]);
+            std::move(inner->keys, inner->keys + inner->count, left->keys + left->count + 1);
+            std::copy(inner->children, inner->children + inner->count + 1,
+                left->children + left->count + 1);
+
+            left->count += inner->count + 1;
+            _inner_pool.dealloc_node(inner);
+            _inner_remove_at(parent, index - 1);
+            return true;
+        }
+
+    private:
+        _btree_node_pool<leaf_type, allocator_type> _leaf_pool;
+        _btree_node_pool<inner_type, allocator_type> _inner_pool;
+        void* _root = nullptr;
+        leaf_type* _first_leaf = nullptr;
+        leaf_type* _last_leaf = nullptr;
+        usize _height = 0;
+        usize _count = 0;
+        ATOM_ATTR_NO_UNIQUE_ADDRESS comparer_type _comparer;
+    };
+}
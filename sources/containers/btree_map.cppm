@@ -0,0 +1,218 @@
+export module atom_core:containers.btree_map;
+
+import std;
+import :core;
+import :types;
+import :ranges;
+import :contracts;
+import :default_mem_allocator;
+import :containers.btree_impl;
+
+namespace atom
+{
+    /// --------------------------------------------------------------------------------------------
+    /// ordered map of unique keys to values, implemented as a b+ tree.
+    ///
+    /// nodes hold as many keys as fit in about 4 cache lines and are allocated from pools backed
+    /// by `in_allocator_type`. entries live in leaves which are linked in key order, so range
+    /// queries walk leaves sequentially instead of chasing a pointer per entry.
+    ///
+    /// inserting or removing entries invalidates all iterators.
+    /// --------------------------------------------------------------------------------------------
+    export template <typename in_key_type, typename in_value_type,
+        typename in_comparer_type = std::less<>,
+        typename in_allocator_type = default_mem_allocator>
+    class btree_map
+    {
+        using this_type = btree_map;
+        using impl_type = _btree_impl<in_key_type, in_value_type, in_comparer_type,
+            in_allocator_type>;
+
+    public:
+        using key_type = in_key_type;
+        using value_type = in_value_type;
+        using comparer_type = in_comparer_type;
+        using allocator_type = in_allocator_type;
+        using iterator_type = typename impl_type::iterator_type;
+        using mut_iterator_type = typename impl_type::mut_iterator_type;
+
+    public:
+        btree_map() = default;
+
+        btree_map(const this_type& that) = default;
+        btree_map& operator=(const this_type& that) = default;
+
+        btree_map(this_type&& that) = default;
+        btree_map& operator=(this_type&& that) = default;
+
+        /// ----------------------------------------------------------------------------------------
+        /// constructs with keys from `keys` mapped to values at the same position in `values`.
+        /// leaves are filled completely and built bottom up, without searching or splitting.
+        ///
+        /// \pre `keys` are sorted and unique.
+        /// \pre `keys` and `values` have the same count.
+        /// ----------------------------------------------------------------------------------------
+        template <typename key_range_type, typename value_range_type>
+        btree_map(create_from_sorted_range_tag, const key_range_type& keys,
+            const value_range_type& values)
+            requires(ranges::const_range_concept<key_range_type, key_type>
+                     and ranges::const_range_concept<value_range_type, value_type>)
+        {
+            _impl.bulk_load(ranges::get_iterator(keys), ranges::get_iterator_end(keys),
+                ranges::get_iterator(values));
+        }
+
+        ~btree_map() = default;
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// inserts `key` mapped to a value constructed with `args`, if `key` is not already
+        /// present.
+        ///
+        /// \returns `true` if the key was inserted.
+        /// ----------------------------------------------------------------------------------------
+        template <typename other_key_type, typename... arg_types>
+        auto emplace(other_key_type&& key, arg_types&&... args) -> bool
+        {
+            return _impl.template insert<false>(
+                forward<other_key_type>(key), forward<arg_types>(args)...);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// inserts `key` mapped to `value`, or assigns `value` if `key` is already present.
+        ///
+        /// \returns `true` if the key was inserted.
+        /// ----------------------------------------------------------------------------------------
+        template <typename other_key_type, typename other_value_type>
+        auto insert_or_assign(other_key_type&& key, other_value_type&& value) -> bool
+        {
+            return _impl.template insert<true>(
+                forward<other_key_type>(key), forward<other_value_type>(value));
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// removes `key` and its value if present.
+        ///
+        /// \returns `true` if the key was removed.
+        /// ----------------------------------------------------------------------------------------
+        template <typename other_key_type>
+        auto remove(const other_key_type& key) -> bool
+        {
+            return _impl.remove(key);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// removes all entries and releases the memory of all nodes.
+        /// ----------------------------------------------------------------------------------------
+        auto remove_all() -> void
+        {
+            _impl.remove_all();
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns pointer to the value mapped to `key`, or `nullptr` if not present.
+        /// ----------------------------------------------------------------------------------------
+        template <typename other_key_type>
+        auto find(const other_key_type& key) const -> const value_type*
+        {
+            iterator_type it = _impl.find(key);
+            return it.is_end() ? nullptr : &it.get_value();
+        }
+
+        /// \copydoc find(const other_key_type&)
+        template <typename other_key_type>
+        auto find(const other_key_type& key) -> value_type*
+        {
+            mut_iterator_type it = _impl.find(key);
+            return it.is_end() ? nullptr : &it.get_value();
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns `true` if `key` is present.
+        /// ----------------------------------------------------------------------------------------
+        template <typename other_key_type>
+        auto contains(const other_key_type& key) const -> bool
+        {
+            return not _impl.find(key).is_end();
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns iterator to the first entry whose key is not less than `key`.
+        /// ----------------------------------------------------------------------------------------
+        template <typename other_key_type>
+        auto lower_bound(const other_key_type& key) const -> iterator_type
+        {
+            return _impl.lower_bound(key);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns iterator to the first entry whose key is greater than `key`.
+        /// ----------------------------------------------------------------------------------------
+        template <typename other_key_type>
+        auto upper_bound(const other_key_type& key) const -> iterator_type
+        {
+            return _impl.upper_bound(key);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// calls `action(key, value)` for each entry whose key is in range `[from, to)`, in key
+        /// order.
+        /// ----------------------------------------------------------------------------------------
+        template <typename other_key_type, typename action_type>
+        auto for_each_in_range(
+            const other_key_type& from, const other_key_type& to, action_type&& action) const
+            -> void
+        {
+            _impl.for_each_in_range(from, to, forward<action_type>(action));
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns iterator to the first entry.
+        /// ----------------------------------------------------------------------------------------
+        auto get_iterator() const -> iterator_type
+        {
+            return _impl.get_iterator();
+        }
+
+        /// \copydoc get_iterator()
+        auto get_iterator() -> mut_iterator_type
+        {
+            return _impl.get_iterator();
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns iterator to the end.
+        /// ----------------------------------------------------------------------------------------
+        auto get_iterator_end() const -> iterator_type
+        {
+            return _impl.get_iterator_end();
+        }
+
+        /// \copydoc get_iterator_end()
+        auto get_iterator_end() -> mut_iterator_type
+        {
+            return _impl.get_iterator_end();
+        }
+
+        auto get_count() const -> usize
+        {
+            return _impl.get_count();
+        }
+
+        auto is_empty() const -> bool
+        {
+            return _impl.get_count() == 0;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns count of levels in the tree.
+        /// ----------------------------------------------------------------------------------------
+        auto get_height() const -> usize
+        {
+            return _impl.get_height();
+        }
+
+    private:
+        impl_type _impl;
+    };
+}
@@ -0,0 +1,155 @@
+export module atom_core:containers.btree_set;
+
+import std;
+import :core;
+import :types;
+import :ranges;
+import :contracts;
+import :default_mem_allocator;
+import :containers.btree_impl;
+
+namespace atom
+{
+    /// --------------------------------------------------------------------------------------------
+    /// ordered set of unique keys, implemented as a b+ tree. see `btree_map` for details.
+    ///
+    /// inserting or removing keys invalidates all iterators.
+    /// --------------------------------------------------------------------------------------------
+    export template <typename in_key_type, typename in_comparer_type = std::less<>,
+        typename in_allocator_type = default_mem_allocator>
+    class btree_set
+    {
+        using this_type = btree_set;
+        using impl_type = _btree_impl<in_key_type, void, in_comparer_type, in_allocator_type>;
+
+    public:
+        using key_type = in_key_type;
+        using comparer_type = in_comparer_type;
+        using allocator_type = in_allocator_type;
+        using iterator_type = typename impl_type::iterator_type;
+
+    public:
+        btree_set() = default;
+
+        btree_set(const this_type& that) = default;
+        btree_set& operator=(const this_type& that) = default;
+
+        btree_set(this_type&& that) = default;
+        btree_set& operator=(this_type&& that) = default;
+
+        /// ----------------------------------------------------------------------------------------
+        /// constructs with keys from `keys`. leaves are filled completely and built bottom up,
+        /// without searching or splitting.
+        ///
+        /// \pre `keys` are sorted and unique.
+        /// ----------------------------------------------------------------------------------------
+        template <typename range_type>
+        btree_set(create_from_sorted_range_tag, const range_type& keys)
+            requires(ranges::const_range_concept<range_type, key_type>)
+        {
+            _impl.bulk_load(ranges::get_iterator(keys), ranges::get_iterator_end(keys), nullptr);
+        }
+
+        ~btree_set() = default;
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// inserts `key` if it's not already present.
+        ///
+        /// \returns `true` if the key was inserted.
+        /// ----------------------------------------------------------------------------------------
+        template <typename other_key_type>
+        auto insert(other_key_type&& key) -> bool
+        {
+            return _impl.template insert<false>(forward<other_key_type>(key));
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// removes `key` if present.
+        ///
+        /// \returns `true` if the key was removed.
+        /// ----------------------------------------------------------------------------------------
+        template <typename other_key_type>
+        auto remove(const other_key_type& key) -> bool
+        {
+            return _impl.remove(key);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// removes all keys and releases the memory of all nodes.
+        /// ----------------------------------------------------------------------------------------
+        auto remove_all() -> void
+        {
+            _impl.remove_all();
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns `true` if `key` is present.
+        /// ----------------------------------------------------------------------------------------
+        template <typename other_key_type>
+        auto contains(const other_key_type& key) const -> bool
+        {
+            return not _impl.find(key).is_end();
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns iterator to the first key which is not less than `key`.
+        /// ----------------------------------------------------------------------------------------
+        template <typename other_key_type>
+        auto lower_bound(const other_key_type& key) const -> iterator_type
+        {
+            return _impl.lower_bound(key);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns iterator to the first key which is greater than `key`.
+        /// ----------------------------------------------------------------------------------------
+        template <typename other_key_type>
+        auto upper_bound(const other_key_type& key) const -> iterator_type
+        {
+            return _impl.upper_bound(key);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// calls `action(key)` for each key in range `[from, to)`, in order.
+        /// ----------------------------------------------------------------------------------------
+        template <typename other_key_type, typename action_type>
+        auto for_each_in_range(
+            const other_key_type& from, const other_key_type& to, action_type&& action) const
+            -> void
+        {
+            _impl.for_each_in_range(from, to, forward<action_type>(action));
+        }
+
+        auto get_iterator() const -> iterator_type
+        {
+            return _impl.get_iterator();
+        }
+
+        auto get_iterator_end() const -> iterator_type
+        {
+            return _impl.get_iterator_end();
+        }
+
+        auto get_count() const -> usize
+        {
+            return _impl.get_count();
+        }
+
+        auto is_empty() const -> bool
+        {
+            return _impl.get_count() == 0;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns count of levels in the tree.
+        /// ----------------------------------------------------------------------------------------
+        auto get_height() const -> usize
+        {
+            return _impl.get_height();
+        }
+
+    private:
+        impl_type _impl;
+    };
+}
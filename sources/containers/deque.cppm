@@ -0,0 +1,341 @@
+export module atom_core:containers.deque;
+
+import std;
+import :core;
+import :types;
+import :ranges;
+import :contracts;
+import :default_mem_allocator;
+import :containers.index_iterator;
+import :containers.ring_buffer;
+
+#include "atom/core/preprocessors.h"
+
+namespace atom
+{
+    export class deque_tag
+    {};
+
+    /// --------------------------------------------------------------------------------------------
+    /// count of values per chunk, so that a chunk is about 4 kb.
+    /// --------------------------------------------------------------------------------------------
+    template <typename value_type>
+    consteval auto _deque_get_default_chunk_count() -> usize
+    {
+        usize count = 4096 / sizeof(value_type);
+        return count < 16 ? 16 : std::bit_floor(count);
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// double ended queue of values, stored in fixed size chunks.
+    ///
+    /// inserting or removing at either end is constant time and never moves other values, so
+    /// references to values stay valid until they are removed. chunk pointers are kept in a
+    /// `ring_buffer`, so chunks are added and released at both ends in constant time.
+    /// --------------------------------------------------------------------------------------------
+    export template <typename in_value_type, typename in_allocator_type = default_mem_allocator,
+        usize in_chunk_count = _deque_get_default_chunk_count<in_value_type>()>
+    class deque: public deque_tag
+    {
+        static_assert(std::has_single_bit(in_chunk_count), "chunk count must be a power of two.");
+
+        using this_type = deque;
+
+    public:
+        using value_type = in_value_type;
+        using allocator_type = in_allocator_type;
+        using const_iterator_type = index_iterator<const this_type>;
+        using const_iterator_end_type = const_iterator_type;
+        using iterator_type = index_iterator<this_type>;
+        using iterator_end_type = iterator_type;
+
+        static constexpr usize chunk_count = in_chunk_count;
+
+    public:
+        deque()
+            : _chunks{}
+            , _head{ 0 }
+            , _count{ 0 }
+            , _allocator{}
+        {}
+
+        deque(const this_type& that)
+            : deque{}
+        {
+            for (usize i = 0; i < that._count; i++)
+                emplace_last(that.get_at(i));
+        }
+
+        deque& operator=(const this_type& that)
+        {
+            if (this != &that)
+            {
+                this_type copy{ that };
+                *this = move(copy);
+            }
+
+            return *this;
+        }
+
+        deque(this_type&& that)
+            : _chunks{ move(that._chunks) }
+            , _head{ that._head }
+            , _count{ that._count }
+            , _allocator{ move(that._allocator) }
+        {
+            that._head = 0;
+            that._count = 0;
+        }
+
+        deque& operator=(this_type&& that)
+        {
+            if (this == &that)
+                return *this;
+
+            remove_all();
+
+            _chunks = move(that._chunks);
+            _head = that._head;
+            _count = that._count;
+            _allocator = move(that._allocator);
+
+            that._head = 0;
+            that._count = 0;
+            return *this;
+        }
+
+        ~deque()
+        {
+            remove_all();
+        }
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// constructs value at last with `args`.
+        /// ----------------------------------------------------------------------------------------
+        template <typename... arg_types>
+        auto emplace_last(arg_types&&... args) -> void
+        {
+            usize pos = _head + _count;
+            if (pos == _chunks.get_count() * chunk_count)
+                _chunks.emplace_last(_alloc_chunk());
+
+            std::construct_at(_get_ptr(pos), forward<arg_types>(args)...);
+            _count++;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// constructs value at first with `args`.
+        /// ----------------------------------------------------------------------------------------
+        template <typename... arg_types>
+        auto emplace_first(arg_types&&... args) -> void
+        {
+            if (_head == 0)
+            {
+                _chunks.emplace_first(_alloc_chunk());
+                _head = chunk_count;
+            }
+
+            std::construct_at(_get_ptr(_head - 1), forward<arg_types>(args)...);
+            _head--;
+            _count++;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// removes the first value.
+        ///
+        /// \pre if debug `not is_empty()`: deque is empty.
+        /// ----------------------------------------------------------------------------------------
+        auto remove_first() -> void
+        {
+            contract_debug_expects(not is_empty(), "deque is empty.");
+
+            std::destroy_at(_get_ptr(_head));
+            _head++;
+            _count--;
+
+            if (_head == chunk_count)
+            {
+                _dealloc_chunk(_chunks.get_first());
+                _chunks.remove_first();
+                _head = 0;
+            }
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// removes the last value.
+        ///
+        /// \pre if debug `not is_empty()`: deque is empty.
+        /// ----------------------------------------------------------------------------------------
+        auto remove_last() -> void
+        {
+            contract_debug_expects(not is_empty(), "deque is empty.");
+
+            _count--;
+            std::destroy_at(_get_ptr(_head + _count));
+
+            if (_head + _count <= (_chunks.get_count() - 1) * chunk_count)
+            {
+                _dealloc_chunk(_chunks.get_last());
+                _chunks.remove_last();
+
+                if (_chunks.is_empty())
+                    _head = 0;
+            }
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// removes all values and releases all chunks.
+        /// ----------------------------------------------------------------------------------------
+        auto remove_all() -> void
+        {
+            if constexpr (not type_info<value_type>::is_trivially_destructible())
+            {
+                for (usize i = 0; i < _count; i++)
+                    std::destroy_at(_get_ptr(_head + i));
+            }
+
+            while (not _chunks.is_empty())
+            {
+                _dealloc_chunk(_chunks.get_last());
+                _chunks.remove_last();
+            }
+
+            _head = 0;
+            _count = 0;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns value at index `i`, counting from the first value.
+        ///
+        /// \pre if debug `i < get_count()`: index is out of range.
+        /// ----------------------------------------------------------------------------------------
+        auto get_at(usize i) const -> const value_type&
+        {
+            contract_debug_expects(i < _count, "index is out of range.");
+
+            return *_get_ptr(_head + i);
+        }
+
+        /// \copydoc get_at(usize)
+        auto get_at(usize i) -> value_type&
+        {
+            contract_debug_expects(i < _count, "index is out of range.");
+
+            return *_get_ptr(_head + i);
+        }
+
+        auto get_first() const -> const value_type&
+        {
+            return get_at(0);
+        }
+
+        auto get_first() -> value_type&
+        {
+            return get_at(0);
+        }
+
+        auto get_last() const -> const value_type&
+        {
+            return get_at(_count - 1);
+        }
+
+        auto get_last() -> value_type&
+        {
+            return get_at(_count - 1);
+        }
+
+        auto get_iterator() const -> const_iterator_type
+        {
+            return const_iterator_type(this, 0);
+        }
+
+        auto get_iterator_end() const -> const_iterator_end_type
+        {
+            return const_iterator_end_type(this, _count);
+        }
+
+        auto get_iterator() -> iterator_type
+        {
+            return iterator_type(this, 0);
+        }
+
+        auto get_iterator_end() -> iterator_end_type
+        {
+            return iterator_end_type(this, _count);
+        }
+
+        auto get_count() const -> usize
+        {
+            return _count;
+        }
+
+        auto is_empty() const -> bool
+        {
+            return _count == 0;
+        }
+
+    private:
+        /// ----------------------------------------------------------------------------------------
+        /// returns pointer to the value at position `pos`, counting from the start of the first
+        /// chunk.
+        /// ----------------------------------------------------------------------------------------
+        auto _get_ptr(usize pos) const -> value_type*
+        {
+            return _chunks.get_at(pos / chunk_count) + pos % chunk_count;
+        }
+
+        auto _alloc_chunk() -> value_type*
+        {
+            void* chunk = _allocator.alloc(chunk_count * sizeof(value_type));
+            contract_asserts(chunk != nullptr, "out of memory.");
+
+            return static_cast<value_type*>(chunk);
+        }
+
+        auto _dealloc_chunk(value_type* chunk) -> void
+        {
+            _allocator.dealloc(chunk);
+        }
+
+    private:
+        ring_buffer<value_type*, allocator_type> _chunks;
+        usize _head;
+        usize _count;
+        ATOM_ATTR_NO_UNIQUE_ADDRESS allocator_type _allocator;
+    };
+
+    export template <typename range_type>
+        requires(type_info<range_type>::template is_derived_from<deque_tag>())
+    class ranges::range_definition<range_type>
+    {
+    public:
+        using value_type = typename range_type::value_type;
+        using const_iterator_type = typename range_type::const_iterator_type;
+        using const_iterator_end_type = typename range_type::const_iterator_end_type;
+        using iterator_type = typename range_type::iterator_type;
+        using iterator_end_type = typename range_type::iterator_end_type;
+
+    public:
+        static constexpr auto get_iterator(range_type& range) -> iterator_type
+        {
+            return range.get_iterator();
+        }
+
+        static constexpr auto get_iterator_end(range_type& range) -> iterator_end_type
+        {
+            return range.get_iterator_end();
+        }
+
+        static constexpr auto get_const_iterator(const range_type& range) -> const_iterator_type
+        {
+            return range.get_iterator();
+        }
+
+        static constexpr auto get_const_iterator_end(
+            const range_type& range) -> const_iterator_end_type
+        {
+            return range.get_iterator_end();
+        }
+    };
+}
@@ -5,7 +5,8 @@ import :ranges;
 import :types;
 import :contracts;
 import :default_mem_allocator;
-import :containers.dynamic_array_impl_vector;
+import :containers.array_slice;
+import :containers.dynamic_array_impl;
 
 namespace atom
 {
@@ -27,7 +28,7 @@ namespace atom
 
     private:
         using this_type = dynamic_array<in_value_type, in_allocator_type>;
-        using impl_type = dynamic_array_impl_vector<in_value_type, in_allocator_type>;
+        using impl_type = _dynamic_array_impl<in_value_type, in_allocator_type>;
         using value_type_info = type_info<in_value_type>;
 
     public:
@@ -240,7 +241,7 @@ namespace atom
         {
             contract_debug_expects(is_index_in_range_or_end(i), "index is out of range.");
 
-            _impl.emplace_at(i, forward<arg_types>(args)...);
+            _impl.emplace_many_at(i, count, args...);
         }
 
         /// ----------------------------------------------------------------------------------------
@@ -264,7 +265,7 @@ namespace atom
             contract_debug_expects(is_iterator_in_range_or_end(it), "iterator is out of range.");
 
             usize index = get_index_for_iterator(it);
-            _impl.emplace_many_at(index, count, forward<arg_types>(args)...);
+            _impl.emplace_many_at(index, count, args...);
             return _impl.get_iterator_at(index);
         }
 
@@ -374,8 +375,9 @@ namespace atom
                 and value_type_info::template is_constructible_from<
                     ranges::value_type<typename type_info<range_type>::pure_type::value_type>>())
         {
-            usize count = _impl.insert_range_first(move(range));
-            return _impl.get_iterator(count);
+            usize count = _impl.insert_range_first(
+                ranges::get_iterator(range), ranges::get_iterator_end(range));
+            return _impl.get_iterator_at(count);
         }
 
         /// ----------------------------------------------------------------------------------------
@@ -445,21 +447,21 @@ namespace atom
         }
 
         /// ----------------------------------------------------------------------------------------
-        /// removes values from index `from` to `to`.
+        /// removes values from index `from` to `to`, excluding `to`.
         ///
-        /// \pre if debug `is_index_in_range(to)`: index was out of range.
+        /// \pre if debug `is_index_in_range_or_end(to)`: index was out of range.
         /// \pre if debug `from <= to`: index was out of range.
         /// ----------------------------------------------------------------------------------------
         constexpr auto remove_range(usize from, usize to) -> void
         {
-            contract_debug_expects(is_index_in_range(to), "index was out of range.");
+            contract_debug_expects(is_index_in_range_or_end(to), "index was out of range.");
             contract_debug_expects(from <= to, "index was out of range.");
 
-            _impl.remove_range(from, to);
+            _impl.remove_range(from, to - from);
         }
 
         /// ----------------------------------------------------------------------------------------
-        /// removes values from position referenced by `from` to `to`.
+        /// removes values from position referenced by `from` to `to`, excluding `to`.
         ///
         /// \returns `iterator_type` to next value of the last removed value. if the last
         /// removed value was also the last value of the array, returns `get_iterator_end()`.
@@ -467,7 +469,7 @@ namespace atom
         /// \pre if debug `is_iterator_valid(from)`: invalid iterator.
         /// \pre if debug `is_iterator_valid(to)`: invalid iterator.
         /// \pre if debug `is_iterator_in_range(from)`: iterator is out range.
-        /// \pre if debug `is_iterator_in_range(to)`: iterator is out range.
+        /// \pre if debug `is_iterator_in_range_or_end(to)`: iterator is out range.
         /// \pre if debug `(from - to) <= 0`: invalid range.
         /// ----------------------------------------------------------------------------------------
         constexpr auto remove_range(
@@ -476,14 +478,14 @@ namespace atom
             contract_debug_expects(is_iterator_valid(from), "invalid iterator.");
             contract_debug_expects(is_iterator_valid(to), "invalid iterator.");
             contract_debug_expects(is_iterator_in_range(from), "iterator is out range.");
-            contract_debug_expects(is_iterator_in_range(to), "iterator is out range.");
+            contract_debug_expects(is_iterator_in_range_or_end(to), "iterator is out range.");
             contract_debug_expects((from - to) <= 0, "invalid range.");
 
             usize from_index = get_index_for_iterator(from);
             usize to_index = get_index_for_iterator(to);
-            _impl.remove_range(from_index, to_index);
+            _impl.remove_range(from_index, to_index - from_index);
 
-            return _impl.get_iterator(from_index);
+            return _impl.get_iterator_at(from_index);
         }
 
         /// ----------------------------------------------------------------------------------------
@@ -679,6 +681,65 @@ namespace atom
             return _impl.reserve_more(count);
         }
 
+        /// ----------------------------------------------------------------------------------------
+        /// sets the count of values to `count`. values added are left uninitialized, so this
+        /// can be used to read or decode directly into the array without zeroing it first.
+        ///
+        /// \note all iterators are invalidated after this operation.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto resize_uninitialized(usize count) -> void
+            requires(_can_be_uninitialized())
+        {
+            _impl.resize_uninitialized(count);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// adds `count` uninitialized values at last.
+        ///
+        /// \returns `array_slice` of the values added, to be written by the caller.
+        ///
+        /// \note all iterators are invalidated after this operation.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto append_uninitialized(usize count) -> array_slice<value_type>
+            requires(_can_be_uninitialized())
+        {
+            usize index = _impl.get_count();
+            _impl.resize_uninitialized(index + count);
+            return array_slice<value_type>{ create_from_raw, _impl.get_data() + index, count };
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// reserves space for at least `count` more values without adding them.
+        ///
+        /// \returns `array_slice` of the whole spare capacity. write into it and then call
+        /// `commit_spare()` with the count of values written.
+        ///
+        /// \note all iterators are invalidated after this operation.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto reserve_spare(usize count) -> array_slice<value_type>
+            requires(_can_be_uninitialized())
+        {
+            _impl.reserve_more(count);
+
+            usize index = _impl.get_count();
+            return array_slice<value_type>{ create_from_raw, _impl.get_data() + index,
+                _impl.get_capacity() - index };
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// adds `count` values written into the spare capacity returned by `reserve_spare()`.
+        ///
+        /// \pre if debug `count <= get_reserved_count()`: count is more than spare capacity.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto commit_spare(usize count) -> void
+            requires(_can_be_uninitialized())
+        {
+            contract_debug_expects(
+                count <= get_reserved_count(), "count is more than spare capacity.");
+
+            _impl.resize_uninitialized(_impl.get_count() + count);
+        }
+
         /// ----------------------------------------------------------------------------------------
         /// releases unused memory.
         /// ----------------------------------------------------------------------------------------
@@ -704,9 +765,9 @@ namespace atom
         }
 
         /// ----------------------------------------------------------------------------------------
-        /// \returns reference to stored allocator.
+        /// \returns copy of the stored allocator.
         /// ----------------------------------------------------------------------------------------
-        constexpr auto get_allocator() const -> const allocator_type&
+        constexpr auto get_allocator() const -> allocator_type
         {
             return _impl.get_allocator();
         }
@@ -767,6 +828,16 @@ namespace atom
             return _impl.is_iterator_in_range_or_end(it);
         }
 
+    private:
+        /// ----------------------------------------------------------------------------------------
+        /// values which don't need to be constructed before written to or destroyed after.
+        /// ----------------------------------------------------------------------------------------
+        static consteval auto _can_be_uninitialized() -> bool
+        {
+            return value_type_info::is_trivially_default_constructible()
+                   and value_type_info::is_trivially_destructible();
+        }
+
     private:
         impl_type _impl;
     };
@@ -2,15 +2,25 @@ export module atom_core:containers.dynamic_array_impl;
 
 import std;
 import :core;
+import :types;
 import :ranges;
 import :contracts;
+import :memory_utils;
 
 namespace atom
 {
+    /// --------------------------------------------------------------------------------------------
+    /// native implementation of `dynamic_array`.
+    ///
+    /// values which are trivially copyable and destructible are relocated, copied and shifted
+    /// using mem operations, and ranges from contiguous iterators of such values are inserted with
+    /// a single capacity check and a single copy.
+    /// --------------------------------------------------------------------------------------------
     template <typename in_value_type, typename in_allocator_type>
     class _dynamic_array_impl
     {
         using this_type = _dynamic_array_impl;
+        using value_type_info = type_info<in_value_type>;
 
     public:
         using value_type = in_value_type;
@@ -39,19 +49,23 @@ namespace atom
         {}
 
         constexpr _dynamic_array_impl(copy_tag, const _dynamic_array_impl& that)
-            : this_type{ range_tag(), that.get_iterator(), that.get_iterator_end() }
-        {}
+            : _data{ nullptr }
+            , _count{ 0 }
+            , _capacity{ 0 }
+            , _allocator{ that._allocator }
+        {
+            insert_range_last(that.get_iterator(), that.get_iterator_end());
+        }
 
         constexpr _dynamic_array_impl(move_tag, _dynamic_array_impl& that)
             : _data{ that._data }
             , _count{ that._count }
             , _capacity{ that._capacity }
-            , _allocator{ that._allocator }
+            , _allocator{ move(that._allocator) }
         {
             that._data = nullptr;
             that._count = 0;
             that._capacity = 0;
-            that._allocator = allocator_type();
         }
 
         template <typename other_iterator_type, typename other_iterator_end_type>
@@ -62,55 +76,72 @@ namespace atom
             insert_range_last(move(it), move(it_end));
         }
 
+        constexpr _dynamic_array_impl(create_from_raw_tag, const value_type* arr, usize count)
+            : _dynamic_array_impl{}
+        {
+            insert_range_last(arr, arr + count);
+        }
+
         constexpr _dynamic_array_impl(create_with_count_tag, usize count)
-            : _count{ count }
-            , _capacity{ count }
-            , _allocator{}
+            : _dynamic_array_impl{}
         {
-            _data = (value_type*)_allocator.alloc(count);
+            _ensure_cap_for(count);
+
+            if (value_type_info::is_trivially_default_constructible()
+                and not std::is_constant_evaluated())
+            {
+                if (count != 0)
+                    memory_utils::fill(_data, count * sizeof(value_type), byte(0));
+            }
+            else
+            {
+                for (usize i = 0; i < count; i++)
+                    _construct_at(i);
+            }
+
+            _count = count;
         }
 
         constexpr _dynamic_array_impl(create_with_count_tag, usize count, const value_type& value)
-            : _count{ count }
-            , _capacity{ count }
-            , _allocator{}
+            : _dynamic_array_impl{}
         {
-            _data = (value_type*)_allocator.alloc(count);
+            _ensure_cap_for(count);
 
-            for (usize i = 0; i < _count; i++)
-                _data[i] = value;
+            for (usize i = 0; i < count; i++)
+                _construct_at(i, value);
+
+            _count = count;
         }
 
         constexpr _dynamic_array_impl(create_with_capacity_tag, usize capacity)
-            : _count{ 0 }
-            , _capacity{ capacity }
-            , _allocator{}
+            : _dynamic_array_impl{}
         {
-            _data = (value_type*)_allocator.alloc(capacity);
+            _ensure_cap_for(capacity);
         }
 
         constexpr ~_dynamic_array_impl()
         {
-            if (_count != 0)
-            {
-                _destruct_all();
-                _release_all_mem();
-            }
+            _destruct_all();
+            _release_all_mem();
         }
 
     public:
         constexpr auto move_this(this_type& that) -> void
         {
-            if (_count != 0)
-            {
-                _destruct_all();
-                _release_all_mem();
-            }
+            if (this == &that)
+                return;
+
+            _destruct_all();
+            _release_all_mem();
 
             _data = that._data;
             _count = that._count;
             _capacity = that._capacity;
-            _allocator = that._allocator;
+            _allocator = move(that._allocator);
+
+            that._data = nullptr;
+            that._count = 0;
+            that._capacity = 0;
         }
 
         constexpr auto get_at(usize index) const -> const value_type&
@@ -118,7 +149,7 @@ namespace atom
             return _data[index];
         }
 
-        constexpr auto get_mut_at(usize index) -> value_type&
+        constexpr auto get_at(usize index) -> value_type&
         {
             return _data[index];
         }
@@ -138,17 +169,17 @@ namespace atom
             return iterator_end_type(_data + _count);
         }
 
-        constexpr auto get_mut_iterator() -> mut_iterator_type
+        constexpr auto get_iterator() -> mut_iterator_type
         {
             return mut_iterator_type(_data);
         }
 
-        constexpr auto get_mut_iterator_at(usize index) -> mut_iterator_type
+        constexpr auto get_iterator_at(usize index) -> mut_iterator_type
         {
             return mut_iterator_type(_data + index);
         }
 
-        constexpr auto get_mut_iterator_end() -> mut_iterator_end_type
+        constexpr auto get_iterator_end() -> mut_iterator_end_type
         {
             return mut_iterator_end_type(_data + _count);
         }
@@ -156,23 +187,88 @@ namespace atom
         template <typename other_iterator_type, typename other_iterator_end_type>
         constexpr auto assign_range(other_iterator_type it, other_iterator_end_type it_end)
         {
-            remove_all();
-            insert_range_last(move(it), move(it_end));
+            if constexpr (_is_trivial_array_source<other_iterator_type, other_iterator_end_type>())
+            {
+                const value_type* src = std::to_address(it);
+                usize count = usize(it_end - it);
+
+                if (not std::is_constant_evaluated() and not _is_aliasing(src, count))
+                {
+                    _count = 0;
+                    _ensure_cap_for(count);
+                    _copy_trivial(src, count, _data);
+                    _count = count;
+                    return;
+                }
+            }
+
+            // the range may be a part of this array, so build the new values before destroying
+            // the current ones.
+            this_type tmp{ range_tag(), move(it), move(it_end) };
+            move_this(tmp);
+        }
+
+        template <typename... arg_types>
+        constexpr auto emplace_at(usize index, arg_types&&... args) -> usize
+        {
+            if (index == _count and _count < _capacity)
+            {
+                _construct_at(_count, forward<arg_types>(args)...);
+                _count++;
+                return index;
+            }
+
+            if (_count == _capacity)
+            {
+                // `args` may refer to a value of this array, so construct the new value before
+                // relocating the current ones.
+                value_type* new_data = _alloc_mem(_calc_cap_growth(_count + 1));
+                std::construct_at(new_data + index, forward<arg_types>(args)...);
+                _relocate_with_gap_to(new_data, _calc_cap_growth(_count + 1), index, 1);
+                _count++;
+                return index;
+            }
+
+            value_type value(forward<arg_types>(args)...);
+            usize live_end = _open_gap(index, 1);
+            _fill_gap_at(index, live_end, move(value));
+            _count++;
+            return index;
         }
 
         template <typename... arg_types>
-        constexpr auto emplace_at(usize index, arg_types&&... args)
+        constexpr auto emplace_many_at(usize index, usize count, const arg_types&... args) -> usize
         {
-            return _emplace_at(index, forward<arg_types>(args)...);
+            if (count == 0)
+                return index;
+
+            value_type value(args...);
+            usize live_end = _ensure_gap_at(index, count);
+
+            for (usize i = 0; i < count; i++)
+                _fill_gap_at(index + i, live_end, value);
+
+            _count += count;
+            return index;
         }
 
         template <typename other_iterator_type, typename other_iterator_end_type>
         constexpr auto insert_range_at(
             usize index, other_iterator_type it, other_iterator_end_type it_end) -> usize
         {
+            if constexpr (_is_trivial_array_source<other_iterator_type, other_iterator_end_type>())
+            {
+                if (not std::is_constant_evaluated())
+                {
+                    return _insert_trivial_range_at(
+                        index, std::to_address(it), usize(it_end - it));
+                }
+            }
+
             if constexpr (_can_get_range_size<other_iterator_type, other_iterator_end_type>())
             {
-                return _insert_range_at_counted(index, it, _get_range_size(move(it), move(it_end)));
+                usize count = _get_range_size(it, it_end);
+                return _insert_range_at_counted(index, move(it), count);
             }
             else
             {
@@ -183,7 +279,13 @@ namespace atom
         template <typename... arg_types>
         constexpr auto emplace_first(arg_types&&... args)
         {
-            return _emplace_first(forward<arg_types>(args)...);
+            return emplace_at(0, forward<arg_types>(args)...);
+        }
+
+        template <typename... arg_types>
+        constexpr auto emplace_many_first(usize count, const arg_types&... args) -> usize
+        {
+            return emplace_many_at(0, count, args...);
         }
 
         template <typename other_iterator_type, typename other_iterator_end_type>
@@ -196,44 +298,61 @@ namespace atom
         template <typename... arg_types>
         constexpr auto emplace_last(arg_types&&... args)
         {
-            return _emplace_at(_count, forward<arg_types>(args)...);
+            return emplace_at(_count, forward<arg_types>(args)...);
+        }
+
+        template <typename... arg_types>
+        constexpr auto emplace_many_last(usize count, const arg_types&... args) -> usize
+        {
+            return emplace_many_at(_count, count, args...);
         }
 
         template <typename other_iterator_type, typename other_iterator_end_type>
         constexpr auto insert_range_last(
             other_iterator_type it, other_iterator_end_type it_end) -> usize
         {
-            if constexpr (_can_get_range_size<other_iterator_type, other_iterator_end_type>())
+            return insert_range_at(_count, move(it), move(it_end));
+        }
+
+        constexpr auto remove_at(usize index)
+        {
+            remove_range(index, 1);
+        }
+
+        constexpr auto remove_range(usize begin, usize count)
+        {
+            if (count == 0)
+                return;
+
+            if (_is_trivial() and not std::is_constant_evaluated())
             {
-                usize count = _get_range_size(move(it), move(it_end));
-                _insert_range_last_counted(it, count);
-                return count;
+                usize tail_count = _count - begin - count;
+                if (tail_count != 0)
+                    _copy_trivial(_data + begin + count, tail_count, _data + begin);
             }
             else
             {
-                return _insert_range_last_uncounted(move(it), move(it_end));
+                std::move(_data + begin + count, _data + _count, _data + begin);
+                std::destroy(_data + _count - count, _data + _count);
             }
+
+            _count -= count;
         }
 
-        constexpr auto remove_at(usize index)
+        constexpr auto remove_first(usize count)
         {
-            _destruct_at(index);
-            _shift_range_first(index, 1);
+            remove_range(0, count);
         }
 
-        constexpr auto remove_range(usize begin, usize count)
+        constexpr auto remove_last(usize count)
         {
-            _destruct_range(begin, count);
-            _shift_range_first(begin + count, count);
+            remove_range(_count - count, count);
         }
 
         constexpr auto remove_all()
         {
-            if (_count != 0)
-            {
-                _destruct_all();
-                _count = 0;
-            }
+            _destruct_all();
+            _count = 0;
         }
 
         constexpr auto reserve(usize count)
@@ -246,8 +365,41 @@ namespace atom
             _ensure_cap_for(_count + count);
         }
 
-        // todo: implement this.
-        constexpr auto release_unused_mem() {}
+        /// ----------------------------------------------------------------------------------------
+        /// sets the count to `count` without constructing or destroying any value.
+        ///
+        /// \pre `value_type` can be left uninitialized and is trivially destructible.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto resize_uninitialized(usize count) -> void
+        {
+            _ensure_cap_for(count);
+            _count = count;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// shrinks the capacity to the count, releasing the memory if there are no values.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto release_unused_mem() -> void
+        {
+            if (_capacity == _count)
+                return;
+
+            if (_count == 0)
+            {
+                _release_all_mem();
+                _capacity = 0;
+                return;
+            }
+
+            if (_is_trivial() and not std::is_constant_evaluated())
+            {
+                _realloc_mem(_count);
+                return;
+            }
+
+            value_type* new_data = _alloc_mem(_count);
+            _relocate_with_gap_to(new_data, _count, _count, 0);
+        }
 
         constexpr auto get_capacity() const -> usize
         {
@@ -264,12 +416,12 @@ namespace atom
             return _data;
         }
 
-        constexpr auto get_mut_data() -> value_type*
+        constexpr auto get_data() -> value_type*
         {
             return _data;
         }
 
-        constexpr auto get_allocator() const -> const allocator_type&
+        constexpr auto get_allocator() const -> allocator_type
         {
             return _allocator;
         }
@@ -296,7 +448,7 @@ namespace atom
 
         constexpr auto get_index_for_iterator(iterator_type it) const -> usize
         {
-            isize index = &*it - _data;
+            isize index = it - _data;
             return index < 0 ? nums::get_max_usize() : index;
         }
 
@@ -311,202 +463,322 @@ namespace atom
         }
 
     private:
-        constexpr auto _release_all_mem()
+        /// ----------------------------------------------------------------------------------------
+        /// values which can be relocated, copied and destroyed using mem operations.
+        /// ----------------------------------------------------------------------------------------
+        static consteval auto _is_trivial() -> bool
         {
-            _allocator.dealloc(_data);
+            return value_type_info::is_trivially_copyable()
+                   and value_type_info::is_trivially_moveable()
+                   and value_type_info::is_trivially_destructible();
         }
 
-        template <typename... arg_types>
-        constexpr auto _emplace_at(usize index, arg_types&&... args) -> usize
+        /// ----------------------------------------------------------------------------------------
+        /// returns `true` if the range can be inserted with a single mem copy.
+        /// ----------------------------------------------------------------------------------------
+        template <typename other_iterator_type, typename other_iterator_end_type>
+        static consteval auto _is_trivial_array_source() -> bool
         {
-            _ensure_space_at(index, 1);
-            _construct_at(index, forward<arg_types>(args)...);
-            _count += 1;
+            return _is_trivial()
+                   and ranges::const_array_iterator_pair_concept<other_iterator_type,
+                       other_iterator_end_type, value_type>;
+        }
 
-            return index;
+        constexpr auto _is_aliasing(const value_type* src, usize count) const -> bool
+        {
+            return count != 0 and _data != nullptr and src < _data + _capacity
+                   and src + count > _data;
         }
 
+        /// ----------------------------------------------------------------------------------------
+        /// returns `true` if the `count` values from `it` may be a part of this array. only
+        /// contiguous ranges of `value_type` can be.
+        /// ----------------------------------------------------------------------------------------
         template <typename other_iterator_type>
-        constexpr auto _insert_range_at_counted(
-            usize index, other_iterator_type it, usize count) -> usize
+        constexpr auto _is_iterator_aliasing(const other_iterator_type& it, usize count) const
+            -> bool
         {
-            if (count == 0)
-                return index;
-
-            _ensure_space_at(count);
+            if constexpr (ranges::const_array_iterator_concept<other_iterator_type, value_type>)
+            {
+                // pointers to different objects can't be ordered during constant evaluation.
+                if (std::is_constant_evaluated())
+                    return count != 0 and _data != nullptr;
 
-            for (usize i = 0; i < count; i++)
+                return _is_aliasing(std::to_address(it), count);
+            }
+            else
             {
-                _construct_at(index + i, it.value());
-                it.next();
+                return false;
             }
-
-            _count += count;
-            return index;
         }
 
-        // todo: improve performance.
-        constexpr auto _ensure_space_first(usize count) -> void
+        static constexpr auto _copy_trivial(
+            const value_type* src, usize count, value_type* dest) -> void
         {
-            _ensure_space_at(0, count);
+            memory_utils::copy_to(src, count * sizeof(value_type), dest);
         }
 
-        // todo: improve performance.
-        constexpr auto _ensure_space_at(usize index, usize count) -> void
+        /// ----------------------------------------------------------------------------------------
+        /// inserts `count` values from `src` at `index`, with a single capacity check and copy.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto _insert_trivial_range_at(
+            usize index, const value_type* src, usize count) -> usize
         {
-            _ensure_cap_for(count);
+            if (count == 0)
+                return 0;
 
-            if (_count != 0)
-                _shift_range_last(index, count);
-        }
+            usize tail_count = _count - index;
 
-        // todo: improve performance.
-        constexpr auto _ensure_space_last(usize count) -> void
-        {
-            _ensure_cap_for(count);
-        }
+            // relocating into new memory keeps `src` valid, even if it is a part of this array.
+            if (_capacity - _count < count or _is_aliasing(src, count))
+            {
+                usize new_cap = _calc_cap_growth(_count + count);
+                value_type* new_data = _alloc_mem(new_cap);
 
-        // unchecked
-        template <typename other_iterator_type, typename other_iterator_end_type>
-        constexpr auto _insert_range_at_uncounted(
-            usize index, other_iterator_type it, other_iterator_end_type it_end) -> usize
-        {
-            usize rotate_size = _count - index;
-            _insert_range_last_uncounted(move(it), move(it_end));
-            _rotate_range_last(index, rotate_size);
+                if (index != 0)
+                    _copy_trivial(_data, index, new_data);
 
-            return index;
+                _copy_trivial(src, count, new_data + index);
+
+                if (tail_count != 0)
+                    _copy_trivial(_data + index, tail_count, new_data + index + count);
+
+                _release_all_mem();
+                _data = new_data;
+                _capacity = new_cap;
+            }
+            else
+            {
+                if (tail_count != 0)
+                    _copy_trivial(_data + index, tail_count, _data + index + count);
+
+                _copy_trivial(src, count, _data + index);
+            }
+
+            _count += count;
+            return count;
         }
 
         template <typename other_iterator_type>
-        constexpr auto _insert_range_last_counted(other_iterator_type it, usize count)
+        constexpr auto _insert_range_at_counted(
+            usize index, other_iterator_type it, usize count) -> usize
         {
             if (count == 0)
-                return;
-
-            _ensure_space_last(count);
+                return 0;
 
-            for (usize i = 0; i < count; i++)
+            // the range may be a part of this array, so construct the new values before
+            // relocating the current ones. opening the gap in place would shift the values of an
+            // aliasing range, so those are relocated to new memory too.
+            bool needs_growth = _capacity - _count < count;
+            if (needs_growth or _is_iterator_aliasing(it, count))
             {
-                _construct_at(_count + i, it.value());
-                it.next();
+                usize new_cap = needs_growth ? _calc_cap_growth(_count + count) : _capacity;
+                value_type* new_data = _alloc_mem(new_cap);
+
+                for (usize i = 0; i < count; i++, ++it)
+                    std::construct_at(new_data + index + i, *it);
+
+                _relocate_with_gap_to(new_data, new_cap, index, count);
+                _count += count;
+                return count;
             }
 
+            usize live_end = _open_gap(index, count);
+
+            for (usize i = 0; i < count; i++, ++it)
+                _fill_gap_at(index + i, live_end, *it);
+
             _count += count;
+            return count;
         }
 
         template <typename other_iterator_type, typename other_iterator_end_type>
-        constexpr auto _insert_range_last_uncounted(
-            other_iterator_type it, other_iterator_end_type it_end) -> usize
+        constexpr auto _insert_range_at_uncounted(
+            usize index, other_iterator_type it, other_iterator_end_type it_end) -> usize
         {
-            usize count = 0;
-            while (it != it_end)
+            usize old_count = _count;
+            for (; it != it_end; ++it)
             {
-                _ensure_space_last(1);
-                _construct_at(_count + count, it.value());
-
-                it.next();
-                count++;
+                _ensure_cap_for(_count + 1);
+                _construct_at(_count, *it);
+                _count++;
             }
 
-            _count += count;
-            return count;
+            std::rotate(_data + index, _data + old_count, _data + _count);
+            return _count - old_count;
         }
 
-        // todo: implement this.
-        constexpr auto _update_iterator_debug_id() {}
-
-        constexpr auto _calc_cap_growth(usize required) const -> usize
+        /// ----------------------------------------------------------------------------------------
+        /// makes room for `count` values at `index`, growing the capacity if needed. returns the
+        /// end of the gap's live slots, see `_open_gap()`.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto _ensure_gap_at(usize index, usize count) -> usize
         {
-            const usize max = _count < nums::get_max_usize() / 2 ? _count : nums::get_max_usize();
-            return std::max(max, required);
+            if (_capacity - _count < count)
+            {
+                usize new_cap = _calc_cap_growth(_count + count);
+                value_type* new_data = _alloc_mem(new_cap);
+
+                // the gap is in new memory, so it's uninitialized.
+                _relocate_with_gap_to(new_data, new_cap, index, count);
+                return index;
+            }
+
+            return _open_gap(index, count);
         }
 
-        constexpr auto _ensure_cap_for(usize count)
+        /// ----------------------------------------------------------------------------------------
+        /// shifts values from `index` by `count` within the current capacity.
+        ///
+        /// returns the end of the gap's live slots. slots of the gap before it still hold moved
+        /// from values and are assigned to, the rest are uninitialized and are constructed into.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto _open_gap(usize index, usize count) -> usize
         {
-            // we have enough capacity.
-            if (_capacity - _count >= count)
-                return;
+            usize tail_count = _count - index;
 
-            _update_iterator_debug_id();
+            if (_is_trivial() and not std::is_constant_evaluated())
+            {
+                if (tail_count != 0)
+                    _copy_trivial(_data + index, tail_count, _data + index + count);
 
-            usize new_cap = _calc_cap_growth(count);
-            value_type* new_data = (value_type*)_allocator.alloc(new_cap);
+                return index;
+            }
 
-            if (_count != 0)
+            if (tail_count > count)
             {
-                _move_range_to(0, new_data);
+                // move construct the last `count` values into uninitialized memory, then shift the
+                // rest by move assignment.
+                std::uninitialized_move(_data + _count - count, _data + _count, _data + _count);
+                std::move_backward(_data + index, _data + _count - count, _data + _count);
+                return index + count;
             }
 
-            if (_data != nullptr)
+            std::uninitialized_move(_data + index, _data + _count, _data + index + count);
+            return index + tail_count;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// sets the slot `index` of a gap whose live slots end at `live_end`.
+        /// ----------------------------------------------------------------------------------------
+        template <typename arg_type>
+        constexpr auto _fill_gap_at(usize index, usize live_end, arg_type&& arg) -> void
+        {
+            if (index < live_end)
+                _data[index] = forward<arg_type>(arg);
+            else
+                _construct_at(index, forward<arg_type>(arg));
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// relocates current values to `new_data`, leaving a gap of `count` values at `index`,
+        /// and replaces the current memory with it.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto _relocate_with_gap_to(
+            value_type* new_data, usize new_cap, usize index, usize count) -> void
+        {
+            if (_is_trivial() and not std::is_constant_evaluated())
             {
-                _allocator.dealloc(_data);
+                if (index != 0)
+                    _copy_trivial(_data, index, new_data);
+
+                if (_count != index)
+                    _copy_trivial(_data + index, _count - index, new_data + index + count);
+            }
+            else
+            {
+                std::uninitialized_move(_data, _data + index, new_data);
+                std::uninitialized_move(_data + index, _data + _count, new_data + index + count);
+                _destruct_all();
             }
 
+            _release_all_mem();
             _data = new_data;
             _capacity = new_cap;
         }
 
-        template <typename... arg_types>
-        constexpr auto _construct_at(usize index, arg_types&&... args) -> void
+        constexpr auto _calc_cap_growth(usize required) const -> usize
         {
-            value_type* src = _data + index;
-            std::construct_at(src, forward<arg_types>(args)...);
+            usize doubled = _capacity < nums::get_max_usize() / 2 ? _capacity * 2 : required;
+            return std::max(doubled, required);
         }
 
-        constexpr auto _destruct_at(usize index) -> void
+        /// ----------------------------------------------------------------------------------------
+        /// ensures capacity for `count` values in total.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto _ensure_cap_for(usize count) -> void
         {
-            value_type* src = _data + index;
-            std::destroy_at(src);
-        }
+            // we have enough capacity.
+            if (_capacity >= count)
+                return;
 
-        constexpr auto _destruct_range(usize index, usize count) -> void
-        {
-            value_type* begin = _data + index;
-            value_type* end = begin + count;
-            std::destroy(begin, end);
+            usize new_cap = _calc_cap_growth(count);
+
+            // trivial values can be relocated by the allocator, which may extend the allocation
+            // in place.
+            if (_is_trivial() and not std::is_constant_evaluated() and _data != nullptr)
+            {
+                _realloc_mem(new_cap);
+                return;
+            }
+
+            value_type* new_data = _alloc_mem(new_cap);
+            _relocate_with_gap_to(new_data, new_cap, _count, 0);
         }
 
-        constexpr auto _destruct_all() -> void
+        constexpr auto _alloc_mem(usize count) -> value_type*
         {
-            value_type* begin = _data;
-            value_type* end = _data + _count;
-            std::destroy(begin, end);
+            if (std::is_constant_evaluated())
+                return std::allocator<value_type>().allocate(count);
+
+            void* mem = _allocator.alloc(count * sizeof(value_type));
+            contract_asserts(mem != nullptr, "out of memory.");
+
+            return static_cast<value_type*>(mem);
         }
 
-        constexpr auto _shift_range_first(usize index, usize steps) -> void
+        /// ----------------------------------------------------------------------------------------
+        /// resizes the current memory to `count` values with the allocator, which may extend it in
+        /// place. only for trivial values.
+        /// ----------------------------------------------------------------------------------------
+        auto _realloc_mem(usize count) -> void
         {
-            value_type* begin = _data + index;
-            value_type* end = _data + _count;
-            value_type* dest = begin - steps;
-            std::move(begin, end, dest);
+            void* mem = _allocator.realloc(_data, count * sizeof(value_type));
+            contract_asserts(mem != nullptr, "out of memory.");
+
+            _data = static_cast<value_type*>(mem);
+            _capacity = count;
         }
 
-        constexpr auto _shift_range_last(usize index, usize steps) -> void
+        constexpr auto _release_all_mem() -> void
         {
-            value_type* begin = _data + index;
-            value_type* end = _data + _count;
-            value_type* dest = begin + steps;
-            std::move_backward(begin, end, dest);
+            if (_data == nullptr)
+                return;
+
+            if (std::is_constant_evaluated())
+                std::allocator<value_type>().deallocate(_data, _capacity);
+            else
+                _allocator.dealloc(_data);
+
+            _data = nullptr;
         }
 
-        constexpr auto _rotate_range_last(usize index, usize count) -> void
+        template <typename... arg_types>
+        constexpr auto _construct_at(usize index, arg_types&&... args) -> void
         {
-            value_type* begin = _data;
-            value_type* mid = begin + index;
-            value_type* end = begin + _count;
-            std::rotate(begin, mid, end);
+            std::construct_at(_data + index, forward<arg_types>(args)...);
         }
 
-        constexpr auto _move_range_to(usize index, value_type* dest) -> void
+        constexpr auto _destruct_all() -> void
         {
-            value_type* begin = _data + index;
-            value_type* end = _data + _count;
-            std::move(begin, end, dest);
+            if constexpr (not value_type_info::is_trivially_destructible())
+            {
+                std::destroy(_data, _data + _count);
+            }
         }
 
         template <typename other_iterator_type, typename other_iterator_end_type>
-        static constexpr auto _can_get_range_size() -> bool
+        static consteval auto _can_get_range_size() -> bool
         {
             return ranges::const_unidirectional_iterator_pair_concept<other_iterator_type,
                 other_iterator_end_type>;
@@ -519,14 +791,16 @@ namespace atom
             if constexpr (ranges::const_random_access_iterator_pair_concept<other_iterator_type,
                               other_iterator_end_type>)
             {
-                return it - it_end;
+                return usize(it_end - it);
             }
+            else
+            {
+                usize count = 0;
+                for (; it != it_end; ++it)
+                    count++;
 
-            usize count = 0;
-            for (; it != it_end; it++)
-                count++;
-
-            return count;
+                return count;
+            }
         }
 
     private:
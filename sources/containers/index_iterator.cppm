@@ -0,0 +1,147 @@
+export module atom_core:containers.index_iterator;
+
+import std;
+import :core;
+
+namespace atom
+{
+    /// --------------------------------------------------------------------------------------------
+    /// random access iterator for containers which are not contiguous but can access a value by
+    /// index in constant time. dereferences to `container->get_at(index)`.
+    ///
+    /// `in_container_type` is const for const iterators.
+    /// --------------------------------------------------------------------------------------------
+    export template <typename in_container_type>
+    class index_iterator
+    {
+        using this_type = index_iterator;
+
+    public:
+        using container_type = in_container_type;
+        using value_type = typename container_type::value_type;
+        using reference = decltype(std::declval<container_type&>().get_at(0));
+        using pointer = std::remove_reference_t<reference>*;
+        using difference_type = isize;
+        using iterator_category = std::random_access_iterator_tag;
+        using iterator_concept = std::random_access_iterator_tag;
+
+    public:
+        constexpr index_iterator()
+            : _container{ nullptr }
+            , _index{ 0 }
+        {}
+
+        constexpr index_iterator(container_type* container, usize index)
+            : _container{ container }
+            , _index{ index }
+        {}
+
+    public:
+        constexpr auto operator*() const -> reference
+        {
+            return _container->get_at(_index);
+        }
+
+        constexpr auto operator->() const -> pointer
+        {
+            return &_container->get_at(_index);
+        }
+
+        constexpr auto operator[](isize offset) const -> reference
+        {
+            return _container->get_at(_index + offset);
+        }
+
+        constexpr auto operator++() -> this_type&
+        {
+            _index++;
+            return *this;
+        }
+
+        constexpr auto operator++(int) -> this_type
+        {
+            this_type copy = *this;
+            _index++;
+            return copy;
+        }
+
+        constexpr auto operator--() -> this_type&
+        {
+            _index--;
+            return *this;
+        }
+
+        constexpr auto operator--(int) -> this_type
+        {
+            this_type copy = *this;
+            _index--;
+            return copy;
+        }
+
+        constexpr auto operator+=(isize offset) -> this_type&
+        {
+            _index += offset;
+            return *this;
+        }
+
+        constexpr auto operator-=(isize offset) -> this_type&
+        {
+            _index -= offset;
+            return *this;
+        }
+
+        constexpr auto operator+(isize offset) const -> this_type
+        {
+            return this_type(_container, _index + offset);
+        }
+
+        constexpr friend auto operator+(isize offset, const this_type& it) -> this_type
+        {
+            return it + offset;
+        }
+
+        constexpr auto operator-(isize offset) const -> this_type
+        {
+            return this_type(_container, _index - offset);
+        }
+
+        constexpr auto operator-(const this_type& that) const -> isize
+        {
+            return isize(_index) - isize(that._index);
+        }
+
+        constexpr auto operator==(const this_type& that) const -> bool
+        {
+            return _index == that._index;
+        }
+
+        constexpr auto operator<(const this_type& that) const -> bool
+        {
+            return _index < that._index;
+        }
+
+        constexpr auto operator>(const this_type& that) const -> bool
+        {
+            return _index > that._index;
+        }
+
+        constexpr auto operator<=(const this_type& that) const -> bool
+        {
+            return _index <= that._index;
+        }
+
+        constexpr auto operator>=(const this_type& that) const -> bool
+        {
+            return _index >= that._index;
+        }
+
+        constexpr auto get_index() const -> usize
+        {
+            return _index;
+        }
+
+    private:
+        container_type* _container;
+        usize _index;
+    };
+}
@@ -0,0 +1,378 @@
+export module atom_core:containers.ring_buffer;
+
+import std;
+import :core;
+import :types;
+import :ranges;
+import :contracts;
+import :default_mem_allocator;
+import :containers.index_iterator;
+
+#include "atom/core/preprocessors.h"
+
+namespace atom
+{
+    export class ring_buffer_tag
+    {};
+
+    /// --------------------------------------------------------------------------------------------
+    /// circular buffer of values with constant time insertion and removal at both ends.
+    ///
+    /// the capacity is always a power of two, so wrapping an index is a single mask. the buffer
+    /// grows when full, use `emplace_last_overwrite()` to keep a fixed size window instead.
+    /// --------------------------------------------------------------------------------------------
+    export template <typename in_value_type, typename in_allocator_type = default_mem_allocator>
+    class ring_buffer: public ring_buffer_tag
+    {
+        using this_type = ring_buffer;
+
+    public:
+        using value_type = in_value_type;
+        using allocator_type = in_allocator_type;
+        using const_iterator_type = index_iterator<const this_type>;
+        using const_iterator_end_type = const_iterator_type;
+        using iterator_type = index_iterator<this_type>;
+        using iterator_end_type = iterator_type;
+
+    public:
+        ring_buffer()
+            : _data{ nullptr }
+            , _capacity{ 0 }
+            , _head{ 0 }
+            , _count{ 0 }
+            , _allocator{}
+        {}
+
+        ring_buffer(const this_type& that)
+            : ring_buffer{}
+        {
+            reserve(that._count);
+
+            for (usize i = 0; i < that._count; i++)
+                std::construct_at(_data + i, that.get_at(i));
+
+            _count = that._count;
+        }
+
+        ring_buffer& operator=(const this_type& that)
+        {
+            if (this != &that)
+            {
+                this_type copy{ that };
+                *this = move(copy);
+            }
+
+            return *this;
+        }
+
+        ring_buffer(this_type&& that)
+            : _data{ that._data }
+            , _capacity{ that._capacity }
+            , _head{ that._head }
+            , _count{ that._count }
+            , _allocator{ move(that._allocator) }
+        {
+            that._data = nullptr;
+            that._capacity = 0;
+            that._head = 0;
+            that._count = 0;
+        }
+
+        ring_buffer& operator=(this_type&& that)
+        {
+            if (this == &that)
+                return *this;
+
+            _release_mem();
+
+            _data = that._data;
+            _capacity = that._capacity;
+            _head = that._head;
+            _count = that._count;
+            _allocator = move(that._allocator);
+
+            that._data = nullptr;
+            that._capacity = 0;
+            that._head = 0;
+            that._count = 0;
+            return *this;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// constructs with capacity for at least `capacity` values, rounded up to a power of two.
+        /// ----------------------------------------------------------------------------------------
+        ring_buffer(create_with_capacity_tag, usize capacity)
+            : ring_buffer{}
+        {
+            reserve(capacity);
+        }
+
+        ~ring_buffer()
+        {
+            _release_mem();
+        }
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// constructs value at last with `args`, growing the buffer if full.
+        /// ----------------------------------------------------------------------------------------
+        template <typename... arg_types>
+        auto emplace_last(arg_types&&... args) -> void
+        {
+            if (_count == _capacity)
+                _grow_to(_count + 1);
+
+            std::construct_at(_data + _wrap(_head + _count), forward<arg_types>(args)...);
+            _count++;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// constructs value at first with `args`, growing the buffer if full.
+        /// ----------------------------------------------------------------------------------------
+        template <typename... arg_types>
+        auto emplace_first(arg_types&&... args) -> void
+        {
+            if (_count == _capacity)
+                _grow_to(_count + 1);
+
+            usize head = _wrap(_head - 1);
+            std::construct_at(_data + head, forward<arg_types>(args)...);
+            _head = head;
+            _count++;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// constructs value at last with `args`. if the buffer is full, the first value is
+        /// removed to make space instead of growing.
+        ///
+        /// \pre if debug `get_capacity() > 0`: buffer has no capacity.
+        /// ----------------------------------------------------------------------------------------
+        template <typename... arg_types>
+        auto emplace_last_overwrite(arg_types&&... args) -> void
+        {
+            contract_debug_expects(_capacity > 0, "buffer has no capacity.");
+
+            if (_count == _capacity)
+                remove_first();
+
+            emplace_last(forward<arg_types>(args)...);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// removes the first value.
+        ///
+        /// \pre if debug `not is_empty()`: buffer is empty.
+        /// ----------------------------------------------------------------------------------------
+        auto remove_first() -> void
+        {
+            contract_debug_expects(not is_empty(), "buffer is empty.");
+
+            std::destroy_at(_data + _head);
+            _head = _wrap(_head + 1);
+            _count--;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// removes the last value.
+        ///
+        /// \pre if debug `not is_empty()`: buffer is empty.
+        /// ----------------------------------------------------------------------------------------
+        auto remove_last() -> void
+        {
+            contract_debug_expects(not is_empty(), "buffer is empty.");
+
+            std::destroy_at(_data + _wrap(_head + _count - 1));
+            _count--;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// removes all values, keeping the memory.
+        /// ----------------------------------------------------------------------------------------
+        auto remove_all() -> void
+        {
+            if constexpr (not type_info<value_type>::is_trivially_destructible())
+            {
+                for (usize i = 0; i < _count; i++)
+                    std::destroy_at(_data + _wrap(_head + i));
+            }
+
+            _head = 0;
+            _count = 0;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns value at index `i`, counting from the first value.
+        ///
+        /// \pre if debug `i < get_count()`: index is out of range.
+        /// ----------------------------------------------------------------------------------------
+        auto get_at(usize i) const -> const value_type&
+        {
+            contract_debug_expects(i < _count, "index is out of range.");
+
+            return _data[_wrap(_head + i)];
+        }
+
+        /// \copydoc get_at(usize)
+        auto get_at(usize i) -> value_type&
+        {
+            contract_debug_expects(i < _count, "index is out of range.");
+
+            return _data[_wrap(_head + i)];
+        }
+
+        auto get_first() const -> const value_type&
+        {
+            return get_at(0);
+        }
+
+        auto get_first() -> value_type&
+        {
+            return get_at(0);
+        }
+
+        auto get_last() const -> const value_type&
+        {
+            return get_at(_count - 1);
+        }
+
+        auto get_last() -> value_type&
+        {
+            return get_at(_count - 1);
+        }
+
+        auto get_iterator() const -> const_iterator_type
+        {
+            return const_iterator_type(this, 0);
+        }
+
+        auto get_iterator_end() const -> const_iterator_end_type
+        {
+            return const_iterator_end_type(this, _count);
+        }
+
+        auto get_iterator() -> iterator_type
+        {
+            return iterator_type(this, 0);
+        }
+
+        auto get_iterator_end() -> iterator_end_type
+        {
+            return iterator_end_type(this, _count);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// ensures capacity for at least `capacity` values, rounded up to a power of two.
+        /// ----------------------------------------------------------------------------------------
+        auto reserve(usize capacity) -> void
+        {
+            if (capacity > _capacity and capacity > 0)
+                _grow_to(capacity);
+        }
+
+        auto get_count() const -> usize
+        {
+            return _count;
+        }
+
+        auto get_capacity() const -> usize
+        {
+            return _capacity;
+        }
+
+        auto is_empty() const -> bool
+        {
+            return _count == 0;
+        }
+
+        auto is_full() const -> bool
+        {
+            return _count == _capacity;
+        }
+
+    private:
+        auto _wrap(usize index) const -> usize
+        {
+            return index & (_capacity - 1);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// moves values into a new buffer with capacity for at least `capacity` values, with the
+        /// first value at the start.
+        /// ----------------------------------------------------------------------------------------
+        auto _grow_to(usize capacity) -> void
+        {
+            usize new_capacity = std::bit_ceil(std::max(capacity, _capacity * 2));
+            new_capacity = std::max(new_capacity, usize(8));
+
+            value_type* new_data =
+                static_cast<value_type*>(_allocator.alloc(new_capacity * sizeof(value_type)));
+            contract_asserts(new_data != nullptr, "out of memory.");
+
+            for (usize i = 0; i < _count; i++)
+            {
+                value_type& value = _data[_wrap(_head + i)];
+                std::construct_at(new_data + i, move(value));
+                std::destroy_at(&value);
+            }
+
+            if (_data != nullptr)
+                _allocator.dealloc(_data);
+
+            _data = new_data;
+            _capacity = new_capacity;
+            _head = 0;
+        }
+
+        auto _release_mem() -> void
+        {
+            remove_all();
+
+            if (_data != nullptr)
+                _allocator.dealloc(_data);
+
+            _data = nullptr;
+            _capacity = 0;
+        }
+
+    private:
+        value_type* _data;
+        usize _capacity;
+        usize _head;
+        usize _count;
+        ATOM_ATTR_NO_UNIQUE_ADDRESS allocator_type _allocator;
+    };
+
+    export template <typename range_type>
+        requires(type_info<range_type>::template is_derived_from<ring_buffer_tag>())
+    class ranges::range_definition<range_type>
+    {
+    public:
+        using value_type = typename range_type::value_type;
+        using const_iterator_type = typename range_type::const_iterator_type;
+        using const_iterator_end_type = typename range_type::const_iterator_end_type;
+        using iterator_type = typename range_type::iterator_type;
+        using iterator_end_type = typename range_type::iterator_end_type;
+
+    public:
+        static constexpr auto get_iterator(range_type& range) -> iterator_type
+        {
+            return range.get_iterator();
+        }
+
+        static constexpr auto get_iterator_end(range_type& range) -> iterator_end_type
+        {
+            return range.get_iterator_end();
+        }
+
+        static constexpr auto get_const_iterator(const range_type& range) -> const_iterator_type
+        {
+            return range.get_iterator();
+        }
+
+        static constexpr auto get_const_iterator_end(
+            const range_type& range) -> const_iterator_end_type
+        {
+            return range.get_iterator_end();
+        }
+    };
+}
@@ -0,0 +1,310 @@
+export module atom_core:containers.segmented_array;
+
+import std;
+import :core;
+import :types;
+import :ranges;
+import :contracts;
+import :default_mem_allocator;
+import :containers.index_iterator;
+
+#include "atom/core/preprocessors.h"
+
+namespace atom
+{
+    export class segmented_array_tag
+    {};
+
+    /// --------------------------------------------------------------------------------------------
+    /// growable array whose values never move.
+    ///
+    /// values are stored in segments which double in size, so growing allocates a new segment
+    /// instead of relocating the existing values, and pointers to values stay valid until they
+    /// are removed. the first two segments have `in_first_segment_count` values, and each next
+    /// segment has as many values as all previous segments, so finding a value by index is a bit
+    /// scan and a subtraction.
+    /// --------------------------------------------------------------------------------------------
+    export template <typename in_value_type, typename in_allocator_type = default_mem_allocator,
+        usize in_first_segment_count = 16>
+    class segmented_array: public segmented_array_tag
+    {
+        static_assert(
+            std::has_single_bit(in_first_segment_count), "segment count must be a power of two.");
+
+        using this_type = segmented_array;
+
+    public:
+        using value_type = in_value_type;
+        using allocator_type = in_allocator_type;
+        using const_iterator_type = index_iterator<const this_type>;
+        using const_iterator_end_type = const_iterator_type;
+        using iterator_type = index_iterator<this_type>;
+        using iterator_end_type = iterator_type;
+
+        static constexpr usize first_segment_count = in_first_segment_count;
+
+    private:
+        static constexpr usize _first_segment_shift = std::countr_zero(first_segment_count);
+        static constexpr usize _max_segments = 64 - _first_segment_shift;
+
+    public:
+        segmented_array()
+            : _segments{}
+            , _segment_count{ 0 }
+            , _count{ 0 }
+            , _allocator{}
+        {}
+
+        segmented_array(const this_type& that)
+            : segmented_array{}
+        {
+            reserve(that._count);
+
+            for (usize i = 0; i < that._count; i++)
+                emplace_last(that.get_at(i));
+        }
+
+        segmented_array& operator=(const this_type& that)
+        {
+            if (this != &that)
+            {
+                this_type copy{ that };
+                *this = move(copy);
+            }
+
+            return *this;
+        }
+
+        segmented_array(this_type&& that)
+            : _segment_count{ that._segment_count }
+            , _count{ that._count }
+            , _allocator{ move(that._allocator) }
+        {
+            std::copy(that._segments, that._segments + _max_segments, _segments);
+            that._segment_count = 0;
+            that._count = 0;
+        }
+
+        segmented_array& operator=(this_type&& that)
+        {
+            if (this == &that)
+                return *this;
+
+            _release_mem();
+
+            std::copy(that._segments, that._segments + _max_segments, _segments);
+            _segment_count = that._segment_count;
+            _count = that._count;
+            _allocator = move(that._allocator);
+
+            that._segment_count = 0;
+            that._count = 0;
+            return *this;
+        }
+
+        ~segmented_array()
+        {
+            _release_mem();
+        }
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// constructs value at last with `args`. other values are not moved.
+        ///
+        /// \returns reference to the value constructed.
+        /// ----------------------------------------------------------------------------------------
+        template <typename... arg_types>
+        auto emplace_last(arg_types&&... args) -> value_type&
+        {
+            if (_count == get_capacity())
+                _alloc_segment();
+
+            value_type* value = std::construct_at(_get_ptr(_count), forward<arg_types>(args)...);
+            _count++;
+            return *value;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// removes the last value. the memory is kept to be reused.
+        ///
+        /// \pre if debug `not is_empty()`: array is empty.
+        /// ----------------------------------------------------------------------------------------
+        auto remove_last() -> void
+        {
+            contract_debug_expects(not is_empty(), "array is empty.");
+
+            _count--;
+            std::destroy_at(_get_ptr(_count));
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// removes all values, keeping the memory.
+        /// ----------------------------------------------------------------------------------------
+        auto remove_all() -> void
+        {
+            if constexpr (not type_info<value_type>::is_trivially_destructible())
+            {
+                for (usize i = 0; i < _count; i++)
+                    std::destroy_at(_get_ptr(i));
+            }
+
+            _count = 0;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// allocates segments until there is capacity for at least `count` values.
+        /// ----------------------------------------------------------------------------------------
+        auto reserve(usize count) -> void
+        {
+            while (get_capacity() < count)
+                _alloc_segment();
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns value at index `i`.
+        ///
+        /// \pre if debug `i < get_count()`: index is out of range.
+        /// ----------------------------------------------------------------------------------------
+        auto get_at(usize i) const -> const value_type&
+        {
+            contract_debug_expects(i < _count, "index is out of range.");
+
+            return *_get_ptr(i);
+        }
+
+        /// \copydoc get_at(usize)
+        auto get_at(usize i) -> value_type&
+        {
+            contract_debug_expects(i < _count, "index is out of range.");
+
+            return *_get_ptr(i);
+        }
+
+        auto get_last() const -> const value_type&
+        {
+            return get_at(_count - 1);
+        }
+
+        auto get_last() -> value_type&
+        {
+            return get_at(_count - 1);
+        }
+
+        auto get_iterator() const -> const_iterator_type
+        {
+            return const_iterator_type(this, 0);
+        }
+
+        auto get_iterator_end() const -> const_iterator_end_type
+        {
+            return const_iterator_end_type(this, _count);
+        }
+
+        auto get_iterator() -> iterator_type
+        {
+            return iterator_type(this, 0);
+        }
+
+        auto get_iterator_end() -> iterator_end_type
+        {
+            return iterator_end_type(this, _count);
+        }
+
+        auto get_count() const -> usize
+        {
+            return _count;
+        }
+
+        auto get_capacity() const -> usize
+        {
+            return _get_segment_start(_segment_count);
+        }
+
+        auto is_empty() const -> bool
+        {
+            return _count == 0;
+        }
+
+    private:
+        /// ----------------------------------------------------------------------------------------
+        /// index of the first value in segment `segment`.
+        /// ----------------------------------------------------------------------------------------
+        static constexpr auto _get_segment_start(usize segment) -> usize
+        {
+            return segment == 0 ? 0 : first_segment_count << (segment - 1);
+        }
+
+        static constexpr auto _get_segment_size(usize segment) -> usize
+        {
+            return segment == 0 ? first_segment_count : first_segment_count << (segment - 1);
+        }
+
+        auto _get_ptr(usize i) const -> value_type*
+        {
+            usize segment = std::bit_width(i >> _first_segment_shift);
+            return _segments[segment] + (i - _get_segment_start(segment));
+        }
+
+        auto _alloc_segment() -> void
+        {
+            contract_asserts(_segment_count < _max_segments, "too many segments.");
+
+            usize size = _get_segment_size(_segment_count) * sizeof(value_type);
+            value_type* segment = static_cast<value_type*>(_allocator.alloc(size));
+            contract_asserts(segment != nullptr, "out of memory.");
+
+            _segments[_segment_count] = segment;
+            _segment_count++;
+        }
+
+        auto _release_mem() -> void
+        {
+            remove_all();
+
+            for (usize i = 0; i < _segment_count; i++)
+                _allocator.dealloc(_segments[i]);
+
+            _segment_count = 0;
+        }
+
+    private:
+        value_type* _segments[_max_segments];
+        usize _segment_count;
+        usize _count;
+        ATOM_ATTR_NO_UNIQUE_ADDRESS allocator_type _allocator;
+    };
+
+    export template <typename range_type>
+        requires(type_info<range_type>::template is_derived_from<segmented_array_tag>())
+    class ranges::range_definition<range_type>
+    {
+    public:
+        using value_type = typename range_type::value_type;
+        using const_iterator_type = typename range_type::const_iterator_type;
+        using const_iterator_end_type = typename range_type::const_iterator_end_type;
+        using iterator_type = typename range_type::iterator_type;
+        using iterator_end_type = typename range_type::iterator_end_type;
+
+    public:
+        static constexpr auto get_iterator(range_type& range) -> iterator_type
+        {
+            return range.get_iterator();
+        }
+
+        static constexpr auto get_iterator_end(range_type& range) -> iterator_end_type
+        {
+            return range.get_iterator_end();
+        }
+
+        static constexpr auto get_const_iterator(const range_type& range) -> const_iterator_type
+        {
+            return range.get_iterator();
+        }
+
+        static constexpr auto get_const_iterator_end(
+            const range_type& range) -> const_iterator_end_type
+        {
+            return range.get_iterator_end();
+        }
+    };
+}
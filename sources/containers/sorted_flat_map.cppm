@@ -0,0 +1,381 @@
+export module atom_core:containers.sorted_flat_map;
+
+import std;
+import :core;
+import :types;
+import :ranges;
+import :contracts;
+import :default_mem_allocator;
+import :containers.dynamic_array;
+import :containers.sorted_flat_set;
+
+namespace atom
+{
+    /// --------------------------------------------------------------------------------------------
+    /// map of unique keys to values, stored sorted by key.
+    ///
+    /// keys and values are stored in separate `dynamic_array`s, so lookups only touch the keys and
+    /// a search covers as many keys per cache line as possible. like `sorted_flat_set`, this is
+    /// meant for small to medium maps which are read much more often than written.
+    /// --------------------------------------------------------------------------------------------
+    export template <typename in_key_type, typename in_value_type,
+        typename in_comparer_type = std::less<>,
+        typename in_allocator_type = default_mem_allocator>
+    class sorted_flat_map
+    {
+        using this_type = sorted_flat_map;
+
+    public:
+        using key_type = in_key_type;
+        using value_type = in_value_type;
+        using comparer_type = in_comparer_type;
+        using allocator_type = in_allocator_type;
+        using key_array_type = dynamic_array<key_type, allocator_type>;
+        using value_array_type = dynamic_array<value_type, allocator_type>;
+
+        static constexpr usize npos = nums::get_max_usize();
+
+    public:
+        constexpr sorted_flat_map()
+            : _keys{}
+            , _values{}
+            , _comparer{}
+        {}
+
+        constexpr sorted_flat_map(const this_type& that) = default;
+        constexpr sorted_flat_map& operator=(const this_type& that) = default;
+
+        constexpr sorted_flat_map(this_type&& that) = default;
+        constexpr sorted_flat_map& operator=(this_type&& that) = default;
+
+        /// ----------------------------------------------------------------------------------------
+        /// constructs with keys from `keys` mapped to values at the same position in `values`.
+        /// keys don't need to be sorted or unique, they are sorted once and for duplicates the
+        /// last value is kept.
+        ///
+        /// \pre `keys` and `values` have the same count.
+        /// ----------------------------------------------------------------------------------------
+        template <typename key_range_type, typename value_range_type>
+        constexpr sorted_flat_map(create_from_range_tag, const key_range_type& keys,
+            const value_range_type& values, comparer_type comparer = comparer_type())
+            requires(ranges::const_range_concept<key_range_type, key_type>
+                     and ranges::const_range_concept<value_range_type, value_type>)
+            : _keys{}
+            , _values{}
+            , _comparer{ move(comparer) }
+        {
+            _keys.insert_range_last(keys);
+            _values.insert_range_last(values);
+
+            contract_expects(_keys.get_count() == _values.get_count(),
+                "keys and values have different count.");
+
+            _sort_unique(_keys, _values);
+        }
+
+        constexpr ~sorted_flat_map() = default;
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// inserts `key` mapped to a value constructed with `args`, if `key` is not already
+        /// present.
+        ///
+        /// \returns `true` if the key was inserted.
+        /// ----------------------------------------------------------------------------------------
+        template <typename other_key_type, typename... arg_types>
+        constexpr auto emplace(other_key_type&& key, arg_types&&... args) -> bool
+        {
+            usize index = _lower_bound(key);
+            if (index < _keys.get_count() and _is_equivalent(_keys.get_at(index), key))
+                return false;
+
+            _keys.emplace_at(index, forward<other_key_type>(key));
+            _values.emplace_at(index, forward<arg_types>(args)...);
+            return true;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// inserts `key` mapped to `value`, or assigns `value` if `key` is already present.
+        ///
+        /// \returns `true` if the key was inserted.
+        /// ----------------------------------------------------------------------------------------
+        template <typename other_key_type, typename other_value_type>
+        constexpr auto insert_or_assign(other_key_type&& key, other_value_type&& value) -> bool
+        {
+            usize index = _lower_bound(key);
+            if (index < _keys.get_count() and _is_equivalent(_keys.get_at(index), key))
+            {
+                _values.get_at(index) = forward<other_value_type>(value);
+                return false;
+            }
+
+            _keys.emplace_at(index, forward<other_key_type>(key));
+            _values.emplace_at(index, forward<other_value_type>(value));
+            return true;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// inserts keys from `keys` mapped to values at the same position in `values`. values of
+        /// keys already present are assigned. keys don't need to be sorted or unique.
+        ///
+        /// the new entries are sorted once and then merged with the current ones, so this is
+        /// `O(n log n + m)` instead of `O(n * m)` for inserting one entry at a time.
+        ///
+        /// \pre `keys` and `values` have the same count.
+        /// ----------------------------------------------------------------------------------------
+        template <typename key_range_type, typename value_range_type>
+        constexpr auto insert_range(const key_range_type& keys, const value_range_type& values)
+            -> void
+            requires(ranges::const_range_concept<key_range_type, key_type>
+                     and ranges::const_range_concept<value_range_type, value_type>)
+        {
+            this_type other{ create_from_range, keys, values, _comparer };
+
+            if (_keys.is_empty())
+            {
+                _keys = move(other._keys);
+                _values = move(other._values);
+                return;
+            }
+
+            usize merged_count = _keys.get_count() + other._keys.get_count();
+            key_array_type merged_keys;
+            value_array_type merged_values;
+            merged_keys.reserve(merged_count);
+            merged_values.reserve(merged_count);
+
+            usize i = 0;
+            usize j = 0;
+            while (i < _keys.get_count() and j < other._keys.get_count())
+            {
+                key_type& key = _keys.get_at(i);
+                key_type& new_key = other._keys.get_at(j);
+
+                if (_comparer(key, new_key))
+                {
+                    merged_keys.emplace_last(move(key));
+                    merged_values.emplace_last(move(_values.get_at(i)));
+                    i++;
+                }
+                else if (_comparer(new_key, key))
+                {
+                    merged_keys.emplace_last(move(new_key));
+                    merged_values.emplace_last(move(other._values.get_at(j)));
+                    j++;
+                }
+                else
+                {
+                    merged_keys.emplace_last(move(key));
+                    merged_values.emplace_last(move(other._values.get_at(j)));
+                    i++;
+                    j++;
+                }
+            }
+
+            for (; i < _keys.get_count(); i++)
+            {
+                merged_keys.emplace_last(move(_keys.get_at(i)));
+                merged_values.emplace_last(move(_values.get_at(i)));
+            }
+
+            for (; j < other._keys.get_count(); j++)
+            {
+                merged_keys.emplace_last(move(other._keys.get_at(j)));
+                merged_values.emplace_last(move(other._values.get_at(j)));
+            }
+
+            _keys = move(merged_keys);
+            _values = move(merged_values);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// removes `key` and its value if present.
+        ///
+        /// \returns `true` if the key was removed.
+        /// ----------------------------------------------------------------------------------------
+        template <typename other_key_type>
+        constexpr auto remove(const other_key_type& key) -> bool
+        {
+            usize index = get_index(key);
+            if (index == npos)
+                return false;
+
+            _keys.remove_at(index);
+            _values.remove_at(index);
+            return true;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// removes all keys and values.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto remove_all() -> void
+        {
+            _keys.remove_all();
+            _values.remove_all();
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns index of `key`, or `npos` if not present.
+        /// ----------------------------------------------------------------------------------------
+        template <typename other_key_type>
+        constexpr auto get_index(const other_key_type& key) const -> usize
+        {
+            usize index = _lower_bound(key);
+            if (index < _keys.get_count() and _is_equivalent(_keys.get_at(index), key))
+                return index;
+
+            return npos;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns pointer to the value mapped to `key`, or `nullptr` if not present.
+        /// ----------------------------------------------------------------------------------------
+        template <typename other_key_type>
+        constexpr auto find(const other_key_type& key) const -> const value_type*
+        {
+            usize index = get_index(key);
+            return index == npos ? nullptr : &_values.get_at(index);
+        }
+
+        /// \copydoc find(const other_key_type&)
+        template <typename other_key_type>
+        constexpr auto find(const other_key_type& key) -> value_type*
+        {
+            usize index = get_index(key);
+            return index == npos ? nullptr : &_values.get_at(index);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns `true` if `key` is present.
+        /// ----------------------------------------------------------------------------------------
+        template <typename other_key_type>
+        constexpr auto contains(const other_key_type& key) const -> bool
+        {
+            return get_index(key) != npos;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns key at index `i`.
+        ///
+        /// \pre if debug `i < get_count()`: index is out of range.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto get_key_at(usize i) const -> const key_type&
+        {
+            contract_debug_expects(i < get_count(), "index is out of range.");
+
+            return _keys.get_at(i);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns value at index `i`.
+        ///
+        /// \pre if debug `i < get_count()`: index is out of range.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto get_value_at(usize i) const -> const value_type&
+        {
+            contract_debug_expects(i < get_count(), "index is out of range.");
+
+            return _values.get_at(i);
+        }
+
+        /// \copydoc get_value_at(usize)
+        constexpr auto get_value_at(usize i) -> value_type&
+        {
+            contract_debug_expects(i < get_count(), "index is out of range.");
+
+            return _values.get_at(i);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns the sorted keys.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto get_keys() const -> const key_array_type&
+        {
+            return _keys;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns the values, in the same order as `get_keys()`.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto get_values() const -> const value_array_type&
+        {
+            return _values;
+        }
+
+        constexpr auto get_count() const -> usize
+        {
+            return _keys.get_count();
+        }
+
+        constexpr auto is_empty() const -> bool
+        {
+            return _keys.is_empty();
+        }
+
+        constexpr auto reserve(usize count) -> void
+        {
+            _keys.reserve(count);
+            _values.reserve(count);
+        }
+
+    private:
+        template <typename other_key_type>
+        constexpr auto _lower_bound(const other_key_type& key) const -> usize
+        {
+            return _flat_lower_bound(_keys.get_data(), _keys.get_count(), key, _comparer);
+        }
+
+        template <typename other_key_type>
+        constexpr auto _is_equivalent(const key_type& key0, const other_key_type& key1) const
+            -> bool
+        {
+            return _flat_is_equivalent(key0, key1, _comparer);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// sorts `keys` and `values` by key and removes duplicate keys, keeping the last value.
+        ///
+        /// sorts an array of indices, so keys and values are only moved once into their place.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto _sort_unique(key_array_type& keys, value_array_type& values) const -> void
+        {
+            usize count = keys.get_count();
+            if (count < 2)
+                return;
+
+            dynamic_array<usize> order;
+            order.resize_uninitialized(count);
+            for (usize i = 0; i < count; i++)
+                order.get_at(i) = i;
+
+            const key_type* key_data = keys.get_data();
+            std::stable_sort(order.get_data(), order.get_data() + count,
+                [&](usize lhs, usize rhs) { return _comparer(key_data[lhs], key_data[rhs]); });
+
+            key_array_type sorted_keys;
+            value_array_type sorted_values;
+            sorted_keys.reserve(count);
+            sorted_values.reserve(count);
+
+            for (usize i = 0; i < count; i++)
+            {
+                // the sort is stable, so the last of equivalent keys is the last inserted.
+                usize index = order.get_at(i);
+                if (i + 1 < count
+                    and not _comparer(key_data[index], key_data[order.get_at(i + 1)]))
+                    continue;
+
+                sorted_keys.emplace_last(move(keys.get_at(index)));
+                sorted_values.emplace_last(move(values.get_at(index)));
+            }
+
+            keys = move(sorted_keys);
+            values = move(sorted_values);
+        }
+
+    private:
+        key_array_type _keys;
+        value_array_type _values;
+        comparer_type _comparer;
+    };
+}
@@ -0,0 +1,309 @@
+export module atom_core:containers.sorted_flat_set;
+
+import std;
+import :core;
+import :types;
+import :ranges;
+import :contracts;
+import :default_mem_allocator;
+import :containers.dynamic_array;
+
+namespace atom
+{
+    /// --------------------------------------------------------------------------------------------
+    /// returns the index of the first key in `keys` which is not less than `key`.
+    ///
+    /// the loop always runs `log2(count)` times and only selects the next base, which compilers
+    /// lower to a conditional move. so there is no unpredictable branch per step, unlike the usual
+    /// binary search.
+    /// --------------------------------------------------------------------------------------------
+    template <typename key_type, typename other_key_type, typename comparer_type>
+    constexpr auto _flat_lower_bound(const key_type* keys, usize count, const other_key_type& key,
+        const comparer_type& comparer) -> usize
+    {
+        if (count == 0)
+            return 0;
+
+        const key_type* base = keys;
+        while (count > 1)
+        {
+            usize half = count / 2;
+            base = comparer(base[half], key) ? base + half : base;
+            count -= half;
+        }
+
+        return usize(base - keys) + usize(comparer(*base, key));
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// returns `true` if `key0` and `key1` are equivalent under `comparer`.
+    /// --------------------------------------------------------------------------------------------
+    template <typename key_type, typename other_key_type, typename comparer_type>
+    constexpr auto _flat_is_equivalent(const key_type& key0, const other_key_type& key1,
+        const comparer_type& comparer) -> bool
+    {
+        return not comparer(key0, key1) and not comparer(key1, key0);
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// set of unique keys, stored sorted in a `dynamic_array`.
+    ///
+    /// lookups are binary searches over contiguous memory, which for small to medium sets that
+    /// are read much more often than written is faster and much smaller than node based sets.
+    /// inserting or removing a single key is linear, prefer `insert_range()` for bulk inserts.
+    /// --------------------------------------------------------------------------------------------
+    export template <typename in_key_type, typename in_comparer_type = std::less<>,
+        typename in_allocator_type = default_mem_allocator>
+    class sorted_flat_set
+    {
+        using this_type = sorted_flat_set;
+
+    public:
+        using key_type = in_key_type;
+        using comparer_type = in_comparer_type;
+        using allocator_type = in_allocator_type;
+        using key_array_type = dynamic_array<key_type, allocator_type>;
+
+        static constexpr usize npos = nums::get_max_usize();
+
+    public:
+        constexpr sorted_flat_set()
+            : _keys{}
+            , _comparer{}
+        {}
+
+        constexpr sorted_flat_set(const this_type& that) = default;
+        constexpr sorted_flat_set& operator=(const this_type& that) = default;
+
+        constexpr sorted_flat_set(this_type&& that) = default;
+        constexpr sorted_flat_set& operator=(this_type&& that) = default;
+
+        /// ----------------------------------------------------------------------------------------
+        /// constructs with keys from `range`, which doesn't need to be sorted or unique. keys are
+        /// sorted once and duplicates are removed, keeping the first one.
+        /// ----------------------------------------------------------------------------------------
+        template <typename range_type>
+        constexpr sorted_flat_set(create_from_range_tag, const range_type& range,
+            comparer_type comparer = comparer_type())
+            requires(ranges::const_range_concept<range_type, key_type>)
+            : _keys{}
+            , _comparer{ move(comparer) }
+        {
+            _keys.insert_range_last(range);
+            _sort_unique(_keys);
+        }
+
+        constexpr ~sorted_flat_set() = default;
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// inserts `key` if it's not already present.
+        ///
+        /// \returns `true` if the key was inserted.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto insert(const key_type& key) -> bool
+        {
+            usize index = _lower_bound(key);
+            if (index < _keys.get_count() and _is_equivalent(_keys.get_at(index), key))
+                return false;
+
+            _keys.emplace_at(index, key);
+            return true;
+        }
+
+        /// \copydoc insert(const key_type&)
+        constexpr auto insert(key_type&& key) -> bool
+        {
+            usize index = _lower_bound(key);
+            if (index < _keys.get_count() and _is_equivalent(_keys.get_at(index), key))
+                return false;
+
+            _keys.emplace_at(index, move(key));
+            return true;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// inserts keys from `range` which are not already present. `range` doesn't need to be
+        /// sorted or unique.
+        ///
+        /// the keys are sorted once and then merged with the current keys, so this is
+        /// `O(n log n + m)` instead of `O(n * m)` for inserting one key at a time.
+        /// ----------------------------------------------------------------------------------------
+        template <typename range_type>
+        constexpr auto insert_range(const range_type& range) -> void
+            requires(ranges::const_range_concept<range_type, key_type>)
+        {
+            key_array_type new_keys;
+            new_keys.insert_range_last(range);
+            _sort_unique(new_keys);
+
+            if (_keys.is_empty())
+            {
+                _keys = move(new_keys);
+                return;
+            }
+
+            key_array_type merged;
+            merged.reserve(_keys.get_count() + new_keys.get_count());
+
+            usize i = 0;
+            usize j = 0;
+            while (i < _keys.get_count() and j < new_keys.get_count())
+            {
+                key_type& key = _keys.get_at(i);
+                key_type& new_key = new_keys.get_at(j);
+
+                if (_comparer(key, new_key))
+                {
+                    merged.emplace_last(move(key));
+                    i++;
+                }
+                else if (_comparer(new_key, key))
+                {
+                    merged.emplace_last(move(new_key));
+                    j++;
+                }
+                else
+                {
+                    merged.emplace_last(move(key));
+                    i++;
+                    j++;
+                }
+            }
+
+            for (; i < _keys.get_count(); i++)
+                merged.emplace_last(move(_keys.get_at(i)));
+
+            for (; j < new_keys.get_count(); j++)
+                merged.emplace_last(move(new_keys.get_at(j)));
+
+            _keys = move(merged);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// removes `key` if present.
+        ///
+        /// \returns `true` if the key was removed.
+        /// ----------------------------------------------------------------------------------------
+        template <typename other_key_type>
+        constexpr auto remove(const other_key_type& key) -> bool
+        {
+            usize index = get_index(key);
+            if (index == npos)
+                return false;
+
+            _keys.remove_at(index);
+            return true;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// removes all keys.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto remove_all() -> void
+        {
+            _keys.remove_all();
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns index of `key`, or `npos` if not present.
+        /// ----------------------------------------------------------------------------------------
+        template <typename other_key_type>
+        constexpr auto get_index(const other_key_type& key) const -> usize
+        {
+            usize index = _lower_bound(key);
+            if (index < _keys.get_count() and _is_equivalent(_keys.get_at(index), key))
+                return index;
+
+            return npos;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns `true` if `key` is present.
+        /// ----------------------------------------------------------------------------------------
+        template <typename other_key_type>
+        constexpr auto contains(const other_key_type& key) const -> bool
+        {
+            return get_index(key) != npos;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns key at index `i`.
+        ///
+        /// \pre if debug `i < get_count()`: index is out of range.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto get_at(usize i) const -> const key_type&
+        {
+            contract_debug_expects(i < get_count(), "index is out of range.");
+
+            return _keys.get_at(i);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns the sorted keys.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto get_keys() const -> const key_array_type&
+        {
+            return _keys;
+        }
+
+        constexpr auto get_count() const -> usize
+        {
+            return _keys.get_count();
+        }
+
+        constexpr auto is_empty() const -> bool
+        {
+            return _keys.is_empty();
+        }
+
+        constexpr auto reserve(usize count) -> void
+        {
+            _keys.reserve(count);
+        }
+
+    private:
+        template <typename other_key_type>
+        constexpr auto _lower_bound(const other_key_type& key) const -> usize
+        {
+            return _flat_lower_bound(_keys.get_data(), _keys.get_count(), key, _comparer);
+        }
+
+        template <typename other_key_type>
+        constexpr auto _is_equivalent(const key_type& key0, const other_key_type& key1) const
+            -> bool
+        {
+            return _flat_is_equivalent(key0, key1, _comparer);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// sorts `keys` and removes duplicates, keeping the first one.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto _sort_unique(key_array_type& keys) const -> void
+        {
+            key_type* data = keys.get_data();
+            usize count = keys.get_count();
+            if (count < 2)
+                return;
+
+            std::stable_sort(data, data + count, _comparer);
+
+            usize unique_count = 1;
+            for (usize i = 1; i < count; i++)
+            {
+                if (not _comparer(data[unique_count - 1], data[i]))
+                    continue;
+
+                if (unique_count != i)
+                    data[unique_count] = move(data[i]);
+
+                unique_count++;
+            }
+
+            keys.remove_last(count - unique_count);
+        }
+
+    private:
+        key_array_type _keys;
+        comparer_type _comparer;
+    };
+}
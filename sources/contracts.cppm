@@ -8,15 +8,154 @@ import fmt;
 import :core.build_config;
 import :core.source_location;
 
+#include "atom/core/preprocessors.h"
+
 namespace atom
 {
     template <auto type>
-    constexpr auto _contract_check(bool assert, std::string_view msg, source_location src) -> void;
+    ATOM_ATTR_ALWAYS_INLINE constexpr auto _contract_check(
+        bool assert, std::string_view msg, source_location src) -> void;
 
     [[noreturn]]
     constexpr auto _panic(std::string_view msg, source_location src) -> void;
 
     constexpr auto _contract_violation_to_string(const auto& violation) -> std::string;
+
+    /// --------------------------------------------------------------------------------------------
+    /// limits how many violations per second capture a stack trace.
+    ///
+    /// counts captures in the current second with a relaxed atomic, so the limit is approximate
+    /// when many threads violate contracts at the second boundary.
+    /// --------------------------------------------------------------------------------------------
+    class _contract_trace_limiter
+    {
+    public:
+        static auto set_limit(std::uint32_t per_second) -> void
+        {
+            _limit.store(per_second, std::memory_order_relaxed);
+        }
+
+        static auto get_limit() -> std::uint32_t
+        {
+            return _limit.load(std::memory_order_relaxed);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// returns `true` if a trace should be captured for a violation, which is the
+        /// `site_count`th violation at its site.
+        ///
+        /// the first violation at each site always captures a trace unless capturing is disabled,
+        /// so a burst at one site doesn't hide a violation at another.
+        /// ----------------------------------------------------------------------------------------
+        static auto should_capture(std::uint64_t site_count) -> bool
+        {
+            std::uint32_t limit = get_limit();
+            if (limit == 0)
+                return false;
+
+            auto now = std::chrono::steady_clock::now().time_since_epoch();
+            std::int64_t second = std::chrono::duration_cast<std::chrono::seconds>(now).count();
+
+            std::int64_t window = _window.load(std::memory_order_relaxed);
+            if (second != window
+                and _window.compare_exchange_strong(window, second, std::memory_order_relaxed))
+                _count.store(0, std::memory_order_relaxed);
+
+            return _count.fetch_add(1, std::memory_order_relaxed) < limit or site_count == 1;
+        }
+
+    private:
+        static inline std::atomic<std::uint32_t> _limit = 64;
+        static inline std::atomic<std::int64_t> _window = 0;
+        static inline std::atomic<std::uint32_t> _count = 0;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// counts violations per check site.
+    ///
+    /// counters live in a fixed size lock free hash table keyed by a hash of the site's file,
+    /// line and column, so counting takes no lock and never allocates. sites beyond the table
+    /// size share one counter.
+    /// --------------------------------------------------------------------------------------------
+    class _contract_site_counters
+    {
+        static constexpr std::size_t _slot_count = 1024;
+
+        class _slot
+        {
+        public:
+            std::atomic<std::uint64_t> key;
+            std::atomic<std::uint64_t> count;
+        };
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// increments the count of violations at `src`, returning the new count.
+        /// ----------------------------------------------------------------------------------------
+        static auto increment(const source_location& src) -> std::uint64_t
+        {
+            std::uint64_t key = _get_key(src);
+            for (std::size_t i = 0; i < _slot_count; i++)
+            {
+                _slot& slot = _slots[(key + i) % _slot_count];
+                std::uint64_t slot_key = slot.key.load(std::memory_order_acquire);
+
+                if (slot_key == 0
+                    and slot.key.compare_exchange_strong(
+                        slot_key, key, std::memory_order_acq_rel, std::memory_order_acquire))
+                    slot_key = key;
+
+                if (slot_key == key)
+                    return slot.count.fetch_add(1, std::memory_order_relaxed) + 1;
+            }
+
+            return _overflow_count.fetch_add(1, std::memory_order_relaxed) + 1;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// returns the count of violations at `src`.
+        /// ----------------------------------------------------------------------------------------
+        static auto get(const source_location& src) -> std::uint64_t
+        {
+            std::uint64_t key = _get_key(src);
+            for (std::size_t i = 0; i < _slot_count; i++)
+            {
+                _slot& slot = _slots[(key + i) % _slot_count];
+                std::uint64_t slot_key = slot.key.load(std::memory_order_acquire);
+
+                if (slot_key == key)
+                    return slot.count.load(std::memory_order_relaxed);
+
+                if (slot_key == 0)
+                    return 0;
+            }
+
+            return _overflow_count.load(std::memory_order_relaxed);
+        }
+
+    private:
+        /// ----------------------------------------------------------------------------------------
+        /// hashes the file name's chars, not its address, as the same file can be named by a
+        /// different literal in each translation unit.
+        /// ----------------------------------------------------------------------------------------
+        static auto _get_key(const source_location& src) -> std::uint64_t
+        {
+            // fnv-1a.
+            std::uint64_t hash = 0xCBF29CE484222325;
+            for (char ch : src.file_name)
+                hash = (hash ^ std::uint8_t(ch)) * 0x100000001B3;
+
+            hash = (hash ^ src.line) * 0x100000001B3;
+            hash = (hash ^ src.column) * 0x100000001B3;
+
+            // `0` marks empty slots.
+            return hash | 1;
+        }
+
+    private:
+        static inline _slot _slots[_slot_count] = {};
+        static inline std::atomic<std::uint64_t> _overflow_count = 0;
+    };
 };
 
 export namespace atom
@@ -36,10 +175,60 @@ export namespace atom
         debug_panic,
     };
 
+    /// --------------------------------------------------------------------------------------------
+    /// level at which a contract category is checked.
+    ///
+    /// - `off`: no checks are performed.
+    /// - `default_`: only non debug checks are performed.
+    /// - `audit`: debug checks are performed too.
+    /// --------------------------------------------------------------------------------------------
+    enum class contract_level
+    {
+        off,
+        default_,
+        audit,
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// returns the level configured for the category of contract `type`.
+    ///
+    /// \see `ATOM_CONTRACTS_EXPECTS_LEVEL`, `ATOM_CONTRACTS_ASSERTS_LEVEL` and
+    ///     `ATOM_CONTRACTS_ENSURES_LEVEL`.
+    /// --------------------------------------------------------------------------------------------
+    consteval auto get_contract_level(contract_type type) -> contract_level
+    {
+        switch (type)
+        {
+            case contract_type::expects:
+            case contract_type::debug_expects: return contract_level(ATOM_CONTRACTS_EXPECTS_LEVEL);
+            case contract_type::asserts:
+            case contract_type::debug_asserts: return contract_level(ATOM_CONTRACTS_ASSERTS_LEVEL);
+            case contract_type::ensures:
+            case contract_type::debug_ensures: return contract_level(ATOM_CONTRACTS_ENSURES_LEVEL);
+            default:                           return contract_level::default_;
+        }
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// returns `true` if contract `type` is checked with the configured levels.
+    /// --------------------------------------------------------------------------------------------
+    consteval auto is_contract_checked(contract_type type) -> bool
+    {
+        contract_level level = get_contract_level(type);
+
+        switch (type)
+        {
+            case contract_type::debug_expects:
+            case contract_type::debug_asserts:
+            case contract_type::debug_ensures: return level == contract_level::audit;
+            default:                           return level != contract_level::off;
+        }
+    }
+
     /// ------------------------------------------------------------------------------------------------
     /// represents pre condition.
     /// ------------------------------------------------------------------------------------------------
-    constexpr auto contract_expects(bool assert, std::string_view msg = "",
+    ATOM_ATTR_ALWAYS_INLINE constexpr auto contract_expects(bool assert, std::string_view msg = "",
         source_location _src = source_location::current()) -> void
     {
         _contract_check<contract_type::expects>(assert, msg, _src);
@@ -48,7 +237,7 @@ export namespace atom
     /// ------------------------------------------------------------------------------------------------
     /// represents debug pre condition.
     /// ------------------------------------------------------------------------------------------------
-    constexpr auto contract_debug_expects(bool assert, std::string_view msg = "",
+    ATOM_ATTR_ALWAYS_INLINE constexpr auto contract_debug_expects(bool assert, std::string_view msg = "",
         source_location _src = source_location::current()) -> void
     {
         _contract_check<contract_type::debug_expects>(assert, msg, _src);
@@ -57,7 +246,7 @@ export namespace atom
     /// ------------------------------------------------------------------------------------------------
     /// represents assertion.
     /// ------------------------------------------------------------------------------------------------
-    constexpr auto contract_asserts(bool assert, std::string_view msg = "",
+    ATOM_ATTR_ALWAYS_INLINE constexpr auto contract_asserts(bool assert, std::string_view msg = "",
         source_location _src = source_location::current()) -> void
     {
         _contract_check<contract_type::asserts>(assert, msg, _src);
@@ -66,7 +255,7 @@ export namespace atom
     /// ------------------------------------------------------------------------------------------------
     /// represents debug assertion.
     /// ------------------------------------------------------------------------------------------------
-    constexpr auto contract_debug_asserts(bool assert, std::string_view msg = "",
+    ATOM_ATTR_ALWAYS_INLINE constexpr auto contract_debug_asserts(bool assert, std::string_view msg = "",
         source_location _src = source_location::current()) -> void
     {
         _contract_check<contract_type::debug_asserts>(assert, msg, _src);
@@ -75,7 +264,7 @@ export namespace atom
     /// ------------------------------------------------------------------------------------------------
     /// represents post condition.
     /// ------------------------------------------------------------------------------------------------
-    constexpr auto contract_ensures(bool assert, std::string_view msg = "",
+    ATOM_ATTR_ALWAYS_INLINE constexpr auto contract_ensures(bool assert, std::string_view msg = "",
         source_location _src = source_location::current()) -> void
     {
         _contract_check<contract_type::ensures>(assert, msg, _src);
@@ -84,7 +273,7 @@ export namespace atom
     /// ------------------------------------------------------------------------------------------------
     /// represents debug post condition.
     /// ------------------------------------------------------------------------------------------------
-    constexpr auto contract_debug_ensures(bool assert, std::string_view msg = "",
+    ATOM_ATTR_ALWAYS_INLINE constexpr auto contract_debug_ensures(bool assert, std::string_view msg = "",
         source_location _src = source_location::current()) -> void
     {
         _contract_check<contract_type::debug_ensures>(assert, msg, _src);
@@ -123,15 +312,61 @@ export namespace atom
     }
 
     /// --------------------------------------------------------------------------------------------
+    /// a contract violation, passed to `contract_violation_handler`.
     ///
+    /// only the raw frame addresses of the stack trace are captured, symbols are resolved on the
+    /// first call to `get_trace()`. so a handler which recovers from violations without printing
+    /// them doesn't pay for symbolization, which takes milliseconds.
     /// --------------------------------------------------------------------------------------------
     class contract_violation
     {
+    public:
+        contract_violation(contract_type type, std::string_view msg, source_location src,
+            cpptrace::raw_trace raw_trace, std::uint64_t site_count)
+            : type{ type }
+            , msg{ msg }
+            , src{ src }
+            , raw_trace{ std::move(raw_trace) }
+            , site_count{ site_count }
+            , _trace{}
+        {}
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// returns the stack trace, resolving its symbols on the first call.
+        ///
+        /// the trace is empty if it was not captured, see `has_trace()`.
+        /// ----------------------------------------------------------------------------------------
+        auto get_trace() const -> const cpptrace::stacktrace&
+        {
+            if (not _trace.has_value())
+                _trace = raw_trace.resolve();
+
+            return *_trace;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// returns `true` if a stack trace was captured for this violation. traces are skipped
+        /// when over the limit set with `contract_violation_handler::set_trace_limit()`.
+        /// ----------------------------------------------------------------------------------------
+        auto has_trace() const -> bool
+        {
+            return not raw_trace.empty();
+        }
+
     public:
         contract_type type;
         std::string_view msg;
         source_location src;
-        cpptrace::stacktrace trace;
+
+        /// frame addresses of the stack trace, without symbols.
+        cpptrace::raw_trace raw_trace;
+
+        /// count of violations at this site so far, including this one.
+        std::uint64_t site_count;
+
+    private:
+        mutable std::optional<cpptrace::stacktrace> _trace;
     };
 
     /// --------------------------------------------------------------------------------------------
@@ -142,12 +377,28 @@ export namespace atom
     public:
         contract_violation_exception(contract_violation violation)
             : violation(violation)
-            , _what{ _contract_violation_to_string(violation) }
+            , _what{}
         {}
 
     public:
+        /// ----------------------------------------------------------------------------------------
+        /// returns the description of the violation, building it on the first call. this
+        /// resolves the symbols of the trace, so throwing stays cheap when nobody reads it.
+        /// ----------------------------------------------------------------------------------------
         virtual auto what() const noexcept -> const char* override
         {
+            if (_what.empty())
+            {
+                try
+                {
+                    _what = _contract_violation_to_string(violation);
+                }
+                catch (...)
+                {
+                    return "contract violation.";
+                }
+            }
+
             return _what.data();
         }
 
@@ -155,7 +406,7 @@ export namespace atom
         contract_violation violation;
 
     private:
-        std::string _what;
+        mutable std::string _what;
     };
 
     /// --------------------------------------------------------------------------------------------
@@ -184,8 +435,36 @@ export namespace atom
             _handler = _default_handler;
         }
 
+        /// ----------------------------------------------------------------------------------------
+        /// sets the count of violations per second which capture a stack trace, `0` disables
+        /// capturing. otherwise the first violation at each site captures a trace regardless of
+        /// the limit.
+        ///
+        /// the default is 64.
+        /// ----------------------------------------------------------------------------------------
+        static auto set_trace_limit(std::uint32_t per_second) -> void
+        {
+            _contract_trace_limiter::set_limit(per_second);
+        }
+
+        static auto get_trace_limit() -> std::uint32_t
+        {
+            return _contract_trace_limiter::get_limit();
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// returns the count of violations so far at the check site `src`.
+        /// ----------------------------------------------------------------------------------------
+        static auto get_site_count(const source_location& src) -> std::uint64_t
+        {
+            return _contract_site_counters::get(src);
+        }
+
     public:
-        [[noreturn]]
+        /// ----------------------------------------------------------------------------------------
+        /// handles `violation`. returning continues execution after the failed check, except for
+        /// panics, which terminate.
+        /// ----------------------------------------------------------------------------------------
         virtual auto handle(const contract_violation& violation) -> void = 0;
 
     private:
@@ -222,32 +501,38 @@ export namespace atom
 
 namespace atom
 {
+    /// --------------------------------------------------------------------------------------------
+    /// reports the violation to the handler. this is kept out of line and marked cold, so that
+    /// checking sites only contain the comparison and a branch to this.
+    /// --------------------------------------------------------------------------------------------
+    ATOM_ATTR_COLD ATOM_ATTR_NOINLINE auto _contract_check_failed(
+        contract_type type, std::string_view msg, source_location src) -> void
+    {
+        std::uint64_t site_count = _contract_site_counters::increment(src);
+
+        // 1 for this function, the impl and api functions are always inlined.
+        cpptrace::raw_trace trace = _contract_trace_limiter::should_capture(site_count)
+                                        ? cpptrace::raw_trace::current(1)
+                                        : cpptrace::raw_trace{};
+
+        contract_violation violation{ type, msg, src, std::move(trace), site_count };
+        contract_violation_handler::get()->handle(violation);
+    }
+
     template <auto type>
-    constexpr auto _contract_check(bool assert, std::string_view msg, source_location src) -> void
+    ATOM_ATTR_ALWAYS_INLINE constexpr auto _contract_check(
+        bool assert, std::string_view msg, source_location src) -> void
     {
-        if constexpr (not build_config::is_mode_debug())
+        if constexpr (is_contract_checked(type))
         {
-            if constexpr (type == contract_type::debug_expects
-                          or type == contract_type::debug_asserts
-                          or type == contract_type::debug_ensures)
+            if (assert) [[likely]]
                 return;
-        }
 
-        if (assert)
-            return;
+            if (std::is_constant_evaluated())
+                throw 0;
 
-        if (std::is_constant_evaluated())
-            throw 0;
-
-        // 1 for this impl function and 1 for the api function.
-        contract_violation violation{
-            .type = type,
-            .msg = msg,
-            .src = src,
-            .trace = cpptrace::stacktrace::current(2),
-        };
-
-        contract_violation_handler::get()->handle(violation);
+            _contract_check_failed(type, msg, src);
+        }
     }
 
     constexpr auto _panic(std::string_view msg, source_location src) -> void
@@ -255,15 +540,18 @@ namespace atom
         if (std::is_constant_evaluated())
             throw 0;
 
+        std::uint64_t site_count = _contract_site_counters::increment(src);
+
         // 1 for this impl function and 1 for the api function.
-        contract_violation violation{
-            .type = contract_type::panic,
-            .msg = msg,
-            .src = src,
-            .trace = cpptrace::stacktrace::current(2),
-        };
+        cpptrace::raw_trace trace = _contract_trace_limiter::should_capture(site_count)
+                                        ? cpptrace::raw_trace::current(2)
+                                        : cpptrace::raw_trace{};
+
+        contract_violation violation{ contract_type::panic, msg, src, std::move(trace),
+            site_count };
 
         contract_violation_handler::get()->handle(violation);
+        std::terminate();
     }
 
     constexpr auto _contract_type_to_string(contract_type type) -> std::string_view
@@ -288,10 +576,12 @@ namespace atom
                                       "\n\twith msg: {}"
                                       "\n\tat: {}:{}:{}"
                                       "\n\tfunc: {}"
+                                      "\n\tcount: {}"
                                       "\n\ttrace: {}",
             _contract_type_to_string(violation.type), violation.msg, violation.src.file_name,
             violation.src.line, violation.src.column, violation.src.func_name,
-            violation.trace.to_string());
+            violation.site_count,
+            violation.has_trace() ? violation.get_trace().to_string() : "[not captured]");
 
         return out;
     }
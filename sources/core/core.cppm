@@ -22,6 +22,9 @@ export namespace atom
     struct create_from_range_tag
     {};
 
+    struct create_from_sorted_range_tag
+    {};
+
     struct create_from_variant_tag
     {};
 
@@ -44,6 +47,7 @@ export namespace atom
     constexpr auto create_from_raw = create_from_raw_tag{};
     constexpr auto create_with_join = create_with_join_tag{};
     constexpr auto create_from_range = create_from_range_tag{};
+    constexpr auto create_from_sorted_range = create_from_sorted_range_tag{};
     constexpr auto create_from_variant = create_from_variant_tag{};
     constexpr auto create_from_result = create_from_result_tag{};
     constexpr auto create_from_void = create_from_void_tag{};
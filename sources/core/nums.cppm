@@ -1,6 +1,8 @@
 export module atom_core:core.nums;
 
 import std;
+import :contracts;
+import :core.num_wrapper;
 export import :core.int_wrapper;
 export import :core.float_wrapper;
 
@@ -56,4 +58,154 @@ export namespace atom::nums
     {
         return std::clamp(num, low, high);
     }
+
+    /// --------------------------------------------------------------------------------------------
+    /// returns `true` if no overflow occurs when adding `lhs` and `rhs`.
+    /// --------------------------------------------------------------------------------------------
+    template <typename num_type>
+    constexpr auto is_add_safe(num_type lhs, num_type rhs) -> bool
+        requires std::is_integral_v<num_type>
+    {
+        num_type result;
+        return not _int_overflow_impl::add(lhs, rhs, result);
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// returns result after adding `lhs` and `rhs`.
+    ///
+    /// \pre no overflow occurs.
+    /// --------------------------------------------------------------------------------------------
+    template <typename num_type>
+    constexpr auto add_checked(num_type lhs, num_type rhs) -> num_type
+        requires std::is_integral_v<num_type>
+    {
+        num_type result;
+        bool overflow = _int_overflow_impl::add(lhs, rhs, result);
+        contract_expects(not overflow, "integer overflow.");
+
+        return result;
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// returns result after adding `lhs` and `rhs`, clamped to the range of `num_type` on
+    /// overflow.
+    /// --------------------------------------------------------------------------------------------
+    template <typename num_type>
+    constexpr auto add_saturating(num_type lhs, num_type rhs) -> num_type
+        requires std::is_integral_v<num_type>
+    {
+        return _int_overflow_impl::add_saturating(lhs, rhs);
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// returns result after adding `lhs` and `rhs`, wrapped around on overflow.
+    /// --------------------------------------------------------------------------------------------
+    template <typename num_type>
+    constexpr auto add_wrapping(num_type lhs, num_type rhs) -> num_type
+        requires std::is_integral_v<num_type>
+    {
+        num_type result;
+        _int_overflow_impl::add(lhs, rhs, result);
+        return result;
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// returns `true` if no overflow occurs when subtracting `rhs` from `lhs`.
+    /// --------------------------------------------------------------------------------------------
+    template <typename num_type>
+    constexpr auto is_sub_safe(num_type lhs, num_type rhs) -> bool
+        requires std::is_integral_v<num_type>
+    {
+        num_type result;
+        return not _int_overflow_impl::sub(lhs, rhs, result);
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// returns result after subtracting `rhs` from `lhs`.
+    ///
+    /// \pre no overflow occurs.
+    /// --------------------------------------------------------------------------------------------
+    template <typename num_type>
+    constexpr auto sub_checked(num_type lhs, num_type rhs) -> num_type
+        requires std::is_integral_v<num_type>
+    {
+        num_type result;
+        bool overflow = _int_overflow_impl::sub(lhs, rhs, result);
+        contract_expects(not overflow, "integer overflow.");
+
+        return result;
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// returns result after subtracting `rhs` from `lhs`, clamped to the range of `num_type` on
+    /// overflow.
+    /// --------------------------------------------------------------------------------------------
+    template <typename num_type>
+    constexpr auto sub_saturating(num_type lhs, num_type rhs) -> num_type
+        requires std::is_integral_v<num_type>
+    {
+        return _int_overflow_impl::sub_saturating(lhs, rhs);
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// returns result after subtracting `rhs` from `lhs`, wrapped around on overflow.
+    /// --------------------------------------------------------------------------------------------
+    template <typename num_type>
+    constexpr auto sub_wrapping(num_type lhs, num_type rhs) -> num_type
+        requires std::is_integral_v<num_type>
+    {
+        num_type result;
+        _int_overflow_impl::sub(lhs, rhs, result);
+        return result;
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// returns `true` if no overflow occurs when multiplying `lhs` and `rhs`.
+    /// --------------------------------------------------------------------------------------------
+    template <typename num_type>
+    constexpr auto is_mul_safe(num_type lhs, num_type rhs) -> bool
+        requires std::is_integral_v<num_type>
+    {
+        num_type result;
+        return not _int_overflow_impl::mul(lhs, rhs, result);
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// returns result after multiplying `lhs` and `rhs`.
+    ///
+    /// \pre no overflow occurs.
+    /// --------------------------------------------------------------------------------------------
+    template <typename num_type>
+    constexpr auto mul_checked(num_type lhs, num_type rhs) -> num_type
+        requires std::is_integral_v<num_type>
+    {
+        num_type result;
+        bool overflow = _int_overflow_impl::mul(lhs, rhs, result);
+        contract_expects(not overflow, "integer overflow.");
+
+        return result;
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// returns result after multiplying `lhs` and `rhs`, clamped to the range of `num_type` on
+    /// overflow.
+    /// --------------------------------------------------------------------------------------------
+    template <typename num_type>
+    constexpr auto mul_saturating(num_type lhs, num_type rhs) -> num_type
+        requires std::is_integral_v<num_type>
+    {
+        return _int_overflow_impl::mul_saturating(lhs, rhs);
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// returns result after multiplying `lhs` and `rhs`, wrapped around on overflow.
+    /// --------------------------------------------------------------------------------------------
+    template <typename num_type>
+    constexpr auto mul_wrapping(num_type lhs, num_type rhs) -> num_type
+        requires std::is_integral_v<num_type>
+    {
+        num_type result;
+        _int_overflow_impl::mul(lhs, rhs, result);
+        return result;
+    }
 }
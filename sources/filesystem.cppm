@@ -1,3 +1,5 @@
 export module atom_core:filesystem;
 
 export import :filesystem.file;
+export import :filesystem.directory;
+export import :filesystem.file_copy;
@@ -0,0 +1,675 @@
+module;
+#include "atom/core/preprocessors.h"
+#include <cerrno>
+
+#if defined(ATOM_PLATFORM_POSIX)
+#    include <dirent.h>
+#    include <fcntl.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+#if defined(__linux__)
+#    include <sys/syscall.h>
+#endif
+
+export module atom_core:filesystem.directory;
+
+import std;
+import :core;
+import :contracts;
+import :containers;
+import :default_mem_allocator;
+import :function_box;
+import :strings;
+import :filesystem.file;
+
+namespace atom::filesystem
+{
+    /// --------------------------------------------------------------------------------------------
+    /// type of a directory entry.
+    /// --------------------------------------------------------------------------------------------
+    export enum class entry_type : u8
+    {
+        unknown,
+        file,
+        directory,
+        symlink,
+        other,
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// entry read from a directory.
+    /// --------------------------------------------------------------------------------------------
+    export class directory_entry
+    {
+    public:
+        auto is_file() const -> bool
+        {
+            return type == entry_type::file;
+        }
+
+        auto is_directory() const -> bool
+        {
+            return type == entry_type::directory;
+        }
+
+    public:
+        /// name of the entry, without the path of the directory. points into the buffer of the
+        /// directory, valid until the next entry is read.
+        string_view name;
+        entry_type type;
+        u64 inode;
+    };
+
+#if defined(__linux__)
+    /// --------------------------------------------------------------------------------------------
+    /// record layout returned by `getdents64`.
+    /// --------------------------------------------------------------------------------------------
+    class _linux_dirent64
+    {
+    public:
+        u64 d_ino;
+        i64 d_off;
+        u16 d_reclen;
+        u8 d_type;
+        char d_name[1];
+    };
+#endif
+
+    /// --------------------------------------------------------------------------------------------
+    /// an open directory, to read its entries.
+    ///
+    /// entries are read with `getdents64` in batches of many entries per syscall, and their type
+    /// comes from `d_type`, so no `stat` is needed per entry. for filesystems which don't fill
+    /// `d_type`, the type is looked up with `fstatat`. `.` and `..` are skipped.
+    ///
+    /// on posix platforms other than linux, entries are read with `readdir` instead. on other
+    /// platforms, opening a directory fails with `ENOSYS`.
+    /// --------------------------------------------------------------------------------------------
+    export class directory
+    {
+        using this_type = directory;
+
+    public:
+        using open_result = result<directory, filesystem_error, noentry_error>;
+        using next_result = result<bool, filesystem_error>;
+
+        static constexpr usize buffer_size = 32 * 1024;
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// opens the directory at `path`.
+        /// ----------------------------------------------------------------------------------------
+        static auto open(string_view path) -> open_result
+        {
+#if defined(ATOM_PLATFORM_POSIX)
+            return open_at(AT_FDCWD, path);
+#else
+            return filesystem_error{ ENOSYS };
+#endif
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// opens the directory at `path` relative to the directory `dir_fd`, which saves the
+        /// kernel from resolving the whole path again.
+        /// ----------------------------------------------------------------------------------------
+        static auto open_at(i32 dir_fd, string_view path) -> open_result
+        {
+#if defined(ATOM_PLATFORM_POSIX)
+            i32 fd = ::openat(dir_fd, path.get_data(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+            if (fd < 0)
+            {
+                if (errno == ENOENT)
+                    return noentry_error{ path };
+
+                return filesystem_error{ errno };
+            }
+
+            return directory{ fd };
+#else
+            return filesystem_error{ ENOSYS };
+#endif
+        }
+
+    public:
+        directory(const this_type&) = delete;
+        directory& operator=(const this_type&) = delete;
+
+        directory(this_type&& that)
+        {
+            _take(that);
+        }
+
+        directory& operator=(this_type&& that)
+        {
+            if (this == &that)
+                return *this;
+
+            _close();
+            _take(that);
+            return *this;
+        }
+
+        ~directory()
+        {
+            _close();
+        }
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// reads the next entry into `entry`. returns `true` if an entry was read, `false` at the
+        /// end of the directory.
+        /// ----------------------------------------------------------------------------------------
+        auto next(directory_entry& entry) -> next_result
+        {
+            contract_debug_expects(_fd >= 0, "the directory is closed.");
+
+#if defined(__linux__)
+            while (true)
+            {
+                if (_pos == _end)
+                {
+                    isize count = ::syscall(SYS_getdents64, _fd, _buffer, buffer_size);
+                    if (count < 0)
+                    {
+                        if (errno == EINTR)
+                            continue;
+
+                        return filesystem_error{ errno };
+                    }
+
+                    if (count == 0)
+                        return false;
+
+                    _pos = 0;
+                    _end = usize(count);
+                }
+
+                const _linux_dirent64* dirent =
+                    reinterpret_cast<const _linux_dirent64*>(_buffer + _pos);
+                _pos += dirent->d_reclen;
+
+                const char* name = dirent->d_name;
+                if (_is_dot_or_dot_dot(name))
+                    continue;
+
+                entry.name = string_view{ name };
+                entry.inode = dirent->d_ino;
+                entry.type = _get_type(dirent->d_type);
+                if (entry.type == entry_type::unknown)
+                    entry.type = _stat_type(name);
+
+                return true;
+            }
+#elif defined(ATOM_PLATFORM_POSIX)
+            // `fdopendir` takes over the fd, `closedir` closes it.
+            if (_dir == nullptr)
+            {
+                _dir = ::fdopendir(_fd);
+                if (_dir == nullptr)
+                    return filesystem_error{ errno };
+            }
+
+            while (true)
+            {
+                errno = 0;
+                const dirent* record = ::readdir(_dir);
+                if (record == nullptr)
+                {
+                    if (errno != 0)
+                        return filesystem_error{ errno };
+
+                    return false;
+                }
+
+                const char* name = record->d_name;
+                if (_is_dot_or_dot_dot(name))
+                    continue;
+
+                entry.name = string_view{ name };
+                entry.inode = record->d_ino;
+#    if defined(DT_UNKNOWN)
+                entry.type = _get_type(record->d_type);
+#    else
+                entry.type = entry_type::unknown;
+#    endif
+                if (entry.type == entry_type::unknown)
+                    entry.type = _stat_type(name);
+
+                return true;
+            }
+#else
+            return filesystem_error{ ENOSYS };
+#endif
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// returns the file descriptor, for use with `open_at()`.
+        /// ----------------------------------------------------------------------------------------
+        auto get_fd() const -> i32
+        {
+            return _fd;
+        }
+
+    private:
+        directory(i32 fd)
+            : _fd{ fd }
+        {
+#if defined(__linux__)
+            _buffer = static_cast<char*>(default_mem_allocator().alloc(buffer_size));
+            contract_asserts(_buffer != nullptr, "out of memory.");
+#endif
+        }
+
+        auto _take(this_type& that) -> void
+        {
+            _fd = that._fd;
+            that._fd = -1;
+
+#if defined(__linux__)
+            _buffer = that._buffer;
+            _pos = that._pos;
+            _end = that._end;
+            that._buffer = nullptr;
+#elif defined(ATOM_PLATFORM_POSIX)
+            _dir = that._dir;
+            that._dir = nullptr;
+#endif
+        }
+
+        auto _close() -> void
+        {
+#if defined(__linux__)
+            if (_fd >= 0)
+                ::close(_fd);
+
+            if (_buffer != nullptr)
+                default_mem_allocator().dealloc(_buffer);
+
+            _buffer = nullptr;
+#elif defined(ATOM_PLATFORM_POSIX)
+            if (_dir != nullptr)
+                ::closedir(_dir);
+            else if (_fd >= 0)
+                ::close(_fd);
+
+            _dir = nullptr;
+#endif
+
+            _fd = -1;
+        }
+
+        static auto _is_dot_or_dot_dot(const char* name) -> bool
+        {
+            return name[0] == '.' and (name[1] == '\0' or (name[1] == '.' and name[2] == '\0'));
+        }
+
+#if defined(DT_UNKNOWN)
+        static auto _get_type(u8 d_type) -> entry_type
+        {
+            switch (d_type)
+            {
+                case DT_REG:     return entry_type::file;
+                case DT_DIR:     return entry_type::directory;
+                case DT_LNK:     return entry_type::symlink;
+                case DT_UNKNOWN: return entry_type::unknown;
+                default:         return entry_type::other;
+            }
+        }
+#endif
+
+#if defined(ATOM_PLATFORM_POSIX)
+        auto _stat_type(const char* name) const -> entry_type
+        {
+            struct stat info;
+            if (::fstatat(_fd, name, &info, AT_SYMLINK_NOFOLLOW) != 0)
+                return entry_type::unknown;
+
+            if (S_ISREG(info.st_mode))
+                return entry_type::file;
+
+            if (S_ISDIR(info.st_mode))
+                return entry_type::directory;
+
+            if (S_ISLNK(info.st_mode))
+                return entry_type::symlink;
+
+            return entry_type::other;
+        }
+#endif
+
+    private:
+        i32 _fd = -1;
+
+#if defined(__linux__)
+        char* _buffer = nullptr;
+        usize _pos = 0;
+        usize _end = 0;
+#elif defined(ATOM_PLATFORM_POSIX)
+        DIR* _dir = nullptr;
+#endif
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// entry visited by `walk_directory()`.
+    /// --------------------------------------------------------------------------------------------
+    export class walk_entry
+    {
+    public:
+        /// path of the entry, starting with the walked path. valid during the callback.
+        string_view path;
+
+        /// name of the entry, the last part of `path`.
+        string_view name;
+
+        entry_type type;
+
+        /// depth of the entry, `0` for entries in the walked directory.
+        usize depth;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// options for `walk_directory()`.
+    /// --------------------------------------------------------------------------------------------
+    export class walk_options
+    {
+    public:
+        /// count of threads walking, `0` to use one per hardware thread.
+        usize thread_count = 0;
+
+        /// depth of the deepest entries visited, `0` to visit only the walked directory.
+        usize max_depth = std::numeric_limits<usize>::max();
+
+        /// entries for which this returns `false` are not passed to the callback. null passes
+        /// all entries.
+        function_box<bool(const walk_entry&)> filter = nullptr;
+
+        /// directories for which this returns `false` are not walked into. null walks into all
+        /// directories.
+        function_box<bool(const walk_entry&)> dir_filter = nullptr;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// counts of what `walk_directory()` did.
+    /// --------------------------------------------------------------------------------------------
+    export class walk_stats
+    {
+    public:
+        usize entry_count = 0;
+        usize dir_count = 0;
+
+        /// count of directories which couldn't be opened or read, and were skipped.
+        usize error_count = 0;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// shared state of the threads of `walk_directory()`.
+    ///
+    /// directories waiting to be walked are kept in a stack, so the walk stays mostly depth first
+    /// and the stack stays small. `_pending_count` counts directories in the stack and being
+    /// walked, the walk is done when it drops to `0`.
+    ///
+    /// subdirectories are opened relative to their parent, so the kernel doesn't resolve the
+    /// whole path again. a parent stays open until all its subdirectories are opened, which
+    /// keeps about one directory open per level of the stack.
+    /// --------------------------------------------------------------------------------------------
+    class _directory_walker
+    {
+        /// ----------------------------------------------------------------------------------------
+        /// walked directory, `ref_count` counts its subdirectories not opened yet.
+        /// ----------------------------------------------------------------------------------------
+        class _parent_dir
+        {
+        public:
+            _parent_dir(directory handle, usize ref_count)
+                : handle{ move(handle) }
+                , ref_count{ ref_count }
+            {}
+
+        public:
+            directory handle;
+            std::atomic<usize> ref_count;
+        };
+
+        class _pending_dir
+        {
+        public:
+            auto get_path() const -> string_view
+            {
+                return string_view(create_from_raw, path.get_data(), path.get_count() - 1);
+            }
+
+            /// returns the name of the directory, to open it relative to `parent`.
+            auto get_name() const -> string_view
+            {
+                return string_view(create_from_raw, path.get_data() + name_offset,
+                    path.get_count() - 1 - name_offset);
+            }
+
+        public:
+            /// path including a null terminator, to open it.
+            string path;
+            usize depth = 0;
+            usize name_offset = 0;
+
+            /// null for the walked directory, which is already open.
+            _parent_dir* parent = nullptr;
+        };
+
+    public:
+        _directory_walker(const walk_options& opts,
+            function_box<void(const walk_entry&)>& callback, directory root)
+            : _opts{ opts }
+            , _callback{ callback }
+            , _root{ move(root) }
+        {}
+
+    public:
+        auto walk(string_view path) -> walk_stats
+        {
+            string root{ path };
+            while (root.get_count() > 1 and root.get_data()[root.get_count() - 1] == '/')
+                root.remove_last();
+
+            root.emplace_last('\0');
+            _pending.emplace_last(_pending_dir{ move(root), 0 });
+            _pending_count = 1;
+
+            usize thread_count = _opts.thread_count;
+            if (thread_count == 0)
+                thread_count = std::max(usize(std::thread::hardware_concurrency()), usize(1));
+
+            dynamic_array<std::thread> threads;
+            for (usize i = 1; i < thread_count; i++)
+                threads.emplace_last([this] { _work(); });
+
+            _work();
+
+            for (usize i = 0; i < threads.get_count(); i++)
+                threads.get_at(i).join();
+
+            walk_stats stats;
+            stats.entry_count = _entry_count.load(std::memory_order_relaxed);
+            stats.dir_count = _dir_count.load(std::memory_order_relaxed);
+            stats.error_count = _error_count.load(std::memory_order_relaxed);
+            return stats;
+        }
+
+    private:
+        auto _work() -> void
+        {
+            dynamic_array<_pending_dir> found;
+            string path;
+
+            while (true)
+            {
+                _pending_dir dir;
+                {
+                    std::unique_lock<std::mutex> lock{ _lock };
+                    _cond.wait(
+                        lock, [this] { return not _pending.is_empty() or _pending_count == 0; });
+
+                    if (_pending.is_empty())
+                        return;
+
+                    dir = move(_pending.get_at(_pending.get_count() - 1));
+                    _pending.remove_last();
+                }
+
+                _walk_dir(dir, path, found);
+
+                std::unique_lock<std::mutex> lock{ _lock };
+                _pending_count += found.get_count();
+                _pending_count--;
+
+                for (usize i = 0; i < found.get_count(); i++)
+                    _pending.emplace_last(move(found.get_at(i)));
+
+                found.remove_all();
+                if (_pending_count == 0 or _pending.get_count() > 1)
+                    _cond.notify_all();
+                else if (not _pending.is_empty())
+                    _cond.notify_one();
+            }
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// visits entries of `dir`, and adds its subdirectories to `found`. `path` is reused as
+        /// the buffer to build entry paths.
+        /// ----------------------------------------------------------------------------------------
+        auto _walk_dir(const _pending_dir& dir, string& path, dynamic_array<_pending_dir>& found)
+            -> void
+        {
+            directory::open_result open_result = _open_dir(dir);
+            if (open_result.is_error())
+            {
+                _error_count.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+
+            directory handle = move(open_result.get_value());
+            _dir_count.fetch_add(1, std::memory_order_relaxed);
+
+            path.remove_all();
+            path.insert_range_last(dir.get_path());
+            if (path.get_data()[path.get_count() - 1] != '/')
+                path.emplace_last('/');
+
+            usize base_count = path.get_count();
+            usize entry_count = 0;
+
+            directory_entry entry;
+            while (true)
+            {
+                directory::next_result next = handle.next(entry);
+                if (next.is_error())
+                {
+                    _error_count.fetch_add(1, std::memory_order_relaxed);
+                    break;
+                }
+
+                if (not next.get_value())
+                    break;
+
+                path.remove_last(path.get_count() - base_count);
+                path.insert_range_last(entry.name);
+
+                walk_entry visited{
+                    .path = string_view{ path },
+                    .name = entry.name,
+                    .type = entry.type,
+                    .depth = dir.depth,
+                };
+
+                if (not _opts.filter.has() or _opts.filter(visited))
+                {
+                    _callback(visited);
+                    entry_count++;
+                }
+
+                if (entry.type == entry_type::directory and dir.depth < _opts.max_depth
+                    and (not _opts.dir_filter.has() or _opts.dir_filter(visited)))
+                {
+                    string dir_path{ string_view{ path } };
+                    dir_path.emplace_last('\0');
+                    found.emplace_last(_pending_dir{ move(dir_path), dir.depth + 1, base_count });
+                }
+            }
+
+            _entry_count.fetch_add(entry_count, std::memory_order_relaxed);
+
+            if (found.is_empty())
+                return;
+
+            _parent_dir* parent = static_cast<_parent_dir*>(_allocator.alloc(sizeof(_parent_dir)));
+            contract_asserts(parent != nullptr, "out of memory.");
+            std::construct_at(parent, move(handle), found.get_count());
+
+            for (usize i = 0; i < found.get_count(); i++)
+                found.get_at(i).parent = parent;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// opens `dir` relative to its parent, and closes the parent after its last
+        /// subdirectory.
+        /// ----------------------------------------------------------------------------------------
+        auto _open_dir(const _pending_dir& dir) -> directory::open_result
+        {
+            if (dir.parent == nullptr)
+                return move(_root);
+
+            directory::open_result result =
+                directory::open_at(dir.parent->handle.get_fd(), dir.get_name());
+
+            if (dir.parent->ref_count.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                std::destroy_at(dir.parent);
+                _allocator.dealloc(dir.parent);
+            }
+
+            return result;
+        }
+
+    private:
+        walk_options _opts;
+        function_box<void(const walk_entry&)>& _callback;
+        directory _root;
+        default_mem_allocator _allocator;
+
+        std::mutex _lock;
+        std::condition_variable _cond;
+        dynamic_array<_pending_dir> _pending;
+        usize _pending_count = 0;
+
+        std::atomic<usize> _entry_count = 0;
+        std::atomic<usize> _dir_count = 0;
+        std::atomic<usize> _error_count = 0;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// walks the directory at `path` and its subdirectories in parallel, calling `callback` for
+    /// each entry.
+    ///
+    /// directories are shared between `opts.thread_count` threads, including the calling thread,
+    /// so `callback` and the filters are called from many threads at once and must be thread
+    /// safe. the order of entries is not specified. symlinks are visited but not followed, so the
+    /// walk can't loop. directories which can't be opened or read are skipped and counted in
+    /// `walk_stats::error_count`, except `path` itself.
+    /// --------------------------------------------------------------------------------------------
+    export auto walk_directory(string_view path, const walk_options& opts,
+        function_box<void(const walk_entry&)> callback)
+        -> result<walk_stats, filesystem_error, noentry_error>
+    {
+        // open the root here, to report why it can't be walked.
+        directory::open_result root = directory::open(path);
+        if (root.is_error<noentry_error>())
+            return noentry_error{ path };
+
+        if (root.is_error<filesystem_error>())
+            return root.get_error<filesystem_error>();
+
+        _directory_walker walker{ opts, callback, move(root.get_value()) };
+        return walker.walk(path);
+    }
+}
@@ -1,7 +1,13 @@
 module;
+#include "atom/core/preprocessors.h"
 #include <cerrno>
 #include <cstdio>
 
+#if defined(ATOM_PLATFORM_POSIX)
+#    include <sys/uio.h>
+#    include <unistd.h>
+#endif
+
 export module atom_core:filesystem.file;
 
 import std;
@@ -13,6 +19,20 @@ import :dynamic_buffer;
 
 namespace atom::filesystem
 {
+#if defined(ATOM_PLATFORM_POSIX)
+    using _iovec = iovec;
+#else
+    /// --------------------------------------------------------------------------------------------
+    /// same layout as posix `iovec`, so views are batched the same way on every platform.
+    /// --------------------------------------------------------------------------------------------
+    class _iovec
+    {
+    public:
+        void* iov_base;
+        usize iov_len;
+    };
+#endif
+
     /// --------------------------------------------------------------------------------------------
     /// error representing system level error.
     /// --------------------------------------------------------------------------------------------
@@ -92,6 +112,8 @@ namespace atom::filesystem
         /// ----------------------------------------------------------------------------------------
         using open_result = result<file, filesystem_error, noentry_error, invalid_options_error>;
         using reopen_result = result<void, filesystem_error, noentry_error, invalid_options_error>;
+        using read_at_result = result<usize, filesystem_error>;
+        using write_at_result = result<void, filesystem_error>;
 
     public:
         /// ----------------------------------------------------------------------------------------
@@ -203,6 +225,21 @@ namespace atom::filesystem
             return _file == nullptr;
         }
 
+        /// ----------------------------------------------------------------------------------------
+        /// returns the file descriptor. writes through it bypass the buffer of this file, so
+        /// `flush()` before using it to write.
+        /// ----------------------------------------------------------------------------------------
+        auto get_fd() const -> i32
+        {
+            contract_debug_expects(not is_closed(), "the file is closed.");
+
+#if defined(ATOM_PLATFORM_WIN)
+            return _fileno(_file);
+#else
+            return fileno(_file);
+#endif
+        }
+
         /// ----------------------------------------------------------------------------------------
         /// reads the file contents from begining to end as bytes.
         /// ----------------------------------------------------------------------------------------
@@ -212,10 +249,11 @@ namespace atom::filesystem
 
             std::fseek(_file, 0, SEEK_END);
             usize size = std::ftell(_file);
-            dynamic_buffer content{ create_with_size, size };
+            dynamic_buffer content;
+            mut_memory_view out = content.append_uninitialized(size);
 
             std::fseek(_file, 0, SEEK_SET);
-            usize read_count = std::fread(content.get_data(), sizeof(byte), size, _file);
+            usize read_count = std::fread(out.get_data(), sizeof(byte), size, _file);
 
             contract_asserts(read_count == size);
             return content;
@@ -240,7 +278,8 @@ namespace atom::filesystem
 
             std::fseek(_file, 0, SEEK_END);
             usize size = std::ftell(_file);
-            string content{ create_with_count, size };
+            string content;
+            content.resize_uninitialized(size);
 
             std::fseek(_file, 0, SEEK_SET);
             usize read_count = std::fread(content.get_data(), sizeof(char), size, _file);
@@ -259,7 +298,8 @@ namespace atom::filesystem
             usize current_pos = std::ftell(_file);
             std::fseek(_file, 0, SEEK_END);
             usize size = std::ftell(_file) - current_pos;
-            string content{ create_with_count, size };
+            string content;
+            content.resize_uninitialized(size);
 
             std::fseek(_file, current_pos, SEEK_SET);
             usize read_count = std::fread(content.get_data(), sizeof(char), size, _file);
@@ -279,6 +319,146 @@ namespace atom::filesystem
             std::fwrite(str.get_data(), sizeof(char), str.get_count(), _file);
         }
 
+        /// ----------------------------------------------------------------------------------------
+        /// writes the contents of `builder` to the file.
+        ///
+        /// the chunks are written in place with vectored writes, after flushing the buffered
+        /// data, so nothing is copied. the position is at the end of what was written after
+        /// this, for stdio calls too. without posix, the chunks are written one by one through
+        /// the buffer of this file. returns `false` if writing failed.
+        /// ----------------------------------------------------------------------------------------
+        auto write_builder(const string_builder& builder) -> bool
+        {
+            contract_debug_expects(not is_closed(), "the file is closed.");
+
+#if defined(ATOM_PLATFORM_POSIX)
+            if (std::fflush(_file) != 0)
+                return false;
+
+            _iovec iovs[_iov_batch_count];
+            usize iov_count = 0;
+            bool failed = false;
+
+            builder.for_each_chunk([&](string_view chunk) {
+                if (failed)
+                    return;
+
+                iovs[iov_count].iov_base = const_cast<char*>(chunk.get_data());
+                iovs[iov_count].iov_len = chunk.get_count();
+                iov_count++;
+
+                if (iov_count == _iov_batch_count)
+                {
+                    failed = not _write_iovs(iovs, iov_count, nullptr);
+                    iov_count = 0;
+                }
+            });
+
+            if (not failed and iov_count > 0)
+                failed = not _write_iovs(iovs, iov_count, nullptr);
+
+            // the descriptor's position moved behind stdio's back, drop its cached position. this
+            // fails harmlessly for pipes and terminals, which have no position.
+            std::fseek(_file, 0, SEEK_CUR);
+            return not failed;
+#else
+            bool failed = false;
+            builder.for_each_chunk([&](string_view chunk) {
+                if (not failed)
+                {
+                    usize count = chunk.get_count();
+                    failed = std::fwrite(chunk.get_data(), sizeof(char), count, _file) != count;
+                }
+            });
+
+            return not failed;
+#endif
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// reads up to `buf.get_size()` bytes at `offset` into `buf`, returns the count of bytes
+        /// read, which is less only at the end of the file.
+        ///
+        /// positional io goes through the file descriptor, it doesn't use or move the current
+        /// position, so it can be used by many threads at once. it also bypasses the buffer of
+        /// this file, so `flush()` after buffered writes before reading them back. without
+        /// posix, it seeks this file to `offset` and back instead, which isn't thread safe.
+        /// ----------------------------------------------------------------------------------------
+        auto read_at(u64 offset, mut_memory_view buf) const -> read_at_result
+        {
+            contract_debug_expects(not is_closed(), "the file is closed.");
+
+            _iovec iov = _to_iovec(buf);
+            isize count = _read_iovs(&iov, 1, offset);
+            if (count < 0)
+                return filesystem_error{ errno };
+
+            return usize(count);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// reads at `offset` into `bufs` one after another with vectored reads, returns the count
+        /// of bytes read. see `read_at(u64, mut_memory_view)`.
+        /// ----------------------------------------------------------------------------------------
+        auto read_at(u64 offset, array_view<mut_memory_view> bufs) const -> read_at_result
+        {
+            contract_debug_expects(not is_closed(), "the file is closed.");
+
+            usize total = 0;
+            bool is_eof = false;
+            bool ok = _for_each_iov_batch(bufs, [&](_iovec* iovs, usize count, usize size) {
+                if (is_eof)
+                    return true;
+
+                isize read = _read_iovs(iovs, count, offset + total);
+                if (read < 0)
+                    return false;
+
+                total += usize(read);
+                is_eof = usize(read) < size;
+                return true;
+            });
+
+            if (not ok)
+                return filesystem_error{ errno };
+
+            return total;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// writes `bytes` at `offset`. see `read_at(u64, mut_memory_view)`.
+        ///
+        /// data still in the buffer of this file is written at the current position on the next
+        /// `flush()`, and overwrites what this wrote if the ranges overlap. `flush()` before
+        /// mixing buffered and positional writes.
+        /// ----------------------------------------------------------------------------------------
+        auto write_at(u64 offset, memory_view bytes) -> write_at_result
+        {
+            contract_debug_expects(not is_closed(), "the file is closed.");
+
+            _iovec iov = _to_iovec(bytes);
+            if (not _write_iovs(&iov, 1, &offset))
+                return filesystem_error{ errno };
+
+            return { create_from_void };
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// writes `bufs` at `offset` one after another with vectored writes.
+        /// ----------------------------------------------------------------------------------------
+        auto write_at(u64 offset, array_view<memory_view> bufs) -> write_at_result
+        {
+            return _write_views_at(offset, bufs);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// writes `strs` at `offset` one after another with vectored writes.
+        /// ----------------------------------------------------------------------------------------
+        auto write_at(u64 offset, array_view<string_view> strs) -> write_at_result
+        {
+            return _write_views_at(offset, strs);
+        }
+
         /// ----------------------------------------------------------------------------------------
         /// writes a string to the file ending with a new line character.
         /// ----------------------------------------------------------------------------------------
@@ -471,6 +651,219 @@ namespace atom::filesystem
         }
 
     private:
+        template <typename view_type>
+        auto _write_views_at(u64 offset, array_view<view_type> views) -> write_at_result
+        {
+            contract_debug_expects(not is_closed(), "the file is closed.");
+
+            bool ok = _for_each_iov_batch(views, [&](_iovec* iovs, usize count, usize size) {
+                u64 batch_offset = offset;
+                if (not _write_iovs(iovs, count, &batch_offset))
+                    return false;
+
+                offset += size;
+                return true;
+            });
+
+            if (not ok)
+                return filesystem_error{ errno };
+
+            return { create_from_void };
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// converts `views` to batches of `iovec` on the stack, and calls `func` with each batch
+        /// and its size in bytes. stops and returns `false` if `func` does.
+        /// ----------------------------------------------------------------------------------------
+        template <typename view_type, typename function_type>
+        static auto _for_each_iov_batch(array_view<view_type> views, function_type&& func) -> bool
+        {
+            _iovec iovs[_iov_batch_count];
+            for (usize i = 0; i < views.get_count(); i += _iov_batch_count)
+            {
+                usize count = std::min(views.get_count() - i, _iov_batch_count);
+                usize size = 0;
+                for (usize j = 0; j < count; j++)
+                {
+                    iovs[j] = _to_iovec(views[i + j]);
+                    size += iovs[j].iov_len;
+                }
+
+                if (not func(iovs, count, size))
+                    return false;
+            }
+
+            return true;
+        }
+
+        static auto _to_iovec(mut_memory_view view) -> _iovec
+        {
+            return _iovec{ view.get_data(), view.get_size() };
+        }
+
+        static auto _to_iovec(memory_view view) -> _iovec
+        {
+            return _iovec{ const_cast<byte*>(view.get_data()), view.get_size() };
+        }
+
+        static auto _to_iovec(string_view view) -> _iovec
+        {
+            return _iovec{ const_cast<char*>(view.get_data()), view.get_count() };
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// reads into `iovs` at `offset`, resuming after partial reads and interrupts until the
+        /// end of file. returns the count of bytes read, or `-1` with `errno` set.
+        /// ----------------------------------------------------------------------------------------
+        auto _read_iovs(_iovec* iovs, usize iov_count, u64 offset) const -> isize
+        {
+#if defined(ATOM_PLATFORM_POSIX)
+            i32 fd = get_fd();
+            isize total = 0;
+            while (iov_count > 0)
+            {
+                isize read = ::preadv(fd, iovs, int(iov_count), offset + total);
+                if (read < 0)
+                {
+                    if (errno == EINTR)
+                        continue;
+
+                    return -1;
+                }
+
+                if (read == 0)
+                    break;
+
+                total += read;
+                _advance_iovs(iovs, iov_count, usize(read));
+            }
+
+            return total;
+#else
+            i64 pos = _tell();
+            if (pos < 0 or not _seek(offset))
+                return -1;
+
+            isize total = 0;
+            for (usize i = 0; i < iov_count; i++)
+            {
+                usize read = std::fread(iovs[i].iov_base, sizeof(byte), iovs[i].iov_len, _file);
+                total += isize(read);
+
+                if (read < iovs[i].iov_len)
+                {
+                    if (std::ferror(_file) != 0)
+                        return -1;
+
+                    break;
+                }
+            }
+
+            if (not _seek(u64(pos)))
+                return -1;
+
+            return total;
+#endif
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// writes all of `iovs` at `*offset`, or at the current position if `offset` is null,
+        /// resuming after partial writes and interrupts. `*offset` is advanced past the bytes
+        /// written.
+        /// ----------------------------------------------------------------------------------------
+        auto _write_iovs(_iovec* iovs, usize iov_count, u64* offset) -> bool
+        {
+#if defined(ATOM_PLATFORM_POSIX)
+            i32 fd = get_fd();
+            while (iov_count > 0)
+            {
+                isize written = offset == nullptr
+                                    ? ::writev(fd, iovs, int(iov_count))
+                                    : ::pwritev(fd, iovs, int(iov_count), off_t(*offset));
+                if (written < 0)
+                {
+                    if (errno == EINTR)
+                        continue;
+
+                    return false;
+                }
+
+                if (offset != nullptr)
+                    *offset += usize(written);
+
+                _advance_iovs(iovs, iov_count, usize(written));
+            }
+
+            return true;
+#else
+            i64 pos = -1;
+            if (offset != nullptr)
+            {
+                pos = _tell();
+                if (pos < 0 or not _seek(*offset))
+                    return false;
+            }
+
+            for (usize i = 0; i < iov_count; i++)
+            {
+                usize written =
+                    std::fwrite(iovs[i].iov_base, sizeof(byte), iovs[i].iov_len, _file);
+                if (offset != nullptr)
+                    *offset += written;
+
+                if (written < iovs[i].iov_len)
+                    return false;
+            }
+
+            return offset == nullptr or _seek(u64(pos));
+#endif
+        }
+
+#if !defined(ATOM_PLATFORM_POSIX)
+        /// ----------------------------------------------------------------------------------------
+        /// returns the current position, or `-1` with `errno` set.
+        /// ----------------------------------------------------------------------------------------
+        auto _tell() const -> i64
+        {
+#    if defined(ATOM_PLATFORM_WIN)
+            return ::_ftelli64(_file);
+#    else
+            return std::ftell(_file);
+#    endif
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// moves the current position to `offset`, flushing the buffered writes.
+        /// ----------------------------------------------------------------------------------------
+        auto _seek(u64 offset) const -> bool
+        {
+#    if defined(ATOM_PLATFORM_WIN)
+            return ::_fseeki64(_file, i64(offset), SEEK_SET) == 0;
+#    else
+            return std::fseek(_file, long(offset), SEEK_SET) == 0;
+#    endif
+        }
+#endif
+
+        /// ----------------------------------------------------------------------------------------
+        /// skips `count` bytes transferred from the front of `iovs`.
+        /// ----------------------------------------------------------------------------------------
+        static auto _advance_iovs(_iovec*& iovs, usize& iov_count, usize count) -> void
+        {
+            while (iov_count > 0 and count >= iovs->iov_len)
+            {
+                count -= iovs->iov_len;
+                iovs++;
+                iov_count--;
+            }
+
+            if (iov_count > 0)
+            {
+                iovs->iov_base = static_cast<char*>(iovs->iov_base) + count;
+                iovs->iov_len -= count;
+            }
+        }
+
         /// ----------------------------------------------------------------------------------------
         /// @todo fix clang warning `case value not in enumerated type 'open_flags' [-Wswitch]`
         /// ----------------------------------------------------------------------------------------
@@ -506,6 +899,9 @@ namespace atom::filesystem
             }
         }
 
+    private:
+        static constexpr usize _iov_batch_count = 64;
+
     private:
         FILE* _file;
         open_flags _flags;
@@ -519,7 +915,10 @@ namespace atom::filesystem
         if (result.is_value())
         {
             class file& file = result.get_value();
-            return file.read_str_all();
+            string content = file.read_str_all();
+            file.close();
+
+            return content;
         }
 
         if (result.is_error<noentry_error>())
@@ -540,6 +939,7 @@ namespace atom::filesystem
         {
             class file& file = result.get_value();
             file.write_str(str);
+            file.close();
 
             return { create_from_void };
         }
@@ -563,6 +963,7 @@ namespace atom::filesystem
         {
             class file& file = result.get_value();
             file.write_fmt(fmt, forward<arg_types>(args)...);
+            file.close();
 
             return { create_from_void };
         }
@@ -583,7 +984,10 @@ namespace atom::filesystem
         if (result.is_value())
         {
             class file& file = result.get_value();
-            return file.read_bytes_all();
+            dynamic_buffer content = file.read_bytes_all();
+            file.close();
+
+            return content;
         }
 
         if (result.is_error<noentry_error>())
@@ -604,6 +1008,7 @@ namespace atom::filesystem
         {
             class file& file = result.get_value();
             file.write_bytes(bytes);
+            file.close();
 
             return { create_from_void };
         }
@@ -0,0 +1,415 @@
+module;
+#include "atom/core/preprocessors.h"
+#include <cerrno>
+
+#if defined(ATOM_PLATFORM_POSIX)
+#    include <fcntl.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+#if defined(__linux__)
+#    include <linux/fs.h>
+#    include <sys/ioctl.h>
+#    include <sys/sendfile.h>
+#endif
+
+export module atom_core:filesystem.file_copy;
+
+import std;
+import :core;
+import :contracts;
+import :default_mem_allocator;
+import :strings;
+import :filesystem.file;
+
+export namespace atom::filesystem
+{
+    /// --------------------------------------------------------------------------------------------
+    /// ways `copy_file()` and `copy_range()` may use to copy, tried in this order. copying in
+    /// chunks through a buffer is always allowed, as the last resort, and is the only way used
+    /// on platforms other than linux.
+    /// --------------------------------------------------------------------------------------------
+    enum class copy_methods : byte
+    {
+        none = 0,
+        clone = 1 << 0,     // share the extents with `FICLONE`, only for whole files.
+        kernel = 1 << 1,    // copy in the kernel with `copy_file_range`.
+        send_file = 1 << 2, // copy in the kernel with `sendfile`, only for whole files.
+        all = clone | kernel | send_file,
+    };
+}
+
+#if defined(ATOM_PLATFORM_POSIX)
+namespace atom::filesystem
+{
+    /// --------------------------------------------------------------------------------------------
+    /// copies between file descriptors, trying the fastest way allowed first.
+    ///
+    /// `FICLONE` shares the extents of the whole file on filesystems supporting reflinks, which
+    /// copies no data. `copy_file_range` copies in the kernel, and may also reflink or copy on
+    /// the server for network filesystems. `sendfile` copies in the kernel too, but only to the
+    /// current position. when none of them work, data is copied in chunks through a buffer.
+    /// --------------------------------------------------------------------------------------------
+    class _file_copy_impl
+    {
+    public:
+        static constexpr usize chunk_size = 1024 * 1024;
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// copies `count` bytes or until the end of `in_fd`, returns the count of bytes copied or
+        /// `-1` with `errno` set.
+        /// ----------------------------------------------------------------------------------------
+        static auto copy_range(i32 in_fd, u64 in_offset, i32 out_fd, u64 out_offset, usize count,
+            copy_methods methods) -> isize
+        {
+            usize total = 0;
+            isize ret = _unsupported;
+#    if defined(__linux__)
+            if (enums::has_all_flags(methods, copy_methods::kernel))
+                ret = _copy_kernel(in_fd, in_offset, out_fd, out_offset, count, total);
+#    endif
+
+            if (ret == _unsupported)
+                ret = _copy_chunks(in_fd, in_offset + total, out_fd, out_offset + total,
+                    count - total, total);
+
+            return ret < 0 ? -1 : isize(total);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// copies all of `in_fd` to the start of the empty file `out_fd`.
+        /// ----------------------------------------------------------------------------------------
+        static auto copy_all(i32 in_fd, i32 out_fd, usize size, copy_methods methods) -> isize
+        {
+            usize total = 0;
+            isize ret = _unsupported;
+#    if defined(__linux__)
+            if (enums::has_all_flags(methods, copy_methods::clone) and size > 0
+                and ::ioctl(out_fd, FICLONE, in_fd) == 0)
+                return isize(size);
+
+            if (enums::has_all_flags(methods, copy_methods::kernel))
+                ret = _copy_kernel(in_fd, 0, out_fd, 0, size, total);
+
+            if (ret == _unsupported and enums::has_all_flags(methods, copy_methods::send_file))
+                ret = _send_file(in_fd, out_fd, size, total);
+#    endif
+
+            if (ret == _unsupported)
+                ret = _copy_chunks(in_fd, total, out_fd, total, size - total, total);
+
+            if (ret < 0)
+                return -1;
+
+            // the file may have grown while copying, or not report its size, like in procfs. probe
+            // for more with a single byte, so a buffer is allocated only if there is more.
+            if (total == size)
+            {
+                isize more = _has_more(in_fd, total);
+                if (more < 0)
+                    return -1;
+
+                usize rest = 0;
+                if (more > 0 and _copy_chunks(in_fd, total, out_fd, total, _max_count, rest) < 0)
+                    return -1;
+
+                total += rest;
+            }
+
+            return isize(total);
+        }
+
+    private:
+        static constexpr isize _unsupported = -2;
+        static constexpr usize _max_count = std::numeric_limits<isize>::max();
+
+#    if defined(__linux__)
+        static auto _is_unsupported(i32 err) -> bool
+        {
+            return err == ENOSYS or err == EXDEV or err == EINVAL or err == EOPNOTSUPP
+                   or err == ENOTSUP;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// copies with `copy_file_range`, adding the count of bytes copied to `total`. returns
+        /// `_unsupported` if it can't be used for these files, before copying anything.
+        ///
+        /// special files, like in sysfs, may report a size but copy nothing, so copying nothing
+        /// at first is also handled as unsupported.
+        /// ----------------------------------------------------------------------------------------
+        static auto _copy_kernel(i32 in_fd, u64 in_offset, i32 out_fd, u64 out_offset,
+            usize count, usize& total) -> isize
+        {
+            loff_t in_off = loff_t(in_offset);
+            loff_t out_off = loff_t(out_offset);
+            usize copied = 0;
+
+            while (copied < count)
+            {
+                usize request = std::min(count - copied, usize(1) << 30);
+                isize ret = ::copy_file_range(in_fd, &in_off, out_fd, &out_off, request, 0);
+                if (ret < 0)
+                {
+                    if (errno == EINTR)
+                        continue;
+
+                    if (copied == 0 and _is_unsupported(errno))
+                        return _unsupported;
+
+                    return -1;
+                }
+
+                if (ret == 0)
+                {
+                    if (copied == 0)
+                        return _unsupported;
+
+                    break;
+                }
+
+                copied += usize(ret);
+                total += usize(ret);
+            }
+
+            return 0;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// copies with `sendfile` to the current position of `out_fd`, which must be at `total`.
+        /// copying nothing at first is handled as unsupported, like for `_copy_kernel()`.
+        /// ----------------------------------------------------------------------------------------
+        static auto _send_file(i32 in_fd, i32 out_fd, usize count, usize& total) -> isize
+        {
+            off_t in_off = off_t(total);
+            usize copied = total;
+
+            if (::lseek(out_fd, off_t(total), SEEK_SET) < 0)
+                return _unsupported;
+
+            while (copied < count)
+            {
+                usize request = std::min(count - copied, usize(1) << 30);
+                isize ret = ::sendfile(out_fd, in_fd, &in_off, request);
+                if (ret < 0)
+                {
+                    if (errno == EINTR)
+                        continue;
+
+                    if (copied == total and _is_unsupported(errno))
+                        return _unsupported;
+
+                    return -1;
+                }
+
+                if (ret == 0)
+                {
+                    if (copied == total)
+                        return _unsupported;
+
+                    break;
+                }
+
+                copied += usize(ret);
+            }
+
+            total = copied;
+            return 0;
+        }
+#    endif
+
+        /// ----------------------------------------------------------------------------------------
+        /// returns `1` if `in_fd` has data at `offset`, `0` if not, or `-1` with `errno` set.
+        /// ----------------------------------------------------------------------------------------
+        static auto _has_more(i32 in_fd, u64 offset) -> isize
+        {
+            char probe;
+            while (true)
+            {
+                isize read = ::pread(in_fd, &probe, 1, offset);
+                if (read >= 0 or errno != EINTR)
+                    return read;
+            }
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// copies through a buffer with `pread` and `pwrite`.
+        /// ----------------------------------------------------------------------------------------
+        static auto _copy_chunks(i32 in_fd, u64 in_offset, i32 out_fd, u64 out_offset,
+            usize count, usize& total) -> isize
+        {
+            default_mem_allocator allocator;
+            usize buffer_size = std::min(count, chunk_size);
+            if (buffer_size == 0)
+                return 0;
+
+            char* buffer = static_cast<char*>(allocator.alloc(buffer_size));
+            contract_asserts(buffer != nullptr, "out of memory.");
+
+            usize copied = 0;
+            isize status = 0;
+
+            while (copied < count)
+            {
+                isize read = ::pread(
+                    in_fd, buffer, std::min(count - copied, buffer_size), in_offset + copied);
+                if (read < 0)
+                {
+                    if (errno == EINTR)
+                        continue;
+
+                    status = -1;
+                    break;
+                }
+
+                if (read == 0)
+                    break;
+
+                for (isize written = 0; written < read;)
+                {
+                    isize ret = ::pwrite(out_fd, buffer + written, usize(read - written),
+                        out_offset + copied + written);
+                    if (ret < 0)
+                    {
+                        if (errno == EINTR)
+                            continue;
+
+                        status = -1;
+                        break;
+                    }
+
+                    written += ret;
+                }
+
+                if (status < 0)
+                    break;
+
+                copied += usize(read);
+                total += usize(read);
+            }
+
+            allocator.dealloc(buffer);
+            return status;
+        }
+    };
+}
+#endif
+
+export namespace atom::filesystem
+{
+    /// --------------------------------------------------------------------------------------------
+    /// copies `count` bytes at `from_offset` in `from` to `to_offset` in `to`, or less if `from`
+    /// ends before. returns the count of bytes copied.
+    ///
+    /// the data is copied in the kernel with `copy_file_range` when the files allow it, else in
+    /// chunks through a buffer. it goes through the file descriptors, so `flush()` both files
+    /// before, and the current positions are not used or moved. fails with `ENOSYS` on platforms
+    /// other than posix.
+    ///
+    /// `methods` restricts the ways tried before copying through a buffer, see `copy_methods`.
+    /// --------------------------------------------------------------------------------------------
+    auto copy_range(const file& from, u64 from_offset, file& to, u64 to_offset, usize count,
+        copy_methods methods = copy_methods::all) -> result<usize, filesystem_error>
+    {
+#if defined(ATOM_PLATFORM_POSIX)
+        isize ret = _file_copy_impl::copy_range(
+            from.get_fd(), from_offset, to.get_fd(), to_offset, count, methods);
+        if (ret < 0)
+            return filesystem_error{ errno };
+
+        return usize(ret);
+#else
+        return filesystem_error{ ENOSYS };
+#endif
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// copies the file at `from_path` to `to_path`, replacing it if it exists, with the same
+    /// permissions. returns the count of bytes copied, or `invalid_options_error` if both paths
+    /// refer to the same file.
+    ///
+    /// the file is cloned with `FICLONE` on filesystems supporting reflinks, so no data is
+    /// copied. else it's copied in the kernel with `copy_file_range` or `sendfile`, and only if
+    /// none of them work in chunks through a buffer. `methods` restricts the ways tried, see
+    /// `copy_methods`. fails with `ENOSYS` on platforms other than posix.
+    /// --------------------------------------------------------------------------------------------
+    auto copy_file(string_view from_path, string_view to_path,
+        copy_methods methods = copy_methods::all)
+        -> result<usize, filesystem_error, noentry_error, invalid_options_error>
+    {
+#if defined(ATOM_PLATFORM_POSIX)
+        i32 in_fd = ::open(from_path.get_data(), O_RDONLY | O_CLOEXEC);
+        if (in_fd < 0)
+        {
+            if (errno == ENOENT)
+                return noentry_error{ from_path };
+
+            return filesystem_error{ errno };
+        }
+
+        struct stat info;
+        if (::fstat(in_fd, &info) != 0)
+        {
+            i32 err = errno;
+            ::close(in_fd);
+            return filesystem_error{ err };
+        }
+
+        // not truncated yet, `to_path` may be `from_path` or a link to it.
+        i32 out_fd =
+            ::open(to_path.get_data(), O_WRONLY | O_CREAT | O_CLOEXEC, info.st_mode & 07777);
+        if (out_fd < 0)
+        {
+            i32 err = errno;
+            ::close(in_fd);
+
+            if (err == ENOENT)
+                return noentry_error{ to_path };
+
+            return filesystem_error{ err };
+        }
+
+        struct stat out_info;
+        if (::fstat(out_fd, &out_info) != 0)
+        {
+            i32 err = errno;
+            ::close(in_fd);
+            ::close(out_fd);
+            return filesystem_error{ err };
+        }
+
+        if (out_info.st_dev == info.st_dev and out_info.st_ino == info.st_ino)
+        {
+            ::close(in_fd);
+            ::close(out_fd);
+            return invalid_options_error{ "source and destination are the same file." };
+        }
+
+        if (::ftruncate(out_fd, 0) != 0)
+        {
+            i32 err = errno;
+            ::close(in_fd);
+            ::close(out_fd);
+            return filesystem_error{ err };
+        }
+
+        isize ret = _file_copy_impl::copy_all(in_fd, out_fd, usize(info.st_size), methods);
+        i32 err = errno;
+
+        ::close(in_fd);
+        if (::close(out_fd) != 0 and ret >= 0)
+        {
+            ret = -1;
+            err = errno;
+        }
+
+        if (ret < 0)
+            return filesystem_error{ err };
+
+        return usize(ret);
+#else
+        return filesystem_error{ ENOSYS };
+#endif
+    }
+}
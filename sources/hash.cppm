@@ -22,4 +22,13 @@ namespace std
             return hash<std::string_view>()(str);
         }
     };
+
+    export template <>
+    struct hash<atom::symbol>
+    {
+        auto operator()(const atom::symbol& sym) const -> std::size_t
+        {
+            return sym.get_hash();
+        }
+    };
 }
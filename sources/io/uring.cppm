@@ -0,0 +1,781 @@
+module;
+#include "atom/core/preprocessors.h"
+#include <cerrno>
+#include <cstring>
+
+#if defined(ATOM_PLATFORM_POSIX)
+#    include <sys/uio.h>
+#    include <unistd.h>
+#elif defined(ATOM_PLATFORM_WIN)
+#    include <io.h>
+#    include <stdio.h>
+#endif
+
+#if defined(__linux__)
+#    include <linux/io_uring.h>
+#    include <sys/mman.h>
+#    include <sys/syscall.h>
+#endif
+
+export module atom_core:io.uring;
+
+import std;
+import :core;
+import :contracts;
+import :containers;
+import :function_box;
+import :dynamic_buffer;
+import :filesystem;
+
+namespace atom::io
+{
+    /// --------------------------------------------------------------------------------------------
+    /// identifies an operation queued without a callback, pass it to `uring::wait()` to get its
+    /// result.
+    /// --------------------------------------------------------------------------------------------
+    export class uring_ticket
+    {
+    public:
+        u32 slot;
+        u32 generation;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// state of an operation in flight.
+    /// --------------------------------------------------------------------------------------------
+    class _uring_slot
+    {
+    public:
+        function_box<void(i64)> callback;
+        i64 result = 0;
+        u32 generation = 0;
+        bool is_done = false;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// kind of an operation queued.
+    /// --------------------------------------------------------------------------------------------
+    enum class _uring_op : u8
+    {
+        read,
+        write,
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// asynchronous file io engine using linux io_uring.
+    ///
+    /// reads and writes at offsets are queued into the submission ring, and passed to the kernel
+    /// in batches by `submit()`, `poll()` or `wait()`, one syscall for the whole batch. each
+    /// operation completes with the count of bytes transferred or `-errno`, which is passed to
+    /// its callback or returned by `wait()` for its ticket. callbacks run on the thread calling
+    /// `poll()`, `wait()` or `wait_all()`, and may queue more operations.
+    ///
+    /// files and buffers registered with `register_files()` and `register_buffers()` are used
+    /// automatically when an operation uses them, which saves the kernel from looking up the file
+    /// and mapping the pages on each operation. with `options::use_polling` a kernel thread polls
+    /// the submission ring, so submitting takes no syscall while it is busy.
+    ///
+    /// when io_uring is not available, because of the platform, the kernel or a sandbox,
+    /// operations run with blocking `pread()` and `pwrite()` when queued, and complete on the next
+    /// `poll()` or `wait()`. on windows they seek and read or write instead, and on other
+    /// platforms they complete with `-ENOSYS`. `is_async()` tells which one is used.
+    ///
+    /// not thread safe, use one per thread.
+    /// --------------------------------------------------------------------------------------------
+    export class uring
+    {
+        using this_type = uring;
+
+    public:
+        using callback_type = function_box<void(i64)>;
+        using register_result = result<void, filesystem::system_error>;
+        using submit_result = result<void, filesystem::system_error>;
+
+        /// ----------------------------------------------------------------------------------------
+        /// options to setup the ring.
+        /// ----------------------------------------------------------------------------------------
+        class options
+        {
+        public:
+            /// count of entries in the submission ring, rounded up to power of 2 by the kernel.
+            u32 entry_count = 256;
+
+            /// use a kernel thread to poll the submission ring.
+            bool use_polling = false;
+
+            /// milliseconds after which the polling thread sleeps when idle.
+            u32 polling_idle_ms = 1000;
+
+            /// use blocking `pread()` and `pwrite()` even if io_uring is available.
+            bool use_fallback = false;
+        };
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// # default constructor
+        /// ----------------------------------------------------------------------------------------
+        uring()
+            : uring{ options{} }
+        {}
+
+        /// ----------------------------------------------------------------------------------------
+        /// sets up the ring with `opts`, falling back to blocking io if that fails. if polling is
+        /// not permitted, sets up the ring without it.
+        /// ----------------------------------------------------------------------------------------
+        explicit uring(const options& opts)
+        {
+            contract_expects(opts.entry_count > 0, "entry count is 0.");
+
+            _slot_count = opts.entry_count;
+
+#if defined(__linux__)
+            if (not opts.use_fallback)
+            {
+                if (opts.use_polling)
+                    _setup(opts.entry_count, IORING_SETUP_SQPOLL, opts.polling_idle_ms);
+
+                if (_ring_fd < 0)
+                    _setup(opts.entry_count, 0, 0);
+            }
+
+            // the completion ring is twice the submission ring, so it's enough for one slot per
+            // completion entry.
+            if (_ring_fd >= 0)
+                _slot_count = *_cq_mask + 1;
+#endif
+
+            _slots = dynamic_array<_uring_slot>(create_with_count, _slot_count);
+            _free_slots.reserve(_slot_count);
+            for (u32 i = _slot_count; i > 0; i--)
+                _free_slots.emplace_last(i - 1);
+        }
+
+        uring(const this_type&) = delete;
+        uring& operator=(const this_type&) = delete;
+
+        /// ----------------------------------------------------------------------------------------
+        /// # destructor
+        ///
+        /// waits for all operations in flight, as the kernel may still be using their buffers.
+        /// ----------------------------------------------------------------------------------------
+        ~uring()
+        {
+            wait_all();
+
+#if defined(__linux__)
+            if (_ring_fd >= 0)
+            {
+                ::munmap(_sqes, _sqes_size);
+                if (_cq_ptr != _sq_ptr)
+                    ::munmap(_cq_ptr, _cq_size);
+
+                ::munmap(_sq_ptr, _sq_size);
+                ::close(_ring_fd);
+            }
+#endif
+        }
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// returns `true` if io_uring is used, `false` if blocking io is used instead.
+        /// ----------------------------------------------------------------------------------------
+        auto is_async() const -> bool
+        {
+            return _ring_fd >= 0;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// returns `true` if a kernel thread polls the submission ring.
+        /// ----------------------------------------------------------------------------------------
+        auto is_polling() const -> bool
+        {
+            return _is_polling;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// returns the count of operations queued or in flight.
+        /// ----------------------------------------------------------------------------------------
+        auto get_pending_count() const -> usize
+        {
+            return _slot_count - _free_slots.get_count();
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// registers `fds` with the kernel. later operations on these fds use the registered
+        /// files. can be called once.
+        /// ----------------------------------------------------------------------------------------
+        auto register_files(array_view<i32> fds) -> register_result
+        {
+            contract_expects(_file_indices.is_empty(), "files are already registered.");
+
+#if defined(__linux__)
+            if (is_async())
+            {
+                i32 ret = _register(IORING_REGISTER_FILES, fds.get_data(), fds.get_count());
+                if (ret < 0)
+                    return filesystem::system_error{ errno };
+            }
+#endif
+
+            for (usize i = 0; i < fds.get_count(); i++)
+            {
+                i32 fd = fds[i];
+                contract_expects(fd >= 0, "invalid file descriptor.");
+
+                while (_file_indices.get_count() <= usize(fd))
+                    _file_indices.emplace_last(-1);
+
+                _file_indices.get_data()[fd] = i32(i);
+            }
+
+            return { create_from_void };
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// registers `buffers` with the kernel, which pins their pages. later operations on
+        /// memory inside these buffers use the registered buffers. can be called once.
+        /// ----------------------------------------------------------------------------------------
+        auto register_buffers(array_view<mut_memory_view> buffers) -> register_result
+        {
+            contract_expects(_buffers.is_empty(), "buffers are already registered.");
+
+#if defined(__linux__)
+            if (is_async())
+            {
+                dynamic_array<iovec> iovs;
+                iovs.reserve(buffers.get_count());
+                for (usize i = 0; i < buffers.get_count(); i++)
+                    iovs.emplace_last(iovec{ buffers[i].get_data(), buffers[i].get_size() });
+
+                i32 ret = _register(IORING_REGISTER_BUFFERS, iovs.get_data(), iovs.get_count());
+                if (ret < 0)
+                    return filesystem::system_error{ errno };
+            }
+#endif
+
+            _buffers.insert_range_last(buffers);
+            return { create_from_void };
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// queues a read of `buf.get_size()` bytes from `fd` at `offset` into `buf`, and calls
+        /// `callback` with the result when it completes. `buf` must stay valid until then.
+        /// ----------------------------------------------------------------------------------------
+        auto read_at(i32 fd, u64 offset, mut_memory_view buf, callback_type callback) -> void
+        {
+            u32 slot = _queue(_uring_op::read, fd, offset, buf.get_data(), buf.get_size());
+            _slots.get_at(slot).callback = move(callback);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// queues a read of `buf.get_size()` bytes from `fd` at `offset` into `buf`. returns the
+        /// ticket to wait for its result.
+        /// ----------------------------------------------------------------------------------------
+        auto read_at(i32 fd, u64 offset, mut_memory_view buf) -> uring_ticket
+        {
+            u32 slot = _queue(_uring_op::read, fd, offset, buf.get_data(), buf.get_size());
+            return uring_ticket{ slot, _slots.get_at(slot).generation };
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// queues a write of `buf` to `fd` at `offset`, and calls `callback` with the result when
+        /// it completes. `buf` must stay valid until then.
+        /// ----------------------------------------------------------------------------------------
+        auto write_at(i32 fd, u64 offset, memory_view buf, callback_type callback) -> void
+        {
+            u32 slot = _queue(_uring_op::write, fd, offset, const_cast<byte*>(buf.get_data()),
+                buf.get_size());
+            _slots.get_at(slot).callback = move(callback);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// queues a write of `buf` to `fd` at `offset`. returns the ticket to wait for its result.
+        /// ----------------------------------------------------------------------------------------
+        auto write_at(i32 fd, u64 offset, memory_view buf) -> uring_ticket
+        {
+            u32 slot = _queue(_uring_op::write, fd, offset, const_cast<byte*>(buf.get_data()),
+                buf.get_size());
+            return uring_ticket{ slot, _slots.get_at(slot).generation };
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// passes queued operations to the kernel, without waiting for them.
+        ///
+        /// if the kernel refuses them, they complete with `-errno` on the next `poll()` or
+        /// `wait()`, and the error is returned.
+        /// ----------------------------------------------------------------------------------------
+        auto submit() -> submit_result
+        {
+#if defined(__linux__)
+            if (not is_async() or _queued_count == 0)
+                return { create_from_void };
+
+            std::atomic_ref<u32>(*_sq_tail).store(_sq_tail_local, std::memory_order_release);
+
+            if (_is_polling)
+            {
+                // the polling thread picks them up by itself, unless it went to sleep.
+                _in_flight_count += _queued_count;
+                _queued_count = 0;
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                u32 flags = std::atomic_ref<u32>(*_sq_flags).load(std::memory_order_relaxed);
+                if ((flags & IORING_SQ_NEED_WAKEUP) != 0
+                    and _enter(0, 0, IORING_ENTER_SQ_WAKEUP) < 0)
+                    return filesystem::system_error{ errno };
+
+                return { create_from_void };
+            }
+
+            while (_queued_count > 0)
+            {
+                i32 ret = _enter(_queued_count, 0, 0);
+                if (ret >= 0)
+                {
+                    _queued_count -= u32(ret);
+                    _in_flight_count += u32(ret);
+                    continue;
+                }
+
+                i32 err = errno;
+                if (err == EINTR)
+                    continue;
+
+                // the completion ring is full or the kernel is out of resources, wait for
+                // operations in flight to complete and retry.
+                if (err == EBUSY or err == EAGAIN)
+                {
+                    if (_reap() > 0)
+                        continue;
+
+                    if (_wait_completion())
+                        continue;
+                }
+
+                _fail_queued(err);
+                return filesystem::system_error{ err };
+            }
+#endif
+
+            return { create_from_void };
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// submits queued operations and completes finished ones, without blocking. returns the
+        /// count of operations completed.
+        /// ----------------------------------------------------------------------------------------
+        auto poll() -> usize
+        {
+            submit();
+            return _reap();
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// blocks until the operation of `ticket` completes and returns its result, the count of
+        /// bytes transferred or `-errno`. callbacks of other operations completing meanwhile are
+        /// called, and operations they queue are submitted.
+        ///
+        /// \pre waiting for completions doesn't fail.
+        /// ----------------------------------------------------------------------------------------
+        auto wait(uring_ticket ticket) -> i64
+        {
+            contract_expects(ticket.slot < _slot_count, "invalid ticket.");
+
+            _uring_slot& slot = _slots.get_at(ticket.slot);
+            contract_expects(slot.generation == ticket.generation, "ticket is already waited.");
+
+            while (not slot.is_done)
+            {
+                // callbacks may have queued more operations.
+                submit();
+                if (_reap() > 0 or slot.is_done)
+                    continue;
+
+                bool is_waited = _wait_completion();
+                contract_asserts(is_waited, "waiting for completions failed.");
+            }
+
+            i64 res = slot.result;
+            _free_slot(ticket.slot);
+            return res;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// blocks until all operations with callbacks complete, including the ones queued by
+        /// callbacks meanwhile. operations with tickets still need to be waited.
+        ///
+        /// returns early if waiting for completions fails.
+        /// ----------------------------------------------------------------------------------------
+        auto wait_all() -> void
+        {
+            while (get_pending_count() > _done_ticket_count)
+            {
+                // callbacks may have queued more operations.
+                submit();
+                if (_reap() > 0 or get_pending_count() == _done_ticket_count)
+                    continue;
+
+                if (not _wait_completion())
+                    return;
+            }
+        }
+
+    private:
+#if defined(__linux__)
+        auto _setup(u32 entry_count, u32 flags, u32 idle_ms) -> void
+        {
+            io_uring_params params;
+            std::memset(&params, 0, sizeof(params));
+            params.flags = flags;
+            params.sq_thread_idle = idle_ms;
+
+            i32 fd = i32(::syscall(__NR_io_uring_setup, entry_count, &params));
+            if (fd < 0)
+                return;
+
+            _sq_size = params.sq_off.array + params.sq_entries * sizeof(u32);
+            _cq_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+            _sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+
+            bool is_single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+            if (is_single_mmap)
+                _sq_size = _cq_size = std::max(_sq_size, _cq_size);
+
+            _sq_ptr = _mmap(fd, _sq_size, IORING_OFF_SQ_RING);
+            _cq_ptr = is_single_mmap ? _sq_ptr : _mmap(fd, _cq_size, IORING_OFF_CQ_RING);
+            _sqes = static_cast<io_uring_sqe*>(_mmap(fd, _sqes_size, IORING_OFF_SQES));
+
+            if (_sq_ptr == nullptr or _cq_ptr == nullptr or _sqes == nullptr)
+            {
+                if (_sqes != nullptr)
+                    ::munmap(_sqes, _sqes_size);
+
+                if (_cq_ptr != nullptr and _cq_ptr != _sq_ptr)
+                    ::munmap(_cq_ptr, _cq_size);
+
+                if (_sq_ptr != nullptr)
+                    ::munmap(_sq_ptr, _sq_size);
+
+                ::close(fd);
+                _sq_ptr = _cq_ptr = nullptr;
+                _sqes = nullptr;
+                return;
+            }
+
+            char* sq = static_cast<char*>(_sq_ptr);
+            _sq_head = reinterpret_cast<u32*>(sq + params.sq_off.head);
+            _sq_tail = reinterpret_cast<u32*>(sq + params.sq_off.tail);
+            _sq_mask = reinterpret_cast<u32*>(sq + params.sq_off.ring_mask);
+            _sq_flags = reinterpret_cast<u32*>(sq + params.sq_off.flags);
+            _sq_array = reinterpret_cast<u32*>(sq + params.sq_off.array);
+            _sq_entry_count = params.sq_entries;
+            _sq_tail_local = *_sq_tail;
+
+            char* cq = static_cast<char*>(_cq_ptr);
+            _cq_head = reinterpret_cast<u32*>(cq + params.cq_off.head);
+            _cq_tail = reinterpret_cast<u32*>(cq + params.cq_off.tail);
+            _cq_mask = reinterpret_cast<u32*>(cq + params.cq_off.ring_mask);
+            _cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+
+            _ring_fd = fd;
+            _is_polling = flags & IORING_SETUP_SQPOLL;
+        }
+
+        static auto _mmap(i32 fd, usize size, u64 offset) -> void*
+        {
+            void* ptr = ::mmap(
+                nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, offset);
+            return ptr == MAP_FAILED ? nullptr : ptr;
+        }
+
+        auto _enter(u32 submit_count, u32 min_complete, u32 flags) -> i32
+        {
+            return i32(::syscall(
+                __NR_io_uring_enter, _ring_fd, submit_count, min_complete, flags, nullptr, 0));
+        }
+
+        auto _register(u32 opcode, const void* args, usize count) -> i32
+        {
+            return i32(::syscall(__NR_io_uring_register, _ring_fd, opcode, args, u32(count)));
+        }
+
+        auto _get_sqe() -> io_uring_sqe*
+        {
+            std::atomic_ref<u32> sq_head{ *_sq_head };
+            while (_sq_tail_local - sq_head.load(std::memory_order_acquire) >= _sq_entry_count)
+            {
+                // a failed submit leaves the ring empty.
+                submit();
+
+                // the polling thread is still consuming the ring.
+                if (_is_polling)
+                    _enter(0, 0, IORING_ENTER_SQ_WAIT);
+            }
+
+            u32 index = _sq_tail_local & *_sq_mask;
+            _sq_array[index] = index;
+            _sq_tail_local++;
+            _queued_count++;
+            return &_sqes[index];
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// takes back the operations the kernel refused from the submission ring, they complete
+        /// with `-err` on the next reap.
+        /// ----------------------------------------------------------------------------------------
+        auto _fail_queued(i32 err) -> void
+        {
+            for (u32 i = _sq_tail_local - _queued_count; i != _sq_tail_local; i++)
+            {
+                u32 slot = u32(_sqes[i & *_sq_mask].user_data);
+                _slots.get_at(slot).result = -err;
+                _completed_early.emplace_last(slot);
+            }
+
+            _sq_tail_local -= _queued_count;
+            _queued_count = 0;
+            std::atomic_ref<u32>(*_sq_tail).store(_sq_tail_local, std::memory_order_release);
+        }
+#endif
+
+        /// ----------------------------------------------------------------------------------------
+        /// blocks until an operation in flight completes. returns `false` if no operation is in
+        /// flight or waiting failed.
+        /// ----------------------------------------------------------------------------------------
+        auto _wait_completion() -> bool
+        {
+#if defined(__linux__)
+            if (not is_async() or _in_flight_count == 0)
+                return false;
+
+            while (_enter(0, 1, IORING_ENTER_GETEVENTS) < 0)
+            {
+                if (errno != EINTR)
+                    return false;
+            }
+
+            return true;
+#else
+            return false;
+#endif
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// takes a slot and puts the operation in the submission ring, or runs it right away for
+        /// blocking io.
+        /// ----------------------------------------------------------------------------------------
+        auto _queue(_uring_op op, i32 fd, u64 offset, byte* data, usize size) -> u32
+        {
+            contract_expects(size <= std::numeric_limits<u32>::max(), "buffer is too large.");
+
+            u32 slot = _alloc_slot();
+
+            if (not is_async())
+            {
+                _completed_early.emplace_last(slot);
+                _slots.get_at(slot).result = _run_blocking(op, fd, offset, data, size);
+                return slot;
+            }
+
+#if defined(__linux__)
+            io_uring_sqe* sqe = _get_sqe();
+            std::memset(sqe, 0, sizeof(io_uring_sqe));
+            sqe->opcode = op == _uring_op::read ? IORING_OP_READ : IORING_OP_WRITE;
+            sqe->fd = fd;
+            sqe->off = offset;
+            sqe->addr = u64(data);
+            sqe->len = u32(size);
+            sqe->user_data = slot;
+
+            if (usize(fd) < _file_indices.get_count() and _file_indices.get_at(fd) >= 0)
+            {
+                sqe->fd = _file_indices.get_at(fd);
+                sqe->flags |= IOSQE_FIXED_FILE;
+            }
+
+            i32 buf_index = _find_buffer(data, size);
+            if (buf_index >= 0)
+            {
+                sqe->opcode = op == _uring_op::read ? IORING_OP_READ_FIXED : IORING_OP_WRITE_FIXED;
+                sqe->buf_index = u16(buf_index);
+            }
+#endif
+
+            return slot;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// runs the operation with blocking io, returns its result.
+        /// ----------------------------------------------------------------------------------------
+        static auto _run_blocking(_uring_op op, i32 fd, u64 offset, byte* data, usize size) -> i64
+        {
+#if defined(ATOM_PLATFORM_POSIX)
+            isize ret = op == _uring_op::read ? ::pread(fd, data, size, offset)
+                                              : ::pwrite(fd, data, size, offset);
+            return ret < 0 ? -errno : ret;
+#elif defined(ATOM_PLATFORM_WIN)
+            if (::_lseeki64(fd, i64(offset), SEEK_SET) < 0)
+                return -errno;
+
+            i32 ret = op == _uring_op::read ? ::_read(fd, data, u32(size))
+                                            : ::_write(fd, data, u32(size));
+            return ret < 0 ? -errno : ret;
+#else
+            return -ENOSYS;
+#endif
+        }
+
+        auto _find_buffer(const byte* data, usize size) const -> i32
+        {
+            for (usize i = 0; i < _buffers.get_count(); i++)
+            {
+                const mut_memory_view& buf = _buffers.get_at(i);
+                if (data >= buf.get_data() and data + size <= buf.get_data() + buf.get_size())
+                    return i32(i);
+            }
+
+            return -1;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// completes all finished operations, returns their count.
+        /// ----------------------------------------------------------------------------------------
+        auto _reap() -> usize
+        {
+            usize count = 0;
+
+            if (not _completed_early.is_empty())
+            {
+                // callbacks may queue more, which complete on the next call.
+                dynamic_array<u32> done = move(_completed_early);
+                _completed_early = dynamic_array<u32>();
+                for (usize i = 0; i < done.get_count(); i++)
+                {
+                    u32 slot = done.get_at(i);
+                    _complete(slot, _slots.get_at(slot).result);
+                }
+
+                count += done.get_count();
+            }
+
+#if defined(__linux__)
+            if (not is_async())
+                return count;
+
+            std::atomic_ref<u32> cq_head{ *_cq_head };
+            std::atomic_ref<u32> cq_tail{ *_cq_tail };
+            while (true)
+            {
+                // advance the head before completing, so callbacks can reap too.
+                u32 head = cq_head.load(std::memory_order_relaxed);
+                if (head == cq_tail.load(std::memory_order_acquire))
+                    break;
+
+                const io_uring_cqe& cqe = _cqes[head & *_cq_mask];
+                u32 slot = u32(cqe.user_data);
+                i64 res = cqe.res;
+                cq_head.store(head + 1, std::memory_order_release);
+                _in_flight_count--;
+
+                _complete(slot, res);
+                count++;
+            }
+#endif
+
+            return count;
+        }
+
+        auto _complete(u32 index, i64 res) -> void
+        {
+            _uring_slot& slot = _slots.get_at(index);
+            if (slot.callback.has())
+            {
+                callback_type callback = move(slot.callback);
+                slot.callback = nullptr;
+                _free_slot(index);
+                callback.invoke(move(res));
+                return;
+            }
+
+            slot.result = res;
+            slot.is_done = true;
+            _done_ticket_count++;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// takes a free slot, completing operations until one is free.
+        /// ----------------------------------------------------------------------------------------
+        auto _alloc_slot() -> u32
+        {
+            while (_free_slots.is_empty())
+            {
+                contract_asserts(get_pending_count() > _done_ticket_count,
+                    "all slots are used by tickets not waited.");
+
+                submit();
+                if (_reap() > 0 or not _free_slots.is_empty())
+                    continue;
+
+                bool is_waited = _wait_completion();
+                contract_asserts(is_waited, "waiting for completions failed.");
+            }
+
+            u32 slot = _free_slots.get_at(_free_slots.get_count() - 1);
+            _free_slots.remove_last();
+            return slot;
+        }
+
+        auto _free_slot(u32 index) -> void
+        {
+            _uring_slot& slot = _slots.get_at(index);
+            if (slot.is_done)
+                _done_ticket_count--;
+
+            slot.is_done = false;
+            slot.generation++;
+            _free_slots.emplace_last(index);
+        }
+
+    private:
+        i32 _ring_fd = -1;
+        bool _is_polling = false;
+
+#if defined(__linux__)
+        u32 _queued_count = 0;
+
+        void* _sq_ptr = nullptr;
+        usize _sq_size = 0;
+        u32* _sq_head = nullptr;
+        u32* _sq_tail = nullptr;
+        u32* _sq_mask = nullptr;
+        u32* _sq_flags = nullptr;
+        u32* _sq_array = nullptr;
+        u32 _sq_entry_count = 0;
+        u32 _sq_tail_local = 0;
+
+        /// count of operations passed to the kernel and not completed yet.
+        u32 _in_flight_count = 0;
+
+        void* _cq_ptr = nullptr;
+        usize _cq_size = 0;
+        u32* _cq_head = nullptr;
+        u32* _cq_tail = nullptr;
+        u32* _cq_mask = nullptr;
+        io_uring_cqe* _cqes = nullptr;
+
+        io_uring_sqe* _sqes = nullptr;
+        usize _sqes_size = 0;
+#endif
+
+        dynamic_array<_uring_slot> _slots;
+        u32 _slot_count = 0;
+        usize _done_ticket_count = 0;
+        dynamic_array<u32> _free_slots;
+
+        /// operations completed without the ring, by blocking io or because submitting them
+        /// failed, waiting for the next reap.
+        dynamic_array<u32> _completed_early;
+
+        dynamic_array<i32> _file_indices;
+        dynamic_array<mut_memory_view> _buffers;
+    };
+}
@@ -0,0 +1,1267 @@
+module;
+#include "atom/core/preprocessors.h"
+
+#if defined(ATOM_PLATFORM_POSIX)
+#    include <signal.h>
+#    include <unistd.h>
+#endif
+
+export module atom_core:log;
+
+import std;
+import :core;
+import :contracts;
+import :strings;
+import :mutex;
+import :lock_guard;
+import :default_mem_allocator;
+import :filesystem;
+import :io;
+import :time;
+
+/// ------------------------------------------------------------------------------------------------
+/// asynchronous logging.
+///
+/// logging a message doesn't format or write anything on the calling thread. the format string
+/// and the args are copied into the thread's own single producer single consumer ring buffer,
+/// which costs a few stores and never takes a lock. a background writer thread drains every
+/// thread's buffer, formats the messages and writes them in batches with vectored writes.
+///
+/// levels below `min_level` are removed at compile time. use the macros in `atom/core/log.h` to
+/// also skip evaluating the args of disabled levels.
+/// ------------------------------------------------------------------------------------------------
+namespace atom::log
+{
+    /// --------------------------------------------------------------------------------------------
+    /// severity of a message.
+    /// --------------------------------------------------------------------------------------------
+    export enum class level : u8
+    {
+        trace,
+        debug,
+        info,
+        warn,
+        error,
+        fatal,
+        off,
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// lowest level compiled in, messages of lower levels compile to nothing.
+    ///
+    /// set with the `atom_core_log_level` cmake option, defaults to `level::trace` in debug builds
+    /// and `level::info` in release builds.
+    /// --------------------------------------------------------------------------------------------
+    export constexpr level min_level =
+#if defined(ATOM_LOG_LEVEL)
+        level(ATOM_LOG_LEVEL);
+#else
+        build_config::is_mode_debug() ? level::trace : level::info;
+#endif
+
+    /// --------------------------------------------------------------------------------------------
+    /// options for `start()`.
+    /// --------------------------------------------------------------------------------------------
+    export class options
+    {
+    public:
+        /// file to write messages to, `io::stdout` if null. it must stay open until `stop()`.
+        filesystem::file* sink = nullptr;
+
+        /// size in bytes of each thread's buffer, rounded up to a power of two.
+        usize buffer_size = 1024 * 1024;
+
+        /// how long the writer sleeps when there is nothing to write.
+        u64 flush_interval_us = 1000;
+
+        /// if `true`, logging waits for the writer when the thread's buffer is full. else the
+        /// message is dropped, and the count of dropped messages is logged later.
+        bool block_when_full = false;
+    };
+
+    inline auto _get_level_name(level lvl) -> string_view
+    {
+        switch (lvl)
+        {
+            case level::trace: return string_view{ "trace" };
+            case level::debug: return string_view{ "debug" };
+            case level::info:  return string_view{ "info" };
+            case level::warn:  return string_view{ "warn" };
+            case level::error: return string_view{ "error" };
+            case level::fatal: return string_view{ "fatal" };
+            case level::off:   return string_view{ "off" };
+        }
+
+        return string_view{ "unknown" };
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// formats the args of a record into `out`.
+    /// --------------------------------------------------------------------------------------------
+    using _format_func = auto (*)(byte* payload, string_builder& out) -> void;
+
+    /// records are aligned to this, so the header always fits before the end of the buffer.
+    constexpr usize _record_align = 32;
+
+    /// --------------------------------------------------------------------------------------------
+    /// header of a record in a `_log_buffer`, the encoded args follow at `_record_align`.
+    ///
+    /// `format` is null for the padding skipped at the end of the buffer.
+    /// --------------------------------------------------------------------------------------------
+    class _record_header
+    {
+    public:
+        _format_func format;
+        u64 timestamp;
+        u32 size;
+        level lvl;
+    };
+
+    static_assert(sizeof(_record_header) <= _record_align);
+
+    constexpr auto _align_up(usize offset, usize align) -> usize
+    {
+        return (offset + align - 1) & ~(align - 1);
+    }
+
+    template <typename value_type>
+    concept _string_arg = requires(const value_type& value) { std::string_view(value); };
+
+    /// --------------------------------------------------------------------------------------------
+    /// encodes and decodes an arg of type `value_type` in a record.
+    ///
+    /// args are copied as is and destroyed after formatting. the offsets are computed the same
+    /// way when encoding and decoding, so nothing else is stored.
+    /// --------------------------------------------------------------------------------------------
+    template <typename value_type>
+    class _arg_codec
+    {
+        static_assert(alignof(value_type) <= _record_align, "arg is over aligned.");
+
+    public:
+        static auto get_size(usize offset, const value_type& value) -> usize
+        {
+            return _align_up(offset, alignof(value_type)) + sizeof(value_type);
+        }
+
+        template <typename arg_type>
+        static auto encode(byte* payload, usize& offset, arg_type&& value) -> void
+        {
+            offset = _align_up(offset, alignof(value_type));
+            std::construct_at(reinterpret_cast<value_type*>(payload + offset),
+                atom::forward<arg_type>(value));
+            offset += sizeof(value_type);
+        }
+
+        static auto decode(byte* payload, usize& offset) -> value_type&
+        {
+            offset = _align_up(offset, alignof(value_type));
+            value_type* value = reinterpret_cast<value_type*>(payload + offset);
+            offset += sizeof(value_type);
+            return *value;
+        }
+
+        static auto destroy(byte* payload, usize& offset) -> void
+        {
+            offset = _align_up(offset, alignof(value_type));
+            if constexpr (not std::is_trivially_destructible_v<value_type>)
+                std::destroy_at(reinterpret_cast<value_type*>(payload + offset));
+
+            offset += sizeof(value_type);
+        }
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// strings are copied as their count followed by their chars, and decoded as `string_view`.
+    /// --------------------------------------------------------------------------------------------
+    template <_string_arg value_type>
+    class _arg_codec<value_type>
+    {
+    public:
+        static auto get_size(usize offset, const value_type& value) -> usize
+        {
+            return _align_up(offset, alignof(usize)) + sizeof(usize)
+                   + std::string_view(value).size();
+        }
+
+        static auto encode(byte* payload, usize& offset, const value_type& value) -> void
+        {
+            std::string_view str(value);
+            usize count = str.size();
+
+            offset = _align_up(offset, alignof(usize));
+            std::memcpy(payload + offset, &count, sizeof(usize));
+            std::memcpy(payload + offset + sizeof(usize), str.data(), count);
+            offset += sizeof(usize) + count;
+        }
+
+        static auto decode(byte* payload, usize& offset) -> string_view
+        {
+            usize count;
+            offset = _align_up(offset, alignof(usize));
+            std::memcpy(&count, payload + offset, sizeof(usize));
+
+            const char* data = reinterpret_cast<const char*>(payload + offset + sizeof(usize));
+            offset += sizeof(usize) + count;
+            return string_view(create_from_raw, data, count);
+        }
+
+        static auto destroy(byte* payload, usize& offset) -> void
+        {
+            decode(payload, offset);
+        }
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// decodes the format string and args of a record, formats them into `out` and destroys the
+    /// args.
+    /// --------------------------------------------------------------------------------------------
+    template <typename... value_types>
+    auto _format_record(byte* payload, string_builder& out) -> void
+    {
+        usize offset = 0;
+        string_view fmt = _arg_codec<string_view>::decode(payload, offset);
+
+        // elements of a braced init list are evaluated in order, so are the offsets.
+        std::tuple<decltype(_arg_codec<value_types>::decode(payload, offset))...> args{
+            _arg_codec<value_types>::decode(payload, offset)...
+        };
+
+        std::apply(
+            [&](auto&... values) {
+                string::format_to(out, runtime_format_string{ fmt }, values...);
+            },
+            args);
+
+        offset = 0;
+        _arg_codec<string_view>::destroy(payload, offset);
+        (_arg_codec<value_types>::destroy(payload, offset), ...);
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// ring buffer of records logged by a single thread.
+    ///
+    /// the owning thread is the only producer and the writer is the only consumer. records are
+    /// stored contiguously, when one doesn't fit before the end of the buffer the rest is skipped
+    /// with a padding record.
+    /// --------------------------------------------------------------------------------------------
+    class _log_buffer
+    {
+    public:
+        _log_buffer(usize capacity)
+            : _capacity{ capacity }
+        {
+            _memory = static_cast<byte*>(_allocator.alloc(capacity + _record_align));
+            contract_asserts(_memory != nullptr, "out of memory.");
+
+            _data = reinterpret_cast<byte*>(
+                _align_up(reinterpret_cast<usize>(_memory), _record_align));
+        }
+
+        _log_buffer(const _log_buffer& that) = delete;
+        _log_buffer& operator=(const _log_buffer& that) = delete;
+
+        ~_log_buffer()
+        {
+            _allocator.dealloc(_memory);
+        }
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// returns space for a record of `size` bytes, or null if the buffer is full. the record
+        /// is published by `commit()`.
+        ///
+        /// must only be called by the owning thread.
+        /// ----------------------------------------------------------------------------------------
+        auto reserve(usize size) -> byte*
+        {
+            usize head = _head.load(std::memory_order_relaxed);
+            usize index = head & (_capacity - 1);
+            usize padding = _capacity - index < size ? _capacity - index : 0;
+
+            if (head + padding + size - _cached_tail > _capacity)
+            {
+                _cached_tail = _tail.load(std::memory_order_acquire);
+                if (head + padding + size - _cached_tail > _capacity)
+                    return nullptr;
+            }
+
+            if (padding > 0)
+            {
+                _record_header* header = reinterpret_cast<_record_header*>(_data + index);
+                header->format = nullptr;
+                header->size = u32(padding);
+                head += padding;
+                index = 0;
+            }
+
+            _next_head = head + size;
+            return _data + index;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// publishes the record returned by the last `reserve()`.
+        /// ----------------------------------------------------------------------------------------
+        auto commit() -> void
+        {
+            _head.store(_next_head, std::memory_order_release);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// pops every record currently in the buffer, passing the header and the payload of each
+        /// of them to `action`. space is released after each record, so a blocked producer can
+        /// continue before the whole buffer is drained.
+        ///
+        /// must only be called by the consumer.
+        /// ----------------------------------------------------------------------------------------
+        template <typename action_type>
+        auto pop_all(action_type&& action) -> usize
+        {
+            usize tail = _tail.load(std::memory_order_relaxed);
+            usize head = _head.load(std::memory_order_acquire);
+            usize count = 0;
+
+            while (tail != head)
+            {
+                byte* data = _data + (tail & (_capacity - 1));
+                _record_header* header = reinterpret_cast<_record_header*>(data);
+
+                if (header->format != nullptr)
+                {
+                    action(*header, data + _record_align);
+                    count++;
+                }
+
+                tail += header->size;
+                _tail.store(tail, std::memory_order_release);
+            }
+
+            return count;
+        }
+
+        auto is_empty() const -> bool
+        {
+            return _head.load(std::memory_order_acquire) == _tail.load(std::memory_order_acquire);
+        }
+
+        auto get_capacity() const -> usize
+        {
+            return _capacity;
+        }
+
+        auto add_dropped() -> void
+        {
+            _dropped_count.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        auto get_dropped_count() const -> usize
+        {
+            return _dropped_count.load(std::memory_order_relaxed);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// marks the buffer as no longer owned by any thread. once drained, the buffer can be
+        /// reused for a new thread.
+        /// ----------------------------------------------------------------------------------------
+        auto retire() -> void
+        {
+            _is_retired.store(true, std::memory_order_release);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// claims a retired and drained buffer for a new thread.
+        /// ----------------------------------------------------------------------------------------
+        auto try_reuse() -> bool
+        {
+            if (not _is_retired.load(std::memory_order_acquire) or not is_empty())
+                return false;
+
+            _is_retired.store(false, std::memory_order_relaxed);
+            return true;
+        }
+
+    public:
+        /// count of dropped messages already reported, only used by the consumer.
+        usize reported_dropped_count = 0;
+
+    private:
+        alignas(64) std::atomic<usize> _head = 0;
+        usize _next_head = 0;
+        usize _cached_tail = 0;
+        alignas(64) std::atomic<usize> _tail = 0;
+        std::atomic<usize> _dropped_count = 0;
+        std::atomic<bool> _is_retired = false;
+        usize _capacity;
+        byte* _data;
+        byte* _memory;
+        default_mem_allocator _allocator;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// formats timestamps as utc iso 8601 dates, caching the date and time up to the second.
+    ///
+    /// dates are computed without calling into libc, so this is also used from signal handlers.
+    /// --------------------------------------------------------------------------------------------
+    class _time_formatter
+    {
+    public:
+        auto append(string_builder& out, u64 wall_ns) -> void
+        {
+            u64 seconds = wall_ns / 1'000'000'000;
+            if (seconds != _cached_seconds or _cached_count == 0)
+            {
+                _cached_seconds = seconds;
+                _cached_count = _format_date_time(_cached, seconds);
+            }
+
+            char fraction[8];
+            fraction[0] = '.';
+            _put_digits(fraction + 1, wall_ns % 1'000'000'000 / 1000, 6);
+            fraction[7] = 'Z';
+
+            out.append(string_view(create_from_raw, _cached, _cached_count));
+            out.append(string_view(create_from_raw, fraction, sizeof(fraction)));
+        }
+
+    private:
+        /// ----------------------------------------------------------------------------------------
+        /// writes `seconds` since the unix epoch as `YYYY-MM-DDTHH:MM:SS` into `out`, returns the
+        /// count of chars written.
+        ///
+        /// converts days to a civil date as in http://howardhinnant.github.io/date_algorithms.html.
+        /// ----------------------------------------------------------------------------------------
+        static auto _format_date_time(char* out, u64 seconds) -> usize
+        {
+            u64 day_seconds = seconds % 86400;
+            u64 days = seconds / 86400 + 719468;
+            u64 era = days / 146097;
+            u64 day_of_era = days - era * 146097;
+            u64 year_of_era =
+                (day_of_era - day_of_era / 1460 + day_of_era / 36524 - day_of_era / 146096) / 365;
+            u64 day_of_year =
+                day_of_era - (365 * year_of_era + year_of_era / 4 - year_of_era / 100);
+            u64 month_index = (5 * day_of_year + 2) / 153;
+            u64 day = day_of_year - (153 * month_index + 2) / 5 + 1;
+            u64 month = month_index < 10 ? month_index + 3 : month_index - 9;
+            u64 year = year_of_era + era * 400 + (month <= 2 ? 1 : 0);
+
+            _put_digits(out, year, 4);
+            out[4] = '-';
+            _put_digits(out + 5, month, 2);
+            out[7] = '-';
+            _put_digits(out + 8, day, 2);
+            out[10] = 'T';
+            _put_digits(out + 11, day_seconds / 3600, 2);
+            out[13] = ':';
+            _put_digits(out + 14, day_seconds / 60 % 60, 2);
+            out[16] = ':';
+            _put_digits(out + 17, day_seconds % 60, 2);
+            return 19;
+        }
+
+        /// writes the last `count` decimal digits of `value`, padded with zeros.
+        static auto _put_digits(char* out, u64 value, usize count) -> void
+        {
+            for (usize i = count; i > 0; i--)
+            {
+                out[i - 1] = char('0' + value % 10);
+                value /= 10;
+            }
+        }
+
+    private:
+        u64 _cached_seconds = 0;
+        usize _cached_count = 0;
+        char _cached[32];
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// keeps track of every thread's buffer and runs the writer thread.
+    /// --------------------------------------------------------------------------------------------
+    class _logger
+    {
+        enum class _writer_state : u8
+        {
+            idle,
+            running,
+            stopped,
+        };
+
+    public:
+        static auto get() -> _logger&
+        {
+            static _logger instance;
+            return instance;
+        }
+
+    public:
+        _logger()
+            : _base_ticks{ time::tsc_clock::now() }
+            , _base_wall_ns{ u64(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                  std::chrono::system_clock::now().time_since_epoch())
+                      .count()) }
+        {}
+
+        ~_logger()
+        {
+            stop();
+        }
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// starts the writer with `opts`, restarting it if it's running.
+        /// ----------------------------------------------------------------------------------------
+        auto start(const options& opts) -> void
+        {
+            lock_guard guard{ _control_lock };
+
+            _stop_writer();
+            _start_writer(opts);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// starts the writer with default options if it was never started.
+        /// ----------------------------------------------------------------------------------------
+        auto start_if_idle() -> void
+        {
+            lock_guard guard{ _control_lock };
+
+            if (_state.load(std::memory_order_relaxed) == _writer_state::idle)
+                _start_writer(options{});
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// writes everything logged and stops the writer.
+        /// ----------------------------------------------------------------------------------------
+        auto stop() -> void
+        {
+            lock_guard guard{ _control_lock };
+
+            _stop_writer();
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// waits until the writer wrote everything logged before this call.
+        /// ----------------------------------------------------------------------------------------
+        auto flush() -> void
+        {
+            // only the writer can read its own id here, other threads never match whatever they
+            // read across a restart.
+            if (not is_running()
+                or std::this_thread::get_id() == _writer_id.load(std::memory_order_relaxed))
+                return;
+
+            std::unique_lock guard{ _wake_lock };
+            if (_is_stopping)
+                return;
+
+            u64 ticket = ++_flush_requested;
+            _wake.notify_all();
+            _flushed.wait(guard, [&] { return _flush_done >= ticket; });
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// allocates what `flush_on_crash()` needs up front, so it doesn't have to allocate from
+        /// a signal handler.
+        /// ----------------------------------------------------------------------------------------
+        auto prepare_crash_flush() -> void
+        {
+            _try_acquire_drain(usize(-1));
+
+            if (_crash_out.get_chunk_count() == 0)
+                _crash_out = string_builder{ create_with_capacity, string_builder::max_chunk_size };
+
+            {
+                lock_guard guard{ _lock };
+                _snapshot.reserve(std::max(_buffers.capacity(), usize(64)));
+            }
+
+            _is_draining.store(false, std::memory_order_release);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// writes what's left in the buffers from a signal handler.
+        ///
+        /// this is best effort, it gives up if the writer doesn't release the buffers in time,
+        /// e.g. because the writer itself crashed. messages are formatted into the builder
+        /// allocated by `prepare_crash_flush()` and written to the sink's file descriptor, only a
+        /// message longer than `_crash_write_threshold` or a formatter that allocates still calls
+        /// into the allocator. buffers registered after the snapshot was last grown are skipped.
+        /// ----------------------------------------------------------------------------------------
+        auto flush_on_crash(i32 signal) -> void
+        {
+            if (not _try_acquire_drain(1000))
+                return;
+
+            if (_lock.try_lock())
+            {
+                if (_buffers.size() <= _snapshot.capacity())
+                    _update_snapshot();
+
+                _lock.unlock();
+            }
+
+            _drain(_crash_out, false);
+
+            _timestamps.append(_crash_out, _to_wall_ns(time::tsc_clock::now()));
+            _crash_out.append_fmt(" [fatal] caught signal {}.\n", signal);
+            _write_raw(_crash_out);
+
+            _is_draining.store(false, std::memory_order_release);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// writes every record left in the buffers on the calling thread. used by producers
+        /// whose record may have been committed after the writer's last pass.
+        /// ----------------------------------------------------------------------------------------
+        auto write_pending() -> void
+        {
+            _try_acquire_drain(usize(-1));
+
+            {
+                lock_guard guard{ _lock };
+                _update_snapshot();
+            }
+
+            string_builder out;
+            _drain(out, true);
+            _is_draining.store(false, std::memory_order_release);
+        }
+
+        auto is_running() const -> bool
+        {
+            return _state.load(std::memory_order_acquire) == _writer_state::running;
+        }
+
+        auto is_idle() const -> bool
+        {
+            return _state.load(std::memory_order_acquire) == _writer_state::idle;
+        }
+
+        auto is_blocking_when_full() const -> bool
+        {
+            return _block_when_full.load(std::memory_order_relaxed);
+        }
+
+        auto get_sink() const -> filesystem::file&
+        {
+            filesystem::file* sink = _sink.load(std::memory_order_acquire);
+            return sink == nullptr ? io::stdout : *sink;
+        }
+
+        auto register_thread() -> _log_buffer*
+        {
+            lock_guard guard{ _lock };
+
+            for (auto& buffer : _buffers)
+            {
+                if (buffer->get_capacity() == _buffer_size and buffer->try_reuse())
+                    return buffer.get();
+            }
+
+            _buffers.push_back(std::make_unique<_log_buffer>(_buffer_size));
+            return _buffers.back().get();
+        }
+
+        auto get_dropped_count() -> usize
+        {
+            lock_guard guard{ _lock };
+
+            usize count = 0;
+            for (auto& buffer : _buffers)
+                count += buffer->get_dropped_count();
+
+            return count;
+        }
+
+        auto to_wall_ns(u64 ticks) const -> u64
+        {
+            return _to_wall_ns(ticks);
+        }
+
+    public:
+        std::atomic<level> runtime_level = min_level;
+
+    private:
+        auto _start_writer(const options& opts) -> void
+        {
+            _sink.store(opts.sink, std::memory_order_release);
+            _block_when_full.store(opts.block_when_full, std::memory_order_relaxed);
+            {
+                lock_guard guard{ _lock };
+                _buffer_size = std::bit_ceil(std::max(opts.buffer_size, usize(4096)));
+                _buffer_size = std::min(_buffer_size, usize(1) << 30);
+            }
+
+            {
+                std::unique_lock guard{ _wake_lock };
+                _is_stopping = false;
+            }
+
+            _writer = std::jthread([this, interval = opts.flush_interval_us] { _run(interval); });
+            _state.store(_writer_state::running, std::memory_order_release);
+        }
+
+        auto _stop_writer() -> void
+        {
+            if (_state.load(std::memory_order_relaxed) != _writer_state::running)
+                return;
+
+            // set before the writer's last pass, so producers that commit after it see it and
+            // write their records themselves, see `write()`.
+            _state.store(_writer_state::stopped, std::memory_order_seq_cst);
+
+            {
+                std::unique_lock guard{ _wake_lock };
+                _is_stopping = true;
+            }
+
+            _wake.notify_all();
+            _writer.join();
+
+            // everything was written, release flushes requested after the writer's last pass.
+            {
+                std::unique_lock guard{ _wake_lock };
+                _flush_done = _flush_requested;
+            }
+
+            _flushed.notify_all();
+        }
+
+        auto _run(u64 interval_us) -> void
+        {
+            // set by the writer itself, so it's set before a formatter can call `flush()`.
+            _writer_id.store(std::this_thread::get_id(), std::memory_order_relaxed);
+
+            string_builder out;
+
+            while (true)
+            {
+                u64 ticket;
+                bool is_stopping;
+                {
+                    std::unique_lock guard{ _wake_lock };
+                    ticket = _flush_requested;
+                    is_stopping = _is_stopping;
+                }
+
+                // pairs with the fence in `write()`, the last pass sees every record committed
+                // by producers that didn't see the writer stopping.
+                if (is_stopping)
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+                _try_acquire_drain(usize(-1));
+
+                {
+                    lock_guard guard{ _lock };
+                    _update_snapshot();
+                }
+
+                usize count = _drain(out, true);
+                _is_draining.store(false, std::memory_order_release);
+
+                {
+                    std::unique_lock guard{ _wake_lock };
+                    _flush_done = ticket;
+                }
+
+                _flushed.notify_all();
+
+                if (is_stopping)
+                    break;
+
+                if (count == 0)
+                {
+                    std::unique_lock guard{ _wake_lock };
+                    _wake.wait_for(guard, std::chrono::microseconds(interval_us),
+                        [&] { return _is_stopping or _flush_requested != _flush_done; });
+                }
+            }
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// copies the list of buffers, so they can be drained without holding `_lock`. buffers
+        /// are never freed, only reused. the copy keeps as much room as `_buffers`, so it can be
+        /// updated from a signal handler as long as `_buffers` didn't grow since.
+        /// ----------------------------------------------------------------------------------------
+        auto _update_snapshot() -> void
+        {
+            if (_snapshot.size() == _buffers.size())
+                return;
+
+            _snapshot.clear();
+            _snapshot.reserve(_buffers.capacity());
+            for (auto& buffer : _buffers)
+                _snapshot.push_back(buffer.get());
+        }
+
+        auto _try_acquire_drain(usize spin_count) -> bool
+        {
+            for (usize i = 0; i < spin_count; i++)
+            {
+                if (not _is_draining.exchange(true, std::memory_order_acquire))
+                    return true;
+
+                std::this_thread::yield();
+            }
+
+            return false;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// formats every record of every buffer into `out` and writes it. returns the count of
+        /// records.
+        ///
+        /// must only be called while holding `_is_draining`.
+        /// ----------------------------------------------------------------------------------------
+        auto _drain(string_builder& out, bool use_sink) -> usize
+        {
+            usize count = 0;
+            for (_log_buffer* buffer : _snapshot)
+            {
+                count += buffer->pop_all([&](const _record_header& header, byte* payload) {
+                    _append_prefix(out, header.timestamp, header.lvl);
+                    header.format(payload, out);
+                    out.append('\n');
+
+                    if (out.get_count() >= (use_sink ? _write_threshold : _crash_write_threshold))
+                        _write(out, use_sink);
+                });
+
+                usize dropped_count = buffer->get_dropped_count();
+                if (dropped_count != buffer->reported_dropped_count)
+                {
+                    _append_prefix(out, time::tsc_clock::now(), level::warn);
+                    out.append_fmt("dropped {} messages, the thread's buffer was full.\n",
+                        dropped_count - buffer->reported_dropped_count);
+
+                    buffer->reported_dropped_count = dropped_count;
+                }
+            }
+
+            _write(out, use_sink);
+            return count;
+        }
+
+        auto _append_prefix(string_builder& out, u64 ticks, level lvl) -> void
+        {
+            _timestamps.append(out, _to_wall_ns(ticks));
+            out.append(string_view{ " [" });
+            out.append(_get_level_name(lvl));
+            out.append(string_view{ "] " });
+        }
+
+        auto _write(string_builder& out, bool use_sink) -> void
+        {
+            if (out.is_empty())
+                return;
+
+            if (use_sink)
+                get_sink().write_builder(out);
+            else
+                _write_raw(out);
+
+            out.clear();
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// writes `out` to the sink's file descriptor without going through stdio, which may be
+        /// locked by the crashed thread. without posix, there is no crash handler and this writes
+        /// through the sink.
+        /// ----------------------------------------------------------------------------------------
+        auto _write_raw(string_builder& out) -> void
+        {
+#if defined(ATOM_PLATFORM_POSIX)
+            i32 fd = get_sink().get_fd();
+            out.for_each_chunk([&](string_view chunk) {
+                const char* data = chunk.get_data();
+                usize count = chunk.get_count();
+                while (count > 0)
+                {
+                    isize ret = ::write(fd, data, count);
+                    if (ret <= 0)
+                        return;
+
+                    data += ret;
+                    count -= usize(ret);
+                }
+            });
+#else
+            get_sink().write_builder(out);
+#endif
+
+            out.clear();
+        }
+
+        auto _to_wall_ns(u64 ticks) const -> u64
+        {
+            if (ticks >= _base_ticks)
+                return _base_wall_ns + time::tsc_clock::ticks_to_ns(ticks - _base_ticks);
+
+            return _base_wall_ns - time::tsc_clock::ticks_to_ns(_base_ticks - ticks);
+        }
+
+    private:
+        static constexpr usize _write_threshold = 64 * 1024;
+
+        // half of `_crash_out`'s only chunk, so a message shorter than this never grows it.
+        static constexpr usize _crash_write_threshold = string_builder::max_chunk_size / 2;
+
+        // serializes starting and stopping the writer, which takes `_lock` to list the buffers.
+        simple_mutex _control_lock;
+        simple_mutex _lock;
+        std::vector<std::unique_ptr<_log_buffer>> _buffers;
+        usize _buffer_size = options{}.buffer_size;
+        std::atomic<_writer_state> _state = _writer_state::idle;
+        std::atomic<filesystem::file*> _sink = nullptr;
+        std::atomic<bool> _block_when_full = false;
+
+        std::jthread _writer;
+        std::atomic<std::thread::id> _writer_id;
+        std::mutex _wake_lock;
+        std::condition_variable _wake;
+        std::condition_variable _flushed;
+        u64 _flush_requested = 0;
+        u64 _flush_done = 0;
+        bool _is_stopping = false;
+
+        // owned by whoever holds `_is_draining`.
+        std::atomic<bool> _is_draining = false;
+        std::vector<_log_buffer*> _snapshot;
+        _time_formatter _timestamps;
+        string_builder _crash_out;
+
+        const u64 _base_ticks;
+        const u64 _base_wall_ns;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// registers the thread's buffer on first use and retires it when the thread exits.
+    /// --------------------------------------------------------------------------------------------
+    class _thread_buffer_holder
+    {
+    public:
+        _thread_buffer_holder()
+            : buffer{ _logger::get().register_thread() }
+        {}
+
+        ~_thread_buffer_holder()
+        {
+            buffer->retire();
+        }
+
+    public:
+        _log_buffer* buffer;
+    };
+
+    inline auto _get_thread_buffer() -> _log_buffer*
+    {
+        thread_local _thread_buffer_holder holder;
+        return holder.buffer;
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// formats and writes the message on the calling thread, used once the writer is stopped.
+    /// --------------------------------------------------------------------------------------------
+    template <typename... arg_types>
+    ATOM_ATTR_NOINLINE auto _write_now(
+        level lvl, format_string<arg_types...> fmt, arg_types&&... args) -> void
+    {
+        _logger& logger = _logger::get();
+
+        string_builder out;
+        _time_formatter{}.append(out, logger.to_wall_ns(time::tsc_clock::now()));
+        out.append(string_view{ " [" });
+        out.append(_get_level_name(lvl));
+        out.append(string_view{ "] " });
+        out.append_fmt(fmt, atom::forward<arg_types>(args)...);
+        out.append('\n');
+
+        logger.get_sink().write_builder(out);
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// returns `true` if messages of level `lvl` are logged, checking both `min_level` and the
+    /// level set with `set_level()`.
+    /// --------------------------------------------------------------------------------------------
+    export auto is_enabled(level lvl) -> bool
+    {
+        return lvl >= min_level and lvl != level::off
+               and lvl >= _logger::get().runtime_level.load(std::memory_order_relaxed);
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// sets the lowest level logged at runtime. levels below `min_level` stay disabled.
+    /// --------------------------------------------------------------------------------------------
+    export auto set_level(level lvl) -> void
+    {
+        _logger::get().runtime_level.store(lvl, std::memory_order_relaxed);
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// returns the level set with `set_level()`, `min_level` by default.
+    /// --------------------------------------------------------------------------------------------
+    export auto get_level() -> level
+    {
+        return _logger::get().runtime_level.load(std::memory_order_relaxed);
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// starts the writer thread with `opts`. if it's already running, it's restarted after
+    /// writing everything logged so far.
+    ///
+    /// the writer is started with default options on the first message, so calling this is only
+    /// needed to change the options. `buffer_size` only applies to threads that log for the
+    /// first time after this.
+    /// --------------------------------------------------------------------------------------------
+    export auto start(const options& opts = options{}) -> void
+    {
+        _logger::get().start(opts);
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// writes everything logged and stops the writer thread. messages logged after this are
+    /// formatted and written on the calling thread, until `start()` is called again.
+    /// --------------------------------------------------------------------------------------------
+    export auto stop() -> void
+    {
+        _logger::get().stop();
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// blocks until every message logged before this call is written.
+    /// --------------------------------------------------------------------------------------------
+    export auto flush() -> void
+    {
+        _logger::get().flush();
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// returns the count of messages dropped because a thread's buffer was full.
+    /// --------------------------------------------------------------------------------------------
+    export auto get_dropped_count() -> usize
+    {
+        return _logger::get().get_dropped_count();
+    }
+
+#if defined(ATOM_PLATFORM_POSIX)
+    /// signal handlers replaced by `install_crash_handler()`.
+    constexpr usize _crash_signal_count = 5;
+    constexpr i32 _crash_signals[_crash_signal_count] = {
+        SIGSEGV, SIGBUS, SIGFPE, SIGILL, SIGABRT
+    };
+    struct sigaction _previous_crash_actions[_crash_signal_count];
+
+    /// seconds the crash handler may take before `SIGALRM` terminates the process.
+    constexpr u32 _crash_timeout_s = 5;
+
+    /// size of the alternate stack the crash handler runs on.
+    constexpr usize _crash_stack_size = 64 * 1024;
+
+    auto _on_crash_signal(i32 signal) -> void
+    {
+        // formatting can still deadlock if it allocates while the crashed thread holds the
+        // allocator's lock, the alarm makes sure the process terminates anyway.
+        ::alarm(_crash_timeout_s);
+        _logger::get().flush_on_crash(signal);
+        ::alarm(0);
+
+        for (usize i = 0; i < _crash_signal_count; i++)
+        {
+            if (_crash_signals[i] == signal)
+                ::sigaction(signal, &_previous_crash_actions[i], nullptr);
+        }
+
+        ::raise(signal);
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// gives the calling thread an alternate signal stack, so the crash handler can run after a
+    /// stack overflow. keeps the thread's own alternate stack if it has one.
+    /// --------------------------------------------------------------------------------------------
+    inline auto _install_crash_stack() -> void
+    {
+        stack_t current;
+        if (::sigaltstack(nullptr, &current) != 0 or (current.ss_flags & SS_DISABLE) == 0)
+            return;
+
+        // never freed, the thread may be interrupted at any time.
+        usize size = std::max(usize(SIGSTKSZ), _crash_stack_size);
+        void* mem = default_mem_allocator().alloc(size);
+        contract_asserts(mem != nullptr, "out of memory.");
+
+        stack_t stack = {};
+        stack.ss_sp = mem;
+        stack.ss_size = size;
+        ::sigaltstack(&stack, nullptr);
+    }
+#endif
+
+    /// --------------------------------------------------------------------------------------------
+    /// installs handlers for `SIGSEGV`, `SIGBUS`, `SIGFPE`, `SIGILL` and `SIGABRT` that write the
+    /// messages still in the buffers, then restore the previous handlers and raise the signal
+    /// again.
+    ///
+    /// writing from a signal handler is best effort, the messages are formatted on the crashing
+    /// thread into memory allocated by this call and written directly to the sink's file
+    /// descriptor. messages that don't fit in that memory and formatters that allocate are not
+    /// async signal safe, so the handler is bounded by an `alarm()` of `_crash_timeout_s`
+    /// seconds, and a second crash inside it terminates the process.
+    ///
+    /// the handler runs on an alternate stack, which is only installed for the calling thread. a
+    /// stack overflow on another thread terminates the process without writing anything.
+    ///
+    /// does nothing on platforms other than posix.
+    /// --------------------------------------------------------------------------------------------
+    export auto install_crash_handler() -> void
+    {
+#if defined(ATOM_PLATFORM_POSIX)
+        _logger::get().prepare_crash_flush();
+        _install_crash_stack();
+
+        struct sigaction action = {};
+        action.sa_handler = _on_crash_signal;
+        action.sa_flags = SA_ONSTACK | SA_RESETHAND;
+        ::sigemptyset(&action.sa_mask);
+
+        for (usize i = 0; i < _crash_signal_count; i++)
+            ::sigaction(_crash_signals[i], &action, &_previous_crash_actions[i]);
+#endif
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// logs the message `fmt` formatted with `args` at level `lvl`.
+    ///
+    /// the args are copied into the thread's buffer and formatted later on the writer thread.
+    /// strings are copied by value, so they don't need to outlive the call. other args must be
+    /// copy or move constructible.
+    /// --------------------------------------------------------------------------------------------
+    export template <level lvl, typename... arg_types>
+    auto write(format_string<arg_types...> fmt, arg_types&&... args) -> void
+        requires(string_formatter_provider<arg_types>::has() and ...)
+    {
+        if constexpr (lvl < min_level or lvl == level::off)
+        {
+            return;
+        }
+        else
+        {
+            _logger& logger = _logger::get();
+            if (lvl < logger.runtime_level.load(std::memory_order_relaxed))
+                return;
+
+            if (not logger.is_running()) [[unlikely]]
+            {
+                if (logger.is_idle())
+                    logger.start_if_idle();
+
+                if (not logger.is_running())
+                {
+                    _write_now(lvl, fmt, atom::forward<arg_types>(args)...);
+                    return;
+                }
+            }
+
+            usize size = _arg_codec<string_view>::get_size(0, fmt.str);
+            ((size = _arg_codec<std::decay_t<arg_types>>::get_size(size, args)), ...);
+            size = _align_up(_record_align + size, _record_align);
+
+            _log_buffer* buffer = _get_thread_buffer();
+            byte* data = size <= buffer->get_capacity() ? buffer->reserve(size) : nullptr;
+
+            while (data == nullptr)
+            {
+                if (size > buffer->get_capacity() or not logger.is_blocking_when_full()
+                    or not logger.is_running())
+                {
+                    buffer->add_dropped();
+                    return;
+                }
+
+                std::this_thread::yield();
+                data = buffer->reserve(size);
+            }
+
+            _record_header* header = reinterpret_cast<_record_header*>(data);
+            header->format = &_format_record<std::decay_t<arg_types>...>;
+            header->timestamp = time::tsc_clock::now();
+            header->size = u32(size);
+            header->lvl = lvl;
+
+            byte* payload = data + _record_align;
+            usize offset = 0;
+            _arg_codec<string_view>::encode(payload, offset, fmt.str);
+            (_arg_codec<std::decay_t<arg_types>>::encode(
+                 payload, offset, atom::forward<arg_types>(args)),
+                ...);
+
+            buffer->commit();
+
+            // `stop()` may have run the writer's last pass since the check above, in which case
+            // nobody else writes the record.
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (not logger.is_running()) [[unlikely]]
+            {
+                logger.write_pending();
+                return;
+            }
+
+            if constexpr (lvl == level::fatal)
+                logger.flush();
+        }
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// logs at `level::trace`, for detailed steps only useful while following the code.
+    /// --------------------------------------------------------------------------------------------
+    export template <typename... arg_types>
+    auto trace(format_string<arg_types...> fmt, arg_types&&... args) -> void
+    {
+        write<level::trace>(fmt, atom::forward<arg_types>(args)...);
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// logs at `level::debug`, for information useful while debugging.
+    /// --------------------------------------------------------------------------------------------
+    export template <typename... arg_types>
+    auto debug(format_string<arg_types...> fmt, arg_types&&... args) -> void
+    {
+        write<level::debug>(fmt, atom::forward<arg_types>(args)...);
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// logs at `level::info`, for the normal progress of the program.
+    /// --------------------------------------------------------------------------------------------
+    export template <typename... arg_types>
+    auto info(format_string<arg_types...> fmt, arg_types&&... args) -> void
+    {
+        write<level::info>(fmt, atom::forward<arg_types>(args)...);
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// logs at `level::warn`, for unexpected conditions the program recovers from.
+    /// --------------------------------------------------------------------------------------------
+    export template <typename... arg_types>
+    auto warn(format_string<arg_types...> fmt, arg_types&&... args) -> void
+    {
+        write<level::warn>(fmt, atom::forward<arg_types>(args)...);
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// logs at `level::error`, for failed operations the program keeps running after.
+    /// --------------------------------------------------------------------------------------------
+    export template <typename... arg_types>
+    auto error(format_string<arg_types...> fmt, arg_types&&... args) -> void
+    {
+        write<level::error>(fmt, atom::forward<arg_types>(args)...);
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// logs at `level::fatal` and waits until the message is written.
+    /// --------------------------------------------------------------------------------------------
+    export template <typename... arg_types>
+    auto fatal(format_string<arg_types...> fmt, arg_types&&... args) -> void
+    {
+        write<level::fatal>(fmt, atom::forward<arg_types>(args)...);
+    }
+}
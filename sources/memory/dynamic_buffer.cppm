@@ -2,12 +2,79 @@ export module atom_core:dynamic_buffer;
 
 import std;
 import :core;
+import :contracts;
 import :default_mem_allocator;
 import :memory_utils;
 import :ranges;
 
 namespace atom
 {
+    export class memory_view
+    {
+    public:
+        constexpr memory_view()
+            : _data{ nullptr }
+            , _size{ 0 }
+        {}
+
+        constexpr memory_view(const void* data, usize size)
+            : _data{ static_cast<const byte*>(data) }
+            , _size{ size }
+        {}
+
+    public:
+        constexpr auto get_data() const -> const byte*
+        {
+            return _data;
+        }
+
+        constexpr auto get_size() const -> usize
+        {
+            return _size;
+        }
+
+    private:
+        const byte* _data;
+        usize _size;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// view of writable bytes, converts to `memory_view`.
+    /// --------------------------------------------------------------------------------------------
+    export class mut_memory_view
+    {
+    public:
+        constexpr mut_memory_view()
+            : _data{ nullptr }
+            , _size{ 0 }
+        {}
+
+        constexpr mut_memory_view(void* data, usize size)
+            : _data{ static_cast<byte*>(data) }
+            , _size{ size }
+        {}
+
+    public:
+        constexpr auto get_data() const -> byte*
+        {
+            return _data;
+        }
+
+        constexpr auto get_size() const -> usize
+        {
+            return _size;
+        }
+
+        constexpr operator memory_view() const
+        {
+            return memory_view{ _data, _size };
+        }
+
+    private:
+        byte* _data;
+        usize _size;
+    };
+
     export class dynamic_buffer
     {
         using this_type = dynamic_buffer;
@@ -27,7 +94,7 @@ namespace atom
             , _capacity{ that._size }
             , _allocator{ that._allocator }
         {
-            _data = static_cast<byte*>(_allocator.alloc(_capacity));
+            _data = _alloc_mem(_capacity);
 
             memory_utils::copy_to(that._data, _size, _data);
         }
@@ -58,6 +125,7 @@ namespace atom
 
             _data = that._data;
             _size = that._size;
+            _capacity = that._capacity;
             _allocator = move(that._allocator);
 
             that._data = nullptr;
@@ -73,7 +141,7 @@ namespace atom
             , _capacity{ size }
             , _allocator{}
         {
-            _data = static_cast<byte*>(_allocator.alloc(_capacity));
+            _data = _alloc_mem(_capacity);
         }
 
         template <typename range_type>
@@ -84,7 +152,7 @@ namespace atom
             , _capacity{ ranges::get_count(range) * sizeof(ranges::value_type<range_type>) }
             , _allocator{}
         {
-            _data = static_cast<byte*>(_allocator.alloc(_capacity));
+            _data = _alloc_mem(_capacity);
 
             memory_utils::copy_to(ranges::get_data(range), _size, _data);
         }
@@ -129,29 +197,83 @@ namespace atom
             }
         }
 
+        /// ----------------------------------------------------------------------------------------
+        /// sets the size to `size`, keeping the current bytes. bytes added are left uninitialized.
+        /// ----------------------------------------------------------------------------------------
         constexpr auto resize(usize size) -> void
         {
-            if (_size == size)
+            reserve(size);
+            _size = size;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// ensures capacity for `size` bytes in total, keeping the current bytes.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto reserve(usize size) -> void
+        {
+            if (_capacity >= size)
             {
                 return;
             }
 
-            if (_data != nullptr)
+            usize new_capacity = _capacity * 2 > size ? _capacity * 2 : size;
+            if (_data == nullptr)
             {
-                _allocator.dealloc(_data);
+                _data = _alloc_mem(new_capacity);
             }
-
-            if (size == 0)
+            else
             {
-                _size = 0;
-                _capacity = 0;
-                _data = nullptr;
-                return;
+                byte* data = static_cast<byte*>(_allocator.realloc(_data, new_capacity));
+                contract_asserts(data != nullptr, "out of memory.");
+
+                _data = data;
             }
 
-            _size = size;
-            _capacity = 0;
-            _data = static_cast<byte*>(_allocator.alloc(_capacity));
+            _capacity = new_capacity;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// adds `size` uninitialized bytes at the end.
+        ///
+        /// \returns `mut_memory_view` of the bytes added, to be written by the caller.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto append_uninitialized(usize size) -> mut_memory_view
+        {
+            usize old_size = _size;
+            resize(_size + size);
+            return mut_memory_view{ _data + old_size, size };
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// reserves space for at least `size` more bytes without adding them.
+        ///
+        /// \returns `mut_memory_view` of the whole spare capacity. write into it and then call
+        /// `commit()` with the count of bytes written.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto get_spare(usize size) -> mut_memory_view
+        {
+            reserve(_size + size);
+            return mut_memory_view{ _data + _size, _capacity - _size };
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns count of bytes in the spare capacity.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto get_spare_size() const -> usize
+        {
+            return _capacity - _size;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// adds `size` bytes written into the spare capacity returned by `get_spare()`.
+        ///
+        /// \pre if debug `size <= get_spare_size()`: size is more than spare capacity.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto commit(usize size) -> void
+        {
+            contract_debug_expects(size <= get_spare_size(), "size is more than spare capacity.");
+
+            _size += size;
         }
 
         template <typename value_type>
@@ -161,13 +283,21 @@ namespace atom
         }
 
     private:
+        constexpr auto _alloc_mem(usize size) -> byte*
+        {
+            byte* data = static_cast<byte*>(_allocator.alloc(size));
+            contract_asserts(data != nullptr or size == 0, "out of memory.");
+
+            return data;
+        }
+
         constexpr auto _set_data(const void* data, usize size) -> void
         {
             if (_data == nullptr)
             {
                 _size = size;
                 _capacity = size;
-                _data = static_cast<byte*>(_allocator.alloc(_capacity));
+                _data = _alloc_mem(_capacity);
 
                 memory_utils::copy_to(data, _size, _data);
                 return;
@@ -179,7 +309,7 @@ namespace atom
                 _allocator.dealloc(_data);
 
                 _capacity = size;
-                _data = static_cast<byte*>(_allocator.alloc(_capacity));
+                _data = _alloc_mem(_capacity);
             }
 
             _size = size;
@@ -192,33 +322,4 @@ namespace atom
         usize _capacity;
         allocator_type _allocator;
     };
-
-    export class memory_view
-    {
-    public:
-        constexpr memory_view()
-            : _data{ nullptr }
-            , _size{ 0 }
-        {}
-
-        constexpr memory_view(const void* data, usize size)
-            : _data{ static_cast<const byte*>(data) }
-            , _size{ size }
-        {}
-
-    public:
-        constexpr auto get_data() const -> const byte*
-        {
-            return _data;
-        }
-
-        constexpr auto get_size() const -> usize
-        {
-            return _size;
-        }
-
-    private:
-        const byte* _data;
-        usize _size;
-    };
 }
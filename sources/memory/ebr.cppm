@@ -0,0 +1,414 @@
+export module atom_core:ebr;
+
+import std;
+import :core;
+import :contracts;
+import :containers;
+import :function_box;
+import :mutex;
+import :lock_guard;
+import :default_mem_allocator;
+import :reclaim;
+
+#include "atom/core/preprocessors.h"
+
+/// ------------------------------------------------------------------------------------------------
+/// epoch based memory reclamation.
+///
+/// threads reading a lock free structure pin the current epoch for the duration of the read.
+/// objects removed from the structure are retired, tagged with the epoch they were retired in,
+/// and destroyed once the global epoch advanced twice past it. the epoch only advances when every
+/// pinned thread has seen the current one, so by then no thread can still hold a reference.
+///
+/// pinning is a store and a fence on the thread's own record, much cheaper than hazard pointers
+/// for read heavy structures. but a thread staying pinned blocks all reclamation, so garbage is
+/// unbounded, see `hazard_ptr_domain` when that matters.
+/// ------------------------------------------------------------------------------------------------
+namespace atom::ebr
+{
+    class domain;
+
+    /// --------------------------------------------------------------------------------------------
+    /// a thread's participation in a `domain`.
+    /// --------------------------------------------------------------------------------------------
+    class _ebr_record
+    {
+    public:
+        /// pinned epoch shifted by one, with the low bit set while pinned.
+        alignas(64) std::atomic<u64> state = 0;
+
+        /// next record in the domain's list, records are never removed.
+        _ebr_record* next = nullptr;
+
+        std::atomic<bool> is_in_use = true;
+
+        // only accessed by the owning thread.
+        u32 guard_count = 0;
+        usize retired_since_collect = 0;
+        dynamic_array<_retired_entry> retired;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// keeps the calling thread pinned while alive, see `domain::pin()`.
+    /// --------------------------------------------------------------------------------------------
+    export class guard
+    {
+        friend class domain;
+
+    public:
+        guard(const guard& that) = delete;
+        guard& operator=(const guard& that) = delete;
+
+        /// ----------------------------------------------------------------------------------------
+        /// # move constructor
+        /// ----------------------------------------------------------------------------------------
+        guard(guard&& that)
+            : _record{ that._record }
+        {
+            that._record = nullptr;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// # move operator
+        /// ----------------------------------------------------------------------------------------
+        guard& operator=(guard&& that)
+        {
+            unpin();
+
+            _record = that._record;
+            that._record = nullptr;
+            return *this;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// # destructor
+        /// ----------------------------------------------------------------------------------------
+        ~guard()
+        {
+            unpin();
+        }
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// unpins the thread if this is its last guard. pointers read while pinned must not be
+        /// used after this.
+        /// ----------------------------------------------------------------------------------------
+        auto unpin() -> void
+        {
+            if (_record == nullptr)
+                return;
+
+            if (--_record->guard_count == 0)
+                _record->state.store(0, std::memory_order_release);
+
+            _record = nullptr;
+        }
+
+        auto is_pinned() const -> bool
+        {
+            return _record != nullptr;
+        }
+
+    private:
+        guard(_ebr_record* record)
+            : _record{ record }
+        {}
+
+    private:
+        _ebr_record* _record;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// epoch manager, tracking the threads pinned and the objects retired.
+    ///
+    /// each thread gets a record in the domain on first use, which is released for reuse when the
+    /// thread exits. objects retired by a thread are kept in its record, and handed to the domain
+    /// when it exits. the domain must outlive any guard, and destroys everything still retired.
+    /// --------------------------------------------------------------------------------------------
+    export class domain
+    {
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// count of retired objects after which a thread tries to advance the epoch and reclaim.
+        /// ----------------------------------------------------------------------------------------
+        static constexpr usize collect_threshold = 64;
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// returns the domain used by the functions in `atom::ebr`.
+        /// ----------------------------------------------------------------------------------------
+        static auto get_default() -> domain&
+        {
+            static domain instance;
+            return instance;
+        }
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// # default constructor
+        /// ----------------------------------------------------------------------------------------
+        domain()
+            : _id{ _reclaim_domains::get().add() }
+        {}
+
+        domain(const domain& that) = delete;
+        domain& operator=(const domain& that) = delete;
+
+        /// ----------------------------------------------------------------------------------------
+        /// # destructor
+        ///
+        /// destroys every retired object, no thread may be pinned.
+        /// ----------------------------------------------------------------------------------------
+        ~domain()
+        {
+            _reclaim_domains::get().remove(_id);
+
+            _ebr_record* record = _records.load(std::memory_order_acquire);
+            while (record != nullptr)
+            {
+                contract_debug_expects(record->guard_count == 0, "a thread is still pinned.");
+
+                _reclaim_all(record->retired);
+                _ebr_record* next = record->next;
+                _delete_node(record);
+                record = next;
+            }
+
+            _reclaim_all(_orphans);
+        }
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// pins the calling thread until the returned guard is destroyed. objects read from a lock
+        /// free structure while pinned are not destroyed even if another thread retires them.
+        ///
+        /// guards nest, the thread stays pinned until its last guard is destroyed.
+        /// ----------------------------------------------------------------------------------------
+        auto pin() -> guard
+        {
+            _ebr_record* record = _get_record();
+            if (record->guard_count++ == 0)
+            {
+                u64 epoch = _epoch.load(std::memory_order_relaxed);
+                record->state.store((epoch << 1) | 1, std::memory_order_relaxed);
+
+                // orders the store before any read of the structure, and pairs with the fence in
+                // `_try_advance()`.
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+            }
+
+            return guard{ record };
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// retires `ptr`, to be destroyed and deallocated with `allocator` once no thread pinned
+        /// before this call is still pinned.
+        ///
+        /// `ptr` must already be unreachable for threads pinning after this call.
+        /// ----------------------------------------------------------------------------------------
+        template <typename value_type, typename allocator_type = default_mem_allocator>
+        auto retire(value_type* ptr, allocator_type allocator = allocator_type()) -> void
+            requires(_reclaim_allocator<allocator_type>)
+        {
+            contract_debug_expects(ptr != nullptr);
+
+            _retire(_make_retired_entry(ptr, move(allocator)));
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// same as `retire(ptr)`, but calls `func` instead of destroying an object, for deferred
+        /// destructors.
+        /// ----------------------------------------------------------------------------------------
+        auto retire(function_box<void()> func) -> void
+        {
+            contract_debug_expects(func.has(), "no function is present.");
+
+            _retire(_retired_entry{
+                .ptr = nullptr, .destroy = nullptr, .func = move(func), .epoch = 0 });
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// tries to advance the epoch, then destroys the objects retired by this thread, and by
+        /// exited threads, that no thread can still read. returns the count of objects destroyed.
+        ///
+        /// called every `collect_threshold` retired objects, calling it explicitly is only needed
+        /// to reclaim sooner.
+        /// ----------------------------------------------------------------------------------------
+        auto collect() -> usize
+        {
+            _ebr_record* record = _get_record();
+            record->retired_since_collect = 0;
+
+            _try_advance();
+            u64 epoch = _epoch.load(std::memory_order_acquire);
+            auto is_safe = [&](const _retired_entry& entry) { return entry.epoch + 2 <= epoch; };
+
+            dynamic_array<_retired_entry> ready;
+            _take_retired_if(record->retired, ready, is_safe);
+
+            if (_orphan_count.load(std::memory_order_relaxed) > 0 and _orphans_lock.try_lock())
+            {
+                _take_retired_if(_orphans, ready, is_safe);
+                _orphan_count.store(_orphans.get_count(), std::memory_order_relaxed);
+                _orphans_lock.unlock();
+            }
+
+            return _reclaim_all(ready);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// returns the current epoch.
+        /// ----------------------------------------------------------------------------------------
+        auto get_epoch() const -> u64
+        {
+            return _epoch.load(std::memory_order_relaxed);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// returns the count of objects retired by the calling thread and not yet destroyed.
+        /// ----------------------------------------------------------------------------------------
+        auto get_retired_count() -> usize
+        {
+            return _get_record()->retired.get_count();
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// called when a thread exits, hands its retired objects to the domain and frees its
+        /// record for reuse.
+        /// ----------------------------------------------------------------------------------------
+        auto release_record(_ebr_record* record) -> void
+        {
+            contract_debug_expects(record->guard_count == 0, "the thread is still pinned.");
+
+            if (not record->retired.is_empty())
+            {
+                lock_guard guard{ _orphans_lock };
+
+                for (usize i = 0; i < record->retired.get_count(); i++)
+                    _orphans.emplace_last(move(record->retired.get_at(i)));
+
+                _orphan_count.store(_orphans.get_count(), std::memory_order_relaxed);
+                record->retired.remove_all();
+            }
+
+            record->retired_since_collect = 0;
+            record->state.store(0, std::memory_order_relaxed);
+            record->is_in_use.store(false, std::memory_order_release);
+        }
+
+    private:
+        auto _retire(_retired_entry entry) -> void
+        {
+            _ebr_record* record = _get_record();
+
+            // the object was unlinked before this, so any thread that could read it pinned an
+            // epoch no later than the one read here.
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            entry.epoch = _epoch.load(std::memory_order_relaxed);
+            record->retired.emplace_last(move(entry));
+
+            if (++record->retired_since_collect >= collect_threshold)
+                collect();
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// advances the epoch if every pinned thread pinned the current one.
+        /// ----------------------------------------------------------------------------------------
+        auto _try_advance() -> bool
+        {
+            u64 epoch = _epoch.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            for (_ebr_record* record = _records.load(std::memory_order_acquire); record != nullptr;
+                 record = record->next)
+            {
+                u64 state = record->state.load(std::memory_order_relaxed);
+                if ((state & 1) != 0 and (state >> 1) != epoch)
+                    return false;
+            }
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            return _epoch.compare_exchange_strong(
+                epoch, epoch + 1, std::memory_order_release, std::memory_order_relaxed);
+        }
+
+        ATOM_ATTR_ALWAYS_INLINE auto _get_record() -> _ebr_record*
+        {
+            _ebr_record* record = _thread_records<domain, _ebr_record>::find(this, _id);
+            if (record != nullptr) [[likely]]
+                return record;
+
+            return _acquire_record();
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// reuses a record released by an exited thread, or adds a new one.
+        /// ----------------------------------------------------------------------------------------
+        ATOM_ATTR_NOINLINE auto _acquire_record() -> _ebr_record*
+        {
+            _ebr_record* record = _records.load(std::memory_order_acquire);
+            for (; record != nullptr; record = record->next)
+            {
+                bool is_in_use = false;
+                if (record->is_in_use.compare_exchange_strong(
+                        is_in_use, true, std::memory_order_acquire, std::memory_order_relaxed))
+                    break;
+            }
+
+            if (record == nullptr)
+            {
+                record = _new_node<_ebr_record>();
+                record->next = _records.load(std::memory_order_relaxed);
+                while (not _records.compare_exchange_weak(record->next, record,
+                    std::memory_order_release, std::memory_order_relaxed))
+                {}
+            }
+
+            _thread_records<domain, _ebr_record>::add(this, _id, record);
+            return record;
+        }
+
+    private:
+        alignas(64) std::atomic<u64> _epoch = 0;
+        alignas(64) std::atomic<_ebr_record*> _records = nullptr;
+
+        simple_mutex _orphans_lock;
+        dynamic_array<_retired_entry> _orphans;
+        std::atomic<usize> _orphan_count = 0;
+        const u64 _id;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// pins the calling thread in the default domain, see `domain::pin()`.
+    /// --------------------------------------------------------------------------------------------
+    export auto pin() -> guard
+    {
+        return domain::get_default().pin();
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// retires `ptr` in the default domain, see `domain::retire()`.
+    /// --------------------------------------------------------------------------------------------
+    export template <typename value_type, typename allocator_type = default_mem_allocator>
+    auto retire(value_type* ptr, allocator_type allocator = allocator_type()) -> void
+        requires(_reclaim_allocator<allocator_type>)
+    {
+        domain::get_default().retire(ptr, move(allocator));
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// retires `func` in the default domain, see `domain::retire()`.
+    /// --------------------------------------------------------------------------------------------
+    export auto retire(function_box<void()> func) -> void
+    {
+        domain::get_default().retire(move(func));
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// collects in the default domain, see `domain::collect()`.
+    /// --------------------------------------------------------------------------------------------
+    export auto collect() -> usize
+    {
+        return domain::get_default().collect();
+    }
+}
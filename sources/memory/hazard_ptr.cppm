@@ -0,0 +1,451 @@
+export module atom_core:hazard_ptr;
+
+import std;
+import :core;
+import :contracts;
+import :containers;
+import :function_box;
+import :mutex;
+import :lock_guard;
+import :default_mem_allocator;
+import :reclaim;
+
+#include "atom/core/preprocessors.h"
+
+/// ------------------------------------------------------------------------------------------------
+/// hazard pointer based memory reclamation.
+///
+/// before reading an object of a lock free structure, a thread publishes its address in a hazard
+/// pointer. objects removed from the structure are retired, and destroyed once no hazard pointer
+/// holds their address.
+///
+/// protecting costs a store and a fence per object read, more than pinning with `ebr::domain`,
+/// but a stalled thread only keeps alive the objects it protects. each thread keeps at most a
+/// threshold proportional to the count of hazard pointers retired, so garbage is bounded.
+/// ------------------------------------------------------------------------------------------------
+namespace atom
+{
+    export class hazard_ptr_domain;
+
+    /// --------------------------------------------------------------------------------------------
+    /// a published hazard pointer, owned by one `hazard_ptr` at a time.
+    /// --------------------------------------------------------------------------------------------
+    class _hazard_slot
+    {
+    public:
+        alignas(64) std::atomic<const void*> ptr = nullptr;
+
+        /// next slot in the domain's list, slots are never removed.
+        _hazard_slot* next = nullptr;
+
+        std::atomic<bool> is_in_use = true;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// objects retired by a thread in a `hazard_ptr_domain`.
+    /// --------------------------------------------------------------------------------------------
+    class _hazard_record
+    {
+    public:
+        /// next record in the domain's list, records are never removed.
+        _hazard_record* next = nullptr;
+
+        std::atomic<bool> is_in_use = true;
+
+        // only accessed by the owning thread.
+        dynamic_array<_retired_entry> retired;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// protects one object at a time from being destroyed after it's retired.
+    ///
+    /// a hazard pointer owns a slot of its domain from construction to destruction, create them
+    /// once per thread and reuse them rather than for each read.
+    /// --------------------------------------------------------------------------------------------
+    export class hazard_ptr
+    {
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// # default constructor
+        ///
+        /// acquires a slot in the default domain.
+        /// ----------------------------------------------------------------------------------------
+        hazard_ptr();
+
+        /// ----------------------------------------------------------------------------------------
+        /// # domain constructor
+        ///
+        /// acquires a slot in `domain`, which must outlive this.
+        /// ----------------------------------------------------------------------------------------
+        explicit hazard_ptr(hazard_ptr_domain& domain);
+
+        hazard_ptr(const hazard_ptr& that) = delete;
+        hazard_ptr& operator=(const hazard_ptr& that) = delete;
+
+        /// ----------------------------------------------------------------------------------------
+        /// # move constructor
+        /// ----------------------------------------------------------------------------------------
+        hazard_ptr(hazard_ptr&& that)
+            : _slot{ that._slot }
+        {
+            that._slot = nullptr;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// # move operator
+        /// ----------------------------------------------------------------------------------------
+        hazard_ptr& operator=(hazard_ptr&& that)
+        {
+            _release();
+
+            _slot = that._slot;
+            that._slot = nullptr;
+            return *this;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// # destructor
+        /// ----------------------------------------------------------------------------------------
+        ~hazard_ptr()
+        {
+            _release();
+        }
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// loads `src` and protects the loaded pointer, retrying until `src` still holds it after
+        /// it's published. the returned object stays alive until this protects another one or is
+        /// reset.
+        /// ----------------------------------------------------------------------------------------
+        template <typename value_type>
+        auto protect(const std::atomic<value_type*>& src) -> value_type*
+        {
+            value_type* ptr = src.load(std::memory_order_relaxed);
+            while (not try_protect(ptr, src))
+            {}
+
+            return ptr;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// protects `ptr`, returns `true` if `src` still holds it after it's published. else sets
+        /// `ptr` to the value of `src` and returns `false`, leaving nothing protected.
+        /// ----------------------------------------------------------------------------------------
+        template <typename value_type>
+        auto try_protect(value_type*& ptr, const std::atomic<value_type*>& src) -> bool
+        {
+            contract_debug_expects(_slot != nullptr, "hazard pointer was moved.");
+
+            _slot->ptr.store(ptr, std::memory_order_relaxed);
+
+            // orders the publication before checking `src`, pairs with the fence in `collect()`.
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            value_type* current = src.load(std::memory_order_acquire);
+            if (current == ptr)
+                return true;
+
+            _slot->ptr.store(nullptr, std::memory_order_release);
+            ptr = current;
+            return false;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// stops protecting the current object.
+        /// ----------------------------------------------------------------------------------------
+        auto reset() -> void
+        {
+            contract_debug_expects(_slot != nullptr, "hazard pointer was moved.");
+
+            _slot->ptr.store(nullptr, std::memory_order_release);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// returns the protected pointer, or null.
+        /// ----------------------------------------------------------------------------------------
+        auto get() const -> const void*
+        {
+            return _slot == nullptr ? nullptr : _slot->ptr.load(std::memory_order_relaxed);
+        }
+
+    private:
+        auto _release() -> void
+        {
+            if (_slot == nullptr)
+                return;
+
+            _slot->ptr.store(nullptr, std::memory_order_release);
+            _slot->is_in_use.store(false, std::memory_order_release);
+            _slot = nullptr;
+        }
+
+    private:
+        _hazard_slot* _slot;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// owns the hazard pointer slots and the objects retired.
+    ///
+    /// each thread gets a record of its retired objects on first use, which is released for reuse
+    /// when the thread exits, handing the objects left to the domain. the domain must outlive its
+    /// hazard pointers, and destroys everything still retired.
+    /// --------------------------------------------------------------------------------------------
+    export class hazard_ptr_domain
+    {
+        friend class hazard_ptr;
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// lowest count of objects retired by a thread after which it collects. the threshold is
+        /// twice the count of slots when that's more, so each collection reclaims at least half.
+        /// ----------------------------------------------------------------------------------------
+        static constexpr usize min_collect_threshold = 64;
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// returns the domain used by default constructed hazard pointers.
+        /// ----------------------------------------------------------------------------------------
+        static auto get_default() -> hazard_ptr_domain&
+        {
+            static hazard_ptr_domain instance;
+            return instance;
+        }
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// # default constructor
+        /// ----------------------------------------------------------------------------------------
+        hazard_ptr_domain()
+            : _id{ _reclaim_domains::get().add() }
+        {}
+
+        hazard_ptr_domain(const hazard_ptr_domain& that) = delete;
+        hazard_ptr_domain& operator=(const hazard_ptr_domain& that) = delete;
+
+        /// ----------------------------------------------------------------------------------------
+        /// # destructor
+        ///
+        /// destroys every retired object, no hazard pointer may be alive.
+        /// ----------------------------------------------------------------------------------------
+        ~hazard_ptr_domain()
+        {
+            _reclaim_domains::get().remove(_id);
+
+            _hazard_record* record = _records.load(std::memory_order_acquire);
+            while (record != nullptr)
+            {
+                _reclaim_all(record->retired);
+                _hazard_record* next = record->next;
+                _delete_node(record);
+                record = next;
+            }
+
+            _reclaim_all(_orphans);
+
+            _hazard_slot* slot = _slots.load(std::memory_order_acquire);
+            while (slot != nullptr)
+            {
+                contract_debug_expects(
+                    not slot->is_in_use.load(std::memory_order_relaxed), "a hazard_ptr is alive.");
+
+                _hazard_slot* next = slot->next;
+                _delete_node(slot);
+                slot = next;
+            }
+        }
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// retires `ptr`, to be destroyed and deallocated with `allocator` once no hazard pointer
+        /// protects it.
+        ///
+        /// `ptr` must already be unreachable from the structure.
+        /// ----------------------------------------------------------------------------------------
+        template <typename value_type, typename allocator_type = default_mem_allocator>
+        auto retire(value_type* ptr, allocator_type allocator = allocator_type()) -> void
+            requires(_reclaim_allocator<allocator_type>)
+        {
+            contract_debug_expects(ptr != nullptr);
+
+            _retire(_make_retired_entry(ptr, move(allocator)));
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// same as `retire(ptr)`, but calls `func` instead of destroying `ptr`, for deferred
+        /// destructors. `func` is called once no hazard pointer protects `ptr`.
+        /// ----------------------------------------------------------------------------------------
+        auto retire(const void* ptr, function_box<void()> func) -> void
+        {
+            contract_debug_expects(func.has(), "no function is present.");
+
+            _retire(_retired_entry{ .ptr = const_cast<void*>(ptr),
+                .destroy = nullptr,
+                .func = move(func),
+                .epoch = 0 });
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// destroys the objects retired by this thread, and by exited threads, that no hazard
+        /// pointer protects. returns the count of objects destroyed.
+        ///
+        /// called when a thread retired enough objects, calling it explicitly is only needed to
+        /// reclaim sooner.
+        /// ----------------------------------------------------------------------------------------
+        auto collect() -> usize
+        {
+            _hazard_record* record = _get_record();
+
+            // pairs with the fence in `hazard_ptr::try_protect()`, a thread that read `src` before
+            // the object was unlinked published its hazard before this.
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            dynamic_array<const void*> hazards;
+            for (_hazard_slot* slot = _slots.load(std::memory_order_acquire); slot != nullptr;
+                 slot = slot->next)
+            {
+                const void* ptr = slot->ptr.load(std::memory_order_acquire);
+                if (ptr != nullptr)
+                    hazards.emplace_last(ptr);
+            }
+
+            const void** hazards_begin = hazards.get_data();
+            const void** hazards_end = hazards_begin + hazards.get_count();
+            std::sort(hazards_begin, hazards_end);
+            auto is_safe = [&](const _retired_entry& entry) {
+                return not std::binary_search(hazards_begin, hazards_end, entry.ptr);
+            };
+
+            dynamic_array<_retired_entry> ready;
+            _take_retired_if(record->retired, ready, is_safe);
+
+            if (_orphan_count.load(std::memory_order_relaxed) > 0 and _orphans_lock.try_lock())
+            {
+                _take_retired_if(_orphans, ready, is_safe);
+                _orphan_count.store(_orphans.get_count(), std::memory_order_relaxed);
+                _orphans_lock.unlock();
+            }
+
+            return _reclaim_all(ready);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// returns the count of objects retired by the calling thread and not yet destroyed.
+        /// ----------------------------------------------------------------------------------------
+        auto get_retired_count() -> usize
+        {
+            return _get_record()->retired.get_count();
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// called when a thread exits, hands its retired objects to the domain and frees its
+        /// record for reuse.
+        /// ----------------------------------------------------------------------------------------
+        auto release_record(_hazard_record* record) -> void
+        {
+            if (not record->retired.is_empty())
+            {
+                lock_guard guard{ _orphans_lock };
+
+                for (usize i = 0; i < record->retired.get_count(); i++)
+                    _orphans.emplace_last(move(record->retired.get_at(i)));
+
+                _orphan_count.store(_orphans.get_count(), std::memory_order_relaxed);
+                record->retired.remove_all();
+            }
+
+            record->is_in_use.store(false, std::memory_order_release);
+        }
+
+    private:
+        auto _retire(_retired_entry entry) -> void
+        {
+            _hazard_record* record = _get_record();
+            record->retired.emplace_last(move(entry));
+
+            usize threshold = std::max(
+                min_collect_threshold, 2 * _slot_count.load(std::memory_order_relaxed));
+
+            if (record->retired.get_count() >= threshold)
+                collect();
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// reuses a slot released by a destroyed hazard pointer, or adds a new one.
+        /// ----------------------------------------------------------------------------------------
+        auto _acquire_slot() -> _hazard_slot*
+        {
+            for (_hazard_slot* slot = _slots.load(std::memory_order_acquire); slot != nullptr;
+                 slot = slot->next)
+            {
+                bool is_in_use = false;
+                if (slot->is_in_use.compare_exchange_strong(
+                        is_in_use, true, std::memory_order_acquire, std::memory_order_relaxed))
+                    return slot;
+            }
+
+            _hazard_slot* slot = _new_node<_hazard_slot>();
+            slot->next = _slots.load(std::memory_order_relaxed);
+            while (not _slots.compare_exchange_weak(
+                slot->next, slot, std::memory_order_release, std::memory_order_relaxed))
+            {}
+
+            _slot_count.fetch_add(1, std::memory_order_relaxed);
+            return slot;
+        }
+
+        ATOM_ATTR_ALWAYS_INLINE auto _get_record() -> _hazard_record*
+        {
+            _hazard_record* record =
+                _thread_records<hazard_ptr_domain, _hazard_record>::find(this, _id);
+            if (record != nullptr) [[likely]]
+                return record;
+
+            return _acquire_record();
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// reuses a record released by an exited thread, or adds a new one.
+        /// ----------------------------------------------------------------------------------------
+        ATOM_ATTR_NOINLINE auto _acquire_record() -> _hazard_record*
+        {
+            _hazard_record* record = _records.load(std::memory_order_acquire);
+            for (; record != nullptr; record = record->next)
+            {
+                bool is_in_use = false;
+                if (record->is_in_use.compare_exchange_strong(
+                        is_in_use, true, std::memory_order_acquire, std::memory_order_relaxed))
+                    break;
+            }
+
+            if (record == nullptr)
+            {
+                record = _new_node<_hazard_record>();
+                record->next = _records.load(std::memory_order_relaxed);
+                while (not _records.compare_exchange_weak(record->next, record,
+                    std::memory_order_release, std::memory_order_relaxed))
+                {}
+            }
+
+            _thread_records<hazard_ptr_domain, _hazard_record>::add(this, _id, record);
+            return record;
+        }
+
+    private:
+        alignas(64) std::atomic<_hazard_slot*> _slots = nullptr;
+        std::atomic<usize> _slot_count = 0;
+        std::atomic<_hazard_record*> _records = nullptr;
+
+        simple_mutex _orphans_lock;
+        dynamic_array<_retired_entry> _orphans;
+        std::atomic<usize> _orphan_count = 0;
+        const u64 _id;
+    };
+
+    hazard_ptr::hazard_ptr()
+        : hazard_ptr{ hazard_ptr_domain::get_default() }
+    {}
+
+    hazard_ptr::hazard_ptr(hazard_ptr_domain& domain)
+        : _slot{ domain._acquire_slot() }
+    {}
+}
@@ -216,7 +216,8 @@ namespace atom
         }
 
         /// ----------------------------------------------------------------------------------------
-        /// rotates mem block `mem` fwd by `steps` steps.
+        /// rotates mem block `mem` fwd by `steps` steps, the byte at index `i` moves to index
+        /// `(i + steps) % mem_size`.
         ///
         /// @param mem: mem block to rotate.
         /// @param mem_size: size of the mem block pointed by `mem`.
@@ -231,7 +232,8 @@ namespace atom
         }
 
         /// ----------------------------------------------------------------------------------------
-        /// rotates mem block `mem` bwd by `steps` steps.
+        /// rotates mem block `mem` bwd by `steps` steps, the byte at index `i` moves to index
+        /// `(i - steps) % mem_size`.
         ///
         /// @param mem: mem block to rotate.
         /// @param mem_size: size of the mem block pointed by `mem`.
@@ -259,11 +261,11 @@ namespace atom
 
             if (steps > 0)
             {
-                _shift_fwd(mem, mem_size, steps);
+                _rotate_fwd(mem, mem_size, steps);
             }
             else
             {
-                _shift_bwd(mem, mem_size, nums::get_abs(steps));
+                _rotate_bwd(mem, mem_size, nums::get_abs(steps));
             }
         }
 
@@ -295,7 +297,7 @@ namespace atom
 
         static constexpr auto _rotate_fwd(void* mem, usize mem_size, usize offset) -> void
         {
-            std::rotate((byte*)mem, (byte*)mem + offset, (byte*)mem + mem_size);
+            std::rotate((byte*)mem, (byte*)mem + mem_size - offset, (byte*)mem + mem_size);
         }
 
         static constexpr auto _rotate_bwd(void* mem, usize mem_size, usize offset) -> void
@@ -0,0 +1,284 @@
+export module atom_core:reclaim;
+
+import std;
+import :core;
+import :contracts;
+import :containers;
+import :default_mem_allocator;
+import :function_box;
+import :mutex;
+import :lock_guard;
+
+#include "atom/core/preprocessors.h"
+
+/// ------------------------------------------------------------------------------------------------
+/// pieces shared by the safe memory reclamation schemes, `ebr::domain` and `hazard_ptr_domain`.
+/// ------------------------------------------------------------------------------------------------
+namespace atom
+{
+    /// --------------------------------------------------------------------------------------------
+    /// an object removed from a lock free structure, waiting until no thread can still read it.
+    ///
+    /// objects retired with their type are destroyed through `destroy`, which needs no
+    /// allocation. others are destroyed by `func`.
+    /// --------------------------------------------------------------------------------------------
+    class _retired_entry
+    {
+    public:
+        auto reclaim() -> void
+        {
+            if (func.has())
+                func.invoke();
+            else
+                destroy(ptr);
+        }
+
+    public:
+        void* ptr;
+        auto (*destroy)(void* ptr) -> void;
+        function_box<void()> func;
+
+        /// epoch the object was retired in, only used by `ebr::domain`.
+        u64 epoch;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// allocators objects can be retired with.
+    /// --------------------------------------------------------------------------------------------
+    template <typename allocator_type>
+    concept _reclaim_allocator = requires(allocator_type allocator, void* ptr) {
+        allocator.dealloc(ptr);
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// destroys the `value_type` at `ptr` and deallocates it with a default constructed
+    /// `allocator_type`.
+    /// --------------------------------------------------------------------------------------------
+    template <typename value_type, typename allocator_type>
+    auto _destroy_retired(void* ptr) -> void
+    {
+        std::destroy_at(static_cast<value_type*>(ptr));
+        allocator_type().dealloc(ptr);
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// returns an entry destroying `ptr` and deallocating it with `allocator`. stateless
+    /// allocators are default constructed again when reclaiming, others are kept in a
+    /// `function_box`.
+    /// --------------------------------------------------------------------------------------------
+    template <typename value_type, typename allocator_type>
+    auto _make_retired_entry(value_type* ptr, allocator_type allocator) -> _retired_entry
+    {
+        _retired_entry entry{ .ptr = ptr, .destroy = nullptr, .func = nullptr, .epoch = 0 };
+
+        if constexpr (std::is_empty_v<allocator_type>)
+        {
+            entry.destroy = &_destroy_retired<value_type, allocator_type>;
+        }
+        else
+        {
+            entry.func = [ptr, allocator]() mutable {
+                std::destroy_at(ptr);
+                allocator.dealloc(ptr);
+            };
+        }
+
+        return entry;
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// moves the entries of `entries` accepted by `pred` to `out`, keeping the order of the
+    /// others.
+    /// --------------------------------------------------------------------------------------------
+    template <typename pred_type>
+    auto _take_retired_if(dynamic_array<_retired_entry>& entries,
+        dynamic_array<_retired_entry>& out, pred_type&& pred) -> void
+    {
+        usize kept = 0;
+        for (usize i = 0; i < entries.get_count(); i++)
+        {
+            _retired_entry& entry = entries.get_at(i);
+            if (pred(entry))
+            {
+                out.emplace_last(move(entry));
+                continue;
+            }
+
+            if (kept != i)
+                entries.get_at(kept) = move(entry);
+
+            kept++;
+        }
+
+        entries.remove_last(entries.get_count() - kept);
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// reclaims every entry of `entries` and returns their count. entries are moved out first, so
+    /// reclaiming may retire more objects.
+    /// --------------------------------------------------------------------------------------------
+    inline auto _reclaim_all(dynamic_array<_retired_entry>& entries) -> usize
+    {
+        dynamic_array<_retired_entry> ready = move(entries);
+        entries.remove_all();
+
+        for (usize i = 0; i < ready.get_count(); i++)
+            ready.get_at(i).reclaim();
+
+        return ready.get_count();
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// allocates and constructs a record or a slot of a domain, which are freed with
+    /// `_delete_node()` when the domain is destroyed.
+    ///
+    /// nodes are aligned to cache lines, more than the allocator guarantees, so the pointer to
+    /// the allocated memory is kept right before the node.
+    /// --------------------------------------------------------------------------------------------
+    template <typename node_type>
+    auto _new_node() -> node_type*
+    {
+        constexpr usize align = alignof(node_type);
+
+        void* mem = default_mem_allocator().alloc(sizeof(void*) + align - 1 + sizeof(node_type));
+        contract_asserts(mem != nullptr, "out of memory.");
+
+        usize addr = (reinterpret_cast<usize>(mem) + sizeof(void*) + align - 1) & ~(align - 1);
+        reinterpret_cast<void**>(addr)[-1] = mem;
+        return std::construct_at(reinterpret_cast<node_type*>(addr));
+    }
+
+    template <typename node_type>
+    auto _delete_node(node_type* node) -> void
+    {
+        void* mem = reinterpret_cast<void**>(node)[-1];
+        std::destroy_at(node);
+        default_mem_allocator().dealloc(mem);
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// ids of the reclamation domains alive.
+    ///
+    /// threads cache their record in each domain they used, and release them when they exit.
+    /// domains are looked up by id, so a thread never releases a record of a destroyed domain.
+    /// --------------------------------------------------------------------------------------------
+    class _reclaim_domains
+    {
+    public:
+        static auto get() -> _reclaim_domains&
+        {
+            static _reclaim_domains instance;
+            return instance;
+        }
+
+    public:
+        auto add() -> u64
+        {
+            lock_guard guard{ _lock };
+
+            u64 id = ++_last_id;
+            _ids.emplace_last(id);
+            return id;
+        }
+
+        auto remove(u64 id) -> void
+        {
+            lock_guard guard{ _lock };
+
+            _ids.remove_one_find(id);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// calls `action` if the domain `id` is alive. the domain can't be destroyed while
+        /// `action` runs.
+        /// ----------------------------------------------------------------------------------------
+        template <typename action_type>
+        auto if_alive(u64 id, action_type&& action) -> void
+        {
+            lock_guard guard{ _lock };
+
+            for (usize i = 0; i < _ids.get_count(); i++)
+            {
+                if (_ids.get_at(i) == id)
+                {
+                    action();
+                    return;
+                }
+            }
+        }
+
+    private:
+        simple_mutex _lock;
+        dynamic_array<u64> _ids;
+        u64 _last_id = 0;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// the calling thread's record in each domain of type `domain_type`.
+    ///
+    /// records are released with `domain_type::release_record()` when the thread exits.
+    /// --------------------------------------------------------------------------------------------
+    template <typename domain_type, typename record_type>
+    class _thread_records
+    {
+        class _slot
+        {
+        public:
+            domain_type* domain;
+            u64 id;
+            record_type* record;
+        };
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// returns the thread's record in the domain `id` at `domain`, or null.
+        /// ----------------------------------------------------------------------------------------
+        ATOM_ATTR_ALWAYS_INLINE static auto find(domain_type* domain, u64 id) -> record_type*
+        {
+            _thread_records& self = _get();
+            if (self._last.domain == domain and self._last.id == id) [[likely]]
+                return self._last.record;
+
+            for (usize i = 0; i < self._slots.get_count(); i++)
+            {
+                _slot& slot = self._slots.get_at(i);
+                if (slot.domain == domain and slot.id == id)
+                {
+                    self._last = slot;
+                    return slot.record;
+                }
+            }
+
+            return nullptr;
+        }
+
+        static auto add(domain_type* domain, u64 id, record_type* record) -> void
+        {
+            _thread_records& self = _get();
+            self._last = _slot{ domain, id, record };
+            self._slots.emplace_last(self._last);
+        }
+
+    public:
+        ~_thread_records()
+        {
+            for (usize i = 0; i < _slots.get_count(); i++)
+            {
+                _slot& slot = _slots.get_at(i);
+                _reclaim_domains::get().if_alive(
+                    slot.id, [&] { slot.domain->release_record(slot.record); });
+            }
+        }
+
+    private:
+        static auto _get() -> _thread_records&
+        {
+            thread_local _thread_records records;
+            return records;
+        }
+
+    private:
+        _slot _last = { nullptr, 0, nullptr };
+        dynamic_array<_slot> _slots;
+    };
+}
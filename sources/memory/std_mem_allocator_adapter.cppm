@@ -0,0 +1,89 @@
+export module atom_core:std_mem_allocator_adapter;
+
+import std;
+import :core;
+
+#include "atom/core/preprocessors.h"
+
+namespace atom
+{
+    /// --------------------------------------------------------------------------------------------
+    /// adapts atom allocator `in_allocator_type` to the std allocator interface, so std containers
+    /// used as implementations allocate through atom allocators.
+    ///
+    /// during constant evaluation, allocates using `std::allocator`.
+    /// --------------------------------------------------------------------------------------------
+    export template <typename in_value_type, typename in_allocator_type>
+    class std_mem_allocator_adapter
+    {
+        using this_type = std_mem_allocator_adapter;
+
+        template <typename other_value_type, typename other_allocator_type>
+        friend class std_mem_allocator_adapter;
+
+    public:
+        using value_type = in_value_type;
+        using allocator_type = in_allocator_type;
+        using propagate_on_container_move_assignment = std::true_type;
+        using is_always_equal = std::bool_constant<std::is_empty_v<allocator_type>>;
+
+        template <typename other_value_type>
+        class rebind
+        {
+        public:
+            using other = std_mem_allocator_adapter<other_value_type, allocator_type>;
+        };
+
+    public:
+        constexpr std_mem_allocator_adapter() = default;
+
+        constexpr std_mem_allocator_adapter(allocator_type allocator)
+            : _allocator{ move(allocator) }
+        {}
+
+        template <typename other_value_type>
+        constexpr std_mem_allocator_adapter(
+            const std_mem_allocator_adapter<other_value_type, allocator_type>& that)
+            : _allocator{ that._allocator }
+        {}
+
+    public:
+        constexpr auto allocate(usize count) -> value_type*
+        {
+            if (std::is_constant_evaluated())
+                return std::allocator<value_type>().allocate(count);
+
+            return static_cast<value_type*>(_allocator.alloc(count * sizeof(value_type)));
+        }
+
+        constexpr auto deallocate(value_type* mem, usize count) -> void
+        {
+            if (std::is_constant_evaluated())
+                return std::allocator<value_type>().deallocate(mem, count);
+
+            _allocator.dealloc(mem);
+        }
+
+        constexpr auto get_allocator() const -> const allocator_type&
+        {
+            return _allocator;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// returns `true` if memory allocated by one can be deallocated by the other. stateless
+        /// allocators are always equal, stateful ones must be equality comparable.
+        /// ----------------------------------------------------------------------------------------
+        template <typename other_value_type>
+        constexpr auto operator==(
+            const std_mem_allocator_adapter<other_value_type, allocator_type>& that) const -> bool
+        {
+            if constexpr (std::is_empty_v<allocator_type>)
+                return true;
+            else
+                return _allocator == that._allocator;
+        }
+
+    private:
+        ATOM_ATTR_NO_UNIQUE_ADDRESS allocator_type _allocator;
+    };
+}
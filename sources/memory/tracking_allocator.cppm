@@ -0,0 +1,466 @@
+export module atom_core:tracking_allocator;
+
+import std;
+import :core;
+import :types;
+import :strings;
+import :containers;
+import :mutex;
+import :lock_guard;
+import :default_mem_allocator;
+
+#include "atom/core/preprocessors.h"
+
+namespace atom
+{
+    /// --------------------------------------------------------------------------------------------
+    /// statistics of allocations made through `tracking_allocator`.
+    /// --------------------------------------------------------------------------------------------
+    export class mem_stats
+    {
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// count of buckets in `size_histogram`.
+        /// ----------------------------------------------------------------------------------------
+        static constexpr usize histogram_bucket_count = 65;
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// bytes allocated and not yet deallocated. can be negative for per thread stats, when a
+        /// thread deallocates memory allocated by another thread.
+        /// ----------------------------------------------------------------------------------------
+        i64 live_bytes = 0;
+
+        /// ----------------------------------------------------------------------------------------
+        /// highest value `live_bytes` has reached.
+        /// ----------------------------------------------------------------------------------------
+        i64 peak_bytes = 0;
+
+        u64 alloc_count = 0;
+        u64 dealloc_count = 0;
+        u64 realloc_count = 0;
+
+        /// ----------------------------------------------------------------------------------------
+        /// sum of sizes of every allocation and reallocation.
+        /// ----------------------------------------------------------------------------------------
+        u64 total_alloc_bytes = 0;
+
+        /// ----------------------------------------------------------------------------------------
+        /// count of allocations by size, bucket `i` counts sizes in range `(2 ^ (i - 1), 2 ^ i]`.
+        /// ----------------------------------------------------------------------------------------
+        u64 size_histogram[histogram_bucket_count] = {};
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// atomic counters behind `mem_stats`.
+    /// --------------------------------------------------------------------------------------------
+    class _mem_stats_counters
+    {
+    public:
+        static constexpr auto get_size_bucket(usize size) -> usize
+        {
+            return size <= 1 ? 0 : usize(std::bit_width(size - 1));
+        }
+
+    public:
+        auto record_alloc(usize size) -> void
+        {
+            _alloc_count.fetch_add(1, std::memory_order_relaxed);
+            _total_alloc_bytes.fetch_add(size, std::memory_order_relaxed);
+            _size_histogram[get_size_bucket(size)].fetch_add(1, std::memory_order_relaxed);
+            _add_live_bytes(i64(size));
+        }
+
+        auto record_dealloc(usize size) -> void
+        {
+            _dealloc_count.fetch_add(1, std::memory_order_relaxed);
+            _add_live_bytes(-i64(size));
+        }
+
+        auto record_realloc(usize old_size, usize new_size) -> void
+        {
+            _realloc_count.fetch_add(1, std::memory_order_relaxed);
+            _total_alloc_bytes.fetch_add(new_size, std::memory_order_relaxed);
+            _size_histogram[get_size_bucket(new_size)].fetch_add(1, std::memory_order_relaxed);
+            _add_live_bytes(i64(new_size) - i64(old_size));
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// adds `stats` to the counters, keeping the highest peak.
+        /// ----------------------------------------------------------------------------------------
+        auto merge(const mem_stats& stats) -> void
+        {
+            _alloc_count.fetch_add(stats.alloc_count, std::memory_order_relaxed);
+            _dealloc_count.fetch_add(stats.dealloc_count, std::memory_order_relaxed);
+            _realloc_count.fetch_add(stats.realloc_count, std::memory_order_relaxed);
+            _total_alloc_bytes.fetch_add(stats.total_alloc_bytes, std::memory_order_relaxed);
+
+            for (usize i = 0; i < mem_stats::histogram_bucket_count; i++)
+            {
+                _size_histogram[i].fetch_add(stats.size_histogram[i], std::memory_order_relaxed);
+            }
+
+            _add_live_bytes(stats.live_bytes);
+            _update_peak_bytes(stats.peak_bytes);
+        }
+
+        auto get_stats() const -> mem_stats
+        {
+            mem_stats stats;
+            stats.live_bytes = _live_bytes.load(std::memory_order_relaxed);
+            stats.peak_bytes = _peak_bytes.load(std::memory_order_relaxed);
+            stats.alloc_count = _alloc_count.load(std::memory_order_relaxed);
+            stats.dealloc_count = _dealloc_count.load(std::memory_order_relaxed);
+            stats.realloc_count = _realloc_count.load(std::memory_order_relaxed);
+            stats.total_alloc_bytes = _total_alloc_bytes.load(std::memory_order_relaxed);
+
+            for (usize i = 0; i < mem_stats::histogram_bucket_count; i++)
+            {
+                stats.size_histogram[i] = _size_histogram[i].load(std::memory_order_relaxed);
+            }
+
+            return stats;
+        }
+
+    private:
+        auto _add_live_bytes(i64 bytes) -> void
+        {
+            i64 live_bytes = _live_bytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+            _update_peak_bytes(live_bytes);
+        }
+
+        auto _update_peak_bytes(i64 bytes) -> void
+        {
+            i64 peak_bytes = _peak_bytes.load(std::memory_order_relaxed);
+            while (bytes > peak_bytes
+                   and not _peak_bytes.compare_exchange_weak(
+                       peak_bytes, bytes, std::memory_order_relaxed))
+            {}
+        }
+
+    private:
+        std::atomic<i64> _live_bytes = 0;
+        std::atomic<i64> _peak_bytes = 0;
+        std::atomic<u64> _alloc_count = 0;
+        std::atomic<u64> _dealloc_count = 0;
+        std::atomic<u64> _realloc_count = 0;
+        std::atomic<u64> _total_alloc_bytes = 0;
+        std::atomic<u64> _size_histogram[mem_stats::histogram_bucket_count] = {};
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// snapshot of statistics of every tag and thread, see `take_mem_stats_snapshot()`.
+    /// --------------------------------------------------------------------------------------------
+    export class mem_stats_snapshot
+    {
+    public:
+        class tag_entry
+        {
+        public:
+            string_view name;
+            mem_stats stats;
+        };
+
+        class thread_entry
+        {
+        public:
+            u32 thread_id;
+            mem_stats stats;
+        };
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// returns a human readable report of the snapshot, one line per tag and thread.
+        /// ----------------------------------------------------------------------------------------
+        auto to_string() const -> string
+        {
+            string out;
+
+            for (usize i = 0; i < tags.get_count(); i++)
+            {
+                const tag_entry& entry = tags.get_at(i);
+                string::format_to(out, "tag '{}': ", entry.name);
+                _format_stats(out, entry.stats);
+            }
+
+            for (usize i = 0; i < threads.get_count(); i++)
+            {
+                const thread_entry& entry = threads.get_at(i);
+                string::format_to(out, "thread {}: ", entry.thread_id);
+                _format_stats(out, entry.stats);
+            }
+
+            string::format_to(out, "exited threads: ");
+            _format_stats(out, exited_threads);
+
+            return out;
+        }
+
+    private:
+        static auto _format_stats(string& out, const mem_stats& stats) -> void
+        {
+            string::format_to(out,
+                "live {} bytes, peak {} bytes, {} allocs, {} deallocs, {} reallocs, {} total "
+                "bytes\n",
+                stats.live_bytes, stats.peak_bytes, stats.alloc_count, stats.dealloc_count,
+                stats.realloc_count, stats.total_alloc_bytes);
+        }
+
+    public:
+        dynamic_array<tag_entry> tags;
+        dynamic_array<thread_entry> threads;
+
+        /// ----------------------------------------------------------------------------------------
+        /// combined statistics of threads that have exited.
+        /// ----------------------------------------------------------------------------------------
+        mem_stats exited_threads;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// keeps track of counters of every tag and thread.
+    /// --------------------------------------------------------------------------------------------
+    class _mem_stats_registry
+    {
+        class _tag_entry
+        {
+        public:
+            string_view name;
+            std::unique_ptr<_mem_stats_counters> counters;
+        };
+
+        class _thread_entry
+        {
+        public:
+            u32 thread_id;
+            std::unique_ptr<_mem_stats_counters> counters;
+        };
+
+    public:
+        static auto get() -> _mem_stats_registry&
+        {
+            // never destroyed, memory can be deallocated during static destruction.
+            static _mem_stats_registry* instance = new _mem_stats_registry();
+            return *instance;
+        }
+
+    public:
+        auto register_tag(string_view name) -> _mem_stats_counters*
+        {
+            lock_guard guard{ _lock };
+
+            _tags.push_back(_tag_entry{ name, std::make_unique<_mem_stats_counters>() });
+            return _tags.back().counters.get();
+        }
+
+        auto register_thread() -> _mem_stats_counters*
+        {
+            lock_guard guard{ _lock };
+
+            _threads.push_back(
+                _thread_entry{ _next_thread_id++, std::make_unique<_mem_stats_counters>() });
+            return _threads.back().counters.get();
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// merges the counters of exiting thread into `exited_threads` and removes them.
+        /// ----------------------------------------------------------------------------------------
+        auto unregister_thread(_mem_stats_counters* counters) -> void
+        {
+            lock_guard guard{ _lock };
+
+            for (auto it = _threads.begin(); it != _threads.end(); it++)
+            {
+                if (it->counters.get() == counters)
+                {
+                    exited_threads.merge(counters->get_stats());
+                    _threads.erase(it);
+                    return;
+                }
+            }
+        }
+
+        auto take_snapshot() -> mem_stats_snapshot
+        {
+            lock_guard guard{ _lock };
+
+            mem_stats_snapshot snapshot;
+            for (const _tag_entry& entry : _tags)
+            {
+                snapshot.tags.emplace_last(entry.name, entry.counters->get_stats());
+            }
+
+            for (const _thread_entry& entry : _threads)
+            {
+                snapshot.threads.emplace_last(entry.thread_id, entry.counters->get_stats());
+            }
+
+            snapshot.exited_threads = exited_threads.get_stats();
+            return snapshot;
+        }
+
+    public:
+        _mem_stats_counters exited_threads;
+
+    private:
+        simple_mutex _lock;
+        std::vector<_tag_entry> _tags;
+        std::vector<_thread_entry> _threads;
+        u32 _next_thread_id = 0;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// per thread counters, trivially destructible so they can be checked during thread exit.
+    /// --------------------------------------------------------------------------------------------
+    thread_local _mem_stats_counters* _thread_mem_stats_counters = nullptr;
+    thread_local bool _is_thread_mem_stats_exited = false;
+
+    class _thread_mem_stats_holder
+    {
+    public:
+        _thread_mem_stats_holder()
+        {
+            _thread_mem_stats_counters = _mem_stats_registry::get().register_thread();
+        }
+
+        ~_thread_mem_stats_holder()
+        {
+            _mem_stats_registry::get().unregister_thread(_thread_mem_stats_counters);
+            _thread_mem_stats_counters = nullptr;
+            _is_thread_mem_stats_exited = true;
+        }
+    };
+
+    inline auto _get_thread_mem_stats_counters() -> _mem_stats_counters*
+    {
+        if (_thread_mem_stats_counters != nullptr) [[likely]]
+            return _thread_mem_stats_counters;
+
+        // allocations made after the thread's counters were unregistered.
+        if (_is_thread_mem_stats_exited)
+            return &_mem_stats_registry::get().exited_threads;
+
+        thread_local _thread_mem_stats_holder holder;
+        return _thread_mem_stats_counters;
+    }
+
+    template <typename tag_type>
+    auto _get_tag_mem_stats_counters() -> _mem_stats_counters*
+    {
+        static _mem_stats_counters* counters = [] {
+            if constexpr (requires { tag_type::name; })
+            {
+                return _mem_stats_registry::get().register_tag(string_view{ tag_type::name });
+            }
+            else
+            {
+                return _mem_stats_registry::get().register_tag(
+                    string_view{ typeid(tag_type).name() });
+            }
+        }();
+
+        return counters;
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// tag used by `tracking_allocator` when none is specified.
+    /// --------------------------------------------------------------------------------------------
+    export class default_mem_tag
+    {
+    public:
+        static constexpr const char* name = "default";
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// allocator which records statistics of allocations made through `in_allocator_type`.
+    ///
+    /// statistics are recorded per `in_tag_type` and per thread. tags group allocations, e.g. use
+    /// a different tag for each container to find which of them hold the most memory. a tag can
+    /// have a `static constexpr const char* name` member used in reports.
+    ///
+    /// each allocation is prefixed with a header storing its size, so deallocations can be
+    /// recorded without being passed the size.
+    /// --------------------------------------------------------------------------------------------
+    export template <typename in_allocator_type = default_mem_allocator,
+        typename in_tag_type = default_mem_tag>
+    class tracking_allocator
+    {
+        /// size of the header, keeps the memory returned aligned like `malloc`.
+        static constexpr usize _header_size = 16;
+
+    public:
+        using allocator_type = in_allocator_type;
+        using tag_type = in_tag_type;
+
+    public:
+        constexpr tracking_allocator() = default;
+
+        constexpr tracking_allocator(allocator_type allocator)
+            : _allocator{ move(allocator) }
+        {}
+
+    public:
+        auto alloc(usize size) -> void*
+        {
+            byte* mem = static_cast<byte*>(_allocator.alloc(size + _header_size));
+            if (mem == nullptr)
+                return nullptr;
+
+            *reinterpret_cast<usize*>(mem) = size;
+
+            _get_tag_mem_stats_counters<tag_type>()->record_alloc(size);
+            _get_thread_mem_stats_counters()->record_alloc(size);
+            return mem + _header_size;
+        }
+
+        auto realloc(void* mem, usize size) -> void*
+        {
+            if (mem == nullptr)
+                return alloc(size);
+
+            byte* old_mem = static_cast<byte*>(mem) - _header_size;
+            usize old_size = *reinterpret_cast<usize*>(old_mem);
+
+            byte* new_mem = static_cast<byte*>(_allocator.realloc(old_mem, size + _header_size));
+            if (new_mem == nullptr)
+                return nullptr;
+
+            *reinterpret_cast<usize*>(new_mem) = size;
+
+            _get_tag_mem_stats_counters<tag_type>()->record_realloc(old_size, size);
+            _get_thread_mem_stats_counters()->record_realloc(old_size, size);
+            return new_mem + _header_size;
+        }
+
+        auto dealloc(void* mem) -> void
+        {
+            if (mem == nullptr)
+                return;
+
+            byte* old_mem = static_cast<byte*>(mem) - _header_size;
+            usize size = *reinterpret_cast<usize*>(old_mem);
+
+            _get_tag_mem_stats_counters<tag_type>()->record_dealloc(size);
+            _get_thread_mem_stats_counters()->record_dealloc(size);
+            _allocator.dealloc(old_mem);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// returns statistics of allocations made with `tag_type`.
+        /// ----------------------------------------------------------------------------------------
+        static auto get_stats() -> mem_stats
+        {
+            return _get_tag_mem_stats_counters<tag_type>()->get_stats();
+        }
+
+    private:
+        ATOM_ATTR_NO_UNIQUE_ADDRESS allocator_type _allocator;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// returns statistics of every tag and thread that has used `tracking_allocator`.
+    /// --------------------------------------------------------------------------------------------
+    export auto take_mem_stats_snapshot() -> mem_stats_snapshot
+    {
+        return _mem_stats_registry::get().take_snapshot();
+    }
+}
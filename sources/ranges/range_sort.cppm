@@ -0,0 +1,912 @@
+export module atom_core:ranges.range_sort;
+
+import std;
+import :core;
+import :types;
+import :contracts;
+import :default_mem_allocator;
+import :ranges.range_definition;
+import :ranges.range_concepts;
+import :ranges.range_functions;
+
+#include "atom/core/preprocessors.h"
+
+namespace atom::ranges
+{
+    /// --------------------------------------------------------------------------------------------
+    /// comparison sorts over contiguous memory.
+    ///
+    /// `sort()` is pattern defeating quicksort: ninther pivots, already partitioned ranges are
+    /// finished with a bounded insertion sort, runs of equal values are skipped with a left
+    /// partition, and unbalanced partitions shuffle and eventually fall back to heapsort, so the
+    /// worst case stays `O(n log n)`. `select()` is the same partition loop used as introselect.
+    /// --------------------------------------------------------------------------------------------
+    class _comparison_sort_impl
+    {
+    private:
+        static constexpr isize _insertion_sort_threshold = 24;
+        static constexpr isize _ninther_threshold = 128;
+        static constexpr isize _partial_insertion_sort_limit = 8;
+
+    public:
+        template <typename value_type, typename comparer_type>
+        static constexpr auto sort(value_type* begin, value_type* end, comparer_type& comp) -> void
+        {
+            if (end - begin < 2)
+                return;
+
+            _sort_loop(begin, end, comp, std::bit_width(usize(end - begin)), true);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// moves the value which would be at `nth` after sorting to `nth`, with no greater values
+        /// before it and no lesser values after it.
+        /// ----------------------------------------------------------------------------------------
+        template <typename value_type, typename comparer_type>
+        static constexpr auto select(
+            value_type* begin, value_type* nth, value_type* end, comparer_type& comp) -> void
+        {
+            i32 bad_allowed = std::bit_width(usize(end - begin));
+            bool leftmost = true;
+
+            while (end - begin > _insertion_sort_threshold)
+            {
+                _choose_pivot(begin, end, comp);
+
+                if (not leftmost and not comp(begin[-1], *begin))
+                {
+                    // all values in `[begin, pivot]` are equal to the pivot.
+                    value_type* pivot = _partition_left(begin, end, comp);
+                    if (nth <= pivot)
+                        return;
+
+                    begin = pivot + 1;
+                    continue;
+                }
+
+                value_type* pivot = _partition_right(begin, end, comp).first;
+                if (pivot == nth)
+                    return;
+
+                isize size = end - begin;
+                if (pivot - begin < size / 8 or end - pivot < size / 8)
+                {
+                    if (--bad_allowed == 0)
+                    {
+                        heap_sort(begin, end, comp);
+                        return;
+                    }
+                }
+
+                if (nth < pivot)
+                {
+                    end = pivot;
+                }
+                else
+                {
+                    begin = pivot + 1;
+                    leftmost = false;
+                }
+            }
+
+            _insertion_sort(begin, end, comp);
+        }
+
+        template <typename value_type, typename comparer_type>
+        static constexpr auto heap_sort(
+            value_type* begin, value_type* end, comparer_type& comp) -> void
+        {
+            isize count = end - begin;
+            for (isize i = count / 2; i > 0; i--)
+                _sift_down(begin, i - 1, count, comp);
+
+            for (isize i = count - 1; i > 0; i--)
+            {
+                std::swap(begin[0], begin[i]);
+                _sift_down(begin, 0, i, comp);
+            }
+        }
+
+    private:
+        template <typename value_type, typename comparer_type>
+        static constexpr auto _sort_loop(value_type* begin, value_type* end, comparer_type& comp,
+            i32 bad_allowed, bool leftmost) -> void
+        {
+            while (true)
+            {
+                isize size = end - begin;
+                if (size < _insertion_sort_threshold)
+                {
+                    if (leftmost)
+                        _insertion_sort(begin, end, comp);
+                    else
+                        _unguarded_insertion_sort(begin, end, comp);
+
+                    return;
+                }
+
+                _choose_pivot(begin, end, comp);
+
+                // the value before this range is a previous pivot, which is not greater than any
+                // value here. if it's equal to the chosen pivot, move all equal values left and
+                // skip them, they are already in place.
+                if (not leftmost and not comp(begin[-1], *begin))
+                {
+                    begin = _partition_left(begin, end, comp) + 1;
+                    continue;
+                }
+
+                auto [pivot, already_partitioned] = _partition_right(begin, end, comp);
+
+                isize left_size = pivot - begin;
+                isize right_size = end - (pivot + 1);
+                if (left_size < size / 8 or right_size < size / 8)
+                {
+                    if (--bad_allowed == 0)
+                    {
+                        heap_sort(begin, end, comp);
+                        return;
+                    }
+
+                    _break_patterns(begin, pivot, end);
+                }
+                else if (already_partitioned and _partial_insertion_sort(begin, pivot, comp)
+                         and _partial_insertion_sort(pivot + 1, end, comp))
+                {
+                    return;
+                }
+
+                // recurse into the left part and loop on the right part.
+                _sort_loop(begin, pivot, comp, bad_allowed, leftmost);
+                begin = pivot + 1;
+                leftmost = false;
+            }
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// moves the median of 3, or the pseudo median of 9 for large ranges, to `begin`.
+        /// ----------------------------------------------------------------------------------------
+        template <typename value_type, typename comparer_type>
+        static constexpr auto _choose_pivot(
+            value_type* begin, value_type* end, comparer_type& comp) -> void
+        {
+            isize half = (end - begin) / 2;
+            if (end - begin > _ninther_threshold)
+            {
+                _sort3(begin, begin + half, end - 1, comp);
+                _sort3(begin + 1, begin + (half - 1), end - 2, comp);
+                _sort3(begin + 2, begin + (half + 1), end - 3, comp);
+                _sort3(begin + (half - 1), begin + half, begin + (half + 1), comp);
+                std::swap(*begin, begin[half]);
+            }
+            else
+            {
+                _sort3(begin + half, begin, end - 1, comp);
+            }
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// partitions around `*begin`, values equal to the pivot go to the right.
+        ///
+        /// \returns position of the pivot and whether the range was already partitioned.
+        /// ----------------------------------------------------------------------------------------
+        template <typename value_type, typename comparer_type>
+        static constexpr auto _partition_right(value_type* begin, value_type* end,
+            comparer_type& comp) -> std::pair<value_type*, bool>
+        {
+            value_type pivot = move(*begin);
+            value_type* first = begin;
+            value_type* last = end;
+
+            // the median of 3 guarantees a value not less than the pivot exists, so the first
+            // loop is unguarded. the second loop is guarded only if no value was less.
+            while (comp(*++first, pivot))
+            {}
+
+            if (first - 1 == begin)
+            {
+                while (first < last and not comp(*--last, pivot))
+                {}
+            }
+            else
+            {
+                while (not comp(*--last, pivot))
+                {}
+            }
+
+            bool already_partitioned = first >= last;
+            while (first < last)
+            {
+                std::swap(*first, *last);
+                while (comp(*++first, pivot))
+                {}
+                while (not comp(*--last, pivot))
+                {}
+            }
+
+            value_type* pivot_pos = first - 1;
+            *begin = move(*pivot_pos);
+            *pivot_pos = move(pivot);
+            return { pivot_pos, already_partitioned };
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// partitions around `*begin`, values equal to the pivot go to the left.
+        /// ----------------------------------------------------------------------------------------
+        template <typename value_type, typename comparer_type>
+        static constexpr auto _partition_left(
+            value_type* begin, value_type* end, comparer_type& comp) -> value_type*
+        {
+            value_type pivot = move(*begin);
+            value_type* first = begin;
+            value_type* last = end;
+
+            while (comp(pivot, *--last))
+            {}
+
+            if (last + 1 == end)
+            {
+                while (first < last and not comp(pivot, *++first))
+                {}
+            }
+            else
+            {
+                while (not comp(pivot, *++first))
+                {}
+            }
+
+            while (first < last)
+            {
+                std::swap(*first, *last);
+                while (comp(pivot, *--last))
+                {}
+                while (not comp(pivot, *++first))
+                {}
+            }
+
+            *begin = move(*last);
+            *last = move(pivot);
+            return last;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// swaps a few values around both sides of an unbalanced partition, so that inputs which
+        /// produce bad pivots repeatedly get shuffled.
+        /// ----------------------------------------------------------------------------------------
+        template <typename value_type>
+        static constexpr auto _break_patterns(
+            value_type* begin, value_type* pivot, value_type* end) -> void
+        {
+            isize left_size = pivot - begin;
+            isize right_size = end - (pivot + 1);
+
+            if (left_size >= _insertion_sort_threshold)
+            {
+                std::swap(begin[0], begin[left_size / 4]);
+                std::swap(pivot[-1], pivot[-left_size / 4]);
+
+                if (left_size > _ninther_threshold)
+                {
+                    std::swap(begin[1], begin[left_size / 4 + 1]);
+                    std::swap(begin[2], begin[left_size / 4 + 2]);
+                    std::swap(pivot[-2], pivot[-(left_size / 4 + 1)]);
+                    std::swap(pivot[-3], pivot[-(left_size / 4 + 2)]);
+                }
+            }
+
+            if (right_size >= _insertion_sort_threshold)
+            {
+                std::swap(pivot[1], pivot[1 + right_size / 4]);
+                std::swap(end[-1], end[-right_size / 4]);
+
+                if (right_size > _ninther_threshold)
+                {
+                    std::swap(pivot[2], pivot[2 + right_size / 4]);
+                    std::swap(pivot[3], pivot[3 + right_size / 4]);
+                    std::swap(end[-2], end[-(1 + right_size / 4)]);
+                    std::swap(end[-3], end[-(2 + right_size / 4)]);
+                }
+            }
+        }
+
+        template <typename value_type, typename comparer_type>
+        static constexpr auto _insertion_sort(
+            value_type* begin, value_type* end, comparer_type& comp) -> void
+        {
+            if (begin == end)
+                return;
+
+            for (value_type* it = begin + 1; it != end; it++)
+            {
+                value_type* hole = it;
+                if (not comp(*hole, hole[-1]))
+                    continue;
+
+                value_type value = move(*hole);
+                do
+                {
+                    *hole = move(hole[-1]);
+                    hole--;
+                } while (hole != begin and comp(value, hole[-1]));
+
+                *hole = move(value);
+            }
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// insertion sort without the bounds check, `begin[-1]` must not be greater than any value
+        /// in the range.
+        /// ----------------------------------------------------------------------------------------
+        template <typename value_type, typename comparer_type>
+        static constexpr auto _unguarded_insertion_sort(
+            value_type* begin, value_type* end, comparer_type& comp) -> void
+        {
+            if (begin == end)
+                return;
+
+            for (value_type* it = begin + 1; it != end; it++)
+            {
+                value_type* hole = it;
+                if (not comp(*hole, hole[-1]))
+                    continue;
+
+                value_type value = move(*hole);
+                do
+                {
+                    *hole = move(hole[-1]);
+                    hole--;
+                } while (comp(value, hole[-1]));
+
+                *hole = move(value);
+            }
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// insertion sort which gives up after moving a few values.
+        ///
+        /// \returns `true` if the range got sorted.
+        /// ----------------------------------------------------------------------------------------
+        template <typename value_type, typename comparer_type>
+        static constexpr auto _partial_insertion_sort(
+            value_type* begin, value_type* end, comparer_type& comp) -> bool
+        {
+            if (begin == end)
+                return true;
+
+            isize moves = 0;
+            for (value_type* it = begin + 1; it != end; it++)
+            {
+                if (moves > _partial_insertion_sort_limit)
+                    return false;
+
+                value_type* hole = it;
+                if (not comp(*hole, hole[-1]))
+                    continue;
+
+                value_type value = move(*hole);
+                do
+                {
+                    *hole = move(hole[-1]);
+                    hole--;
+                } while (hole != begin and comp(value, hole[-1]));
+
+                *hole = move(value);
+                moves += it - hole;
+            }
+
+            return true;
+        }
+
+        template <typename value_type, typename comparer_type>
+        static constexpr auto _sort3(
+            value_type* a, value_type* b, value_type* c, comparer_type& comp) -> void
+        {
+            if (comp(*b, *a))
+                std::swap(*a, *b);
+
+            if (comp(*c, *b))
+                std::swap(*b, *c);
+
+            if (comp(*b, *a))
+                std::swap(*a, *b);
+        }
+
+        template <typename value_type, typename comparer_type>
+        static constexpr auto _sift_down(
+            value_type* heap, isize root, isize count, comparer_type& comp) -> void
+        {
+            value_type value = move(heap[root]);
+            while (true)
+            {
+                isize child = root * 2 + 1;
+                if (child >= count)
+                    break;
+
+                if (child + 1 < count and comp(heap[child], heap[child + 1]))
+                    child++;
+
+                if (not comp(value, heap[child]))
+                    break;
+
+                heap[root] = move(heap[child]);
+                root = child;
+            }
+
+            heap[root] = move(value);
+        }
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// `true` if `key_type` can be sorted by `_lsd_radix_sort_impl`.
+    /// --------------------------------------------------------------------------------------------
+    template <typename key_type>
+    consteval auto _is_radix_num_key() -> bool
+    {
+        if constexpr (std::is_same_v<key_type, bool>)
+            return false;
+        else if constexpr (std::is_integral_v<key_type>)
+            return true;
+        else if constexpr (std::is_floating_point_v<key_type>)
+            return sizeof(key_type) == 4 or sizeof(key_type) == 8;
+        else
+            return false;
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// `true` if `key_type` is a contiguous range of bytes, which can be sorted by
+    /// `_msd_radix_sort_impl`.
+    /// --------------------------------------------------------------------------------------------
+    template <typename key_type>
+    consteval auto _is_radix_str_key() -> bool
+    {
+        if constexpr (const_array_range_concept<key_type>)
+        {
+            using char_type = typename range_definition<key_type>::value_type;
+            return std::is_integral_v<char_type> and sizeof(char_type) == 1;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// least significant digit radix sort for integer and float keys, one byte per pass.
+    ///
+    /// counts for all bytes are taken in a single pass over the keys, and passes where all keys
+    /// share the same byte are skipped, so narrow ranges of wide keys sort in fewer passes. values
+    /// are scattered between the range and a buffer of the same size.
+    /// --------------------------------------------------------------------------------------------
+    class _lsd_radix_sort_impl
+    {
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// count of values below which comparison sort is used instead.
+        /// ----------------------------------------------------------------------------------------
+        static constexpr usize min_count = 256;
+
+    public:
+        template <typename value_type, typename key_getter_type>
+        static auto sort(value_type* data, usize count, key_getter_type& get_key) -> void
+        {
+            using key_type = std::remove_cvref_t<decltype(get_key(*data))>;
+            using bits_type = decltype(_to_bits(key_type()));
+            constexpr usize passes = sizeof(bits_type);
+
+            usize counts[passes][256] = {};
+            for (usize i = 0; i < count; i++)
+            {
+                bits_type bits = _to_bits(get_key(data[i]));
+                for (usize pass = 0; pass < passes; pass++)
+                    counts[pass][(bits >> (pass * 8)) & 0xff]++;
+            }
+
+            default_mem_allocator allocator;
+            value_type* buffer =
+                static_cast<value_type*>(allocator.alloc(count * sizeof(value_type)));
+            contract_asserts(buffer != nullptr, "out of memory.");
+
+            value_type* from = data;
+            value_type* to = buffer;
+
+            for (usize pass = 0; pass < passes; pass++)
+            {
+                usize* pass_counts = counts[pass];
+                bits_type first_byte = (_to_bits(get_key(from[0])) >> (pass * 8)) & 0xff;
+                if (pass_counts[first_byte] == count)
+                    continue;
+
+                usize offsets[256];
+                usize offset = 0;
+                for (usize i = 0; i < 256; i++)
+                {
+                    offsets[i] = offset;
+                    offset += pass_counts[i];
+                }
+
+                for (usize i = 0; i < count; i++)
+                {
+                    usize byte = (_to_bits(get_key(from[i])) >> (pass * 8)) & 0xff;
+                    std::memcpy(to + offsets[byte]++, from + i, sizeof(value_type));
+                }
+
+                std::swap(from, to);
+            }
+
+            if (from != data)
+                std::memcpy(data, from, count * sizeof(value_type));
+
+            allocator.dealloc(buffer);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// returns `true` if `key0` orders before `key1` in the order of `sort()`, which for floats
+        /// puts negative zero before positive zero.
+        /// ----------------------------------------------------------------------------------------
+        template <typename key_type>
+        static constexpr auto is_key_less(key_type key0, key_type key1) -> bool
+        {
+            return _to_bits(key0) < _to_bits(key1);
+        }
+
+    private:
+        /// ----------------------------------------------------------------------------------------
+        /// maps `key` to an unsigned integer with the same order.
+        /// ----------------------------------------------------------------------------------------
+        template <typename key_type>
+        static constexpr auto _to_bits(key_type key)
+        {
+            if constexpr (std::is_floating_point_v<key_type>)
+            {
+                using bits_type = std::conditional_t<sizeof(key_type) == 4, u32, u64>;
+                constexpr bits_type sign_bit = bits_type(1) << (sizeof(key_type) * 8 - 1);
+
+                // negative floats are ordered in reverse, so flip all their bits. positive floats
+                // only need the sign bit set to order after the negative ones.
+                bits_type bits = std::bit_cast<bits_type>(key);
+                return (bits & sign_bit) ? bits_type(~bits) : bits_type(bits | sign_bit);
+            }
+            else if constexpr (std::is_signed_v<key_type>)
+            {
+                using bits_type = std::make_unsigned_t<key_type>;
+                constexpr bits_type sign_bit = bits_type(1) << (sizeof(key_type) * 8 - 1);
+
+                return bits_type(bits_type(key) ^ sign_bit);
+            }
+            else
+            {
+                return key;
+            }
+        }
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// most significant digit radix sort for string keys.
+    ///
+    /// values are distributed in place into 257 buckets by the byte at the current depth, one
+    /// bucket for keys which end there, then each bucket is sorted by the next byte. small
+    /// buckets are finished with insertion sort on the remaining bytes.
+    /// --------------------------------------------------------------------------------------------
+    class _msd_radix_sort_impl
+    {
+    private:
+        static constexpr isize _insertion_sort_threshold = 32;
+
+    public:
+        template <typename value_type, typename key_getter_type>
+        static constexpr auto sort(
+            value_type* begin, value_type* end, usize depth, key_getter_type& get_key) -> void
+        {
+            while (end - begin > _insertion_sort_threshold)
+            {
+                usize counts[257] = {};
+                for (value_type* it = begin; it != end; it++)
+                    counts[_get_digit(get_key(*it), depth)]++;
+
+                // all keys end at this depth, they are equal.
+                if (counts[0] == usize(end - begin))
+                    return;
+
+                // all keys share this byte, skip to the next one without moving anything.
+                bool single_bucket = false;
+                for (usize i = 1; i < 257; i++)
+                {
+                    if (counts[i] == usize(end - begin))
+                    {
+                        single_bucket = true;
+                        break;
+                    }
+                }
+
+                if (single_bucket)
+                {
+                    depth++;
+                    continue;
+                }
+
+                isize heads[257];
+                isize tails[257];
+                isize offset = 0;
+                for (usize i = 0; i < 257; i++)
+                {
+                    heads[i] = offset;
+                    offset += counts[i];
+                    tails[i] = offset;
+                }
+
+                for (usize bucket = 0; bucket < 257; bucket++)
+                {
+                    while (heads[bucket] < tails[bucket])
+                    {
+                        usize digit = _get_digit(get_key(begin[heads[bucket]]), depth);
+                        if (digit == bucket)
+                            heads[bucket]++;
+                        else
+                            std::swap(begin[heads[bucket]], begin[heads[digit]++]);
+                    }
+                }
+
+                // bucket 0 holds keys which ended, they are equal.
+                isize bucket_begin = counts[0];
+                for (usize bucket = 1; bucket < 257; bucket++)
+                {
+                    isize bucket_end = bucket_begin + counts[bucket];
+                    if (counts[bucket] > 1)
+                        sort(begin + bucket_begin, begin + bucket_end, depth + 1, get_key);
+
+                    bucket_begin = bucket_end;
+                }
+
+                return;
+            }
+
+            _insertion_sort(begin, end, depth, get_key);
+        }
+
+    private:
+        /// ----------------------------------------------------------------------------------------
+        /// \returns `0` if `key` ends before `depth`, else byte at `depth` plus one.
+        /// ----------------------------------------------------------------------------------------
+        template <typename key_type>
+        static constexpr auto _get_digit(const key_type& key, usize depth) -> usize
+        {
+            if (depth >= ranges::get_count(key))
+                return 0;
+
+            return usize(u8(*(ranges::get_iterator(key) + depth))) + 1;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// compares bytes of `key0` and `key1` starting from `depth`, as unsigned bytes.
+        /// ----------------------------------------------------------------------------------------
+        template <typename key_type>
+        static constexpr auto _is_less(
+            const key_type& key0, const key_type& key1, usize depth) -> bool
+        {
+            usize count0 = ranges::get_count(key0);
+            usize count1 = ranges::get_count(key1);
+            auto it0 = ranges::get_iterator(key0);
+            auto it1 = ranges::get_iterator(key1);
+
+            for (usize i = depth; i < count0 and i < count1; i++)
+            {
+                u8 byte0 = u8(*(it0 + i));
+                u8 byte1 = u8(*(it1 + i));
+                if (byte0 != byte1)
+                    return byte0 < byte1;
+            }
+
+            return count0 < count1;
+        }
+
+        template <typename value_type, typename key_getter_type>
+        static constexpr auto _insertion_sort(
+            value_type* begin, value_type* end, usize depth, key_getter_type& get_key) -> void
+        {
+            if (begin == end)
+                return;
+
+            for (value_type* it = begin + 1; it != end; it++)
+            {
+                value_type* hole = it;
+                if (not _is_less(get_key(*hole), get_key(hole[-1]), depth))
+                    continue;
+
+                value_type value = move(*hole);
+                do
+                {
+                    *hole = move(hole[-1]);
+                    hole--;
+                } while (hole != begin and _is_less(get_key(value), get_key(hole[-1]), depth));
+
+                *hole = move(value);
+            }
+        }
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// comparer which compares keys returned by `get_key`.
+    /// --------------------------------------------------------------------------------------------
+    template <typename key_getter_type>
+    class _key_comparer
+    {
+    public:
+        template <typename value_type>
+        constexpr auto operator()(const value_type& value0, const value_type& value1) -> bool
+        {
+            return get_key(value0) < get_key(value1);
+        }
+
+    public:
+        key_getter_type& get_key;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// comparer which compares keys returned by `get_key` in the order of `_lsd_radix_sort_impl`.
+    /// --------------------------------------------------------------------------------------------
+    template <typename key_getter_type>
+    class _radix_key_comparer
+    {
+    public:
+        template <typename value_type>
+        constexpr auto operator()(const value_type& value0, const value_type& value1) -> bool
+        {
+            return _lsd_radix_sort_impl::is_key_less(get_key(value0), get_key(value1));
+        }
+
+    public:
+        key_getter_type& get_key;
+    };
+
+    class _identity_key_getter
+    {
+    public:
+        template <typename value_type>
+        constexpr auto operator()(const value_type& value) const -> const value_type&
+        {
+            return value;
+        }
+    };
+}
+
+export namespace atom::ranges
+{
+    ////////////////////////////////////////////////////////////////////////////////////////////
+    ////
+    //// sorting
+    ////
+    ////////////////////////////////////////////////////////////////////////////////////////////
+
+    /// ----------------------------------------------------------------------------------------
+    /// sorts values in `range` using `comparer`. the sort is not stable.
+    ///
+    /// uses pattern defeating quicksort, `O(n log n)` in the worst case and linear for sorted,
+    /// reverse sorted and all equal inputs.
+    /// ----------------------------------------------------------------------------------------
+    template <typename range_type, typename comparer_type = std::less<>>
+    constexpr auto sort(range_type& range, comparer_type comparer = {}) -> range_type&
+        requires array_range_concept<range_type>
+    {
+        value_type<range_type>* data = get_data(range);
+        _comparison_sort_impl::sort(data, data + get_count(range), comparer);
+        return range;
+    }
+
+    /// ----------------------------------------------------------------------------------------
+    /// sorts values in `range` by keys returned by `get_key`. the sort is not stable.
+    /// ----------------------------------------------------------------------------------------
+    template <typename range_type, typename key_getter_type>
+    constexpr auto sort_by_key(range_type& range, key_getter_type get_key) -> range_type&
+        requires array_range_concept<range_type>
+    {
+        return ranges::sort(range, _key_comparer<key_getter_type>{ get_key });
+    }
+
+    /// ----------------------------------------------------------------------------------------
+    /// sorts values in `range` using `comparer`, keeping the order of equivalent values.
+    /// ----------------------------------------------------------------------------------------
+    template <typename range_type, typename comparer_type = std::less<>>
+    constexpr auto stable_sort(range_type& range, comparer_type comparer = {}) -> range_type&
+        requires array_range_concept<range_type>
+    {
+        value_type<range_type>* data = get_data(range);
+        std::stable_sort(data, data + get_count(range), comparer);
+        return range;
+    }
+
+    /// ----------------------------------------------------------------------------------------
+    /// sorts the first `count` values of `range`, leaving the rest in unspecified order.
+    ///
+    /// selects the first `count` values with introselect, then sorts only them, so it's linear
+    /// in the range size plus `O(count log count)`.
+    ///
+    /// \pre `count <= get_count(range)`: count is out of range.
+    /// ----------------------------------------------------------------------------------------
+    template <typename range_type, typename comparer_type = std::less<>>
+    constexpr auto partial_sort(
+        range_type& range, usize count, comparer_type comparer = {}) -> range_type&
+        requires array_range_concept<range_type>
+    {
+        contract_expects(count <= get_count(range), "count is out of range.");
+
+        value_type<range_type>* data = get_data(range);
+        usize range_count = get_count(range);
+        if (count < range_count)
+            _comparison_sort_impl::select(data, data + count, data + range_count, comparer);
+
+        _comparison_sort_impl::sort(data, data + count, comparer);
+        return range;
+    }
+
+    /// ----------------------------------------------------------------------------------------
+    /// moves the value which would be at index `i` after sorting to `i`, with no greater values
+    /// before it and no lesser values after it.
+    ///
+    /// \pre `i < get_count(range)`: index is out of range.
+    /// ----------------------------------------------------------------------------------------
+    template <typename range_type, typename comparer_type = std::less<>>
+    constexpr auto nth_element(
+        range_type& range, usize i, comparer_type comparer = {}) -> range_type&
+        requires array_range_concept<range_type>
+    {
+        contract_expects(i < get_count(range), "index is out of range.");
+
+        value_type<range_type>* data = get_data(range);
+        _comparison_sort_impl::select(data, data + i, data + get_count(range), comparer);
+        return range;
+    }
+
+    /// ----------------------------------------------------------------------------------------
+    /// sorts values in `range` by keys returned by `get_key`, without comparisons.
+    ///
+    /// - integer and float keys: lsd radix sort, one byte per pass. floats are ordered with
+    ///   negative zero before positive zero and nans at the ends, by sign. values must be
+    ///   trivially copyable, the sort is stable.
+    /// - string keys (contiguous ranges of bytes): in place msd radix sort by unsigned bytes, not
+    ///   stable.
+    ///
+    /// small ranges use comparison sorts instead.
+    /// ----------------------------------------------------------------------------------------
+    template <typename range_type, typename key_getter_type>
+    auto radix_sort_by_key(range_type& range, key_getter_type get_key) -> range_type&
+        requires array_range_concept<range_type>
+    {
+        using value_type = ranges::value_type<range_type>;
+        using key_type = std::remove_cvref_t<decltype(get_key(std::declval<const value_type&>()))>;
+
+        value_type* data = get_data(range);
+        usize count = get_count(range);
+
+        if constexpr (_is_radix_num_key<key_type>())
+        {
+            static_assert(type_info<value_type>::is_trivially_copyable(),
+                "lsd radix sort needs trivially copyable values.");
+
+            // compares the same way radix sort orders, so small ranges also order negative zero
+            // before positive zero.
+            if (count < _lsd_radix_sort_impl::min_count)
+                return ranges::stable_sort(range, _radix_key_comparer<key_getter_type>{ get_key });
+
+            _lsd_radix_sort_impl::sort(data, count, get_key);
+        }
+        else
+        {
+            static_assert(_is_radix_str_key<key_type>(), "key type is not supported.");
+
+            _msd_radix_sort_impl::sort(data, data + count, 0, get_key);
+        }
+
+        return range;
+    }
+
+    /// ----------------------------------------------------------------------------------------
+    /// sorts integers, floats or strings in `range` without comparisons. see
+    /// `radix_sort_by_key()`.
+    /// ----------------------------------------------------------------------------------------
+    template <typename range_type>
+    auto radix_sort(range_type& range) -> range_type&
+        requires array_range_concept<range_type>
+    {
+        return ranges::radix_sort_by_key(range, _identity_key_getter{});
+    }
+}
@@ -0,0 +1,107 @@
+export module atom_core:ranges.range_sum;
+
+import std;
+import :core;
+import :types;
+import :ranges.range_concepts;
+import :ranges.range_definition;
+import :ranges.range_functions;
+
+namespace atom::ranges
+{
+    /// --------------------------------------------------------------------------------------------
+    /// sums integers without checking each addition, detecting overflow once at the end.
+    ///
+    /// values narrower than 64 bits are summed into a 64 bit accumulator in blocks which can't
+    /// overflow it, the inner loop is a plain widening sum and vectorizes. 64 bit values are
+    /// summed into 4 independent 128 bit accumulators, one add and one add with carry per value.
+    /// --------------------------------------------------------------------------------------------
+    class _sum_checked_impl
+    {
+    public:
+        template <typename num_type>
+        static constexpr auto sum(const num_type* data, usize count) -> option<num_type>
+        {
+            if constexpr (sizeof(num_type) < 8)
+                return _sum_narrow(data, count);
+            else
+                return _sum_wide(data, count);
+        }
+
+    private:
+        template <typename num_type>
+        static constexpr auto _sum_narrow(const num_type* data, usize count) -> option<num_type>
+        {
+            using acc_type = std::conditional_t<std::is_signed_v<num_type>, i64, u64>;
+
+            // `2^31` values of up to 32 bits sum to less than `2^63`.
+            constexpr usize block_count = usize(1) << 31;
+
+            acc_type total = 0;
+            bool overflow = false;
+            while (count > 0)
+            {
+                usize block = count < block_count ? count : block_count;
+
+                acc_type sum = 0;
+                for (usize i = 0; i < block; i++)
+                    sum += data[i];
+
+                overflow |= __builtin_add_overflow(total, sum, &total);
+                data += block;
+                count -= block;
+            }
+
+            if (overflow or total < acc_type(std::numeric_limits<num_type>::min())
+                or total > acc_type(std::numeric_limits<num_type>::max()))
+                return { create_from_null };
+
+            return num_type(total);
+        }
+
+        template <typename num_type>
+        static constexpr auto _sum_wide(const num_type* data, usize count) -> option<num_type>
+        {
+            using acc_type =
+                std::conditional_t<std::is_signed_v<num_type>, __int128, unsigned __int128>;
+
+            acc_type lanes[4] = { 0, 0, 0, 0 };
+            usize i = 0;
+            for (; i + 4 <= count; i += 4)
+            {
+                lanes[0] += data[i];
+                lanes[1] += data[i + 1];
+                lanes[2] += data[i + 2];
+                lanes[3] += data[i + 3];
+            }
+
+            for (; i < count; i++)
+                lanes[0] += data[i];
+
+            acc_type total = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+            if (total < acc_type(std::numeric_limits<num_type>::min())
+                or total > acc_type(std::numeric_limits<num_type>::max()))
+                return { create_from_null };
+
+            return num_type(total);
+        }
+    };
+}
+
+export namespace atom::ranges
+{
+    /// --------------------------------------------------------------------------------------------
+    /// returns sum of integers in `range`, or null if the sum doesn't fit in the value type.
+    ///
+    /// intermediate sums may exceed the value type as long as the final sum fits. costs about the
+    /// same as an unchecked sum, see `_sum_checked_impl`.
+    /// --------------------------------------------------------------------------------------------
+    template <typename range_type>
+    constexpr auto sum_checked(const range_type& range) -> option<value_type<range_type>>
+        requires const_array_range_concept<range_type>
+                 and std::is_integral_v<value_type<range_type>>
+                 and (not std::is_same_v<value_type<range_type>, bool>)
+    {
+        return _sum_checked_impl::sum(get_data(range), get_count(range));
+    }
+}
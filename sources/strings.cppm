@@ -12,3 +12,9 @@ export import :strings.format_string;
 export import :strings.static_string;
 export import :strings.dynamic_string;
 export import :strings.buf_string;
+export import :strings.num_conversions;
+export import :strings.utf8;
+export import :strings.string_split;
+export import :strings.symbol;
+export import :strings.string_builder;
+export import :strings.fixed_string;
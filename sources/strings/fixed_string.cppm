@@ -0,0 +1,197 @@
+export module atom_core:strings.fixed_string;
+
+import std;
+import :core;
+import :types;
+import :strings.string_view;
+
+export namespace atom::strings
+{
+    /// --------------------------------------------------------------------------------------------
+    /// returns the 64 bit fnv-1a hash of `str`. usable at compile time, and equal to
+    /// `fixed_string::get_hash()` for the same chars.
+    /// --------------------------------------------------------------------------------------------
+    constexpr auto get_hash(string_view str) -> u64
+    {
+        u64 hash = 0xcbf29ce484222325;
+        for (usize i = 0; i < str.get_count(); i++)
+        {
+            hash ^= u8(str[i]);
+            hash *= 0x100000001b3;
+        }
+
+        return hash;
+    }
+}
+
+namespace atom
+{
+    /// --------------------------------------------------------------------------------------------
+    /// string of `in_count` chars fixed at compile time, stored inline with a null terminator.
+    ///
+    /// it is a structural type, so it can be used as a non-type template parameter:
+    /// `template <fixed_string name>`, which accepts string literals as `type<"name">`. its hash
+    /// is computed at compile time, which allows switching on string keys:
+    /// `case fixed_string{ "name" }.get_hash():`, see also `fixed_string_set`.
+    /// --------------------------------------------------------------------------------------------
+    export template <usize in_count>
+    class fixed_string
+    {
+        using this_type = fixed_string;
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// # literal constructor
+        /// ----------------------------------------------------------------------------------------
+        constexpr fixed_string(const char (&str)[in_count + 1])
+        {
+            for (usize i = 0; i < in_count + 1; i++)
+                chars[i] = str[i];
+        }
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// returns the count of chars, without the null terminator.
+        /// ----------------------------------------------------------------------------------------
+        static constexpr auto get_count() -> usize
+        {
+            return in_count;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// returns pointer to the chars, which are null terminated.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto get_data() const -> const char*
+        {
+            return chars;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// returns a view of the chars.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto get_view() const -> string_view
+        {
+            return string_view(create_from_raw, chars, in_count);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// returns the fnv-1a hash, computed at compile time. see `strings::get_hash()`.
+        /// ----------------------------------------------------------------------------------------
+        consteval auto get_hash() const -> u64
+        {
+            return strings::get_hash(get_view());
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        ///
+        /// ----------------------------------------------------------------------------------------
+        constexpr operator string_view() const
+        {
+            return get_view();
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        ///
+        /// ----------------------------------------------------------------------------------------
+        template <usize that_count>
+        constexpr auto operator==(const fixed_string<that_count>& that) const -> bool
+        {
+            return std::string_view(get_view()) == std::string_view(that.get_view());
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        ///
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto operator==(string_view str) const -> bool
+        {
+            return std::string_view(get_view()) == std::string_view(str);
+        }
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// public to keep this a structural type, don't modify.
+        /// ----------------------------------------------------------------------------------------
+        char chars[in_count + 1];
+    };
+
+    export template <usize count>
+    fixed_string(const char (&str)[count]) -> fixed_string<count - 1>;
+
+    /// --------------------------------------------------------------------------------------------
+    /// set of strings fixed at compile time, for mapping runtime strings to indices of `strs`.
+    ///
+    /// `find()` hashes its input once and compares it with the precomputed hashes of `strs`,
+    /// comparing chars only when a hash matches. hashes of `strs` are checked to be unique at
+    /// compile time.
+    /// --------------------------------------------------------------------------------------------
+    export template <fixed_string... strs>
+    class fixed_string_set
+    {
+        static constexpr u64 _hashes[] = { strs.get_hash()... };
+        static constexpr string_view _views[] = { strs.get_view()... };
+
+        static consteval auto _has_unique_hashes() -> bool
+        {
+            for (usize i = 0; i < sizeof...(strs); i++)
+            {
+                for (usize j = i + 1; j < sizeof...(strs); j++)
+                {
+                    if (_hashes[i] == _hashes[j])
+                        return false;
+                }
+            }
+
+            return true;
+        }
+
+        static_assert(sizeof...(strs) > 0, "set is empty.");
+        static_assert(_has_unique_hashes(), "strings are repeated or their hashes collide.");
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// returns the count of strings.
+        /// ----------------------------------------------------------------------------------------
+        static constexpr auto get_count() -> usize
+        {
+            return sizeof...(strs);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// returns the string at index `i`.
+        /// ----------------------------------------------------------------------------------------
+        static constexpr auto get_at(usize i) -> string_view
+        {
+            return _views[i];
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// returns the index of `str`, or null if it's not in the set.
+        /// ----------------------------------------------------------------------------------------
+        static constexpr auto find(string_view str) -> option<usize>
+        {
+            u64 hash = strings::get_hash(str);
+            for (usize i = 0; i < sizeof...(strs); i++)
+            {
+                if (_hashes[i] == hash and std::string_view(_views[i]) == std::string_view(str))
+                    return i;
+            }
+
+            return { create_from_null };
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// returns the index of `str`, checked at compile time to be in the set.
+        /// ----------------------------------------------------------------------------------------
+        template <fixed_string str>
+        static consteval auto get_index() -> usize
+        {
+            for (usize i = 0; i < sizeof...(strs); i++)
+            {
+                if (_hashes[i] == str.get_hash() and str == _views[i])
+                    return i;
+            }
+
+            throw "string is not in the set.";
+        }
+    };
+}
@@ -0,0 +1,353 @@
+export module atom_core:strings.num_conversions;
+
+import std;
+import :core;
+import :containers;
+import :strings.string_view;
+
+namespace atom
+{
+    /// --------------------------------------------------------------------------------------------
+    /// error representing a string which is not a valid number.
+    /// --------------------------------------------------------------------------------------------
+    export class invalid_num_error: public error
+    {
+    public:
+        constexpr invalid_num_error()
+            : error{ "string is not a valid number." }
+        {}
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// error representing a number which doesn't fit in the requested type.
+    /// --------------------------------------------------------------------------------------------
+    export class num_out_of_range_error: public error
+    {
+    public:
+        constexpr num_out_of_range_error()
+            : error{ "number is out of range." }
+        {}
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// error representing an output buffer which can't hold the result.
+    /// --------------------------------------------------------------------------------------------
+    export class buffer_too_small_error: public error
+    {
+    public:
+        constexpr buffer_too_small_error()
+            : error{ "buffer is too small." }
+        {}
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// implementation of integer parsing and formatting.
+    ///
+    /// parsing reads 8 digits at a time into a `u64` and validates and converts them with a few
+    /// multiplications (swar), instead of one multiply and branch per digit. formatting writes
+    /// two digits at a time from a lookup table, after counting the digits with a bit scan.
+    /// --------------------------------------------------------------------------------------------
+    class _int_conversions_impl
+    {
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// parses decimal digits in `[begin, end)` as `u64`.
+        ///
+        /// \returns `0` if valid, `1` if not all chars are digits, `2` if the value overflows.
+        /// ----------------------------------------------------------------------------------------
+        static constexpr auto parse_u64(const char* begin, const char* end, u64& out) -> i32
+        {
+            if (begin == end)
+                return 1;
+
+            const char* it = begin;
+            while (it != end and *it == '0')
+                it++;
+
+            // 19 digits always fit in `u64`, so no overflow checks are needed until then.
+            const char* safe_end = end - it > 19 ? it + 19 : end;
+            u64 value = 0;
+
+            if constexpr (std::endian::native == std::endian::little)
+            {
+                if (not std::is_constant_evaluated())
+                {
+                    while (safe_end - it >= 8)
+                    {
+                        u64 chunk = _load_u64(it);
+                        if (not _is_8_digits(chunk))
+                            break;
+
+                        value = value * 100'000'000 + _parse_8_digits(chunk);
+                        it += 8;
+                    }
+                }
+            }
+
+            for (; it != safe_end; it++)
+            {
+                u8 digit = u8(*it - '0');
+                if (digit > 9)
+                    return 1;
+
+                value = value * 10 + digit;
+            }
+
+            if (it == end)
+            {
+                out = value;
+                return 0;
+            }
+
+            // `u64` max has 20 digits, check the last digit for overflow.
+            u8 digit = u8(*it - '0');
+            if (digit > 9)
+                return 1;
+
+            bool overflow = value > (nums::get_max_u64() - digit) / 10;
+            value = value * 10 + digit;
+            it++;
+
+            for (; it != end; it++)
+            {
+                if (u8(*it - '0') > 9)
+                    return 1;
+
+                overflow = true;
+            }
+
+            if (overflow)
+                return 2;
+
+            out = value;
+            return 0;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns count of decimal digits in `value`.
+        /// ----------------------------------------------------------------------------------------
+        static constexpr auto count_digits(u64 value) -> usize
+        {
+            constexpr u64 powers[] = { 1, 10, 100, 1'000, 10'000, 100'000, 1'000'000, 10'000'000,
+                100'000'000, 1'000'000'000, 10'000'000'000, 100'000'000'000, 1'000'000'000'000,
+                10'000'000'000'000, 100'000'000'000'000, 1'000'000'000'000'000,
+                10'000'000'000'000'000, 100'000'000'000'000'000, 1'000'000'000'000'000'000,
+                10'000'000'000'000'000'000u };
+
+            // approximates `log10` from `log2`, then corrects it with one comparison. `| 1` makes
+            // `0` count as one digit.
+            value |= 1;
+            usize log10 = (std::bit_width(value) * 1233) >> 12;
+            return log10 - (value < powers[log10]) + 1;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// writes decimal digits of `value` ending at `end`.
+        /// ----------------------------------------------------------------------------------------
+        static constexpr auto write_u64_backwards(u64 value, char* end) -> void
+        {
+            constexpr char digit_pairs[] = "00010203040506070809"
+                                           "10111213141516171819"
+                                           "20212223242526272829"
+                                           "30313233343536373839"
+                                           "40414243444546474849"
+                                           "50515253545556575859"
+                                           "60616263646566676869"
+                                           "70717273747576777879"
+                                           "80818283848586878889"
+                                           "90919293949596979899";
+
+            while (value >= 100)
+            {
+                usize pair = (value % 100) * 2;
+                value /= 100;
+                *--end = digit_pairs[pair + 1];
+                *--end = digit_pairs[pair];
+            }
+
+            if (value >= 10)
+            {
+                usize pair = value * 2;
+                *--end = digit_pairs[pair + 1];
+                *--end = digit_pairs[pair];
+            }
+            else
+            {
+                *--end = char('0' + value);
+            }
+        }
+
+    private:
+        static auto _load_u64(const char* data) -> u64
+        {
+            u64 value;
+            std::memcpy(&value, data, sizeof(u64));
+            return value;
+        }
+
+        static constexpr auto _is_8_digits(u64 chunk) -> bool
+        {
+            // each byte's high nibble must be `3`, and adding `6` to its low nibble must not
+            // carry into the high nibble.
+            return ((chunk & 0xF0F0F0F0F0F0F0F0)
+                       | (((chunk + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4))
+                   == 0x3333333333333333;
+        }
+
+        static constexpr auto _parse_8_digits(u64 chunk) -> u64
+        {
+            constexpr u64 mask = 0x000000FF000000FF;
+            constexpr u64 mul1 = 0x000F424000000064; // 100 + (1000000 << 32)
+            constexpr u64 mul2 = 0x0000271000000001; // 1 + (10000 << 32)
+
+            // combines adjacent digits into 2 digit values, then 2 digit values into 8 digit one.
+            chunk -= 0x3030303030303030;
+            chunk = (chunk * 10) + (chunk >> 8);
+            chunk = (((chunk & mask) * mul1) + (((chunk >> 16) & mask) * mul2)) >> 32;
+            return u32(chunk);
+        }
+    };
+
+    template <typename num_type>
+    consteval auto _is_parsable_int() -> bool
+    {
+        return std::is_integral_v<num_type> and not std::is_same_v<num_type, bool>
+               and not std::is_same_v<num_type, char>;
+    }
+}
+
+export namespace atom::nums
+{
+    /// --------------------------------------------------------------------------------------------
+    /// count of chars needed to write any value of `num_type` with `to_chars()`.
+    /// --------------------------------------------------------------------------------------------
+    template <typename num_type>
+    consteval auto get_max_chars_count() -> usize
+    {
+        if constexpr (std::is_floating_point_v<num_type>)
+        {
+            // sign, digits, point, exponent sign and up to 4 digits of exponent.
+            return std::numeric_limits<num_type>::max_digits10 + 8;
+        }
+        else
+        {
+            return std::numeric_limits<num_type>::digits10 + 2;
+        }
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// parses `str` as a decimal number of `num_type`. the whole string must be the number.
+    ///
+    /// integers are an optional `-` for signed types followed by digits. floats are in the
+    /// general format, optionally with an exponent, or `inf` and `nan`.
+    /// --------------------------------------------------------------------------------------------
+    template <typename num_type>
+    constexpr auto parse(
+        string_view str) -> result<num_type, invalid_num_error, num_out_of_range_error>
+        requires(_is_parsable_int<num_type>() or std::is_floating_point_v<num_type>)
+    {
+        const char* begin = str.get_data();
+        const char* end = begin + str.get_count();
+
+        if constexpr (std::is_floating_point_v<num_type>)
+        {
+            num_type value;
+            std::from_chars_result result = std::from_chars(begin, end, value);
+            if (result.ec == std::errc::result_out_of_range)
+                return num_out_of_range_error();
+
+            if (result.ec != std::errc() or result.ptr != end)
+                return invalid_num_error();
+
+            return value;
+        }
+        else
+        {
+            bool negative = false;
+            if constexpr (std::is_signed_v<num_type>)
+            {
+                if (begin != end and *begin == '-')
+                {
+                    negative = true;
+                    begin++;
+                }
+            }
+
+            u64 value;
+            i32 status = _int_conversions_impl::parse_u64(begin, end, value);
+            if (status == 1)
+                return invalid_num_error();
+
+            using unsigned_type = std::make_unsigned_t<num_type>;
+            constexpr u64 max = u64(std::numeric_limits<num_type>::max());
+
+            if (status == 2 or value > max + negative)
+                return num_out_of_range_error();
+
+            if (negative)
+                return num_type(unsigned_type(0) - unsigned_type(value));
+
+            return num_type(value);
+        }
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// writes `num` as decimal chars into `out`. floats are written in the shortest form that
+    /// parses back to the same value.
+    ///
+    /// \returns count of chars written.
+    /// --------------------------------------------------------------------------------------------
+    template <typename num_type>
+    constexpr auto to_chars(
+        num_type num, array_slice<char> out) -> result<usize, buffer_too_small_error>
+        requires(_is_parsable_int<num_type>() or std::is_floating_point_v<num_type>)
+    {
+        char* begin = out.get_data();
+        char* end = begin + out.get_count();
+
+        if constexpr (std::is_floating_point_v<num_type>)
+        {
+            std::to_chars_result result = std::to_chars(begin, end, num);
+            if (result.ec != std::errc())
+                return buffer_too_small_error();
+
+            return usize(result.ptr - begin);
+        }
+        else
+        {
+            u64 value = u64(num);
+            bool negative = false;
+            if constexpr (std::is_signed_v<num_type>)
+            {
+                if (num < 0)
+                {
+                    negative = true;
+                    value = u64(0) - value;
+                }
+            }
+
+            usize count = _int_conversions_impl::count_digits(value) + negative;
+            if (count > usize(end - begin))
+                return buffer_too_small_error();
+
+            if (negative)
+                begin[0] = '-';
+
+            _int_conversions_impl::write_u64_backwards(value, begin + count);
+            return count;
+        }
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// appends `num` as decimal chars to `out`, which can be `string` or any `dynamic_array` of
+    /// chars. see `to_chars(num_type, array_slice<char>)`.
+    /// --------------------------------------------------------------------------------------------
+    template <typename num_type, typename output_type>
+    constexpr auto to_chars(num_type num, output_type& out) -> void
+        requires(_is_parsable_int<num_type>() or std::is_floating_point_v<num_type>)
+                and requires { out.reserve_spare(usize(0)); out.commit_spare(usize(0)); }
+    {
+        array_slice<char> spare = out.reserve_spare(get_max_chars_count<num_type>());
+        out.commit_spare(to_chars(num, spare).get_value());
+    }
+}
@@ -0,0 +1,374 @@
+export module atom_core:strings.string_builder;
+
+import std;
+import :core;
+import :contracts;
+import :default_mem_allocator;
+import :ranges;
+import :strings.format_string;
+import :strings.string_formatter_provider;
+import :strings.string_formatting;
+import :strings.string_view;
+import :strings.string;
+
+namespace atom
+{
+    /// --------------------------------------------------------------------------------------------
+    /// header of a chunk of `string_builder`, followed by `capacity` chars.
+    /// --------------------------------------------------------------------------------------------
+    class _string_builder_chunk
+    {
+    public:
+        auto get_data() -> char*
+        {
+            return reinterpret_cast<char*>(this + 1);
+        }
+
+        auto get_data() const -> const char*
+        {
+            return reinterpret_cast<const char*>(this + 1);
+        }
+
+    public:
+        _string_builder_chunk* next;
+        usize count;
+        usize capacity;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// builds large strings from many small pieces.
+    ///
+    /// text is appended into a chain of chunks which are never moved or copied while building,
+    /// unlike `string` which copies everything written so far every time it grows. chunks grow
+    /// geometrically up to `max_chunk_size`, pieces larger than that get a chunk of their own. the
+    /// result is copied once by `to_string()`, or passed chunk by chunk to a writer by
+    /// `for_each_chunk()`, see `filesystem::file::write_builder()`.
+    /// --------------------------------------------------------------------------------------------
+    export class string_builder
+    {
+        using this_type = string_builder;
+        using allocator_type = default_mem_allocator;
+        using _chunk = _string_builder_chunk;
+
+    public:
+        using value_type = char;
+
+    public:
+        static constexpr usize min_chunk_size = 256;
+        static constexpr usize max_chunk_size = 64 * 1024;
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// # default constructor
+        ///
+        /// allocates nothing until the first append.
+        /// ----------------------------------------------------------------------------------------
+        string_builder()
+            : _first{ nullptr }
+            , _last{ nullptr }
+            , _count{ 0 }
+            , _chunk_count{ 0 }
+            , _allocator{}
+        {}
+
+        /// ----------------------------------------------------------------------------------------
+        /// # named constructor
+        ///
+        /// reserves a first chunk of `count` chars.
+        /// ----------------------------------------------------------------------------------------
+        string_builder(create_with_capacity_tag, usize count)
+            : string_builder{}
+        {
+            _add_chunk(count);
+        }
+
+        string_builder(const this_type&) = delete;
+        string_builder& operator=(const this_type&) = delete;
+
+        string_builder(this_type&& that)
+            : _first{ that._first }
+            , _last{ that._last }
+            , _count{ that._count }
+            , _chunk_count{ that._chunk_count }
+            , _allocator{ move(that._allocator) }
+        {
+            that._first = nullptr;
+            that._last = nullptr;
+            that._count = 0;
+            that._chunk_count = 0;
+        }
+
+        string_builder& operator=(this_type&& that)
+        {
+            if (this == &that)
+                return *this;
+
+            _release();
+
+            _first = that._first;
+            _last = that._last;
+            _count = that._count;
+            _chunk_count = that._chunk_count;
+            _allocator = move(that._allocator);
+
+            that._first = nullptr;
+            that._last = nullptr;
+            that._count = 0;
+            that._chunk_count = 0;
+            return *this;
+        }
+
+        ~string_builder()
+        {
+            _release();
+        }
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// appends `str`.
+        /// ----------------------------------------------------------------------------------------
+        auto append(string_view str) -> this_type&
+        {
+            const char* data = str.get_data();
+            usize count = str.get_count();
+
+            if (count == 0)
+                return *this;
+
+            usize spare = _last == nullptr ? 0 : _last->capacity - _last->count;
+            if (count > spare)
+            {
+                // fill the current chunk, then put the rest in a new one.
+                if (spare > 0)
+                {
+                    std::memcpy(_last->get_data() + _last->count, data, spare);
+                    _last->count += spare;
+                    _count += spare;
+                    data += spare;
+                    count -= spare;
+                }
+
+                _add_chunk(count);
+            }
+
+            std::memcpy(_last->get_data() + _last->count, data, count);
+            _last->count += count;
+            _count += count;
+            return *this;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// appends `ch`.
+        /// ----------------------------------------------------------------------------------------
+        auto append(char ch) -> this_type&
+        {
+            if (_last == nullptr or _last->count == _last->capacity)
+                _add_chunk(1);
+
+            _last->get_data()[_last->count] = ch;
+            _last->count++;
+            _count++;
+            return *this;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// appends `str` formatted with `args`.
+        ///
+        /// formats directly into the spare space of the last chunk. if the result doesn't fit,
+        /// formats it again into a new chunk big enough for it.
+        /// ----------------------------------------------------------------------------------------
+        template <typename... arg_types>
+        auto append_fmt(format_string<arg_types...> fmt, arg_types&&... args) -> this_type&
+            requires(string_formatter_provider<arg_types>::has() and ...)
+        {
+            usize spare = _last == nullptr ? 0 : _last->capacity - _last->count;
+            char* out = _last == nullptr ? nullptr : _last->get_data() + _last->count;
+            usize count = _format_to_n(out, spare, fmt, atom::forward<arg_types>(args)...);
+
+            if (count == 0)
+                return *this;
+
+            if (count > spare)
+            {
+                // args are only referenced by the formatter, forwarding them again is safe.
+                _add_chunk(count);
+                _format_to_n(_last->get_data(), count, fmt, atom::forward<arg_types>(args)...);
+            }
+
+            _last->count += count;
+            _count += count;
+            return *this;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// appends each string of `strs`, with `separator` between them.
+        /// ----------------------------------------------------------------------------------------
+        template <typename range_type>
+        auto append_join(const range_type& strs, string_view separator) -> this_type&
+            requires ranges::const_range_concept<range_type>
+        {
+            auto it = ranges::get_iterator(strs);
+            auto it_end = ranges::get_iterator_end(strs);
+            if (it == it_end)
+                return *this;
+
+            append(string_view{ *it });
+            for (++it; it != it_end; ++it)
+            {
+                append(separator);
+                append(string_view{ *it });
+            }
+
+            return *this;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// same as `append(str)`.
+        /// ----------------------------------------------------------------------------------------
+        auto operator+=(string_view str) -> this_type&
+        {
+            return append(str);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// same as `append(ch)`. also lets `string::format_to()` write to this.
+        /// ----------------------------------------------------------------------------------------
+        auto operator+=(char ch) -> this_type&
+        {
+            return append(ch);
+        }
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// returns the built string, copying all chunks once.
+        /// ----------------------------------------------------------------------------------------
+        auto to_string() const -> string
+        {
+            string str;
+            array_slice<char> out = str.reserve_spare(_count);
+
+            char* it = out.get_data();
+            for (const _chunk* chunk = _first; chunk != nullptr; chunk = chunk->next)
+            {
+                std::memcpy(it, chunk->get_data(), chunk->count);
+                it += chunk->count;
+            }
+
+            str.commit_spare(_count);
+            return str;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// calls `func` with a `string_view` of each non empty chunk in order. the views stay
+        /// valid until this is modified or destroyed.
+        /// ----------------------------------------------------------------------------------------
+        template <typename function_type>
+        auto for_each_chunk(function_type&& func) const -> void
+        {
+            for (const _chunk* chunk = _first; chunk != nullptr; chunk = chunk->next)
+            {
+                if (chunk->count > 0)
+                    func(string_view(create_from_raw, chunk->get_data(), chunk->count));
+            }
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// removes all chars. keeps the first chunk and releases the rest.
+        /// ----------------------------------------------------------------------------------------
+        auto clear() -> void
+        {
+            if (_first == nullptr)
+                return;
+
+            _chunk* chunk = _first->next;
+            while (chunk != nullptr)
+            {
+                _chunk* next = chunk->next;
+                _allocator.dealloc(chunk);
+                chunk = next;
+            }
+
+            _first->next = nullptr;
+            _first->count = 0;
+            _last = _first;
+            _count = 0;
+            _chunk_count = 1;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// returns the count of chars appended.
+        /// ----------------------------------------------------------------------------------------
+        auto get_count() const -> usize
+        {
+            return _count;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// returns the count of chunks allocated, which is an upper bound of the count of views
+        /// passed to `for_each_chunk()`.
+        /// ----------------------------------------------------------------------------------------
+        auto get_chunk_count() const -> usize
+        {
+            return _chunk_count;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// returns `true` if no chars were appended.
+        /// ----------------------------------------------------------------------------------------
+        auto is_empty() const -> bool
+        {
+            return _count == 0;
+        }
+
+    private:
+        /// ----------------------------------------------------------------------------------------
+        /// adds a chunk with space for at least `count` chars. each chunk is twice as big as the
+        /// previous one, up to `max_chunk_size`.
+        /// ----------------------------------------------------------------------------------------
+        auto _add_chunk(usize count) -> void
+        {
+            usize capacity = _last == nullptr ? min_chunk_size : _last->capacity * 2;
+            capacity = std::min(capacity, max_chunk_size);
+            capacity = std::max(capacity, count);
+
+            _chunk* chunk = static_cast<_chunk*>(_allocator.alloc(sizeof(_chunk) + capacity));
+            contract_asserts(chunk != nullptr, "out of memory.");
+
+            std::construct_at(chunk);
+            chunk->next = nullptr;
+            chunk->count = 0;
+            chunk->capacity = capacity;
+
+            if (_last == nullptr)
+                _first = chunk;
+            else
+                _last->next = chunk;
+
+            _last = chunk;
+            _chunk_count++;
+        }
+
+        auto _release() -> void
+        {
+            _chunk* chunk = _first;
+            while (chunk != nullptr)
+            {
+                _chunk* next = chunk->next;
+                _allocator.dealloc(chunk);
+                chunk = next;
+            }
+
+            _first = nullptr;
+            _last = nullptr;
+            _count = 0;
+            _chunk_count = 0;
+        }
+
+    private:
+        _chunk* _first;
+        _chunk* _last;
+        usize _count;
+        usize _chunk_count;
+        allocator_type _allocator;
+    };
+}
@@ -84,4 +84,26 @@ namespace atom
             throw _fmt_error_to_string_format_error(err);
         }
     }
+
+    /// --------------------------------------------------------------------------------------------
+    /// formats into `out`, writing at most `count` chars.
+    ///
+    /// returns the count of chars of the whole formatted string, which may be more than `count`.
+    /// --------------------------------------------------------------------------------------------
+    template <typename... arg_types>
+    constexpr auto _format_to_n(
+        char* out, usize count, format_string<arg_types...> fmt, arg_types&&... args) -> usize
+    {
+        try
+        {
+            return fmt::format_to_n(out, count,
+                _convert_format_string_atom_to_fmt<arg_types...>(fmt),
+                format_arg_wrapper(atom::forward<arg_types>(args))...)
+                .size;
+        }
+        catch (const fmt::format_error& err)
+        {
+            throw _fmt_error_to_string_format_error(err);
+        }
+    }
 }
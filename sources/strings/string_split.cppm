@@ -0,0 +1,506 @@
+export module atom_core:strings.string_split;
+
+import std;
+import :core;
+import :contracts;
+import :containers;
+import :ranges;
+import :strings.string_view;
+
+namespace atom
+{
+    /// --------------------------------------------------------------------------------------------
+    /// finds chars of a set of delimiters.
+    ///
+    /// for sets of up to 8 chars, scans 8 chars at a time: each word is xored with each delimiter
+    /// repeated in every byte, and a zero byte test finds the first match across all of them.
+    /// larger sets, and the tail, look up each char in a 256 bit table.
+    /// --------------------------------------------------------------------------------------------
+    class _char_set_finder
+    {
+        static constexpr usize _max_swar_count = 8;
+
+    public:
+        constexpr _char_set_finder(string_view set)
+            : _table{ 0, 0, 0, 0 }
+            , _swar_patterns{}
+            , _swar_count{ 0 }
+        {
+            for (usize i = 0; i < set.get_count(); i++)
+            {
+                u8 ch = u8(set.get_data()[i]);
+                _table[ch >> 6] |= u64(1) << (ch & 63);
+            }
+
+            if (set.get_count() <= _max_swar_count)
+            {
+                _swar_count = set.get_count();
+                for (usize i = 0; i < _swar_count; i++)
+                    _swar_patterns[i] = u64(0x0101010101010101) * u8(set.get_data()[i]);
+            }
+        }
+
+    public:
+        constexpr auto contains(char ch) const -> bool
+        {
+            return (_table[u8(ch) >> 6] >> (u8(ch) & 63)) & 1;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// returns pointer to the first delimiter in `[it, end)`, or `end` if there is none.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto find(const char* it, const char* end) const -> const char*
+        {
+            if constexpr (std::endian::native == std::endian::little)
+            {
+                if (not std::is_constant_evaluated() and _swar_count != 0)
+                {
+                    for (; end - it >= 8; it += 8)
+                    {
+                        u64 word;
+                        std::memcpy(&word, it, sizeof(u64));
+
+                        u64 matches = 0;
+                        for (usize i = 0; i < _swar_count; i++)
+                            matches |= _get_zero_bytes(word ^ _swar_patterns[i]);
+
+                        if (matches != 0)
+                            return it + std::countr_zero(matches) / 8;
+                    }
+                }
+            }
+
+            for (; it != end; it++)
+            {
+                if (contains(*it))
+                    return it;
+            }
+
+            return end;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// returns pointer to the first char in `[it, end)` which is not a delimiter, or `end` if
+        /// there is none.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto skip(const char* it, const char* end) const -> const char*
+        {
+            while (it != end and contains(*it))
+                it++;
+
+            return it;
+        }
+
+    private:
+        /// ----------------------------------------------------------------------------------------
+        /// returns `word` with the high bit set in each zero byte and all other bits clear. exact,
+        /// unlike the cheaper test whose borrow can flag bytes after a zero byte.
+        /// ----------------------------------------------------------------------------------------
+        static constexpr auto _get_zero_bytes(u64 word) -> u64
+        {
+            constexpr u64 low_bits = 0x7F7F7F7F7F7F7F7F;
+            return ~(((word & low_bits) + low_bits) | word | low_bits);
+        }
+
+    private:
+        u64 _table[4];
+        u64 _swar_patterns[_max_swar_count];
+        usize _swar_count;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// splitters for `string_split_view`.
+    ///
+    /// `next()` sets `token` to the token starting at `it` and advances `it` past it, returning
+    /// `false` if there are no more tokens. `it` is set to `nullptr` after the last token, for
+    /// splitters which yield an empty token after a trailing delimiter.
+    /// --------------------------------------------------------------------------------------------
+    class _char_splitter
+    {
+    public:
+        constexpr _char_splitter(char delim)
+            : _delim{ delim }
+        {}
+
+    public:
+        constexpr auto next(const char*& it, const char* end, string_view& token) const -> bool
+        {
+            if (it == nullptr)
+                return false;
+
+            // `find()` is `memchr()` at runtime, which is vectorized by the c library.
+            usize index = std::string_view(it, usize(end - it)).find(_delim);
+            const char* found = index == std::string_view::npos ? end : it + index;
+
+            token = string_view(create_from_raw, it, usize(found - it));
+            it = found == end ? nullptr : found + 1;
+            return true;
+        }
+
+    private:
+        char _delim;
+    };
+
+    class _str_splitter
+    {
+    public:
+        constexpr _str_splitter(string_view delim)
+            : _delim{ delim }
+        {
+            contract_expects(not delim.is_empty(), "delimiter is empty.");
+        }
+
+    public:
+        constexpr auto next(const char*& it, const char* end, string_view& token) const -> bool
+        {
+            if (it == nullptr)
+                return false;
+
+            usize index = std::string_view(it, usize(end - it)).find(_delim);
+            const char* found = index == std::string_view::npos ? end : it + index;
+
+            token = string_view(create_from_raw, it, usize(found - it));
+            it = found == end ? nullptr : found + _delim.size();
+            return true;
+        }
+
+    private:
+        std::string_view _delim;
+    };
+
+    class _char_set_splitter
+    {
+    public:
+        constexpr _char_set_splitter(string_view delims)
+            : _finder{ delims }
+        {}
+
+    public:
+        constexpr auto next(const char*& it, const char* end, string_view& token) const -> bool
+        {
+            if (it == nullptr)
+                return false;
+
+            const char* found = _finder.find(it, end);
+            token = string_view(create_from_raw, it, usize(found - it));
+            it = found == end ? nullptr : found + 1;
+            return true;
+        }
+
+    private:
+        _char_set_finder _finder;
+    };
+
+    class _char_set_tokenizer
+    {
+    public:
+        constexpr _char_set_tokenizer(string_view delims)
+            : _finder{ delims }
+        {}
+
+    public:
+        constexpr auto next(const char*& it, const char* end, string_view& token) const -> bool
+        {
+            it = _finder.skip(it, end);
+            if (it == end)
+                return false;
+
+            const char* found = _finder.find(it, end);
+            token = string_view(create_from_raw, it, usize(found - it));
+            it = found;
+            return true;
+        }
+
+    private:
+        _char_set_finder _finder;
+    };
+
+    class _line_splitter
+    {
+    public:
+        constexpr auto next(const char*& it, const char* end, string_view& token) const -> bool
+        {
+            if (it == end)
+                return false;
+
+            usize index = std::string_view(it, usize(end - it)).find('\n');
+            const char* found = index == std::string_view::npos ? end : it + index;
+            const char* token_end = found != it and found[-1] == '\r' ? found - 1 : found;
+
+            token = string_view(create_from_raw, it, usize(token_end - it));
+            it = found == end ? end : found + 1;
+            return true;
+        }
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// iterator over tokens of a `string_split_view`.
+    /// --------------------------------------------------------------------------------------------
+    export template <typename in_splitter_type>
+    class string_split_iterator
+    {
+        using this_type = string_split_iterator;
+
+    public:
+        using splitter_type = in_splitter_type;
+        using value_type = string_view;
+        using reference = const string_view&;
+        using pointer = const string_view*;
+        using difference_type = isize;
+        using iterator_category = std::forward_iterator_tag;
+        using iterator_concept = std::forward_iterator_tag;
+
+    public:
+        constexpr string_split_iterator()
+            : _it{ nullptr }
+            , _end{ nullptr }
+            , _token{ create_from_raw, nullptr, 0 }
+            , _splitter{ nullptr }
+            , _is_end{ true }
+        {}
+
+        constexpr string_split_iterator(
+            const char* begin, const char* end, const splitter_type* splitter)
+            : _it{ begin }
+            , _end{ end }
+            , _token{ create_from_raw, nullptr, 0 }
+            , _splitter{ splitter }
+            , _is_end{ true }
+        {
+            // an empty string has no tokens, not one empty token.
+            if (begin != end)
+                _is_end = not _splitter->next(_it, _end, _token);
+        }
+
+    public:
+        constexpr auto operator*() const -> reference
+        {
+            return _token;
+        }
+
+        constexpr auto operator->() const -> pointer
+        {
+            return &_token;
+        }
+
+        constexpr auto operator++() -> this_type&
+        {
+            _is_end = not _splitter->next(_it, _end, _token);
+            return *this;
+        }
+
+        constexpr auto operator++(int) -> this_type
+        {
+            this_type copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        constexpr auto operator==(const this_type& that) const -> bool
+        {
+            if (_is_end or that._is_end)
+                return _is_end == that._is_end;
+
+            return _token.get_data() == that._token.get_data();
+        }
+
+    private:
+        const char* _it;
+        const char* _end;
+        string_view _token;
+        const splitter_type* _splitter;
+        bool _is_end;
+    };
+
+    export class string_split_view_tag
+    {};
+
+    /// --------------------------------------------------------------------------------------------
+    /// lazy range of `string_view` tokens of a string.
+    ///
+    /// tokens are found while iterating, and point into the string, so nothing is allocated. the
+    /// string must outlive the view and its iterators, and iterators must not outlive the view.
+    /// --------------------------------------------------------------------------------------------
+    export template <typename in_splitter_type>
+    class string_split_view: public string_split_view_tag
+    {
+    public:
+        using splitter_type = in_splitter_type;
+        using value_type = string_view;
+        using const_iterator_type = string_split_iterator<splitter_type>;
+        using const_iterator_end_type = const_iterator_type;
+
+    public:
+        constexpr string_split_view(string_view str, splitter_type splitter)
+            : _str{ str }
+            , _splitter{ splitter }
+        {}
+
+    public:
+        constexpr auto get_iterator() const -> const_iterator_type
+        {
+            const char* data = _str.get_data();
+            return const_iterator_type(data, data + _str.get_count(), &_splitter);
+        }
+
+        constexpr auto get_iterator_end() const -> const_iterator_end_type
+        {
+            return const_iterator_end_type();
+        }
+
+    private:
+        string_view _str;
+        splitter_type _splitter;
+    };
+
+    export template <typename range_type>
+        requires(type_info<range_type>::template is_derived_from<string_split_view_tag>())
+    class ranges::range_definition<range_type>
+    {
+    public:
+        using value_type = typename range_type::value_type;
+        using const_iterator_type = typename range_type::const_iterator_type;
+        using const_iterator_end_type = typename range_type::const_iterator_end_type;
+
+    public:
+        static constexpr auto get_const_iterator(const range_type& range) -> const_iterator_type
+        {
+            return range.get_iterator();
+        }
+
+        static constexpr auto get_const_iterator_end(
+            const range_type& range) -> const_iterator_end_type
+        {
+            return range.get_iterator_end();
+        }
+    };
+}
+
+export namespace atom::strings
+{
+    /// --------------------------------------------------------------------------------------------
+    /// splits `str` at each `delim`.
+    ///
+    /// yields empty tokens between adjacent delimiters and after a trailing delimiter, and no
+    /// tokens for an empty string.
+    /// --------------------------------------------------------------------------------------------
+    constexpr auto split(string_view str, char delim) -> string_split_view<_char_splitter>
+    {
+        return string_split_view(str, _char_splitter(delim));
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// splits `str` at each occurrence of `delim`. see `split(string_view, char)`.
+    ///
+    /// \pre `not delim.is_empty()`: delimiter is empty.
+    /// --------------------------------------------------------------------------------------------
+    constexpr auto split(string_view str, string_view delim) -> string_split_view<_str_splitter>
+    {
+        return string_split_view(str, _str_splitter(delim));
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// splits `str` at each char which is one of `delims`. see `split(string_view, char)`.
+    /// --------------------------------------------------------------------------------------------
+    constexpr auto split_any(
+        string_view str, string_view delims) -> string_split_view<_char_set_splitter>
+    {
+        return string_split_view(str, _char_set_splitter(delims));
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// splits `str` into tokens separated by runs of chars which are any of `delims`.
+    ///
+    /// unlike `split_any()`, never yields empty tokens, so leading, trailing and repeated
+    /// delimiters are skipped.
+    /// --------------------------------------------------------------------------------------------
+    constexpr auto tokenize(
+        string_view str, string_view delims) -> string_split_view<_char_set_tokenizer>
+    {
+        return string_split_view(str, _char_set_tokenizer(delims));
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// splits `str` into lines ending with `\n` or `\r\n`, without the line endings.
+    ///
+    /// a trailing line ending doesn't start another line.
+    /// --------------------------------------------------------------------------------------------
+    constexpr auto split_lines(string_view str) -> string_split_view<_line_splitter>
+    {
+        return string_split_view(str, _line_splitter());
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// returns `true` if `ch` is an ascii whitespace char.
+    /// --------------------------------------------------------------------------------------------
+    constexpr auto is_space(char ch) -> bool
+    {
+        return ch == ' ' or (ch >= '\t' and ch <= '\r');
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// returns `str` without leading ascii whitespace.
+    /// --------------------------------------------------------------------------------------------
+    constexpr auto trim_start(string_view str) -> string_view
+    {
+        const char* it = str.get_data();
+        const char* end = it + str.get_count();
+        while (it != end and is_space(*it))
+            it++;
+
+        return string_view(create_from_raw, it, usize(end - it));
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// returns `str` without trailing ascii whitespace.
+    /// --------------------------------------------------------------------------------------------
+    constexpr auto trim_end(string_view str) -> string_view
+    {
+        const char* begin = str.get_data();
+        const char* it = begin + str.get_count();
+        while (it != begin and is_space(it[-1]))
+            it--;
+
+        return string_view(create_from_raw, begin, usize(it - begin));
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// returns `str` without leading and trailing ascii whitespace.
+    /// --------------------------------------------------------------------------------------------
+    constexpr auto trim(string_view str) -> string_view
+    {
+        return trim_end(trim_start(str));
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// returns `true` if `str` starts with `prefix`.
+    /// --------------------------------------------------------------------------------------------
+    constexpr auto starts_with(string_view str, string_view prefix) -> bool
+    {
+        return std::string_view(str).starts_with(prefix);
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// returns `true` if `str` starts with `ch`.
+    /// --------------------------------------------------------------------------------------------
+    constexpr auto starts_with(string_view str, char ch) -> bool
+    {
+        return not str.is_empty() and str.get_first() == ch;
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// returns `true` if `str` ends with `suffix`.
+    /// --------------------------------------------------------------------------------------------
+    constexpr auto ends_with(string_view str, string_view suffix) -> bool
+    {
+        return std::string_view(str).ends_with(suffix);
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// returns `true` if `str` ends with `ch`.
+    /// --------------------------------------------------------------------------------------------
+    constexpr auto ends_with(string_view str, char ch) -> bool
+    {
+        return not str.is_empty() and str.get_data()[str.get_count() - 1] == ch;
+    }
+}
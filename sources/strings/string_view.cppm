@@ -14,6 +14,8 @@ namespace atom
         using base_type = array_view<char>;
 
     public:
+        constexpr string_view() = default;
+
         explicit constexpr string_view(const char* str)
             : base_type{ ranges::from(str) }
         {}
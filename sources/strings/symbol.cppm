@@ -0,0 +1,429 @@
+export module atom_core:strings.symbol;
+
+import std;
+import :core;
+import :contracts;
+import :mutex;
+import :lock_guard;
+import :default_mem_allocator;
+import :containers;
+import :ranges;
+import :strings.string_view;
+
+namespace atom
+{
+    /// --------------------------------------------------------------------------------------------
+    /// header of an interned string in the arena of `symbol_table`, followed by its chars and a
+    /// null terminator.
+    /// --------------------------------------------------------------------------------------------
+    class _symbol_entry
+    {
+    public:
+        auto get_data() const -> const char*
+        {
+            return reinterpret_cast<const char*>(this + 1);
+        }
+
+        auto is_eq(string_view str, usize str_hash) const -> bool
+        {
+            return hash == str_hash and count == str.get_count()
+                   and std::memcmp(get_data(), str.get_data(), count) == 0;
+        }
+
+    public:
+        usize hash;
+        u32 id;
+        u32 count;
+    };
+
+    export class symbol_table;
+
+    /// --------------------------------------------------------------------------------------------
+    /// an interned string.
+    ///
+    /// all symbols of equal strings interned in the same `symbol_table` point to the same entry,
+    /// so comparing and hashing them is constant time, a pointer compare and a load. the chars are
+    /// stored once in the table, and live as long as it. `intern()` uses a global table which is
+    /// never destroyed.
+    /// --------------------------------------------------------------------------------------------
+    export class symbol
+    {
+        friend symbol_table;
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// constructs null symbol, which is not equal to any interned symbol.
+        /// ----------------------------------------------------------------------------------------
+        constexpr symbol()
+            : _entry{ nullptr }
+        {}
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// interns `str` in the global table.
+        /// ----------------------------------------------------------------------------------------
+        static auto intern(string_view str) -> symbol;
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// returns the interned string, which is null terminated. empty for null symbol.
+        /// ----------------------------------------------------------------------------------------
+        auto get_str() const -> string_view
+        {
+            if (_entry == nullptr)
+                return string_view(create_from_raw, "", 0);
+
+            return string_view(create_from_raw, _entry->get_data(), _entry->count);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// returns the index of this symbol in its table. ids are dense, starting from `0` in
+        /// the order the symbols were interned, so they can index arrays.
+        ///
+        /// \pre `not is_null()`: symbol is null.
+        /// ----------------------------------------------------------------------------------------
+        auto get_id() const -> u32
+        {
+            contract_debug_expects(not is_null(), "symbol is null.");
+
+            return _entry->id;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// returns the hash of the string, computed once when interning. equal to
+        /// `std::hash<std::string_view>` of the string, so maps keyed by symbols can be looked up
+        /// with strings too.
+        /// ----------------------------------------------------------------------------------------
+        auto get_hash() const -> usize
+        {
+            if (_entry == nullptr)
+                return std::hash<std::string_view>()(std::string_view());
+
+            return _entry->hash;
+        }
+
+        constexpr auto is_null() const -> bool
+        {
+            return _entry == nullptr;
+        }
+
+        constexpr auto operator==(const symbol& that) const -> bool
+        {
+            return _entry == that._entry;
+        }
+
+    private:
+        constexpr explicit symbol(const _symbol_entry* entry)
+            : _entry{ entry }
+        {}
+
+    private:
+        const _symbol_entry* _entry;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// concurrent table of interned strings.
+    ///
+    /// entries are bump allocated in an arena, and indexed by an open addressing hash table of
+    /// atomic pointers. looking up an interned string takes no lock: the table is published with
+    /// release stores, and entries are never moved or removed. interning a new string takes a
+    /// lock. when the index grows, the old index stays alive until the table is destroyed, so
+    /// readers still probing it are safe, and a miss there is rechecked under the lock.
+    /// --------------------------------------------------------------------------------------------
+    export class symbol_table
+    {
+        using this_type = symbol_table;
+        using allocator_type = default_mem_allocator;
+
+        class _index
+        {
+        public:
+            auto get_slots() -> std::atomic<const _symbol_entry*>*
+            {
+                return reinterpret_cast<std::atomic<const _symbol_entry*>*>(this + 1);
+            }
+
+        public:
+            usize capacity;
+            _index* prev;
+        };
+
+        static constexpr usize _min_capacity = 256;
+        static constexpr usize _chunk_size = 64 * 1024;
+
+    public:
+        symbol_table()
+            : _index_ptr{ nullptr }
+            , _count{ 0 }
+            , _chunk{ nullptr }
+            , _chunk_ptr{ nullptr }
+            , _chunk_remaining{ 0 }
+            , _lock{}
+            , _allocator{}
+        {
+            _index_ptr.store(_alloc_index(_min_capacity, nullptr), std::memory_order_release);
+        }
+
+        symbol_table(const this_type&) = delete;
+        symbol_table& operator=(const this_type&) = delete;
+
+        ~symbol_table()
+        {
+            _index* index = _index_ptr.load(std::memory_order_relaxed);
+            while (index != nullptr)
+            {
+                _index* prev = index->prev;
+                _allocator.dealloc(index);
+                index = prev;
+            }
+
+            void* chunk = _chunk;
+            while (chunk != nullptr)
+            {
+                void* prev = *static_cast<void**>(chunk);
+                _allocator.dealloc(chunk);
+                chunk = prev;
+            }
+        }
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// returns the global table used by `symbol::intern()`.
+        /// ----------------------------------------------------------------------------------------
+        static auto get_global() -> this_type&
+        {
+            // never destroyed, so symbols stay valid in static destructors.
+            static this_type* table = new this_type();
+            return *table;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// returns the symbol for `str`, interning it if it's not interned yet.
+        ///
+        /// \pre `str.get_count() <= nums::get_max<u32>()`: string is too long.
+        /// ----------------------------------------------------------------------------------------
+        auto intern(string_view str) -> symbol
+        {
+            contract_expects(str.get_count() <= nums::get_max<u32>(), "string is too long.");
+
+            usize hash = _hash(str);
+            _index* index = _index_ptr.load(std::memory_order_acquire);
+            const _symbol_entry* entry = _find(index, str, hash);
+            if (entry != nullptr)
+                return symbol(entry);
+
+            lock_guard guard{ _lock };
+            return symbol(_insert(str, hash));
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// interns each string of `strs`, writing their symbols to `out`.
+        ///
+        /// looks up all strings without the lock first, then takes the lock once to intern the
+        /// ones which were not found.
+        ///
+        /// \pre `get_count(strs) <= out.get_count()`: output is too small.
+        /// \pre each string's count is at most `nums::get_max<u32>()`: string is too long.
+        /// ----------------------------------------------------------------------------------------
+        template <typename range_type>
+        auto intern_all(const range_type& strs, array_slice<symbol> out) -> void
+            requires ranges::const_array_range_concept<range_type>
+        {
+            usize count = ranges::get_count(strs);
+            contract_expects(count <= out.get_count(), "output is too small.");
+
+            const auto* data = ranges::get_data(strs);
+            _index* index = _index_ptr.load(std::memory_order_acquire);
+
+            bool has_missing = false;
+            for (usize i = 0; i < count; i++)
+            {
+                string_view str{ data[i] };
+                contract_expects(str.get_count() <= nums::get_max<u32>(), "string is too long.");
+
+                out[i] = symbol(_find(index, str, _hash(str)));
+                has_missing |= out[i].is_null();
+            }
+
+            if (not has_missing)
+                return;
+
+            lock_guard guard{ _lock };
+            for (usize i = 0; i < count; i++)
+            {
+                if (out[i].is_null())
+                {
+                    string_view str{ data[i] };
+                    out[i] = symbol(_insert(str, _hash(str)));
+                }
+            }
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// returns the symbol for `str` if it's interned, without interning it.
+        /// ----------------------------------------------------------------------------------------
+        auto find(string_view str) const -> option<symbol>
+        {
+            usize hash = _hash(str);
+            _index* index = _index_ptr.load(std::memory_order_acquire);
+            const _symbol_entry* entry = _find(index, str, hash);
+            if (entry == nullptr)
+            {
+                // may have been interned after an index grew, check the latest one.
+                lock_guard guard{ _lock };
+                entry = _find(_index_ptr.load(std::memory_order_relaxed), str, hash);
+                if (entry == nullptr)
+                    return { create_from_null };
+            }
+
+            return symbol(entry);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// returns the count of interned strings.
+        /// ----------------------------------------------------------------------------------------
+        auto get_count() const -> usize
+        {
+            return _count.load(std::memory_order_relaxed);
+        }
+
+    private:
+        static auto _hash(string_view str) -> usize
+        {
+            return std::hash<std::string_view>()(str);
+        }
+
+        static auto _find(_index* index, string_view str, usize hash) -> const _symbol_entry*
+        {
+            std::atomic<const _symbol_entry*>* slots = index->get_slots();
+            usize mask = index->capacity - 1;
+
+            // the index is at most half full, so there is always an empty slot to stop at.
+            for (usize i = hash & mask;; i = (i + 1) & mask)
+            {
+                const _symbol_entry* entry = slots[i].load(std::memory_order_acquire);
+                if (entry == nullptr)
+                    return nullptr;
+
+                if (entry->is_eq(str, hash))
+                    return entry;
+            }
+        }
+
+        static auto _place(_index* index, const _symbol_entry* entry) -> void
+        {
+            std::atomic<const _symbol_entry*>* slots = index->get_slots();
+            usize mask = index->capacity - 1;
+
+            usize i = entry->hash & mask;
+            while (slots[i].load(std::memory_order_relaxed) != nullptr)
+                i = (i + 1) & mask;
+
+            slots[i].store(entry, std::memory_order_release);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// interns `str`. the lock must be held.
+        /// ----------------------------------------------------------------------------------------
+        auto _insert(string_view str, usize hash) -> const _symbol_entry*
+        {
+            _index* index = _index_ptr.load(std::memory_order_relaxed);
+
+            // another thread may have interned it since the lookup.
+            const _symbol_entry* entry = _find(index, str, hash);
+            if (entry != nullptr)
+                return entry;
+
+            usize count = _count.load(std::memory_order_relaxed);
+            contract_asserts(count < nums::get_max<u32>(), "too many symbols.");
+
+            if ((count + 1) * 2 > index->capacity)
+                index = _grow(index);
+
+            entry = _alloc_entry(str, hash, u32(count));
+            _place(index, entry);
+            _count.store(count + 1, std::memory_order_relaxed);
+            return entry;
+        }
+
+        auto _grow(_index* index) -> _index*
+        {
+            _index* new_index = _alloc_index(index->capacity * 2, index);
+
+            std::atomic<const _symbol_entry*>* slots = index->get_slots();
+            for (usize i = 0; i < index->capacity; i++)
+            {
+                const _symbol_entry* entry = slots[i].load(std::memory_order_relaxed);
+                if (entry != nullptr)
+                    _place(new_index, entry);
+            }
+
+            _index_ptr.store(new_index, std::memory_order_release);
+            return new_index;
+        }
+
+        auto _alloc_index(usize capacity, _index* prev) -> _index*
+        {
+            usize size = sizeof(_index) + capacity * sizeof(std::atomic<const _symbol_entry*>);
+            _index* index = static_cast<_index*>(_allocator.alloc(size));
+            contract_asserts(index != nullptr, "out of memory.");
+
+            index->capacity = capacity;
+            index->prev = prev;
+
+            std::atomic<const _symbol_entry*>* slots = index->get_slots();
+            for (usize i = 0; i < capacity; i++)
+                std::construct_at(slots + i, nullptr);
+
+            return index;
+        }
+
+        auto _alloc_entry(string_view str, usize hash, u32 id) -> const _symbol_entry*
+        {
+            constexpr usize align = alignof(_symbol_entry);
+            usize size = (sizeof(_symbol_entry) + str.get_count() + 1 + align - 1) & ~(align - 1);
+
+            if (size > _chunk_remaining)
+            {
+                // each chunk starts with a pointer to the previous one. big strings get a chunk
+                // of their own.
+                usize chunk_size = std::max(_chunk_size, sizeof(void*) + size);
+                void* chunk = _allocator.alloc(chunk_size);
+                contract_asserts(chunk != nullptr, "out of memory.");
+
+                *static_cast<void**>(chunk) = _chunk;
+
+                _chunk = chunk;
+                _chunk_ptr = static_cast<char*>(chunk) + sizeof(void*);
+                _chunk_remaining = chunk_size - sizeof(void*);
+            }
+
+            _symbol_entry* entry = std::construct_at(reinterpret_cast<_symbol_entry*>(_chunk_ptr));
+            entry->hash = hash;
+            entry->id = id;
+            entry->count = u32(str.get_count());
+
+            char* chars = reinterpret_cast<char*>(entry + 1);
+            std::memcpy(chars, str.get_data(), str.get_count());
+            chars[str.get_count()] = '\0';
+
+            _chunk_ptr += size;
+            _chunk_remaining -= size;
+            return entry;
+        }
+
+    private:
+        std::atomic<_index*> _index_ptr;
+        std::atomic<usize> _count;
+        void* _chunk;
+        char* _chunk_ptr;
+        usize _chunk_remaining;
+        mutable simple_mutex _lock;
+        allocator_type _allocator;
+    };
+
+    auto symbol::intern(string_view str) -> symbol
+    {
+        return symbol_table::get_global().intern(str);
+    }
+}
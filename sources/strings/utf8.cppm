@@ -0,0 +1,826 @@
+module;
+#if defined(__x86_64__) || defined(__i386__)
+#    include <immintrin.h>
+#endif
+
+export module atom_core:strings.utf8;
+
+import std;
+import :core;
+import :containers;
+import :ranges;
+import :strings.string_view;
+import :strings.num_conversions;
+
+#include "atom/core/preprocessors.h"
+
+#if (defined(__x86_64__) || defined(__i386__))                                                     \
+    && (defined(ATOM_COMPILER_CLANG) || defined(ATOM_COMPILER_GNUC))
+#    define _ATOM_UTF8_AVX2
+#endif
+
+namespace atom
+{
+    /// --------------------------------------------------------------------------------------------
+    /// error representing a string which is not valid utf-8.
+    /// --------------------------------------------------------------------------------------------
+    export class invalid_utf8_error: public error
+    {
+    public:
+        constexpr invalid_utf8_error()
+            : error{ "string is not valid utf-8." }
+        {}
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// error representing a string which is not valid utf-16.
+    /// --------------------------------------------------------------------------------------------
+    export class invalid_utf16_error: public error
+    {
+    public:
+        constexpr invalid_utf16_error()
+            : error{ "string is not valid utf-16." }
+        {}
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// error representing a string which is not valid utf-32.
+    /// --------------------------------------------------------------------------------------------
+    export class invalid_utf32_error: public error
+    {
+    public:
+        constexpr invalid_utf32_error()
+            : error{ "string is not valid utf-32." }
+        {}
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// implementation of utf-8 validation, decoding and encoding.
+    ///
+    /// validation processes 32 bytes at a time with avx2 when the cpu supports it, using the
+    /// lookup algorithm by keiser and lemire: three table lookups on the nibbles of each byte and
+    /// the byte before it classify every error in a two byte window, and two saturating
+    /// subtractions check that three and four byte sequences have enough continuation bytes.
+    /// there is no branch per byte, and pure ascii blocks are skipped with a single test.
+    ///
+    /// everything else is scalar, with an 8 byte ascii fast path.
+    /// --------------------------------------------------------------------------------------------
+    class _utf8_impl
+    {
+    public:
+        static constexpr char32_t replacement_code_point = 0xFFFD;
+
+    public:
+        static constexpr auto is_valid(const char* data, usize count) -> bool
+        {
+#if defined(_ATOM_UTF8_AVX2)
+            if (not std::is_constant_evaluated() and _has_avx2())
+                return _is_valid_avx2(data, count);
+#endif
+
+            return _is_valid_scalar(data, count);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// decodes the code point at `data`, reading at most `count` chars.
+        ///
+        /// \returns count of chars decoded, or `0` if the chars are not a valid sequence.
+        /// ----------------------------------------------------------------------------------------
+        static constexpr auto decode(const char* data, usize count, char32_t& out) -> usize
+        {
+            u32 byte0 = u8(data[0]);
+            if (byte0 < 0x80)
+            {
+                out = byte0;
+                return 1;
+            }
+
+            // continuation bytes and overlong two byte sequences.
+            if (byte0 < 0xC2)
+                return 0;
+
+            if (byte0 < 0xE0)
+            {
+                if (count < 2 or not is_continuation(data[1]))
+                    return 0;
+
+                out = ((byte0 & 0x1F) << 6) | (u8(data[1]) & 0x3F);
+                return 2;
+            }
+
+            if (byte0 < 0xF0)
+            {
+                if (count < 3 or not is_continuation(data[1]) or not is_continuation(data[2]))
+                    return 0;
+
+                u32 byte1 = u8(data[1]);
+
+                // overlong sequences and surrogates.
+                if ((byte0 == 0xE0 and byte1 < 0xA0) or (byte0 == 0xED and byte1 >= 0xA0))
+                    return 0;
+
+                out = ((byte0 & 0x0F) << 12) | ((byte1 & 0x3F) << 6) | (u8(data[2]) & 0x3F);
+                return 3;
+            }
+
+            if (byte0 < 0xF5)
+            {
+                if (count < 4 or not is_continuation(data[1]) or not is_continuation(data[2])
+                    or not is_continuation(data[3]))
+                    return 0;
+
+                u32 byte1 = u8(data[1]);
+
+                // overlong sequences and code points above `0x10FFFF`.
+                if ((byte0 == 0xF0 and byte1 < 0x90) or (byte0 == 0xF4 and byte1 >= 0x90))
+                    return 0;
+
+                out = ((byte0 & 0x07) << 18) | ((byte1 & 0x3F) << 12) | ((u8(data[2]) & 0x3F) << 6)
+                      | (u8(data[3]) & 0x3F);
+                return 4;
+            }
+
+            return 0;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns count of chars needed to encode `code_point`.
+        /// ----------------------------------------------------------------------------------------
+        static constexpr auto get_encoded_count(char32_t code_point) -> usize
+        {
+            return 1 + (code_point >= 0x80) + (code_point >= 0x800) + (code_point >= 0x10000);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// writes `code_point` at `out`, which has space for `get_encoded_count(code_point)` chars.
+        /// ----------------------------------------------------------------------------------------
+        static constexpr auto encode(char32_t code_point, char* out) -> usize
+        {
+            if (code_point < 0x80)
+            {
+                out[0] = char(code_point);
+                return 1;
+            }
+
+            if (code_point < 0x800)
+            {
+                out[0] = char(0xC0 | (code_point >> 6));
+                out[1] = char(0x80 | (code_point & 0x3F));
+                return 2;
+            }
+
+            if (code_point < 0x10000)
+            {
+                out[0] = char(0xE0 | (code_point >> 12));
+                out[1] = char(0x80 | ((code_point >> 6) & 0x3F));
+                out[2] = char(0x80 | (code_point & 0x3F));
+                return 3;
+            }
+
+            out[0] = char(0xF0 | (code_point >> 18));
+            out[1] = char(0x80 | ((code_point >> 12) & 0x3F));
+            out[2] = char(0x80 | ((code_point >> 6) & 0x3F));
+            out[3] = char(0x80 | (code_point & 0x3F));
+            return 4;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns count of leading chars in `[data, data + count)` which are ascii, rounded
+        /// down to a multiple of 8.
+        /// ----------------------------------------------------------------------------------------
+        static constexpr auto skip_ascii(const char* data, usize count) -> usize
+        {
+            usize i = 0;
+            if (not std::is_constant_evaluated())
+            {
+                while (i + 8 <= count and (_load_u64(data + i) & 0x8080808080808080) == 0)
+                    i += 8;
+            }
+
+            return i;
+        }
+
+        static constexpr auto is_continuation(char ch) -> bool
+        {
+            return (u8(ch) & 0xC0) == 0x80;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// transcodes `str` to utf-16 or utf-32 into `out`, validating it.
+        /// ----------------------------------------------------------------------------------------
+        template <typename char_type>
+        static constexpr auto transcode(string_view str, array_slice<char_type> out)
+            -> result<usize, invalid_utf8_error, buffer_too_small_error>
+        {
+            const char* data = str.get_data();
+            usize count = str.get_count();
+            char_type* out_data = out.get_data();
+            usize out_count = out.get_count();
+
+            usize i = 0;
+            usize j = 0;
+            while (i < count)
+            {
+                usize ascii_count = skip_ascii(data + i, count - i);
+                if (ascii_count > out_count - j)
+                    ascii_count = (out_count - j) & ~usize(7);
+
+                for (usize k = 0; k < ascii_count; k++)
+                    out_data[j + k] = char_type(data[i + k]);
+
+                i += ascii_count;
+                j += ascii_count;
+                if (i == count)
+                    break;
+
+                char32_t code_point;
+                usize length = decode(data + i, count - i, code_point);
+                if (length == 0)
+                    return invalid_utf8_error();
+
+                if constexpr (std::is_same_v<char_type, char16_t>)
+                {
+                    if (code_point >= 0x10000)
+                    {
+                        if (out_count - j < 2)
+                            return buffer_too_small_error();
+
+                        code_point -= 0x10000;
+                        out_data[j++] = char16_t(0xD800 + (code_point >> 10));
+                        out_data[j++] = char16_t(0xDC00 + (code_point & 0x3FF));
+                        i += length;
+                        continue;
+                    }
+                }
+
+                if (j == out_count)
+                    return buffer_too_small_error();
+
+                out_data[j++] = char_type(code_point);
+                i += length;
+            }
+
+            return j;
+        }
+
+    private:
+        static auto _load_u64(const char* data) -> u64
+        {
+            u64 value;
+            std::memcpy(&value, data, sizeof(u64));
+            return value;
+        }
+
+        static constexpr auto _is_valid_scalar(const char* data, usize count) -> bool
+        {
+            usize i = 0;
+            while (i < count)
+            {
+                i += skip_ascii(data + i, count - i);
+                if (i == count)
+                    break;
+
+                char32_t code_point;
+                usize length = decode(data + i, count - i, code_point);
+                if (length == 0)
+                    return false;
+
+                i += length;
+            }
+
+            return true;
+        }
+
+#if defined(_ATOM_UTF8_AVX2)
+        static auto _has_avx2() -> bool
+        {
+            static const bool has = __builtin_cpu_supports("avx2");
+            return has;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// error flags of the lookup tables. each byte pair gets the flags its first byte's high
+        /// nibble, first byte's low nibble and second byte's high nibble all agree on.
+        /// ----------------------------------------------------------------------------------------
+        static constexpr u8 _too_short = 1 << 0;
+        static constexpr u8 _too_long = 1 << 1;
+        static constexpr u8 _overlong_3 = 1 << 2;
+        static constexpr u8 _too_large = 1 << 3;
+        static constexpr u8 _surrogate = 1 << 4;
+        static constexpr u8 _overlong_2 = 1 << 5;
+        static constexpr u8 _too_large_1000 = 1 << 6;
+        static constexpr u8 _overlong_4 = 1 << 6;
+        static constexpr u8 _two_conts = 1 << 7;
+        static constexpr u8 _carry = _too_short | _too_long | _two_conts;
+
+        /// maximum value of each of the last 3 bytes of a block which doesn't end in the middle
+        /// of a sequence.
+        alignas(32) static constexpr u8 _incomplete_max[32] = { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xEF, 0xDF, 0xBF };
+
+        class _avx2_state
+        {
+        public:
+            __m256i error;
+            __m256i prev_input;
+            __m256i prev_incomplete;
+        };
+
+        __attribute__((target("avx2"))) static auto _is_valid_avx2(
+            const char* data, usize count) -> bool
+        {
+            _avx2_state state{ _mm256_setzero_si256(), _mm256_setzero_si256(),
+                _mm256_setzero_si256() };
+
+            usize i = 0;
+            for (; i + 32 <= count; i += 32)
+            {
+                __m256i input = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+                _check_block(state, input);
+            }
+
+            if (i < count)
+            {
+                // pads the tail with zeros, which are ascii.
+                alignas(32) char tail[32] = {};
+                std::memcpy(tail, data + i, count - i);
+                _check_block(state, _mm256_load_si256(reinterpret_cast<const __m256i*>(tail)));
+            }
+
+            __m256i error = _mm256_or_si256(state.error, state.prev_incomplete);
+            return _mm256_testz_si256(error, error);
+        }
+
+        __attribute__((target("avx2"))) static auto _check_block(
+            _avx2_state& state, __m256i input) -> void
+        {
+            if (_mm256_movemask_epi8(input) == 0)
+            {
+                // an ascii block can't complete a sequence left incomplete by the previous block.
+                state.error = _mm256_or_si256(state.error, state.prev_incomplete);
+            }
+            else
+            {
+                __m256i prev1 = _get_prev<1>(input, state.prev_input);
+                __m256i special_cases = _check_special_cases(input, prev1);
+                __m256i lengths = _check_multibyte_lengths(input, state.prev_input, special_cases);
+
+                state.error = _mm256_or_si256(state.error, lengths);
+                state.prev_incomplete = _mm256_subs_epu8(input,
+                    _mm256_load_si256(reinterpret_cast<const __m256i*>(_incomplete_max)));
+            }
+
+            state.prev_input = input;
+        }
+
+        __attribute__((target("avx2"))) static auto _check_special_cases(
+            __m256i input, __m256i prev1) -> __m256i
+        {
+            const __m256i byte_1_high_table = _make_table(
+                // 0_______ ________, ascii in byte 1.
+                _too_long, _too_long, _too_long, _too_long, _too_long, _too_long, _too_long,
+                _too_long,
+                // 10______ ________, continuation in byte 1.
+                _two_conts, _two_conts, _two_conts, _two_conts,
+                // 1100____ ________, two byte lead in byte 1.
+                _too_short | _overlong_2,
+                // 1101____ ________, two byte lead in byte 1.
+                _too_short,
+                // 1110____ ________, three byte lead in byte 1.
+                _too_short | _overlong_3 | _surrogate,
+                // 1111____ ________, four byte lead in byte 1.
+                _too_short | _too_large | _too_large_1000 | _overlong_4);
+
+            const __m256i byte_1_low_table = _make_table(
+                // ____0000 ________
+                _carry | _overlong_3 | _overlong_2 | _overlong_4,
+                // ____0001 ________
+                _carry | _overlong_2,
+                // ____001_ ________
+                _carry, _carry,
+                // ____0100 ________
+                _carry | _too_large,
+                // ____0101 ________
+                _carry | _too_large | _too_large_1000,
+                // ____011_ ________
+                _carry | _too_large | _too_large_1000, _carry | _too_large | _too_large_1000,
+                // ____1___ ________
+                _carry | _too_large | _too_large_1000, _carry | _too_large | _too_large_1000,
+                _carry | _too_large | _too_large_1000, _carry | _too_large | _too_large_1000,
+                _carry | _too_large | _too_large_1000,
+                // ____1101 ________
+                _carry | _too_large | _too_large_1000 | _surrogate,
+                _carry | _too_large | _too_large_1000, _carry | _too_large | _too_large_1000);
+
+            const __m256i byte_2_high_table = _make_table(
+                // ________ 0_______, ascii in byte 2.
+                _too_short, _too_short, _too_short, _too_short, _too_short, _too_short, _too_short,
+                _too_short,
+                // ________ 1000____
+                _too_long | _overlong_2 | _two_conts | _overlong_3 | _too_large_1000
+                    | _overlong_4,
+                // ________ 1001____
+                _too_long | _overlong_2 | _two_conts | _overlong_3 | _too_large,
+                // ________ 101_____
+                _too_long | _overlong_2 | _two_conts | _surrogate | _too_large,
+                _too_long | _overlong_2 | _two_conts | _surrogate | _too_large,
+                // ________ 11______, lead in byte 2.
+                _too_short, _too_short, _too_short, _too_short);
+
+            const __m256i low_nibble_mask = _mm256_set1_epi8(0x0F);
+            __m256i prev1_high = _mm256_and_si256(_mm256_srli_epi16(prev1, 4), low_nibble_mask);
+            __m256i prev1_low = _mm256_and_si256(prev1, low_nibble_mask);
+            __m256i input_high = _mm256_and_si256(_mm256_srli_epi16(input, 4), low_nibble_mask);
+
+            __m256i byte_1_high = _mm256_shuffle_epi8(byte_1_high_table, prev1_high);
+            __m256i byte_1_low = _mm256_shuffle_epi8(byte_1_low_table, prev1_low);
+            __m256i byte_2_high = _mm256_shuffle_epi8(byte_2_high_table, input_high);
+
+            return _mm256_and_si256(_mm256_and_si256(byte_1_high, byte_1_low), byte_2_high);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// the tables flag every continuation following a continuation as `_two_conts`. that is
+        /// valid only for the second and third byte after a three or four byte lead, which is
+        /// exactly when the byte 2 or 3 positions back is at least `0xE0` or `0xF0`.
+        /// ----------------------------------------------------------------------------------------
+        __attribute__((target("avx2"))) static auto _check_multibyte_lengths(
+            __m256i input, __m256i prev_input, __m256i special_cases) -> __m256i
+        {
+            __m256i prev2 = _get_prev<2>(input, prev_input);
+            __m256i prev3 = _get_prev<3>(input, prev_input);
+
+            __m256i is_third_byte = _mm256_subs_epu8(prev2, _mm256_set1_epi8(0xE0 - 0x80));
+            __m256i is_fourth_byte = _mm256_subs_epu8(prev3, _mm256_set1_epi8(0xF0 - 0x80));
+            __m256i must_be_continuation = _mm256_and_si256(
+                _mm256_or_si256(is_third_byte, is_fourth_byte), _mm256_set1_epi8(i8(0x80)));
+
+            return _mm256_xor_si256(must_be_continuation, special_cases);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// \returns bytes of `input` shifted by `count` positions, with the last bytes of
+        /// `prev_input` shifted in.
+        /// ----------------------------------------------------------------------------------------
+        template <int count>
+        __attribute__((target("avx2"))) static auto _get_prev(
+            __m256i input, __m256i prev_input) -> __m256i
+        {
+            return _mm256_alignr_epi8(
+                input, _mm256_permute2x128_si256(prev_input, input, 0x21), 16 - count);
+        }
+
+        __attribute__((target("avx2"))) static auto _make_table(u8 v0, u8 v1, u8 v2, u8 v3, u8 v4,
+            u8 v5, u8 v6, u8 v7, u8 v8, u8 v9, u8 v10, u8 v11, u8 v12, u8 v13, u8 v14,
+            u8 v15) -> __m256i
+        {
+            return _mm256_broadcastsi128_si256(_mm_setr_epi8(i8(v0), i8(v1), i8(v2), i8(v3),
+                i8(v4), i8(v5), i8(v6), i8(v7), i8(v8), i8(v9), i8(v10), i8(v11), i8(v12), i8(v13),
+                i8(v14), i8(v15)));
+        }
+#endif
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// iterator over code points of a utf-8 string.
+    ///
+    /// each invalid byte is read as one `U+FFFD` replacement code point, so iterating an
+    /// unvalidated string is safe.
+    /// --------------------------------------------------------------------------------------------
+    export class utf8_iterator
+    {
+        using this_type = utf8_iterator;
+
+    public:
+        using value_type = char32_t;
+        using reference = const char32_t&;
+        using pointer = const char32_t*;
+        using difference_type = isize;
+        using iterator_category = std::forward_iterator_tag;
+        using iterator_concept = std::forward_iterator_tag;
+
+    public:
+        constexpr utf8_iterator()
+            : _it{ nullptr }
+            , _end{ nullptr }
+            , _code_point{ 0 }
+            , _length{ 0 }
+        {}
+
+        constexpr utf8_iterator(const char* it, const char* end)
+            : _it{ it }
+            , _end{ end }
+            , _code_point{ 0 }
+            , _length{ 0 }
+        {
+            _decode();
+        }
+
+    public:
+        constexpr auto operator*() const -> reference
+        {
+            return _code_point;
+        }
+
+        constexpr auto operator->() const -> pointer
+        {
+            return &_code_point;
+        }
+
+        constexpr auto operator++() -> this_type&
+        {
+            _it += _length;
+            _decode();
+            return *this;
+        }
+
+        constexpr auto operator++(int) -> this_type
+        {
+            this_type copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        constexpr auto operator==(const this_type& that) const -> bool
+        {
+            return _it == that._it;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// returns pointer to the first char of the current code point.
+        /// ----------------------------------------------------------------------------------------
+        constexpr auto get_data() const -> const char*
+        {
+            return _it;
+        }
+
+    private:
+        constexpr auto _decode() -> void
+        {
+            if (_it == _end)
+                return;
+
+            _length = _utf8_impl::decode(_it, usize(_end - _it), _code_point);
+            if (_length == 0)
+            {
+                _code_point = _utf8_impl::replacement_code_point;
+                _length = 1;
+            }
+        }
+
+    private:
+        const char* _it;
+        const char* _end;
+        char32_t _code_point;
+        usize _length;
+    };
+
+    export class utf8_view_tag
+    {};
+
+    /// --------------------------------------------------------------------------------------------
+    /// range of code points of a utf-8 string. see `utf8_iterator`.
+    /// --------------------------------------------------------------------------------------------
+    export class utf8_view: public utf8_view_tag
+    {
+    public:
+        using value_type = char32_t;
+        using const_iterator_type = utf8_iterator;
+        using const_iterator_end_type = utf8_iterator;
+
+    public:
+        constexpr utf8_view(string_view str)
+            : _str{ str }
+        {}
+
+    public:
+        constexpr auto get_iterator() const -> const_iterator_type
+        {
+            const char* data = _str.get_data();
+            return const_iterator_type(data, data + _str.get_count());
+        }
+
+        constexpr auto get_iterator_end() const -> const_iterator_end_type
+        {
+            const char* end = _str.get_data() + _str.get_count();
+            return const_iterator_end_type(end, end);
+        }
+
+        constexpr auto get_str() const -> string_view
+        {
+            return _str;
+        }
+
+    private:
+        string_view _str;
+    };
+
+    export template <typename range_type>
+        requires(type_info<range_type>::template is_derived_from<utf8_view_tag>())
+    class ranges::range_definition<range_type>
+    {
+    public:
+        using value_type = typename range_type::value_type;
+        using const_iterator_type = typename range_type::const_iterator_type;
+        using const_iterator_end_type = typename range_type::const_iterator_end_type;
+
+    public:
+        static constexpr auto get_const_iterator(const range_type& range) -> const_iterator_type
+        {
+            return range.get_iterator();
+        }
+
+        static constexpr auto get_const_iterator_end(
+            const range_type& range) -> const_iterator_end_type
+        {
+            return range.get_iterator_end();
+        }
+    };
+}
+
+export namespace atom::utf8
+{
+    /// --------------------------------------------------------------------------------------------
+    /// returns `true` if `str` is valid utf-8.
+    ///
+    /// rejects truncated sequences, overlong encodings, surrogates and code points above
+    /// `0x10FFFF`.
+    /// --------------------------------------------------------------------------------------------
+    constexpr auto is_valid(string_view str) -> bool
+    {
+        return _utf8_impl::is_valid(str.get_data(), str.get_count());
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// returns count of code points in `str`.
+    ///
+    /// \pre `str` is valid utf-8, otherwise the count is of chars which are not continuation
+    ///     bytes.
+    /// --------------------------------------------------------------------------------------------
+    constexpr auto count_code_points(string_view str) -> usize
+    {
+        const char* data = str.get_data();
+        usize count = 0;
+
+        // branchless so that the compiler vectorizes it.
+        for (usize i = 0; i < str.get_count(); i++)
+            count += not _utf8_impl::is_continuation(data[i]);
+
+        return count;
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// returns range of code points in `str`. see `utf8_iterator`.
+    /// --------------------------------------------------------------------------------------------
+    constexpr auto get_code_points(string_view str) -> utf8_view
+    {
+        return utf8_view(str);
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// returns count of utf-16 code units needed to transcode `str`.
+    ///
+    /// \pre `str` is valid utf-8.
+    /// --------------------------------------------------------------------------------------------
+    constexpr auto get_utf16_count(string_view str) -> usize
+    {
+        const char* data = str.get_data();
+        usize count = 0;
+
+        // four byte sequences need a surrogate pair, one unit for the lead and one more.
+        for (usize i = 0; i < str.get_count(); i++)
+            count += not _utf8_impl::is_continuation(data[i]) + (u8(data[i]) >= 0xF0);
+
+        return count;
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// returns count of chars needed to transcode `str` to utf-8.
+    ///
+    /// \pre `str` is valid utf-16.
+    /// --------------------------------------------------------------------------------------------
+    constexpr auto get_utf8_count(array_view<char16_t> str) -> usize
+    {
+        const char16_t* data = str.get_data();
+        usize count = 0;
+
+        // a surrogate pair needs 4 chars, counted as 3 for the high and 1 for the low surrogate.
+        for (usize i = 0; i < str.get_count(); i++)
+        {
+            u16 unit = data[i];
+            count += 1 + (unit >= 0x80) + (unit >= 0x800) - 2 * ((unit & 0xFC00) == 0xDC00);
+        }
+
+        return count;
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// returns count of chars needed to transcode `str` to utf-8.
+    ///
+    /// \pre `str` is valid utf-32.
+    /// --------------------------------------------------------------------------------------------
+    constexpr auto get_utf8_count(array_view<char32_t> str) -> usize
+    {
+        const char32_t* data = str.get_data();
+        usize count = 0;
+
+        for (usize i = 0; i < str.get_count(); i++)
+            count += _utf8_impl::get_encoded_count(data[i]);
+
+        return count;
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// transcodes utf-8 `str` to utf-16 into `out`, validating it.
+    ///
+    /// \returns count of code units written.
+    /// --------------------------------------------------------------------------------------------
+    constexpr auto to_utf16(string_view str, array_slice<char16_t> out)
+        -> result<usize, invalid_utf8_error, buffer_too_small_error>
+    {
+        return _utf8_impl::transcode(str, out);
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// transcodes utf-8 `str` to utf-32 into `out`, validating it.
+    ///
+    /// \returns count of code units written.
+    /// --------------------------------------------------------------------------------------------
+    constexpr auto to_utf32(string_view str, array_slice<char32_t> out)
+        -> result<usize, invalid_utf8_error, buffer_too_small_error>
+    {
+        return _utf8_impl::transcode(str, out);
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// transcodes utf-16 `str` to utf-8 into `out`, validating it.
+    ///
+    /// \returns count of chars written.
+    /// --------------------------------------------------------------------------------------------
+    constexpr auto from_utf16(array_view<char16_t> str, array_slice<char> out)
+        -> result<usize, invalid_utf16_error, buffer_too_small_error>
+    {
+        const char16_t* data = str.get_data();
+        usize count = str.get_count();
+        char* out_data = out.get_data();
+        usize out_count = out.get_count();
+
+        usize j = 0;
+        for (usize i = 0; i < count; i++)
+        {
+            char32_t code_point = data[i];
+            if (code_point < 0x80 and j < out_count)
+            {
+                out_data[j++] = char(code_point);
+                continue;
+            }
+
+            if ((code_point & 0xF800) == 0xD800)
+            {
+                // a high surrogate followed by a low surrogate.
+                if (code_point >= 0xDC00 or i + 1 == count or (data[i + 1] & 0xFC00) != 0xDC00)
+                    return invalid_utf16_error();
+
+                code_point = 0x10000 + ((code_point - 0xD800) << 10) + (data[i + 1] - 0xDC00);
+                i++;
+            }
+
+            if (_utf8_impl::get_encoded_count(code_point) > out_count - j)
+                return buffer_too_small_error();
+
+            j += _utf8_impl::encode(code_point, out_data + j);
+        }
+
+        return j;
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// transcodes utf-32 `str` to utf-8 into `out`, validating it.
+    ///
+    /// \returns count of chars written.
+    /// --------------------------------------------------------------------------------------------
+    constexpr auto from_utf32(array_view<char32_t> str, array_slice<char> out)
+        -> result<usize, invalid_utf32_error, buffer_too_small_error>
+    {
+        const char32_t* data = str.get_data();
+        usize count = str.get_count();
+        char* out_data = out.get_data();
+        usize out_count = out.get_count();
+
+        usize j = 0;
+        for (usize i = 0; i < count; i++)
+        {
+            char32_t code_point = data[i];
+            if (code_point > 0x10FFFF or (code_point & 0xFFFFF800) == 0xD800)
+                return invalid_utf32_error();
+
+            if (_utf8_impl::get_encoded_count(code_point) > out_count - j)
+                return buffer_too_small_error();
+
+            j += _utf8_impl::encode(code_point, out_data + j);
+        }
+
+        return j;
+    }
+}
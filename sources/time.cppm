@@ -1,5 +1,11 @@
 export module atom_core:time;
 
+export import :time.steady_clock;
+export import :time.tsc_clock;
+export import :time.coarse_clock;
+export import :time.stopwatch;
+export import :time.latency_histogram;
+
 import std;
 
 namespace atom
@@ -8,6 +14,12 @@ namespace atom
 
     namespace time
     {
+        /// ----------------------------------------------------------------------------------------
+        /// returns the current wall clock time.
+        ///
+        /// the wall clock can jump, use `steady_now()` or the clocks in `atom::time` to measure
+        /// durations.
+        /// ----------------------------------------------------------------------------------------
         export inline auto now()
         {
             return std::chrono::system_clock::now();
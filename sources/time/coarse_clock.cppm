@@ -0,0 +1,98 @@
+export module atom_core:time.coarse_clock;
+
+import std;
+import :core;
+import :mutex;
+import :lock_guard;
+import :time.steady_clock;
+
+namespace atom::time
+{
+    /// --------------------------------------------------------------------------------------------
+    /// clock that returns a cached time updated by a background thread.
+    ///
+    /// reading the clock is a single relaxed atomic load, at the cost of precision limited to the
+    /// ticker's resolution. useful for timestamps on very hot paths like logging and timeouts,
+    /// not for measuring short durations.
+    ///
+    /// ticks are nanoseconds of `steady_clock`. the ticker starts on first use with the default
+    /// resolution of 1ms, or explicitly with `start()`.
+    /// --------------------------------------------------------------------------------------------
+    export class coarse_clock
+    {
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// returns the cached time in nanoseconds.
+        /// ----------------------------------------------------------------------------------------
+        static auto now() -> u64
+        {
+            u64 ticks = _ticks.load(std::memory_order_relaxed);
+            if (ticks == 0) [[unlikely]]
+            {
+                start();
+                ticks = _ticks.load(std::memory_order_relaxed);
+            }
+
+            return ticks;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// ticks are already in nanoseconds, returns `ticks`.
+        /// ----------------------------------------------------------------------------------------
+        static constexpr auto ticks_to_ns(u64 ticks) -> u64
+        {
+            return ticks;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// starts the ticker thread updating the time every `resolution_ns`, does nothing if the
+        /// ticker is already running.
+        /// ----------------------------------------------------------------------------------------
+        static auto start(u64 resolution_ns = 1'000'000) -> void
+        {
+            lock_guard guard{ _lock };
+
+            if (_ticker.joinable())
+                return;
+
+            _ticks.store(steady_clock::now(), std::memory_order_relaxed);
+            _ticker = std::jthread(
+                [resolution_ns](std::stop_token stop) {
+                    while (not stop.stop_requested())
+                    {
+                        std::this_thread::sleep_for(std::chrono::nanoseconds(resolution_ns));
+                        _ticks.store(steady_clock::now(), std::memory_order_relaxed);
+                    }
+                });
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// stops the ticker thread. the cached time stays frozen until the ticker is started
+        /// again.
+        /// ----------------------------------------------------------------------------------------
+        static auto stop() -> void
+        {
+            lock_guard guard{ _lock };
+
+            if (not _ticker.joinable())
+                return;
+
+            _ticker.request_stop();
+            _ticker.join();
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// returns `true` if the ticker thread is running.
+        /// ----------------------------------------------------------------------------------------
+        static auto is_running() -> bool
+        {
+            lock_guard guard{ _lock };
+            return _ticker.joinable();
+        }
+
+    private:
+        static inline std::atomic<u64> _ticks = 0;
+        static inline simple_mutex _lock;
+        static inline std::jthread _ticker;
+    };
+}
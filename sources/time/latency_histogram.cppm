@@ -0,0 +1,212 @@
+export module atom_core:time.latency_histogram;
+
+import std;
+import :core;
+import :contracts;
+
+namespace atom::time
+{
+    /// --------------------------------------------------------------------------------------------
+    /// histogram of latencies with log-linear buckets, in the style of hdr histogram.
+    ///
+    /// values are grouped by their highest set bit, and each group is split linearly into
+    /// `2 ^ (precision_bits - 1)` buckets, so any recorded value is reported with a relative
+    /// error below `2 ^ -(precision_bits - 1)` across the whole `u64` range. the default of 7 bits
+    /// gives under 1.6% error using 59 * 64 buckets.
+    ///
+    /// recording is a few bit operations and an increment. the histogram is not thread safe,
+    /// record into one histogram per thread and `merge()` them to report.
+    /// --------------------------------------------------------------------------------------------
+    export template <u32 precision_bits = 7>
+    class latency_histogram
+    {
+        static_assert(precision_bits >= 2 and precision_bits <= 16);
+
+        static constexpr u64 _sub_bucket_count = u64(1) << precision_bits;
+        static constexpr u64 _sub_bucket_half = _sub_bucket_count / 2;
+
+    public:
+        static constexpr usize bucket_count = (64 - precision_bits + 2) * _sub_bucket_half;
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// # default constructor
+        /// ----------------------------------------------------------------------------------------
+        latency_histogram()
+        {
+            reset();
+        }
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// records `value` once.
+        /// ----------------------------------------------------------------------------------------
+        auto record(u64 value) -> void
+        {
+            record_n(value, 1);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// records `value` `count` times.
+        /// ----------------------------------------------------------------------------------------
+        auto record_n(u64 value, u64 count) -> void
+        {
+            _counts[get_bucket_index(value)] += count;
+            _total_count += count;
+            _total_sum += value * count;
+            _min = value < _min ? value : _min;
+            _max = value > _max ? value : _max;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// adds every value recorded in `that` to this.
+        /// ----------------------------------------------------------------------------------------
+        auto merge(const latency_histogram& that) -> void
+        {
+            for (usize i = 0; i < bucket_count; i++)
+            {
+                _counts[i] += that._counts[i];
+            }
+
+            _total_count += that._total_count;
+            _total_sum += that._total_sum;
+            _min = that._min < _min ? that._min : _min;
+            _max = that._max > _max ? that._max : _max;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// clears every recorded value.
+        /// ----------------------------------------------------------------------------------------
+        auto reset() -> void
+        {
+            for (usize i = 0; i < bucket_count; i++)
+            {
+                _counts[i] = 0;
+            }
+
+            _total_count = 0;
+            _total_sum = 0;
+            _min = nums::get_max_u64();
+            _max = 0;
+        }
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// returns the count of recorded values.
+        /// ----------------------------------------------------------------------------------------
+        auto get_count() const -> u64
+        {
+            return _total_count;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// returns the smallest recorded value, or 0 if nothing is recorded.
+        /// ----------------------------------------------------------------------------------------
+        auto get_min() const -> u64
+        {
+            return _total_count == 0 ? 0 : _min;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// returns the largest recorded value.
+        /// ----------------------------------------------------------------------------------------
+        auto get_max() const -> u64
+        {
+            return _max;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// returns the mean of recorded values, or 0 if nothing is recorded.
+        /// ----------------------------------------------------------------------------------------
+        auto get_mean() const -> f64
+        {
+            return _total_count == 0 ? 0 : f64(_total_sum) / f64(_total_count);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// returns the value at `percentile`, in the range [0, 100]. e.g. `99.9` for p99.9.
+        ///
+        /// the returned value is the highest value equivalent to the bucket the percentile falls
+        /// in, clamped to the recorded range.
+        /// ----------------------------------------------------------------------------------------
+        auto get_percentile(f64 percentile) const -> u64
+        {
+            contract_expects(percentile >= 0 and percentile <= 100, "percentile is out of range.");
+
+            if (_total_count == 0)
+                return 0;
+
+            u64 rank = u64(percentile / 100 * f64(_total_count) + 0.5);
+            rank = rank == 0 ? 1 : rank;
+
+            u64 seen = 0;
+            for (usize i = 0; i < bucket_count; i++)
+            {
+                seen += _counts[i];
+                if (seen >= rank)
+                {
+                    u64 value = get_bucket_highest(i);
+                    value = value > _max ? _max : value;
+                    return value < _min ? _min : value;
+                }
+            }
+
+            return _max;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// returns the count of values recorded in bucket at `index`.
+        /// ----------------------------------------------------------------------------------------
+        auto get_bucket_count(usize index) const -> u64
+        {
+            contract_debug_expects(index < bucket_count);
+
+            return _counts[index];
+        }
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// returns index of the bucket `value` is recorded in.
+        /// ----------------------------------------------------------------------------------------
+        static constexpr auto get_bucket_index(u64 value) -> usize
+        {
+            if (value < _sub_bucket_count)
+                return usize(value);
+
+            u32 shift = u32(std::bit_width(value)) - precision_bits;
+            return usize(shift * _sub_bucket_half + (value >> shift));
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// returns the lowest value recorded in bucket at `index`.
+        /// ----------------------------------------------------------------------------------------
+        static constexpr auto get_bucket_lowest(usize index) -> u64
+        {
+            u32 shift = _get_bucket_shift(index);
+            return (u64(index) - shift * _sub_bucket_half) << shift;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// returns the highest value recorded in bucket at `index`.
+        /// ----------------------------------------------------------------------------------------
+        static constexpr auto get_bucket_highest(usize index) -> u64
+        {
+            u32 shift = _get_bucket_shift(index);
+            return get_bucket_lowest(index) + ((u64(1) << shift) - 1);
+        }
+
+    private:
+        static constexpr auto _get_bucket_shift(usize index) -> u32
+        {
+            u64 group = index / _sub_bucket_half;
+            return group == 0 ? 0 : u32(group - 1);
+        }
+
+    private:
+        u64 _counts[bucket_count];
+        u64 _total_count;
+        u64 _total_sum;
+        u64 _min;
+        u64 _max;
+    };
+}
@@ -0,0 +1,50 @@
+export module atom_core:time.steady_clock;
+
+import std;
+import :core;
+
+namespace atom::time
+{
+    /// --------------------------------------------------------------------------------------------
+    /// time point of the monotonic clock.
+    /// --------------------------------------------------------------------------------------------
+    export using steady_time_point = std::chrono::steady_clock::time_point;
+
+    /// --------------------------------------------------------------------------------------------
+    /// returns the current time of the monotonic clock.
+    ///
+    /// unlike `now()`, this never goes backwards and is suitable to measure durations.
+    /// --------------------------------------------------------------------------------------------
+    export inline auto steady_now() -> steady_time_point
+    {
+        return std::chrono::steady_clock::now();
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// monotonic clock with ticks in nanoseconds.
+    ///
+    /// every clock in `atom::time` provides `now()` returning ticks and `ticks_to_ns()`, so they
+    /// can be used interchangeably with `stopwatch`.
+    /// --------------------------------------------------------------------------------------------
+    export class steady_clock
+    {
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// returns the current time in nanoseconds since an unspecified epoch.
+        /// ----------------------------------------------------------------------------------------
+        static auto now() -> u64
+        {
+            return u64(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch())
+                    .count());
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// ticks are already in nanoseconds, returns `ticks`.
+        /// ----------------------------------------------------------------------------------------
+        static constexpr auto ticks_to_ns(u64 ticks) -> u64
+        {
+            return ticks;
+        }
+    };
+}
@@ -0,0 +1,133 @@
+export module atom_core:time.stopwatch;
+
+import std;
+import :core;
+import :time.steady_clock;
+
+namespace atom::time
+{
+    /// --------------------------------------------------------------------------------------------
+    /// measures elapsed time using `clock_type`, which can be any of the clocks in `atom::time`.
+    ///
+    /// the stopwatch starts running on construction.
+    /// --------------------------------------------------------------------------------------------
+    export template <typename in_clock_type = steady_clock>
+    class stopwatch
+    {
+    public:
+        using clock_type = in_clock_type;
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// # default constructor
+        ///
+        /// constructs and starts the stopwatch.
+        /// ----------------------------------------------------------------------------------------
+        stopwatch()
+            : _start_ticks{ clock_type::now() }
+            , _elapsed_ticks{ 0 }
+            , _is_running{ true }
+        {}
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// starts the stopwatch if it's stopped, keeping the elapsed time.
+        /// ----------------------------------------------------------------------------------------
+        auto start() -> void
+        {
+            if (_is_running)
+                return;
+
+            _start_ticks = clock_type::now();
+            _is_running = true;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// stops the stopwatch, adding the time since it started to the elapsed time.
+        /// ----------------------------------------------------------------------------------------
+        auto stop() -> void
+        {
+            if (not _is_running)
+                return;
+
+            _elapsed_ticks += clock_type::now() - _start_ticks;
+            _is_running = false;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// stops the stopwatch and clears the elapsed time.
+        /// ----------------------------------------------------------------------------------------
+        auto reset() -> void
+        {
+            _elapsed_ticks = 0;
+            _is_running = false;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// clears the elapsed time and starts the stopwatch.
+        /// ----------------------------------------------------------------------------------------
+        auto restart() -> void
+        {
+            _elapsed_ticks = 0;
+            _start_ticks = clock_type::now();
+            _is_running = true;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// returns the elapsed time in clock ticks and restarts the stopwatch, so the next lap is
+        /// measured from this call.
+        /// ----------------------------------------------------------------------------------------
+        auto lap() -> u64
+        {
+            u64 now = clock_type::now();
+            u64 elapsed = _elapsed_ticks;
+            if (_is_running)
+                elapsed += now - _start_ticks;
+
+            _elapsed_ticks = 0;
+            _start_ticks = now;
+            _is_running = true;
+            return elapsed;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// returns `true` if the stopwatch is running.
+        /// ----------------------------------------------------------------------------------------
+        auto is_running() const -> bool
+        {
+            return _is_running;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// returns the elapsed time in clock ticks.
+        /// ----------------------------------------------------------------------------------------
+        auto get_elapsed_ticks() const -> u64
+        {
+            if (_is_running)
+                return _elapsed_ticks + (clock_type::now() - _start_ticks);
+
+            return _elapsed_ticks;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// returns the elapsed time in nanoseconds.
+        /// ----------------------------------------------------------------------------------------
+        auto get_elapsed_ns() const -> u64
+        {
+            return clock_type::ticks_to_ns(get_elapsed_ticks());
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// returns the elapsed time as `std::chrono::nanoseconds`.
+        /// ----------------------------------------------------------------------------------------
+        auto get_elapsed() const -> std::chrono::nanoseconds
+        {
+            return std::chrono::nanoseconds(get_elapsed_ns());
+        }
+
+    private:
+        u64 _start_ticks;
+        u64 _elapsed_ticks;
+        bool _is_running;
+    };
+}
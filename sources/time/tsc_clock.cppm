@@ -0,0 +1,147 @@
+module;
+#if defined(__x86_64__) || defined(__i386__)
+#    include <cpuid.h>
+#endif
+
+export module atom_core:time.tsc_clock;
+
+import std;
+import :core;
+import :time.steady_clock;
+
+#include "atom/core/preprocessors.h"
+
+namespace atom::time
+{
+    /// --------------------------------------------------------------------------------------------
+    /// clock reading the cpu's time stamp counter.
+    ///
+    /// reading the counter costs a handful of cycles, much cheaper than a clock syscall or vdso
+    /// call. ticks are converted to nanoseconds using a factor calibrated against `steady_clock`,
+    /// calibration happens on first conversion unless `calibrate()` is called explicitly.
+    ///
+    /// on targets without an invariant time stamp counter, ticks are nanoseconds of
+    /// `steady_clock`.
+    /// --------------------------------------------------------------------------------------------
+    export class tsc_clock
+    {
+        /// fixed point shift of `_ns_per_tick_mult`.
+        static constexpr u32 _mult_shift = 32;
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// returns `true` if this clock reads an invariant time stamp counter, i.e. one that
+        /// ticks at a constant rate regardless of frequency scaling and sleep states.
+        /// ----------------------------------------------------------------------------------------
+        static auto is_tsc() -> bool
+        {
+            static const bool is_invariant = _check_invariant_tsc();
+            return is_invariant;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// returns the current tick count.
+        /// ----------------------------------------------------------------------------------------
+        ATOM_ATTR_ALWAYS_INLINE static auto now() -> u64
+        {
+#if (defined(__x86_64__) || defined(__i386__))                                                     \
+    && (defined(ATOM_COMPILER_CLANG) || defined(ATOM_COMPILER_GNUC))
+            if (is_tsc()) [[likely]]
+                return __builtin_ia32_rdtsc();
+#endif
+
+            return steady_clock::now();
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// calibrates the tick rate against `steady_clock`, spinning for `duration_ns`.
+        ///
+        /// longer durations give more precise conversions.
+        /// ----------------------------------------------------------------------------------------
+        static auto calibrate(u64 duration_ns = 10'000'000) -> void
+        {
+            _ns_per_tick_mult.store(_measure_mult(duration_ns), std::memory_order_relaxed);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// returns the count of ticks per second.
+        /// ----------------------------------------------------------------------------------------
+        static auto get_ticks_per_second() -> f64
+        {
+            return 1'000'000'000.0 * f64(u64(1) << _mult_shift) / f64(_get_mult());
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// converts `ticks` to nanoseconds.
+        /// ----------------------------------------------------------------------------------------
+        static auto ticks_to_ns(u64 ticks) -> u64
+        {
+#if defined(__SIZEOF_INT128__)
+            return u64((unsigned __int128)(ticks) * _get_mult() >> _mult_shift);
+#else
+            return u64(f64(ticks) * f64(_get_mult()) / f64(u64(1) << _mult_shift));
+#endif
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// same as `ticks_to_ns()`, named for readability when ticks are cpu cycles.
+        /// ----------------------------------------------------------------------------------------
+        static auto cycles_to_ns(u64 cycles) -> u64
+        {
+            return ticks_to_ns(cycles);
+        }
+
+    private:
+        static auto _get_mult() -> u64
+        {
+            u64 mult = _ns_per_tick_mult.load(std::memory_order_relaxed);
+            if (mult == 0) [[unlikely]]
+            {
+                calibrate();
+                mult = _ns_per_tick_mult.load(std::memory_order_relaxed);
+            }
+
+            return mult;
+        }
+
+        static auto _measure_mult(u64 duration_ns) -> u64
+        {
+            if (not is_tsc())
+                return u64(1) << _mult_shift;
+
+            u64 start_ns = steady_clock::now();
+            u64 start_ticks = now();
+
+            u64 end_ns = start_ns;
+            while (end_ns - start_ns < duration_ns)
+            {
+                end_ns = steady_clock::now();
+            }
+
+            u64 end_ticks = now();
+            if (end_ticks <= start_ticks)
+                return u64(1) << _mult_shift;
+
+            f64 ns_per_tick = f64(end_ns - start_ns) / f64(end_ticks - start_ticks);
+            return u64(ns_per_tick * f64(u64(1) << _mult_shift));
+        }
+
+        static auto _check_invariant_tsc() -> bool
+        {
+#if (defined(__x86_64__) || defined(__i386__))                                                     \
+    && (defined(ATOM_COMPILER_CLANG) || defined(ATOM_COMPILER_GNUC))
+            u32 eax = 0, ebx = 0, ecx = 0, edx = 0;
+            if (__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx) == 0)
+                return false;
+
+            // bit 8 of edx reports invariant tsc.
+            return (edx & (1 << 8)) != 0;
+#else
+            return false;
+#endif
+        }
+
+    private:
+        static inline std::atomic<u64> _ns_per_tick_mult = 0;
+    };
+}
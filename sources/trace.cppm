@@ -0,0 +1,472 @@
+export module atom_core:trace;
+
+import std;
+import :core;
+import :contracts;
+import :ranges;
+import :strings;
+import :mutex;
+import :lock_guard;
+import :filesystem;
+import :time;
+
+#include "atom/core/preprocessors.h"
+
+/// ------------------------------------------------------------------------------------------------
+/// low overhead instrumentation.
+///
+/// each thread records events into its own single producer single consumer ring buffer, so
+/// recording an event is a couple of relaxed loads and stores and never takes a lock. buffers are
+/// drained when the events are exported.
+///
+/// use the macros in `atom/core/trace.h` to instrument code, they compile to nothing unless
+/// `ATOM_TRACE_ENABLED` is defined.
+/// ------------------------------------------------------------------------------------------------
+namespace atom::trace
+{
+    /// --------------------------------------------------------------------------------------------
+    /// type of the recorded event.
+    /// --------------------------------------------------------------------------------------------
+    export enum class event_type : u8
+    {
+        zone_begin,
+        zone_end,
+        counter,
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// a recorded event.
+    ///
+    /// `name` is not copied, it must point to a string with static storage duration.
+    /// --------------------------------------------------------------------------------------------
+    export class event
+    {
+    public:
+        const char* name;
+        u64 timestamp;
+        i64 value;
+        event_type type;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// returns the current timestamp in `time::tsc_clock` ticks.
+    /// --------------------------------------------------------------------------------------------
+    export ATOM_ATTR_ALWAYS_INLINE auto get_timestamp() -> u64
+    {
+        return time::tsc_clock::now();
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// ring buffer of events recorded by a single thread.
+    ///
+    /// the owning thread is the only producer and the exporter is the only consumer.
+    /// --------------------------------------------------------------------------------------------
+    class _event_buffer
+    {
+    public:
+        static constexpr usize capacity = 1 << 13;
+
+    public:
+        _event_buffer(u32 thread_id)
+            : _thread_id{ thread_id }
+        {}
+
+    public:
+        /// ----------------------------------------------------------------------------------------
+        /// pushes `ev` into the buffer, drops it if the buffer is full.
+        ///
+        /// must only be called by the owning thread.
+        /// ----------------------------------------------------------------------------------------
+        auto push(const event& ev) -> bool
+        {
+            return _try_push(ev, 1);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// pushes the zone begin event `ev` and reserves a slot for its end event, drops it if
+        /// the buffer doesn't have space for both.
+        ///
+        /// must only be called by the owning thread.
+        /// ----------------------------------------------------------------------------------------
+        auto push_begin(const event& ev) -> bool
+        {
+            if (not _try_push(ev, 2))
+                return false;
+
+            _reserved_count++;
+            return true;
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// pushes the zone end event `ev` into the slot reserved by `push_begin()`.
+        ///
+        /// must only be called by the owning thread.
+        /// ----------------------------------------------------------------------------------------
+        auto push_end(const event& ev) -> void
+        {
+            contract_debug_expects(_reserved_count > 0, "no zone begin to end.");
+
+            _reserved_count--;
+            usize head = _head.load(std::memory_order_relaxed);
+            _events[head & (capacity - 1)] = ev;
+            _head.store(head + 1, std::memory_order_release);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// pops every event currently in the buffer, passing each of them to `action`.
+        ///
+        /// must only be called by the consumer.
+        /// ----------------------------------------------------------------------------------------
+        template <typename action_type>
+        auto pop_all(action_type&& action) -> void
+        {
+            usize tail = _tail.load(std::memory_order_relaxed);
+            usize head = _head.load(std::memory_order_acquire);
+
+            for (; tail != head; tail++)
+            {
+                action(_events[tail & (capacity - 1)]);
+            }
+
+            _tail.store(tail, std::memory_order_release);
+        }
+
+        auto is_empty() const -> bool
+        {
+            return _head.load(std::memory_order_acquire) == _tail.load(std::memory_order_acquire);
+        }
+
+        auto get_thread_id() const -> u32
+        {
+            return _thread_id;
+        }
+
+        auto get_dropped_count() const -> usize
+        {
+            return _dropped_count.load(std::memory_order_relaxed);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// marks the buffer as no longer owned by any thread. once drained, the buffer can be
+        /// reused for a new thread.
+        /// ----------------------------------------------------------------------------------------
+        auto retire() -> void
+        {
+            _is_retired.store(true, std::memory_order_release);
+        }
+
+        /// ----------------------------------------------------------------------------------------
+        /// claims a retired and drained buffer for the thread `thread_id`.
+        /// ----------------------------------------------------------------------------------------
+        auto try_reuse(u32 thread_id) -> bool
+        {
+            if (not _is_retired.load(std::memory_order_acquire) or not is_empty())
+                return false;
+
+            _thread_id = thread_id;
+            _is_retired.store(false, std::memory_order_relaxed);
+            return true;
+        }
+
+    private:
+        /// ----------------------------------------------------------------------------------------
+        /// pushes `ev` if there are `count` slots free, not counting the ones reserved for ends
+        /// of zones.
+        /// ----------------------------------------------------------------------------------------
+        auto _try_push(const event& ev, usize count) -> bool
+        {
+            usize head = _head.load(std::memory_order_relaxed);
+            usize tail = _tail.load(std::memory_order_acquire);
+
+            if (capacity - (head - tail) - _reserved_count < count) [[unlikely]]
+            {
+                _dropped_count.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+
+            _events[head & (capacity - 1)] = ev;
+            _head.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+    private:
+        alignas(64) std::atomic<usize> _head = 0;
+        alignas(64) std::atomic<usize> _tail = 0;
+        std::atomic<usize> _dropped_count = 0;
+        std::atomic<bool> _is_retired = false;
+        u32 _thread_id;
+
+        /// count of slots reserved for the ends of zones that began, only used by the owner.
+        usize _reserved_count = 0;
+        event _events[capacity];
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// keeps track of every thread's event buffer.
+    /// --------------------------------------------------------------------------------------------
+    class _trace_registry
+    {
+    public:
+        static auto get() -> _trace_registry&
+        {
+            static _trace_registry instance;
+            return instance;
+        }
+
+    public:
+        _trace_registry()
+            : start_ticks{ get_timestamp() }
+        {}
+
+    public:
+        auto register_thread() -> _event_buffer*
+        {
+            lock_guard guard{ _lock };
+
+            u32 thread_id = _next_thread_id++;
+            for (auto& buffer : _buffers)
+            {
+                if (buffer->try_reuse(thread_id))
+                    return buffer.get();
+            }
+
+            _buffers.push_back(std::make_unique<_event_buffer>(thread_id));
+            return _buffers.back().get();
+        }
+
+        template <typename action_type>
+        auto for_each_buffer(action_type&& action) -> void
+        {
+            lock_guard guard{ _lock };
+
+            for (auto& buffer : _buffers)
+            {
+                action(*buffer);
+            }
+        }
+
+    public:
+        std::atomic<bool> is_enabled = true;
+        const u64 start_ticks;
+
+    private:
+        simple_mutex _lock;
+        std::vector<std::unique_ptr<_event_buffer>> _buffers;
+        u32 _next_thread_id = 0;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// registers the thread's buffer on first use and retires it when the thread exits.
+    /// --------------------------------------------------------------------------------------------
+    class _thread_buffer_holder
+    {
+    public:
+        _thread_buffer_holder()
+            : buffer{ _trace_registry::get().register_thread() }
+        {}
+
+        ~_thread_buffer_holder()
+        {
+            buffer->retire();
+        }
+
+    public:
+        _event_buffer* buffer;
+    };
+
+    inline auto _get_thread_buffer() -> _event_buffer*
+    {
+        thread_local _thread_buffer_holder holder;
+        return holder.buffer;
+    }
+
+    inline auto _record(event_type type, const char* name, i64 value) -> bool
+    {
+        if (not _trace_registry::get().is_enabled.load(std::memory_order_relaxed))
+            return false;
+
+        event ev{ .name = name, .timestamp = get_timestamp(), .value = value, .type = type };
+        if (type == event_type::zone_begin)
+            return _get_thread_buffer()->push_begin(ev);
+
+        return _get_thread_buffer()->push(ev);
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// records the end of a zone whose begin was recorded, even if recording was disabled since.
+    /// --------------------------------------------------------------------------------------------
+    inline auto _record_zone_end(const char* name) -> void
+    {
+        _get_thread_buffer()->push_end(event{
+            .name = name, .timestamp = get_timestamp(), .value = 0, .type = event_type::zone_end });
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// enables or disables recording at runtime. recording is enabled by default.
+    /// --------------------------------------------------------------------------------------------
+    export auto set_enabled(bool enable) -> void
+    {
+        _trace_registry::get().is_enabled.store(enable, std::memory_order_relaxed);
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// returns `true` if recording is enabled.
+    /// --------------------------------------------------------------------------------------------
+    export auto is_enabled() -> bool
+    {
+        return _trace_registry::get().is_enabled.load(std::memory_order_relaxed);
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// returns the count of events dropped because a thread's buffer was full.
+    /// --------------------------------------------------------------------------------------------
+    export auto get_dropped_count() -> usize
+    {
+        usize count = 0;
+        _trace_registry::get().for_each_buffer(
+            [&](const _event_buffer& buffer) { count += buffer.get_dropped_count(); });
+
+        return count;
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// records a zone for the lifetime of this object.
+    ///
+    /// `name` must point to a string with static storage duration.
+    /// --------------------------------------------------------------------------------------------
+    export class zone
+    {
+    public:
+        zone(const char* name)
+            : _name{ name }
+            , _is_recorded{ _record(event_type::zone_begin, name, 0) }
+        {}
+
+        zone(const zone& that) = delete;
+        zone& operator=(const zone& that) = delete;
+
+        ~zone()
+        {
+            // only end zones that began, so the exported trace stays balanced even if recording
+            // was toggled or the buffer was full in between. the begin reserved a slot for this.
+            if (_is_recorded)
+                _record_zone_end(_name);
+        }
+
+    private:
+        const char* _name;
+        bool _is_recorded;
+    };
+
+    /// --------------------------------------------------------------------------------------------
+    /// records the value of the counter `name`.
+    ///
+    /// `name` must point to a string with static storage duration.
+    /// --------------------------------------------------------------------------------------------
+    export auto record_counter(const char* name, i64 value) -> void
+    {
+        _record(event_type::counter, name, value);
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// appends `str` to `out` as a json string.
+    /// --------------------------------------------------------------------------------------------
+    auto _append_json_str(string& out, const char* str) -> void
+    {
+        out.emplace_last('"');
+
+        for (; *str != '\0'; str++)
+        {
+            char ch = *str;
+            if (ch == '"' or ch == '\\')
+            {
+                out.emplace_last('\\');
+                out.emplace_last(ch);
+            }
+            else if (u8(ch) < 0x20)
+            {
+                out.emplace_last(' ');
+            }
+            else
+            {
+                out.emplace_last(ch);
+            }
+        }
+
+        out.emplace_last('"');
+    }
+
+    /// --------------------------------------------------------------------------------------------
+    /// drains every thread's buffer and writes the events to the file at `path` in chrome's trace
+    /// event format, which can be opened in `chrome://tracing` or perfetto.
+    /// --------------------------------------------------------------------------------------------
+    export auto write_chrome_json(string_view path)
+        -> result<void, filesystem::filesystem_error, filesystem::noentry_error>
+    {
+        _trace_registry& registry = _trace_registry::get();
+
+        filesystem::file::open_result open_result = filesystem::file::open(path,
+            filesystem::file::open_flags::write | filesystem::file::open_flags::create);
+
+        contract_asserts(not open_result.is_error<filesystem::invalid_options_error>());
+
+        if (open_result.is_error<filesystem::noentry_error>())
+            return open_result.get_error<filesystem::noentry_error>();
+
+        if (open_result.is_error<filesystem::filesystem_error>())
+            return open_result.get_error<filesystem::filesystem_error>();
+
+        filesystem::file& file = open_result.get_value();
+
+        string out;
+        bool is_first = true;
+        file.write_str(string_view{ "{\"traceEvents\":[\n" });
+
+        registry.for_each_buffer(
+            [&](_event_buffer& buffer) {
+                buffer.pop_all(
+                    [&](const event& ev) {
+                        if (not is_first)
+                            out.insert_range_last(string_view{ ",\n" });
+
+                        is_first = false;
+
+                        out.insert_range_last(string_view{ "{\"name\":" });
+                        _append_json_str(out, ev.name);
+
+                        u64 ns = time::tsc_clock::ticks_to_ns(ev.timestamp - registry.start_ticks);
+                        f64 ts = f64(ns) / 1000;
+                        string::format_to(
+                            out, ",\"ts\":{},\"pid\":0,\"tid\":{}", ts, buffer.get_thread_id());
+
+                        switch (ev.type)
+                        {
+                            case event_type::zone_begin:
+                                out.insert_range_last(string_view{ ",\"ph\":\"B\"}" });
+                                break;
+
+                            case event_type::zone_end:
+                                out.insert_range_last(string_view{ ",\"ph\":\"E\"}" });
+                                break;
+
+                            case event_type::counter:
+                                string::format_to(
+                                    out, ",\"ph\":\"C\",\"args\":{{\"value\":{}}}}}", ev.value);
+                                break;
+                        }
+
+                        if (out.get_count() >= 64 * 1024)
+                        {
+                            file.write_str(out);
+                            out.remove_all();
+                        }
+                    });
+            });
+
+        out.insert_range_last(string_view{ "\n]}\n" });
+        file.write_str(out);
+        file.close();
+
+        return { create_from_void };
+    }
+}
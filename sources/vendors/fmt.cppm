@@ -14,6 +14,8 @@ export namespace fmt
     using fmt::format_parse_context;
     using fmt::format_string;
     using fmt::format_to;
+    using fmt::format_to_n;
+    using fmt::format_to_n_result;
     using fmt::formatter;
     using fmt::print;
     using fmt::println;
@@ -38,6 +38,11 @@ module;
 #include <unordered_map>
 #include <exception>
 #include <filesystem>
+#include <bit>
+#include <charconv>
+#include <thread>
+#include <stop_token>
+#include <condition_variable>
 
 export module std;
 
@@ -105,7 +110,9 @@ export namespace std
     using std::add_pointer_t;
     using std::add_rvalue_reference_t;
     using std::add_volatile_t;
+    using std::bool_constant;
     using std::conditional_t;
+    using std::decay_t;
     using std::enable_if_t;
     using std::equality_comparable;
     using std::equality_comparable_with;
@@ -142,6 +149,7 @@ export namespace std
     using std::remove_const_t;
     using std::remove_cv_t;
     using std::remove_cvref_t;
+    using std::make_unsigned_t;
     using std::remove_pointer_t;
     using std::remove_reference_t;
     using std::remove_volatile_t;
@@ -161,10 +169,12 @@ export namespace std
     using std::bitset;
     using std::get;
     using std::hash;
+    using std::less;
     using std::optional;
     using std::pair;
     using std::string;
     using std::string_view;
+    using std::apply;
     using std::tuple;
     using std::tuple_element;
     using std::tuple_size;
@@ -192,7 +202,11 @@ export namespace std
     using std::random_access_iterator;
     using std::random_access_iterator_tag;
 
+    using std::allocator;
     using std::construct_at;
+    using std::to_address;
+    using std::uninitialized_move;
+    using std::binary_search;
     using std::copy;
     using std::copy_backward;
     using std::destroy;
@@ -208,10 +222,20 @@ export namespace std
     using std::move;
     using std::move_backward;
     using std::rotate;
+    using std::sort;
+    using std::stable_sort;
     using std::search;
     using std::shift_left;
     using std::shift_right;
     using std::strlen;
+    using std::chars_format;
+    using std::errc;
+    using std::from_chars;
+    using std::from_chars_result;
+    using std::to_chars;
+    using std::to_chars_result;
+    using std::memcpy;
+    using std::swap;
 
     namespace ranges
     {
@@ -234,10 +258,31 @@ export namespace std
     }
 
     using std::atomic;
+    using std::atomic_ref;
+    using std::atomic_thread_fence;
+    using std::bit_cast;
+    using std::endian;
+    using std::bit_ceil;
+    using std::bit_floor;
+    using std::bit_width;
+    using std::countl_zero;
+    using std::countr_zero;
+    using std::has_single_bit;
+    using std::jthread;
+    using std::stop_token;
+    using std::thread;
+    using std::memory_order;
+    using std::memory_order_acq_rel;
+    using std::memory_order_acquire;
+    using std::memory_order_relaxed;
+    using std::memory_order_release;
+    using std::memory_order_seq_cst;
     using std::free;
     using std::function;
     using std::malloc;
     using std::mutex;
+    using std::condition_variable;
+    using std::unique_lock;
     using std::realloc;
     using std::type_info;
     using std::declval;
@@ -265,8 +310,22 @@ export namespace std
 
     using namespace std::filesystem;
 
+    namespace this_thread
+    {
+        using this_thread::get_id;
+        using this_thread::sleep_for;
+        using this_thread::yield;
+    }
+
     namespace chrono
     {
+        using chrono::duration;
+        using chrono::duration_cast;
+        using chrono::microseconds;
+        using chrono::milliseconds;
+        using chrono::nanoseconds;
+        using chrono::seconds;
+        using chrono::steady_clock;
         using chrono::system_clock;
     }
 
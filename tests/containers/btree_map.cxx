@@ -0,0 +1,109 @@
+module;
+#include "catch2/catch_test_macros.hpp"
+
+module atom_core.tests:btree_map;
+
+import atom_core;
+
+using namespace atom;
+
+TEST_CASE("atom_core.btree_map")
+{
+    SECTION("insert, find and remove")
+    {
+        btree_map<i64, i64> map;
+        for (i64 i = 0; i < 10'000; i++)
+            REQUIRE(map.emplace((i * 7919) % 10'000, i));
+
+        REQUIRE(map.get_count() == 10'000);
+        REQUIRE(map.get_height() > 1);
+        REQUIRE(not map.emplace(5, 0));
+
+        for (i64 i = 0; i < 10'000; i += 2)
+            REQUIRE(map.remove(i));
+
+        REQUIRE(map.get_count() == 5'000);
+        for (i64 i = 0; i < 10'000; i++)
+            REQUIRE(map.contains(i) == (i % 2 == 1));
+
+        REQUIRE(not map.insert_or_assign(1, -1));
+        REQUIRE(*map.find(1) == -1);
+        REQUIRE(map.find(2) == nullptr);
+    }
+
+    SECTION("iteration is in key order")
+    {
+        btree_map<i64, i64> map;
+        for (i64 i = 1'000; i > 0; i--)
+            map.emplace(i, i * 2);
+
+        i64 expected = 1;
+        for (auto it = map.get_iterator(); not it.is_end(); ++it, expected++)
+        {
+            REQUIRE(it.get_key() == expected);
+            REQUIRE(it.get_value() == expected * 2);
+        }
+
+        REQUIRE(expected == 1'001);
+    }
+
+    SECTION("range queries")
+    {
+        btree_map<i64, i64> map;
+        for (i64 i = 0; i < 1'000; i++)
+            map.emplace(i * 10, i);
+
+        REQUIRE(map.lower_bound(15).get_key() == 20);
+        REQUIRE(map.lower_bound(20).get_key() == 20);
+        REQUIRE(map.upper_bound(20).get_key() == 30);
+        REQUIRE(map.lower_bound(10'000).is_end());
+
+        i64 sum = 0;
+        usize count = 0;
+        map.for_each_in_range(i64(100), i64(200), [&](i64 key, i64 value) {
+            sum += value;
+            count++;
+        });
+
+        REQUIRE(count == 10);
+        REQUIRE(sum == 145);
+    }
+
+    SECTION("bulk load from sorted input")
+    {
+        dynamic_array<i64> keys;
+        dynamic_array<i64> values;
+        for (i64 i = 0; i < 5'000; i++)
+        {
+            keys.emplace_last(i * 2);
+            values.emplace_last(i);
+        }
+
+        btree_map<i64, i64> map{ create_from_sorted_range, keys, values };
+
+        REQUIRE(map.get_count() == 5'000);
+        for (i64 i = 0; i < 5'000; i++)
+            REQUIRE(*map.find(i * 2) == i);
+
+        REQUIRE(map.emplace(3, 0));
+        REQUIRE(map.remove(4));
+        REQUIRE(map.get_count() == 5'000);
+
+        btree_map<i64, i64> copy = map;
+        REQUIRE(copy.get_count() == 5'000);
+        REQUIRE(*copy.find(3) == 0);
+    }
+}
+
+TEST_CASE("atom_core.btree_set")
+{
+    btree_set<i64> set;
+    for (i64 i = 0; i < 1'000; i++)
+        set.insert(i % 500);
+
+    REQUIRE(set.get_count() == 500);
+    REQUIRE(set.contains(499));
+    REQUIRE(not set.contains(500));
+    REQUIRE(set.remove(0));
+    REQUIRE(*set.get_iterator() == 1);
+}
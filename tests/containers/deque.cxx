@@ -0,0 +1,50 @@
+module;
+#include "catch2/catch_test_macros.hpp"
+
+module atom_core.tests:deque;
+
+import atom_core;
+
+using namespace atom;
+
+TEST_CASE("atom_core.deque")
+{
+    SECTION("push and pop at both ends")
+    {
+        deque<i64, default_mem_allocator, 16> values;
+        for (i64 i = 0; i < 1'000; i++)
+        {
+            values.emplace_last(i);
+            values.emplace_first(-i - 1);
+        }
+
+        REQUIRE(values.get_count() == 2'000);
+        for (usize i = 0; i < values.get_count(); i++)
+            REQUIRE(values.get_at(i) == i64(i) - 1'000);
+
+        for (i64 i = 0; i < 999; i++)
+        {
+            values.remove_first();
+            values.remove_last();
+        }
+
+        REQUIRE(values.get_count() == 2);
+        REQUIRE(values.get_first() == -1);
+        REQUIRE(values.get_last() == 0);
+    }
+
+    SECTION("references stay valid")
+    {
+        deque<i64, default_mem_allocator, 16> values;
+        values.emplace_last(7);
+        const i64* first = &values.get_first();
+
+        for (i64 i = 0; i < 1'000; i++)
+        {
+            values.emplace_last(i);
+            values.emplace_first(i);
+        }
+
+        REQUIRE(*first == 7);
+    }
+}
@@ -1,5 +1,7 @@
 module;
 #include "catch2/catch_test_macros.hpp"
+#include <initializer_list>
+#include <string>
 
 module atom_core.tests:dynamic_array;
 
@@ -9,6 +11,75 @@ import :tracked_type;
 using namespace atom;
 using namespace atom::tests;
 
+namespace
+{
+    template <typename value_type>
+    auto has_values(const dynamic_array<value_type>& arr, std::initializer_list<value_type> values)
+        -> bool
+    {
+        if (arr.get_count() != values.size())
+            return false;
+
+        usize i = 0;
+        for (const value_type& value : values)
+        {
+            if (not(arr.get_at(i++) == value))
+                return false;
+        }
+
+        return true;
+    }
+
+    auto make_str(i32 value) -> std::string
+    {
+        // long enough to not fit in the small string buffer.
+        return std::string(32, 'a') + std::to_string(value);
+    }
+
+    // writes `i` at each index `i` using the uninitialized apis, growing `arr` on the way.
+    template <typename array_type>
+    auto check_uninitialized_apis(array_type& arr) -> void
+    {
+        arr.resize_uninitialized(10);
+        REQUIRE(arr.get_count() == 10);
+        REQUIRE(arr.get_capacity() >= 10);
+
+        for (i32 i = 0; i < 10; i++)
+            arr.get_at(i) = i;
+
+        // needs growth.
+        array_slice<i32> added = arr.append_uninitialized(1000);
+        REQUIRE(added.get_count() == 1000);
+        REQUIRE(added.get_data() == arr.get_data() + 10);
+        REQUIRE(arr.get_count() == 1010);
+        REQUIRE(arr.get_capacity() >= 1010);
+
+        for (i32 i = 0; i < 1000; i++)
+            added[i] = 10 + i;
+
+        array_slice<i32> spare = arr.reserve_spare(2000);
+        REQUIRE(spare.get_count() >= 2000);
+        REQUIRE(spare.get_count() == arr.get_reserved_count());
+        REQUIRE(spare.get_data() == arr.get_data() + 1010);
+        REQUIRE(arr.get_count() == 1010);
+
+        for (i32 i = 0; i < 5; i++)
+            spare[i] = 1010 + i;
+
+        arr.commit_spare(5);
+        REQUIRE(arr.get_count() == 1015);
+
+        for (i32 i = 0; i < 1015; i++)
+            REQUIRE(arr.get_at(i) == i);
+
+        usize capacity = arr.get_capacity();
+        arr.resize_uninitialized(5);
+        REQUIRE(arr.get_count() == 5);
+        REQUIRE(arr.get_capacity() == capacity);
+        REQUIRE(arr.get_at(4) == 4);
+    }
+}
+
 TEST_CASE("atom_core.dynamic_array")
 {
 //     using tracked_i32 = tracked_type_of<i32>;
@@ -103,3 +174,127 @@ TEST_CASE("atom_core.dynamic_array")
 
 //     SECTION("range operator") {}
 }
+
+TEST_CASE("atom_core.dynamic_array.insert_remove")
+{
+    SECTION("insert and remove at the front, middle and end")
+    {
+        i32 twos[] = { 2, 2 };
+        i32 firsts[] = { -2, -1 };
+        i32 lasts[] = { 5, 6 };
+
+        dynamic_array<i32> arr;
+        arr.emplace_last(1);
+        arr.emplace_last(4);
+        arr.emplace_first(0);
+        arr.emplace_at(2, 3);
+        arr.insert_range_at(2, ranges::from(twos, 2));
+        REQUIRE(has_values(arr, { 0, 1, 2, 2, 3, 4 }));
+
+        arr.insert_range_first(ranges::from(firsts, 2));
+        arr.insert_range_last(ranges::from(lasts, 2));
+        REQUIRE(has_values(arr, { -2, -1, 0, 1, 2, 2, 3, 4, 5, 6 }));
+
+        arr.remove_first();
+        arr.remove_last();
+        arr.remove_at(3);
+        REQUIRE(has_values(arr, { -1, 0, 1, 2, 3, 4, 5 }));
+
+        arr.remove_range(2, 5);
+        REQUIRE(has_values(arr, { -1, 0, 4, 5 }));
+
+        arr.remove_range(2, 4);
+        REQUIRE(has_values(arr, { -1, 0 }));
+
+        arr.remove_range(arr.get_iterator(), arr.get_iterator_end());
+        REQUIRE(arr.is_empty());
+    }
+
+    SECTION("self aliasing inserts")
+    {
+        i32 values[] = { 0, 1, 2, 3 };
+
+        dynamic_array<i32> arr;
+        arr.insert_range_last(ranges::from(values, 4));
+        arr.reserve(16);
+
+        // fits in the capacity.
+        arr.insert_range_at(1, ranges::from(arr.get_data() + 2, 2));
+        REQUIRE(has_values(arr, { 0, 2, 3, 1, 2, 3 }));
+
+        arr.release_mem();
+        REQUIRE(arr.get_capacity() == arr.get_count());
+
+        // needs growth.
+        arr.insert_range_at(0, ranges::from(arr.get_data(), arr.get_count()));
+        REQUIRE(has_values(arr, { 0, 2, 3, 1, 2, 3, 0, 2, 3, 1, 2, 3 }));
+
+        arr.emplace_at(0, arr.get_at(5));
+        REQUIRE(arr.get_at(0) == 3);
+    }
+
+    SECTION("growth")
+    {
+        dynamic_array<i32> arr;
+        for (i32 i = 0; i < 1000; i++)
+            arr.emplace_last(i);
+
+        REQUIRE(arr.get_count() == 1000);
+        REQUIRE(arr.get_capacity() >= 1000);
+
+        for (i32 i = 0; i < 1000; i++)
+            REQUIRE(arr.get_at(i) == i);
+
+        arr.remove_range(0, 990);
+        arr.release_mem();
+        REQUIRE(arr.get_capacity() == 10);
+        REQUIRE(arr.get_at(0) == 990);
+
+        arr.remove_all();
+        arr.release_mem();
+        REQUIRE(arr.get_capacity() == 0);
+        REQUIRE(arr.get_data() == nullptr);
+    }
+
+    SECTION("non trivial values")
+    {
+        dynamic_array<std::string> arr;
+        for (i32 i = 0; i < 4; i++)
+            arr.emplace_last(make_str(i));
+
+        arr.emplace_at(1, make_str(10));
+        arr.emplace_many_at(3, 2, make_str(20));
+        REQUIRE(has_values(arr, { make_str(0), make_str(10), make_str(1), make_str(20),
+                                    make_str(20), make_str(2), make_str(3) }));
+
+        arr.reserve(32);
+
+        // shifting the tail in place would move the values being inserted.
+        arr.insert_range_at(1, ranges::from(arr.get_data() + 4, 3));
+        REQUIRE(has_values(arr, { make_str(0), make_str(20), make_str(2), make_str(3),
+                                    make_str(10), make_str(1), make_str(20), make_str(20),
+                                    make_str(2), make_str(3) }));
+
+        arr.remove_range(1, 4);
+        arr.remove_first();
+        arr.remove_last(2);
+        REQUIRE(has_values(arr, { make_str(10), make_str(1), make_str(20), make_str(20) }));
+
+        arr.release_mem();
+        arr.insert_range_last(ranges::from(arr.get_data(), 2));
+        REQUIRE(has_values(arr, { make_str(10), make_str(1), make_str(20), make_str(20),
+                                    make_str(10), make_str(1) }));
+    }
+
+    SECTION("uninitialized resize and append")
+    {
+        dynamic_array<i32> arr;
+        check_uninitialized_apis(arr);
+    }
+
+    SECTION("uninitialized resize and append of buf_array")
+    {
+        buf_array<i32, 16> arr;
+        check_uninitialized_apis(arr);
+    }
+}
@@ -0,0 +1,43 @@
+module;
+#include "catch2/catch_test_macros.hpp"
+
+module atom_core.tests:ring_buffer;
+
+import atom_core;
+
+using namespace atom;
+
+TEST_CASE("atom_core.ring_buffer")
+{
+    SECTION("push and pop at both ends")
+    {
+        ring_buffer<i32> buffer;
+        for (i32 i = 0; i < 100; i++)
+        {
+            buffer.emplace_last(i);
+            buffer.emplace_first(-i - 1);
+        }
+
+        REQUIRE(buffer.get_count() == 200);
+        REQUIRE(buffer.get_first() == -100);
+        REQUIRE(buffer.get_last() == 99);
+
+        for (i32 i = 0; i < 100; i++)
+            buffer.remove_first();
+
+        REQUIRE(buffer.get_first() == 0);
+        REQUIRE(buffer.get_at(50) == 50);
+    }
+
+    SECTION("overwrite keeps a fixed window")
+    {
+        ring_buffer<i32> buffer{ create_with_capacity, 8 };
+        for (i32 i = 0; i < 20; i++)
+            buffer.emplace_last_overwrite(i);
+
+        REQUIRE(buffer.get_capacity() == 8);
+        REQUIRE(buffer.is_full());
+        REQUIRE(buffer.get_first() == 12);
+        REQUIRE(buffer.get_last() == 19);
+    }
+}
@@ -0,0 +1,30 @@
+module;
+#include "catch2/catch_test_macros.hpp"
+
+module atom_core.tests:segmented_array;
+
+import atom_core;
+
+using namespace atom;
+
+TEST_CASE("atom_core.segmented_array")
+{
+    segmented_array<i64> values;
+    values.emplace_last(-1);
+    const i64* first = &values.get_at(0);
+
+    for (i64 i = 0; i < 10'000; i++)
+        values.emplace_last(i);
+
+    REQUIRE(*first == -1);
+    REQUIRE(values.get_count() == 10'001);
+    for (usize i = 1; i < values.get_count(); i++)
+        REQUIRE(values.get_at(i) == i64(i) - 1);
+
+    values.remove_last();
+    REQUIRE(values.get_last() == 9'998);
+
+    segmented_array<i64> copy = values;
+    REQUIRE(copy.get_count() == values.get_count());
+    REQUIRE(copy.get_at(5'000) == values.get_at(5'000));
+}
@@ -0,0 +1,106 @@
+module;
+#include "catch2/catch_test_macros.hpp"
+
+module atom_core.tests:sorted_flat_map;
+
+import atom_core;
+
+using namespace atom;
+
+TEST_CASE("atom_core.sorted_flat_set")
+{
+    SECTION("bulk construction sorts and removes duplicates")
+    {
+        const i32 input[] = { 5, 1, 4, 1, 3, 5, 2 };
+        sorted_flat_set<i32> set{ create_from_range, ranges::from(input, 7) };
+
+        REQUIRE(set.get_count() == 5);
+        for (usize i = 0; i < set.get_count(); i++)
+            REQUIRE(set.get_at(i) == i32(i + 1));
+
+        REQUIRE(set.contains(3));
+        REQUIRE(not set.contains(0));
+        REQUIRE(not set.contains(6));
+    }
+
+    SECTION("insert and remove")
+    {
+        sorted_flat_set<i32> set;
+
+        REQUIRE(set.insert(2));
+        REQUIRE(set.insert(0));
+        REQUIRE(set.insert(1));
+        REQUIRE(not set.insert(1));
+        REQUIRE(set.get_index(0) == 0);
+        REQUIRE(set.get_index(2) == 2);
+
+        REQUIRE(set.remove(1));
+        REQUIRE(not set.remove(1));
+        REQUIRE(set.get_count() == 2);
+    }
+
+    SECTION("insert range merges")
+    {
+        const i32 first[] = { 1, 3, 5 };
+        const i32 second[] = { 6, 2, 3, 0 };
+        sorted_flat_set<i32> set{ create_from_range, ranges::from(first, 3) };
+        set.insert_range(ranges::from(second, 4));
+
+        REQUIRE(set.get_count() == 6);
+        const i32 expected[] = { 0, 1, 2, 3, 5, 6 };
+        for (usize i = 0; i < set.get_count(); i++)
+            REQUIRE(set.get_at(i) == expected[i]);
+    }
+}
+
+TEST_CASE("atom_core.sorted_flat_map")
+{
+    SECTION("bulk construction keeps the last duplicate")
+    {
+        const i32 keys[] = { 3, 1, 2, 1 };
+        const i32 values[] = { 30, 10, 20, 11 };
+        sorted_flat_map<i32, i32> map{ create_from_range, ranges::from(keys, 4),
+            ranges::from(values, 4) };
+
+        REQUIRE(map.get_count() == 3);
+        REQUIRE(map.get_key_at(0) == 1);
+        REQUIRE(*map.find(1) == 11);
+        REQUIRE(*map.find(2) == 20);
+        REQUIRE(*map.find(3) == 30);
+        REQUIRE(map.find(4) == nullptr);
+    }
+
+    SECTION("emplace and insert_or_assign")
+    {
+        sorted_flat_map<i32, i32> map;
+
+        REQUIRE(map.emplace(2, 20));
+        REQUIRE(not map.emplace(2, 21));
+        REQUIRE(*map.find(2) == 20);
+
+        REQUIRE(map.insert_or_assign(1, 10));
+        REQUIRE(not map.insert_or_assign(2, 22));
+        REQUIRE(*map.find(2) == 22);
+        REQUIRE(map.get_key_at(0) == 1);
+
+        REQUIRE(map.remove(1));
+        REQUIRE(not map.contains(1));
+    }
+
+    SECTION("insert range assigns existing keys")
+    {
+        sorted_flat_map<i32, i32> map;
+        map.emplace(1, 10);
+        map.emplace(3, 30);
+
+        const i32 keys[] = { 4, 3, 0 };
+        const i32 values[] = { 40, 31, 0 };
+        map.insert_range(ranges::from(keys, 3), ranges::from(values, 3));
+
+        REQUIRE(map.get_count() == 4);
+        REQUIRE(map.get_key_at(0) == 0);
+        REQUIRE(map.get_key_at(3) == 4);
+        REQUIRE(*map.find(3) == 31);
+        REQUIRE(*map.find(1) == 10);
+    }
+}
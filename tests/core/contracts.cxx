@@ -0,0 +1,66 @@
+module;
+#include "catch2/catch_test_macros.hpp"
+
+module atom_core.tests:contracts;
+
+import atom_core;
+
+using namespace atom;
+
+class recording_contract_violation_handler final: public contract_violation_handler
+{
+public:
+    virtual auto handle(const contract_violation& violation) -> void override
+    {
+        count++;
+        last_site_count = violation.site_count;
+        last_has_trace = violation.has_trace();
+
+        if (violation.has_trace())
+            last_frame_count = violation.get_trace().frames.size();
+    }
+
+public:
+    usize count = 0;
+    u64 last_site_count = 0;
+    bool last_has_trace = false;
+    usize last_frame_count = 0;
+};
+
+static auto violate_contract() -> void
+{
+    contract_expects(false, "test violation.");
+}
+
+TEST_CASE("atom_core.contracts")
+{
+    recording_contract_violation_handler handler;
+    contract_violation_handler::set(&handler);
+
+    SECTION("recovering handler counts violations per site")
+    {
+        contract_violation_handler::set_trace_limit(0);
+
+        for (usize i = 0; i < 3; i++)
+            violate_contract();
+
+        REQUIRE(handler.count == 3);
+        // counts are kept for the whole process, so earlier runs count too.
+        REQUIRE(handler.last_site_count >= 3);
+        REQUIRE_FALSE(handler.last_has_trace);
+    }
+
+    SECTION("traces are resolved on request")
+    {
+        contract_violation_handler::set_trace_limit(64);
+
+        violate_contract();
+
+        REQUIRE(handler.count == 1);
+        REQUIRE(handler.last_has_trace);
+        REQUIRE(handler.last_frame_count > 0);
+    }
+
+    contract_violation_handler::set_trace_limit(64);
+    contract_violation_handler::set_default();
+}
@@ -0,0 +1,123 @@
+module;
+#include "catch2/catch_test_macros.hpp"
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <set>
+#include <string>
+
+module atom_core.tests:directory;
+
+import atom_core;
+
+using namespace atom;
+
+TEST_CASE("atom_core.filesystem.directory")
+{
+    std::filesystem::path root = std::filesystem::temp_directory_path() / "atom_core_tests_dir";
+    std::filesystem::remove_all(root);
+    std::filesystem::create_directories(root);
+
+    std::set<std::string> expected;
+    for (usize i = 0; i < 10; i++)
+    {
+        std::filesystem::path dir = root / ("dir" + std::to_string(i));
+        std::filesystem::create_directory(dir);
+        expected.insert(dir.string());
+
+        for (usize j = 0; j < 20; j++)
+        {
+            std::filesystem::path file = dir / ("file" + std::to_string(j));
+            std::ofstream{ file };
+            expected.insert(file.string());
+        }
+    }
+
+    std::string root_str = root.string();
+    string_view root_path{ root_str.c_str() };
+
+    SECTION("directory")
+    {
+        filesystem::directory dir = filesystem::directory::open(root_path).get_value();
+
+        std::set<std::string> names;
+        filesystem::directory_entry entry;
+        while (dir.next(entry).get_value())
+        {
+            REQUIRE(entry.is_directory());
+            names.insert(std::string(std::string_view(entry.name)));
+        }
+
+        REQUIRE(names.size() == 10);
+        REQUIRE(names.contains("dir0"));
+        REQUIRE_FALSE(names.contains("."));
+        REQUIRE_FALSE(names.contains(".."));
+
+        REQUIRE(filesystem::directory::open(string_view{ "/nonexistent/atom_core" })
+                    .is_error<filesystem::noentry_error>());
+    }
+
+    SECTION("walk_directory")
+    {
+        for (usize thread_count : { 1, 4 })
+        {
+            std::mutex lock;
+            std::set<std::string> paths;
+
+            filesystem::walk_options opts;
+            opts.thread_count = thread_count;
+
+            auto callback = [&](const filesystem::walk_entry& entry) {
+                std::lock_guard guard{ lock };
+                paths.insert(std::string(std::string_view(entry.path)));
+            };
+
+            filesystem::walk_stats stats =
+                filesystem::walk_directory(root_path, opts, callback).get_value();
+
+            REQUIRE(paths == expected);
+            REQUIRE(stats.entry_count == expected.size());
+            REQUIRE(stats.dir_count == 11);
+            REQUIRE(stats.error_count == 0);
+        }
+    }
+
+    SECTION("walk_directory with filters and depth limit")
+    {
+        std::atomic<usize> count = 0;
+        std::atomic<usize> deep_count = 0;
+
+        // catch2 assertions aren't thread safe, the callback only counts.
+        filesystem::walk_options opts;
+        opts.max_depth = 0;
+        filesystem::walk_directory(root_path, opts, [&](const filesystem::walk_entry& entry) {
+            if (entry.depth != 0)
+                deep_count++;
+
+            count++;
+        });
+
+        REQUIRE(count == 10);
+        REQUIRE(deep_count == 0);
+
+        count = 0;
+        opts.max_depth = std::numeric_limits<usize>::max();
+        opts.filter = [](const filesystem::walk_entry& entry) {
+            return entry.type == filesystem::entry_type::file;
+        };
+        opts.dir_filter = [](const filesystem::walk_entry& entry) {
+            return std::string_view(entry.name) != "dir3";
+        };
+        filesystem::walk_directory(
+            root_path, opts, [&](const filesystem::walk_entry& entry) { count++; });
+
+        REQUIRE(count == 9 * 20);
+
+        REQUIRE(filesystem::walk_directory(string_view{ "/nonexistent/atom_core" }, opts,
+            [](const filesystem::walk_entry& entry) {})
+                    .is_error<filesystem::noentry_error>());
+    }
+
+    std::filesystem::remove_all(root);
+}
@@ -0,0 +1,116 @@
+module;
+#include "catch2/catch_test_macros.hpp"
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+module atom_core.tests:file;
+
+import atom_core;
+
+using namespace atom;
+
+TEST_CASE("atom_core.filesystem.file")
+{
+    std::string path_str =
+        (std::filesystem::temp_directory_path() / "atom_core_tests_file.bin").string();
+    string_view path{ path_str.c_str() };
+
+    filesystem::file file =
+        filesystem::file::open(path, filesystem::file::open_flags::read
+                                         | filesystem::file::open_flags::write
+                                         | filesystem::file::open_flags::create
+                                         | filesystem::file::open_flags::binary)
+            .get_value();
+
+    SECTION("write_at and read_at")
+    {
+        std::string text = "hello positional io";
+        REQUIRE(file.write_at(100, memory_view{ text.data(), text.size() }).is_value());
+
+        char buf[5];
+        REQUIRE(file.read_at(106, mut_memory_view{ buf, sizeof(buf) }).get_value() == 5);
+        REQUIRE(std::string(buf, sizeof(buf)) == "posit");
+
+        // reads past the end are short.
+        char tail[64];
+        REQUIRE(file.read_at(110, mut_memory_view{ tail, sizeof(tail) }).get_value() == 9);
+        REQUIRE(file.read_at(1000, mut_memory_view{ tail, sizeof(tail) }).get_value() == 0);
+
+        // the current position is not used or moved.
+        REQUIRE(file.get_pos() == 0);
+
+        // offsets past the largest file offset fail, instead of writing at the current position.
+        REQUIRE(file.write_at(u64(1) << 63, memory_view{ text.data(), 1 }).is_error());
+        REQUIRE(file.get_pos() == 0);
+    }
+
+    SECTION("vectored write_at and read_at")
+    {
+        std::vector<std::string> strs;
+        std::vector<string_view> views;
+        std::string expected;
+        for (usize i = 0; i < 200; i++)
+            strs.push_back(std::to_string(i) + ";");
+
+        for (const std::string& str : strs)
+        {
+            views.push_back(string_view{ str });
+            expected += str;
+        }
+
+        REQUIRE(file.write_at(0, views).is_value());
+
+        std::vector<std::vector<char>> blocks(100, std::vector<char>(8));
+        std::vector<mut_memory_view> bufs;
+        for (std::vector<char>& block : blocks)
+            bufs.push_back(mut_memory_view{ block.data(), block.size() });
+
+        usize read = file.read_at(0, bufs).get_value();
+        REQUIRE(read == expected.size());
+
+        std::string actual;
+        for (const std::vector<char>& block : blocks)
+            actual.append(block.data(), block.size());
+
+        REQUIRE(actual.substr(0, read) == expected);
+    }
+
+    SECTION("concurrent read_at")
+    {
+        std::vector<u32> data(64 * 1024);
+        for (usize i = 0; i < data.size(); i++)
+            data[i] = u32(i);
+
+        REQUIRE(file.write_at(0, memory_view{ data.data(), data.size() * sizeof(u32) }).is_value());
+
+        std::vector<std::thread> threads;
+        std::vector<u8> results(4, 0);
+        for (usize t = 0; t < results.size(); t++)
+        {
+            threads.emplace_back([&, t] {
+                bool ok = true;
+                for (usize i = t; i < data.size(); i += 97)
+                {
+                    u32 value = 0;
+                    usize read = file.read_at(i * sizeof(u32), mut_memory_view{ &value, 4 })
+                                     .get_value();
+                    ok = ok and read == 4 and value == u32(i);
+                }
+
+                results[t] = ok;
+            });
+        }
+
+        for (std::thread& thread : threads)
+            thread.join();
+
+        for (u8 ok : results)
+            REQUIRE(ok == 1);
+    }
+
+    file.close();
+    std::filesystem::remove(path_str);
+}
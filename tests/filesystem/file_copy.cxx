@@ -0,0 +1,107 @@
+module;
+#include "catch2/catch_test_macros.hpp"
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+module atom_core.tests:file_copy;
+
+import atom_core;
+
+using namespace atom;
+
+TEST_CASE("atom_core.filesystem.file_copy")
+{
+    std::filesystem::path dir = std::filesystem::temp_directory_path() / "atom_core_tests_copy";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+
+    std::string from_str = (dir / "from").string();
+    std::string to_str = (dir / "to").string();
+    string_view from_path{ from_str.c_str() };
+    string_view to_path{ to_str.c_str() };
+
+    // spans several chunks when copied through a buffer.
+    std::string data;
+    for (usize i = 0; i < 3 * 1024 * 1024; i++)
+        data += char('a' + i % 26);
+
+    REQUIRE(filesystem::write_file_str(from_path, string_view{ data }).is_value());
+
+    SECTION("copy_file")
+    {
+        REQUIRE(filesystem::copy_file(from_path, to_path).get_value() == data.size());
+        REQUIRE(std::string_view(filesystem::read_file_str(to_path).get_value()) == data);
+
+        // replaces existing files.
+        REQUIRE(filesystem::write_file_str(to_path, string_view{ "old contents" }).is_value());
+        REQUIRE(filesystem::copy_file(from_path, to_path).get_value() == data.size());
+        REQUIRE(std::string_view(filesystem::read_file_str(to_path).get_value()) == data);
+
+        REQUIRE(filesystem::copy_file(string_view{ "/nonexistent/atom_core" }, to_path)
+                    .is_error<filesystem::noentry_error>());
+    }
+
+    SECTION("copy_file fallbacks")
+    {
+        using filesystem::copy_methods;
+
+        // only `sendfile` and copying through a buffer.
+        REQUIRE(filesystem::copy_file(from_path, to_path, copy_methods::send_file).get_value()
+                == data.size());
+        REQUIRE(std::string_view(filesystem::read_file_str(to_path).get_value()) == data);
+
+        // only copying through a buffer.
+        REQUIRE(filesystem::write_file_str(to_path, string_view{ "old contents" }).is_value());
+        REQUIRE(filesystem::copy_file(from_path, to_path, copy_methods::none).get_value()
+                == data.size());
+        REQUIRE(std::string_view(filesystem::read_file_str(to_path).get_value()) == data);
+    }
+
+    SECTION("copy_file to the same file")
+    {
+        std::string link_str = (dir / "link").string();
+        std::filesystem::create_hard_link(dir / "from", dir / "link");
+
+        REQUIRE(filesystem::copy_file(from_path, from_path)
+                    .is_error<filesystem::invalid_options_error>());
+        REQUIRE(filesystem::copy_file(from_path, string_view{ link_str.c_str() })
+                    .is_error<filesystem::invalid_options_error>());
+
+        // the source is left untouched.
+        REQUIRE(std::string_view(filesystem::read_file_str(from_path).get_value()) == data);
+    }
+
+    SECTION("copy_range")
+    {
+        using filesystem::file;
+
+        file from =
+            file::open(from_path, file::open_flags::read | file::open_flags::binary).get_value();
+        file to = file::open(to_path,
+            file::open_flags::write | file::open_flags::create | file::open_flags::binary)
+                      .get_value();
+
+        REQUIRE(filesystem::copy_range(from, 100, to, 10, 1000).get_value() == 1000);
+
+        // stops at the end of the source.
+        REQUIRE(filesystem::copy_range(from, data.size() - 5, to, 1010, 1000).get_value() == 5);
+
+        // only copying through a buffer, across several chunks.
+        REQUIRE(filesystem::copy_range(
+                    from, 0, to, 2000, data.size(), filesystem::copy_methods::none)
+                    .get_value()
+                == data.size());
+
+        from.close();
+        to.close();
+
+        std::string contents{ std::string_view(filesystem::read_file_str(to_path).get_value()) };
+        REQUIRE(contents.size() == 2000 + data.size());
+        REQUIRE(contents.substr(10, 1000) == data.substr(100, 1000));
+        REQUIRE(contents.substr(1010, 5) == data.substr(data.size() - 5));
+        REQUIRE(contents.substr(2000) == data);
+    }
+
+    std::filesystem::remove_all(dir);
+}
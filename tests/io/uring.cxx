@@ -0,0 +1,131 @@
+module;
+#include "catch2/catch_test_macros.hpp"
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+module atom_core.tests:uring;
+
+import atom_core;
+
+using namespace atom;
+
+namespace
+{
+    auto test_uring(io::uring::options opts) -> void
+    {
+        std::string path_str =
+            (std::filesystem::temp_directory_path() / "atom_core_tests_uring.bin").string();
+        string_view path{ path_str.c_str() };
+
+        filesystem::file file =
+            filesystem::file::open(path, filesystem::file::open_flags::read
+                                             | filesystem::file::open_flags::write
+                                             | filesystem::file::open_flags::create
+                                             | filesystem::file::open_flags::binary)
+                .get_value();
+        i32 fd = file.get_fd();
+
+        io::uring ring{ opts };
+
+        constexpr usize block_count = 1000;
+        constexpr usize block_size = 64;
+        std::vector<char> out(block_count * block_size);
+        for (usize i = 0; i < out.size(); i++)
+            out[i] = char(i * 7 + 3);
+
+        std::vector<char> registered(4 * block_size);
+        std::vector<i32> fds = { fd };
+        std::vector<mut_memory_view> buffers = { { registered.data(), registered.size() } };
+        REQUIRE(ring.register_files(fds).is_value());
+        REQUIRE(ring.register_buffers(buffers).is_value());
+
+        usize write_count = 0;
+        for (usize i = 0; i < block_count; i++)
+        {
+            memory_view block{ out.data() + i * block_size, block_size };
+            ring.write_at(fd, i * block_size, block, [&](i64 res) {
+                REQUIRE(res == block_size);
+                write_count++;
+            });
+        }
+
+        ring.wait_all();
+        REQUIRE(write_count == block_count);
+        REQUIRE(ring.get_pending_count() == 0);
+
+        std::vector<char> in(out.size());
+        usize read_count = 0;
+        for (usize i = 0; i < block_count; i++)
+        {
+            ring.read_at(fd, i * block_size,
+                mut_memory_view{ in.data() + i * block_size, block_size }, [&](i64 res) {
+                    REQUIRE(res == block_size);
+                    read_count++;
+                });
+        }
+
+        io::uring_ticket ticket =
+            ring.read_at(fd, 3 * block_size, mut_memory_view{ registered.data(), block_size });
+        REQUIRE(ring.wait(ticket) == block_size);
+        REQUIRE(std::memcmp(registered.data(), out.data() + 3 * block_size, block_size) == 0);
+
+        ring.wait_all();
+        REQUIRE(read_count == block_count);
+        REQUIRE(in == out);
+
+        // the follow-up is the only operation left when the first one completes.
+        std::vector<char> chained(block_size);
+        usize chained_count = 0;
+        ring.read_at(fd, 0, mut_memory_view{ chained.data(), block_size }, [&](i64 res) {
+            REQUIRE(res == block_size);
+            chained_count++;
+
+            ring.read_at(fd, 5 * block_size, mut_memory_view{ chained.data(), block_size },
+                [&](i64 res) {
+                    REQUIRE(res == block_size);
+                    chained_count++;
+                });
+        });
+
+        ring.wait_all();
+        REQUIRE(chained_count == 2);
+        REQUIRE(ring.get_pending_count() == 0);
+        REQUIRE(std::memcmp(chained.data(), out.data() + 5 * block_size, block_size) == 0);
+
+        io::uring_ticket bad_ticket =
+            ring.read_at(-1, 0, mut_memory_view{ registered.data(), block_size });
+        REQUIRE(ring.wait(bad_ticket) == -EBADF);
+
+        file.close();
+        std::filesystem::remove(path_str);
+    }
+}
+
+TEST_CASE("atom_core.io.uring")
+{
+    SECTION("io_uring")
+    {
+        test_uring(io::uring::options{});
+    }
+
+    SECTION("io_uring with small rings")
+    {
+        test_uring(io::uring::options{ .entry_count = 4 });
+    }
+
+    SECTION("io_uring with polling")
+    {
+        test_uring(io::uring::options{ .use_polling = true });
+    }
+
+    SECTION("blocking fallback")
+    {
+        io::uring::options opts{ .use_fallback = true };
+        REQUIRE_FALSE(io::uring{ opts }.is_async());
+
+        test_uring(opts);
+    }
+}
@@ -0,0 +1,126 @@
+module;
+#include "catch2/catch_test_macros.hpp"
+#include "atom/core/log.h"
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+module atom_core.tests:log;
+
+import atom_core;
+
+using namespace atom;
+
+TEST_CASE("atom_core.log")
+{
+    std::string path_str =
+        (std::filesystem::temp_directory_path() / "atom_core_tests_log.txt").string();
+    string_view path{ path_str.c_str() };
+
+    filesystem::file sink = filesystem::file::open(path,
+        filesystem::file::open_flags::write | filesystem::file::open_flags::create)
+                                .get_value();
+
+    log::start(log::options{ .sink = &sink, .buffer_size = 4096, .block_when_full = true });
+    log::set_level(log::level::trace);
+
+    auto read_log = [&] {
+        log::flush();
+        return std::string{ std::string_view(filesystem::read_file_str(path).get_value()) };
+    };
+
+    SECTION("formats messages on the writer")
+    {
+        std::string temp = "temporary";
+        log::info("int {}, str {}, lit {}", 42, temp, "literal");
+        log::warn("moved {}", std::string(100, 'm'));
+        temp = "changed";
+
+        std::string contents = read_log();
+        REQUIRE(contents.find("[info] int 42, str temporary, lit literal\n") != std::string::npos);
+        REQUIRE(contents.find("[warn] moved " + std::string(100, 'm')) != std::string::npos);
+    }
+
+    SECTION("filters levels")
+    {
+        log::set_level(log::level::warn);
+        log::info("filtered {}", 1);
+        log::error("kept {}", 2);
+
+        bool is_evaluated = false;
+        ATOM_LOG_INFO("filtered {}", is_evaluated = true);
+        REQUIRE(not is_evaluated);
+
+        std::string contents = read_log();
+        REQUIRE(contents.find("filtered") == std::string::npos);
+        REQUIRE(contents.find("[error] kept 2") != std::string::npos);
+    }
+
+    SECTION("many threads")
+    {
+        std::vector<std::thread> threads;
+        for (usize i = 0; i < 4; i++)
+        {
+            threads.emplace_back([i] {
+                for (usize j = 0; j < 1000; j++)
+                    log::info("thread {} message {}", i, j);
+            });
+        }
+
+        for (auto& thread : threads)
+            thread.join();
+
+        std::string contents = read_log();
+        for (usize i = 0; i < 4; i++)
+        {
+            REQUIRE(contents.find("thread " + std::to_string(i) + " message 999\n")
+                    != std::string::npos);
+        }
+    }
+
+    SECTION("messages logged while stopping are written")
+    {
+        std::vector<std::thread> threads;
+        for (usize i = 0; i < 4; i++)
+        {
+            threads.emplace_back([i] {
+                for (usize j = 0; j < 1000; j++)
+                    log::info("racing thread {} message {}", i, j);
+            });
+        }
+
+        for (usize i = 0; i < 20; i++)
+        {
+            log::stop();
+            log::start(
+                log::options{ .sink = &sink, .buffer_size = 4096, .block_when_full = true });
+        }
+
+        for (auto& thread : threads)
+            thread.join();
+
+        std::string contents = read_log();
+        usize count = 0;
+        for (usize pos = contents.find("racing thread"); pos != std::string::npos;
+             pos = contents.find("racing thread", pos + 1))
+            count++;
+
+        REQUIRE(count == 4000);
+    }
+
+    SECTION("writes on the calling thread once stopped")
+    {
+        log::stop();
+        log::info("after stop");
+
+        std::string contents = read_log();
+        REQUIRE(contents.find("[info] after stop\n") != std::string::npos);
+    }
+
+    // don't leave the logger writing to the closed file.
+    log::start();
+    log::set_level(log::min_level);
+    sink.close();
+    std::filesystem::remove(path_str);
+}
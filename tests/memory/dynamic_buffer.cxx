@@ -0,0 +1,72 @@
+module;
+#include "catch2/catch_test_macros.hpp"
+#include <cstring>
+
+module atom_core.tests:dynamic_buffer;
+
+import atom_core;
+
+using namespace atom;
+
+TEST_CASE("atom_core.dynamic_buffer")
+{
+    SECTION("append_uninitialized")
+    {
+        dynamic_buffer buffer;
+
+        mut_memory_view first = buffer.append_uninitialized(3);
+        REQUIRE(first.get_size() == 3);
+        REQUIRE(first.get_data() == buffer.get_data());
+        std::memcpy(first.get_data(), "abc", 3);
+
+        mut_memory_view second = buffer.append_uninitialized(1000);
+        REQUIRE(second.get_size() == 1000);
+        REQUIRE(second.get_data() == buffer.get_data() + 3);
+        std::memset(second.get_data(), 'x', 1000);
+
+        REQUIRE(buffer.get_size() == 1003);
+        REQUIRE(std::memcmp(buffer.get_data(), "abcxx", 5) == 0);
+        REQUIRE(buffer.get_data()[1002] == byte('x'));
+    }
+
+    SECTION("get_spare and commit")
+    {
+        dynamic_buffer buffer;
+        std::memcpy(buffer.append_uninitialized(2).get_data(), "ab", 2);
+
+        mut_memory_view spare = buffer.get_spare(10);
+        REQUIRE(spare.get_size() >= 10);
+        REQUIRE(spare.get_size() == buffer.get_spare_size());
+        REQUIRE(spare.get_data() == buffer.get_data() + 2);
+        REQUIRE(buffer.get_size() == 2);
+
+        std::memcpy(spare.get_data(), "cdef", 4);
+        buffer.commit(4);
+
+        REQUIRE(buffer.get_size() == 6);
+        REQUIRE(buffer.get_spare_size() == buffer.get_capacity() - 6);
+        REQUIRE(std::memcmp(buffer.get_data(), "abcdef", 6) == 0);
+
+        // doesn't grow when the spare capacity is enough.
+        usize capacity = buffer.get_capacity();
+        buffer.get_spare(buffer.get_spare_size());
+        REQUIRE(buffer.get_capacity() == capacity);
+    }
+
+    SECTION("reserve and resize keep the bytes")
+    {
+        dynamic_buffer buffer;
+        std::memcpy(buffer.append_uninitialized(4).get_data(), "abcd", 4);
+
+        buffer.reserve(4096);
+        REQUIRE(buffer.get_capacity() >= 4096);
+        REQUIRE(buffer.get_size() == 4);
+
+        buffer.resize(2);
+        REQUIRE(buffer.get_size() == 2);
+
+        buffer.resize(5000);
+        REQUIRE(buffer.get_size() == 5000);
+        REQUIRE(std::memcmp(buffer.get_data(), "ab", 2) == 0);
+    }
+}
@@ -0,0 +1,156 @@
+module;
+#include "catch2/catch_test_macros.hpp"
+#include <thread>
+#include <vector>
+
+module atom_core.tests:ebr;
+
+import atom_core;
+
+using namespace atom;
+
+namespace
+{
+    std::atomic<i32> ebr_live_count = 0;
+
+    class ebr_node
+    {
+    public:
+        ebr_node(i32 value)
+            : value{ value }
+        {
+            ebr_live_count++;
+        }
+
+        ~ebr_node()
+        {
+            ebr_live_count--;
+        }
+
+    public:
+        i32 value;
+        ebr_node* next = nullptr;
+    };
+
+    auto make_ebr_node(i32 value) -> ebr_node*
+    {
+        void* mem = default_mem_allocator().alloc(sizeof(ebr_node));
+        return new (mem) ebr_node{ value };
+    }
+}
+
+TEST_CASE("atom_core.ebr")
+{
+    SECTION("pinned threads delay reclamation")
+    {
+        ebr::domain domain;
+
+        ebr::guard guard = domain.pin();
+        domain.retire(make_ebr_node(1));
+
+        // the epoch advances at most once while the thread is pinned in it.
+        for (usize i = 0; i < 4; i++)
+            domain.collect();
+
+        REQUIRE(ebr_live_count == 1);
+        REQUIRE(domain.get_retired_count() == 1);
+
+        guard.unpin();
+        REQUIRE(not guard.is_pinned());
+
+        for (usize i = 0; i < 4; i++)
+            domain.collect();
+
+        REQUIRE(ebr_live_count == 0);
+        REQUIRE(domain.get_retired_count() == 0);
+    }
+
+    SECTION("guards nest")
+    {
+        ebr::domain domain;
+
+        ebr::guard outer = domain.pin();
+        {
+            ebr::guard inner = domain.pin();
+        }
+
+        u64 epoch = domain.get_epoch();
+        for (usize i = 0; i < 4; i++)
+            domain.collect();
+
+        REQUIRE(domain.get_epoch() <= epoch + 1);
+    }
+
+    SECTION("deferred functions")
+    {
+        ebr::domain domain;
+
+        bool is_called = false;
+        domain.retire([&] { is_called = true; });
+
+        for (usize i = 0; i < 4; i++)
+            domain.collect();
+
+        REQUIRE(is_called);
+    }
+
+    SECTION("destroying the domain reclaims everything")
+    {
+        {
+            ebr::domain domain;
+            domain.retire(make_ebr_node(1));
+            domain.retire(make_ebr_node(2));
+        }
+
+        REQUIRE(ebr_live_count == 0);
+    }
+
+    SECTION("lock free stack")
+    {
+        ebr::domain domain;
+        std::atomic<ebr_node*> head = nullptr;
+
+        std::vector<std::thread> threads;
+        for (usize i = 0; i < 4; i++)
+        {
+            threads.emplace_back([&] {
+                for (i32 j = 0; j < 10000; j++)
+                {
+                    ebr::guard guard = domain.pin();
+
+                    if (j % 2 == 0)
+                    {
+                        ebr_node* node = make_ebr_node(j);
+                        node->next = head.load();
+                        while (not head.compare_exchange_weak(node->next, node))
+                        {}
+
+                        continue;
+                    }
+
+                    ebr_node* node = head.load();
+                    while (node != nullptr and not head.compare_exchange_weak(node, node->next))
+                    {}
+
+                    if (node != nullptr)
+                        domain.retire(node);
+                }
+            });
+        }
+
+        for (std::thread& thread : threads)
+            thread.join();
+
+        for (ebr_node* node = head.load(); node != nullptr;)
+        {
+            ebr_node* next = node->next;
+            domain.retire(node);
+            node = next;
+        }
+
+        for (usize i = 0; i < 4; i++)
+            domain.collect();
+
+        REQUIRE(ebr_live_count == 0);
+    }
+}
@@ -0,0 +1,163 @@
+module;
+#include "catch2/catch_test_macros.hpp"
+#include <thread>
+#include <vector>
+
+module atom_core.tests:hazard_ptr;
+
+import atom_core;
+
+using namespace atom;
+
+namespace
+{
+    std::atomic<i32> hazard_live_count = 0;
+
+    class hazard_node
+    {
+    public:
+        hazard_node(i32 value)
+            : value{ value }
+        {
+            hazard_live_count++;
+        }
+
+        ~hazard_node()
+        {
+            hazard_live_count--;
+        }
+
+    public:
+        i32 value;
+        hazard_node* next = nullptr;
+    };
+
+    auto make_hazard_node(i32 value) -> hazard_node*
+    {
+        void* mem = default_mem_allocator().alloc(sizeof(hazard_node));
+        return new (mem) hazard_node{ value };
+    }
+}
+
+TEST_CASE("atom_core.hazard_ptr")
+{
+    SECTION("protected objects are not reclaimed")
+    {
+        hazard_ptr_domain domain;
+        hazard_ptr hazard{ domain };
+
+        std::atomic<hazard_node*> src = make_hazard_node(1);
+        hazard_node* node = hazard.protect(src);
+        REQUIRE(hazard.get() == node);
+
+        src.store(nullptr);
+        domain.retire(node);
+        domain.collect();
+
+        REQUIRE(hazard_live_count == 1);
+        REQUIRE(node->value == 1);
+
+        hazard.reset();
+        domain.collect();
+
+        REQUIRE(hazard_live_count == 0);
+        REQUIRE(domain.get_retired_count() == 0);
+    }
+
+    SECTION("try_protect reloads changed pointers")
+    {
+        hazard_ptr_domain domain;
+        hazard_ptr hazard{ domain };
+
+        i32 first = 0;
+        i32 second = 0;
+        std::atomic<i32*> src = &second;
+
+        i32* ptr = &first;
+        REQUIRE(not hazard.try_protect(ptr, src));
+        REQUIRE(ptr == &second);
+        REQUIRE(hazard.get() == nullptr);
+
+        REQUIRE(hazard.try_protect(ptr, src));
+        REQUIRE(hazard.get() == &second);
+    }
+
+    SECTION("deferred functions")
+    {
+        hazard_ptr_domain domain;
+        hazard_ptr hazard{ domain };
+
+        i32 value = 0;
+        std::atomic<i32*> src = &value;
+        hazard.protect(src);
+
+        bool is_called = false;
+        domain.retire(&value, [&] { is_called = true; });
+        domain.collect();
+        REQUIRE(not is_called);
+
+        hazard.reset();
+        domain.collect();
+        REQUIRE(is_called);
+    }
+
+    SECTION("lock free stack")
+    {
+        hazard_ptr_domain domain;
+        std::atomic<hazard_node*> head = nullptr;
+        std::atomic<usize> max_retired_count = 0;
+
+        std::vector<std::thread> threads;
+        for (usize i = 0; i < 4; i++)
+        {
+            threads.emplace_back([&] {
+                hazard_ptr hazard{ domain };
+
+                for (i32 j = 0; j < 10000; j++)
+                {
+                    if (j % 2 == 0)
+                    {
+                        hazard_node* node = make_hazard_node(j);
+                        node->next = head.load();
+                        while (not head.compare_exchange_weak(node->next, node))
+                        {}
+
+                        continue;
+                    }
+
+                    hazard_node* node = hazard.protect(head);
+                    while (node != nullptr and not head.compare_exchange_strong(node, node->next))
+                        node = hazard.protect(head);
+
+                    hazard.reset();
+                    if (node == nullptr)
+                        continue;
+
+                    domain.retire(node);
+
+                    usize count = domain.get_retired_count();
+                    usize max_count = max_retired_count.load();
+                    while (count > max_count
+                           and not max_retired_count.compare_exchange_weak(max_count, count))
+                    {}
+                }
+            });
+        }
+
+        for (std::thread& thread : threads)
+            thread.join();
+
+        // garbage is bounded by the collect threshold.
+        REQUIRE(max_retired_count < hazard_ptr_domain::min_collect_threshold);
+
+        for (hazard_node* node = head.load(); node != nullptr;)
+        {
+            hazard_node* next = node->next;
+            domain.retire(node);
+            node = next;
+        }
+
+        domain.collect();
+        REQUIRE(hazard_live_count == 0);
+    }
+}
@@ -9,11 +9,45 @@ using namespace atom;
 
 TEST_CASE("atom::memory::memory_utils")
 {
-    void* src = std::malloc(100);
-    void* dest = std::malloc(100);
+    SECTION("fwd_copy_to")
+    {
+        void* src = std::malloc(100);
+        void* dest = std::malloc(100);
 
-    memory_utils::fwd_copy_to(src, 5, dest, 10);
+        memory_utils::fwd_copy_to(src, 5, dest, 10);
 
-    std::free(src);
-    std::free(dest);
+        std::free(src);
+        std::free(dest);
+    }
+
+    SECTION("rotate_fwd")
+    {
+        byte mem[] = { 0, 1, 2, 3, 4 };
+        byte expected[] = { 3, 4, 0, 1, 2 };
+
+        memory_utils::rotate_fwd(mem, 5, 2);
+        REQUIRE(std::ranges::equal(mem, expected));
+    }
+
+    SECTION("rotate_bwd")
+    {
+        byte mem[] = { 0, 1, 2, 3, 4 };
+        byte expected[] = { 2, 3, 4, 0, 1 };
+
+        memory_utils::rotate_bwd(mem, 5, 2);
+        REQUIRE(std::ranges::equal(mem, expected));
+    }
+
+    SECTION("rotate_by")
+    {
+        byte mem[] = { 0, 1, 2, 3, 4 };
+        byte fwd_expected[] = { 4, 0, 1, 2, 3 };
+        byte bwd_expected[] = { 1, 2, 3, 4, 0 };
+
+        memory_utils::rotate_by(mem, 5, 1);
+        REQUIRE(std::ranges::equal(mem, fwd_expected));
+
+        memory_utils::rotate_by(mem, 5, -2);
+        REQUIRE(std::ranges::equal(mem, bwd_expected));
+    }
 }
@@ -0,0 +1,67 @@
+module;
+#include "catch2/catch_test_macros.hpp"
+
+module atom_core.tests:tracking_allocator;
+
+import atom_core;
+
+using namespace atom;
+
+namespace
+{
+    class test_array_tag
+    {
+    public:
+        static constexpr const char* name = "test_array";
+    };
+}
+
+TEST_CASE("atom_core.tracking_allocator")
+{
+    SECTION("records allocations of dynamic_array")
+    {
+        using allocator_type = tracking_allocator<default_mem_allocator, test_array_tag>;
+
+        {
+            dynamic_array<i64, allocator_type> arr;
+            for (i64 i = 0; i < 100; i++)
+                arr.emplace_last(i);
+
+            mem_stats stats = allocator_type::get_stats();
+            REQUIRE(stats.alloc_count > 0);
+            REQUIRE(stats.live_bytes >= i64(100 * sizeof(i64)));
+            REQUIRE(stats.peak_bytes >= stats.live_bytes);
+        }
+
+        mem_stats stats = allocator_type::get_stats();
+        REQUIRE(stats.live_bytes == 0);
+        REQUIRE(stats.alloc_count == stats.dealloc_count);
+    }
+
+    SECTION("snapshot")
+    {
+        tracking_allocator<default_mem_allocator, test_array_tag> allocator;
+        void* mem = allocator.alloc(64);
+        mem = allocator.realloc(mem, 128);
+
+        mem_stats_snapshot snapshot = take_mem_stats_snapshot();
+        allocator.dealloc(mem);
+
+        bool found = false;
+        for (usize i = 0; i < snapshot.tags.get_count(); i++)
+        {
+            const auto& entry = snapshot.tags.get_at(i);
+            if (std::string_view(entry.name) == "test_array")
+            {
+                found = true;
+                // 64 bytes fall in bucket `(32, 64]` and 128 bytes in bucket `(64, 128]`.
+                REQUIRE(entry.stats.size_histogram[6] >= 1);
+                REQUIRE(entry.stats.size_histogram[7] >= 1);
+                REQUIRE(entry.stats.realloc_count >= 1);
+            }
+        }
+
+        REQUIRE(found);
+        REQUIRE(snapshot.to_string().get_count() > 0);
+    }
+}
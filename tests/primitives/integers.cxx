@@ -252,3 +252,40 @@ TEMPLATE_TEST_CASE("atom_core.integers", "", i32_test_data, u32_test_data)
     //         }
     //     }
 }
+
+TEST_CASE("atom_core.integers.overflow")
+{
+    SECTION("checked, saturating and wrapping operations")
+    {
+        REQUIRE(nums::is_add_safe<i32>(2'147'483'646, 1));
+        REQUIRE_FALSE(nums::is_add_safe<i32>(2'147'483'647, 1));
+        REQUIRE_FALSE(nums::is_sub_safe<u32>(0, 1));
+        REQUIRE_FALSE(nums::is_mul_safe<i64>(nums::get_max<i64>(), 2));
+
+        REQUIRE(nums::add_checked<i32>(40, 2) == 42);
+        REQUIRE(nums::add_saturating<i32>(2'147'483'647, 1) == 2'147'483'647);
+        REQUIRE(nums::add_saturating<i32>(-2'147'483'647, -2) == nums::get_min<i32>());
+        REQUIRE(nums::sub_saturating<u32>(1, 2) == 0);
+        REQUIRE(nums::mul_saturating<i16>(-300, 300) == nums::get_min<i16>());
+
+        REQUIRE(nums::add_wrapping<u8>(255, 1) == 0);
+        REQUIRE(nums::sub_wrapping<i8>(-128, 1) == 127);
+        REQUIRE(nums::mul_wrapping<u16>(256, 256) == 0);
+    }
+
+    SECTION("sum_checked")
+    {
+        i32 values[] = { 2'147'483'647, 1, -1, -2'147'483'647 };
+        REQUIRE(ranges::sum_checked(values).get() == 0);
+
+        i32 overflowing[] = { 2'147'483'647, 1 };
+        REQUIRE_FALSE(ranges::sum_checked(overflowing).is_value());
+
+        i64 wide[] = { nums::get_max<i64>(), nums::get_max<i64>(), nums::get_min<i64>(),
+            nums::get_min<i64>(), 1 };
+        REQUIRE(ranges::sum_checked(wide).get() == -1);
+
+        u64 wide_overflowing[] = { nums::get_max<u64>(), 1 };
+        REQUIRE_FALSE(ranges::sum_checked(wide_overflowing).is_value());
+    }
+}
@@ -0,0 +1,122 @@
+module;
+#include "catch2/catch_test_macros.hpp"
+#include <algorithm>
+#include <cmath>
+#include <string_view>
+#include <vector>
+
+module atom_core.tests:range_sort;
+
+import atom_core;
+
+using namespace atom;
+
+namespace
+{
+    auto make_values(usize count) -> std::vector<i64>
+    {
+        std::vector<i64> values;
+        u64 state = 42;
+        for (usize i = 0; i < count; i++)
+        {
+            state = state * 6364136223846793005 + 1442695040888963407;
+            values.push_back(i64(state >> 40) - (1 << 23));
+        }
+
+        return values;
+    }
+}
+
+TEST_CASE("atom_core.range_sort")
+{
+    std::vector<i64> values = make_values(10'000);
+    std::vector<i64> expected = values;
+    std::sort(expected.begin(), expected.end());
+
+    SECTION("sort")
+    {
+        ranges::sort(values);
+        REQUIRE(values == expected);
+
+        // already sorted and reverse sorted inputs.
+        ranges::sort(values);
+        REQUIRE(values == expected);
+
+        ranges::sort(values, std::greater<>());
+        REQUIRE(std::is_sorted(values.rbegin(), values.rend()));
+    }
+
+    SECTION("partial_sort and nth_element")
+    {
+        std::vector<i64> partial = values;
+        ranges::partial_sort(partial, 100);
+        REQUIRE(std::equal(partial.begin(), partial.begin() + 100, expected.begin()));
+
+        ranges::nth_element(values, 5'000);
+        REQUIRE(values[5'000] == expected[5'000]);
+        REQUIRE(std::all_of(values.begin(), values.begin() + 5'000,
+            [&](i64 value) { return value <= values[5'000]; }));
+    }
+
+    SECTION("radix_sort integers and floats")
+    {
+        ranges::radix_sort(values);
+        REQUIRE(values == expected);
+
+        std::vector<f64> floats;
+        for (i64 value : make_values(1'000))
+            floats.push_back(f64(value) / 7.0);
+
+        floats.push_back(-0.0);
+        floats.push_back(0.0);
+        ranges::radix_sort(floats);
+        REQUIRE(std::is_sorted(floats.begin(), floats.end()));
+    }
+
+    SECTION("radix_sort orders negative zero first in small ranges")
+    {
+        std::vector<f64> floats = { 0.0, 1.0, -0.0, -1.0, 0.0, -0.0 };
+        ranges::radix_sort(floats);
+
+        REQUIRE(floats == std::vector<f64>{ -1.0, -0.0, -0.0, 0.0, 0.0, 1.0 });
+        REQUIRE(std::signbit(floats[1]));
+        REQUIRE(std::signbit(floats[2]));
+        REQUIRE(not std::signbit(floats[3]));
+        REQUIRE(not std::signbit(floats[4]));
+    }
+
+    SECTION("radix_sort_by_key is stable")
+    {
+        struct entry
+        {
+            u32 key;
+            u32 order;
+        };
+
+        std::vector<entry> entries;
+        for (u32 i = 0; i < 1'000; i++)
+            entries.push_back({ .key = (i * 7919) % 10, .order = i });
+
+        ranges::radix_sort_by_key(entries, [](const entry& entry) { return entry.key; });
+        for (usize i = 1; i < entries.size(); i++)
+        {
+            REQUIRE(entries[i - 1].key <= entries[i].key);
+            if (entries[i - 1].key == entries[i].key)
+                REQUIRE(entries[i - 1].order < entries[i].order);
+        }
+    }
+
+    SECTION("radix_sort strings")
+    {
+        std::vector<std::string_view> strings = { "delta", "alpha", "", "alphabet", "charlie",
+            "bravo", "alp", "delta", "echo" };
+        for (usize i = 0; i < 100; i++)
+            strings.push_back(i % 2 == 0 ? "zulu" : "yankee");
+
+        std::vector<std::string_view> expected_strings = strings;
+        std::sort(expected_strings.begin(), expected_strings.end());
+
+        ranges::radix_sort(strings);
+        REQUIRE(strings == expected_strings);
+    }
+}
@@ -0,0 +1,75 @@
+module;
+#include "catch2/catch_test_macros.hpp"
+#include <string_view>
+
+module atom_core.tests:fixed_string;
+
+import atom_core;
+
+using namespace atom;
+
+namespace
+{
+    template <fixed_string name>
+    class named_field
+    {
+    public:
+        static constexpr auto get_name() -> string_view
+        {
+            return name.get_view();
+        }
+
+        static constexpr u64 hash = name.get_hash();
+    };
+
+    auto dispatch(string_view cmd) -> i32
+    {
+        switch (strings::get_hash(cmd))
+        {
+            case fixed_string{ "get" }.get_hash(): return 1;
+            case fixed_string{ "put" }.get_hash(): return 2;
+            default:                                return 0;
+        }
+    }
+}
+
+TEST_CASE("atom_core.fixed_string")
+{
+    SECTION("literals and template parameters")
+    {
+        constexpr fixed_string str{ "config" };
+        STATIC_REQUIRE(str.get_count() == 6);
+        STATIC_REQUIRE(str == fixed_string{ "config" });
+        STATIC_REQUIRE_FALSE(str == fixed_string{ "conf" });
+        STATIC_REQUIRE(str.get_data()[6] == '\0');
+
+        REQUIRE(std::string_view(named_field<"port">::get_name()) == "port");
+        STATIC_REQUIRE(named_field<"port">::hash == strings::get_hash(string_view{ "port" }));
+    }
+
+    SECTION("hashing")
+    {
+        // fnv-1a test vectors.
+        STATIC_REQUIRE(strings::get_hash(string_view{ "" }) == 0xcbf29ce484222325);
+        STATIC_REQUIRE(strings::get_hash(string_view{ "a" }) == 0xaf63dc4c8601ec8c);
+        STATIC_REQUIRE(fixed_string{ "foobar" }.get_hash() == 0x85944171f73967e8);
+
+        REQUIRE(dispatch(string_view{ "get" }) == 1);
+        REQUIRE(dispatch(string_view{ "put" }) == 2);
+        REQUIRE(dispatch(string_view{ "delete" }) == 0);
+    }
+
+    SECTION("fixed_string_set")
+    {
+        using keys = fixed_string_set<"host", "port", "timeout">;
+
+        STATIC_REQUIRE(keys::get_count() == 3);
+        STATIC_REQUIRE(keys::get_index<"port">() == 1);
+        REQUIRE(std::string_view(keys::get_at(2)) == "timeout");
+
+        REQUIRE(keys::find(string_view{ "host" }).get() == 0);
+        REQUIRE(keys::find(string_view{ "timeout" }).get() == 2);
+        REQUIRE_FALSE(keys::find(string_view{ "hos" }).is_value());
+        REQUIRE_FALSE(keys::find(string_view{ "" }).is_value());
+    }
+}
@@ -0,0 +1,61 @@
+module;
+#include "catch2/catch_test_macros.hpp"
+#include <string_view>
+
+module atom_core.tests:num_conversions;
+
+import atom_core;
+
+using namespace atom;
+
+TEST_CASE("atom_core.num_conversions")
+{
+    SECTION("parse integers")
+    {
+        REQUIRE(nums::parse<i32>(string_view{ "12345" }).get_value() == 12345);
+        REQUIRE(nums::parse<i32>(string_view{ "-2147483648" }).get_value() == -2147483648);
+        REQUIRE(nums::parse<u64>(string_view{ "18446744073709551615" }).get_value()
+                == nums::get_max_u64());
+        REQUIRE(nums::parse<u64>(string_view{ "0000000000000000000000042" }).get_value() == 42);
+
+        REQUIRE(nums::parse<i32>(string_view{ "" }).is_error<invalid_num_error>());
+        REQUIRE(nums::parse<i32>(string_view{ "-" }).is_error<invalid_num_error>());
+        REQUIRE(nums::parse<i32>(string_view{ "12a" }).is_error<invalid_num_error>());
+        REQUIRE(nums::parse<u32>(string_view{ "-1" }).is_error<invalid_num_error>());
+        REQUIRE(nums::parse<i8>(string_view{ "128" }).is_error<num_out_of_range_error>());
+        REQUIRE(nums::parse<u64>(string_view{ "18446744073709551616" })
+                    .is_error<num_out_of_range_error>());
+    }
+
+    SECTION("parse floats")
+    {
+        REQUIRE(nums::parse<f64>(string_view{ "1.5e3" }).get_value() == 1500.0);
+        REQUIRE(nums::parse<f64>(string_view{ "-0.25" }).get_value() == -0.25);
+        REQUIRE(nums::parse<f64>(string_view{ "1.5x" }).is_error<invalid_num_error>());
+        REQUIRE(nums::parse<f64>(string_view{ "1e999" }).is_error<num_out_of_range_error>());
+    }
+
+    SECTION("to_chars")
+    {
+        char buf[nums::get_max_chars_count<i64>()];
+        array_slice<char> out{ create_from_raw, buf, sizeof(buf) };
+
+        usize count = nums::to_chars(i64(-9223372036854775807 - 1), out).get_value();
+        REQUIRE(std::string_view(buf, count) == "-9223372036854775808");
+
+        count = nums::to_chars(u32(0), out).get_value();
+        REQUIRE(std::string_view(buf, count) == "0");
+
+        array_slice<char> small{ create_from_raw, buf, 2 };
+        REQUIRE(nums::to_chars(i32(1000), small).is_error<buffer_too_small_error>());
+    }
+
+    SECTION("to_chars appends to string")
+    {
+        string str;
+        nums::to_chars(i32(42), str);
+        nums::to_chars(0.1, str);
+
+        REQUIRE(std::string_view(str) == "420.1");
+    }
+}
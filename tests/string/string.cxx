@@ -31,3 +31,34 @@ TEST_CASE("atom_core.string")
     //     str.remove_at(str.get_iterator());
     //     str.remove_range({ str.get_iterator(), str.end() });
 }
+
+TEST_CASE("atom_core.string.uninitialized")
+{
+    string str;
+    str.resize_uninitialized(3);
+    REQUIRE(str.get_count() == 3);
+    REQUIRE(str.get_capacity() >= 3);
+
+    str.get_at(0) = 'a';
+    str.get_at(1) = 'b';
+    str.get_at(2) = 'c';
+
+    // needs growth.
+    array_slice<char> added = str.append_uninitialized(100);
+    REQUIRE(str.get_count() == 103);
+    REQUIRE(str.get_capacity() >= 103);
+
+    for (usize i = 0; i < added.get_count(); i++)
+        added[i] = 'x';
+
+    array_slice<char> spare = str.reserve_spare(1);
+    REQUIRE(spare.get_count() == str.get_reserved_count());
+    spare[0] = 'y';
+    str.commit_spare(1);
+
+    REQUIRE(str.get_count() == 104);
+    REQUIRE(str.get_at(0) == 'a');
+    REQUIRE(str.get_at(2) == 'c');
+    REQUIRE(str.get_at(102) == 'x');
+    REQUIRE(str.get_at(103) == 'y');
+}
@@ -0,0 +1,115 @@
+module;
+#include "catch2/catch_test_macros.hpp"
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+module atom_core.tests:string_builder;
+
+import atom_core;
+
+using namespace atom;
+
+TEST_CASE("atom_core.string_builder")
+{
+    SECTION("append across chunks")
+    {
+        string_builder builder;
+        std::string expected;
+
+        REQUIRE(builder.is_empty());
+        REQUIRE(builder.get_chunk_count() == 0);
+
+        for (usize i = 0; i < 1000; i++)
+        {
+            builder.append(string_view{ "line " }).append(char('a' + i % 26)).append('\n');
+            expected += "line ";
+            expected += char('a' + i % 26);
+            expected += '\n';
+        }
+
+        std::string big(3 * string_builder::max_chunk_size, 'x');
+        builder += string_view{ big };
+        expected += big;
+
+        REQUIRE(builder.get_count() == expected.size());
+        REQUIRE(builder.get_chunk_count() > 1);
+        REQUIRE(std::string_view(builder.to_string()) == expected);
+
+        std::string chunks;
+        builder.for_each_chunk([&](string_view chunk) { chunks += std::string_view(chunk); });
+        REQUIRE(chunks == expected);
+    }
+
+    SECTION("append_fmt and append_join")
+    {
+        string_builder builder;
+        builder.append_fmt("{} + {} = {}", 1, 2, 3);
+        builder += '\n';
+
+        std::vector<std::string> names = { "a", "bc", "def" };
+        builder.append_join(names, string_view{ ", " });
+        builder.append_join(std::vector<std::string>{}, string_view{ ", " });
+
+        REQUIRE(std::string_view(builder.to_string()) == "1 + 2 = 3\na, bc, def");
+    }
+
+    SECTION("append_fmt larger than the spare space")
+    {
+        string_builder builder;
+        builder.append_fmt("");
+        REQUIRE(builder.get_chunk_count() == 0);
+
+        builder.append(string_view{ std::string(250, 'x') });
+        builder.append_fmt("{:>600}", 7);
+
+        std::string expected = std::string(250, 'x') + std::string(599, ' ') + "7";
+        REQUIRE(builder.get_count() == expected.size());
+        REQUIRE(builder.get_chunk_count() == 2);
+        REQUIRE(std::string_view(builder.to_string()) == expected);
+    }
+
+    SECTION("clear keeps the first chunk")
+    {
+        string_builder builder{ create_with_capacity, 16 };
+        REQUIRE(builder.get_chunk_count() == 1);
+
+        builder.append(string_view{ std::string(1000, 'y') });
+        builder.clear();
+
+        REQUIRE(builder.is_empty());
+        REQUIRE(builder.get_chunk_count() == 1);
+        REQUIRE(std::string_view(builder.to_string()) == "");
+
+        builder.append(string_view{ "again" });
+        REQUIRE(std::string_view(builder.to_string()) == "again");
+    }
+
+    SECTION("write_builder")
+    {
+        std::string path_str =
+            (std::filesystem::temp_directory_path() / "atom_core_tests_string_builder.txt")
+                .string();
+        string_view path{ path_str.c_str() };
+
+        string_builder builder;
+        std::string expected;
+        for (usize i = 0; i < 100000; i++)
+        {
+            builder.append_fmt("{},", i);
+            expected += std::to_string(i) + ",";
+        }
+
+        filesystem::file file =
+            filesystem::file::open(path, filesystem::file::open_flags::write).get_value();
+        file.write_str(string_view{ "head:" });
+        REQUIRE(file.write_builder(builder));
+        file.close();
+
+        string contents = filesystem::read_file_str(path).get_value();
+        REQUIRE(std::string_view(contents) == "head:" + expected);
+
+        std::filesystem::remove(path_str);
+    }
+}
@@ -0,0 +1,78 @@
+module;
+#include "catch2/catch_test_macros.hpp"
+#include <string>
+#include <string_view>
+#include <vector>
+
+module atom_core.tests:string_split;
+
+import atom_core;
+
+using namespace atom;
+
+template <typename range_type>
+static auto collect(const range_type& range) -> std::vector<std::string>
+{
+    std::vector<std::string> tokens;
+    for (const string_view& token : range)
+        tokens.emplace_back(std::string_view(token));
+
+    return tokens;
+}
+
+using tokens_type = std::vector<std::string>;
+
+TEST_CASE("atom_core.string_split")
+{
+    SECTION("split")
+    {
+        REQUIRE(collect(strings::split(string_view{ "a,b,,c" }, ','))
+                == tokens_type{ "a", "b", "", "c" });
+        REQUIRE(collect(strings::split(string_view{ "a,b," }, ',')) == tokens_type{ "a", "b", "" });
+        REQUIRE(collect(strings::split(string_view{ "abc" }, ',')) == tokens_type{ "abc" });
+        REQUIRE(collect(strings::split(string_view{ "" }, ',')) == tokens_type{});
+
+        REQUIRE(collect(strings::split(string_view{ "a::b:c::" }, string_view{ "::" }))
+                == tokens_type{ "a", "b:c", "" });
+    }
+
+    SECTION("split_any and tokenize")
+    {
+        string_view str{ " a, b;;c  " };
+        REQUIRE(collect(strings::split_any(str, string_view{ ",;" }))
+                == tokens_type{ " a", " b", "", "c  " });
+        REQUIRE(collect(strings::tokenize(str, string_view{ " ,;" }))
+                == tokens_type{ "a", "b", "c" });
+
+        // long enough for the 8 char scan, with delimiters at each offset.
+        std::string long_str = "0123456789abcdef,0123456789abcde;0123456789abcd,x";
+        REQUIRE(collect(strings::split_any(long_str, string_view{ ",;" }))
+                == tokens_type{ "0123456789abcdef", "0123456789abcde", "0123456789abcd", "x" });
+    }
+
+    SECTION("split_lines")
+    {
+        REQUIRE(collect(strings::split_lines(string_view{ "a\r\nb\n\nc\n" }))
+                == tokens_type{ "a", "b", "", "c" });
+        REQUIRE(collect(strings::split_lines(string_view{ "a" })) == tokens_type{ "a" });
+    }
+
+    SECTION("trim")
+    {
+        REQUIRE(std::string_view(strings::trim(string_view{ " \t a b \r\n" })) == "a b");
+        REQUIRE(std::string_view(strings::trim_start(string_view{ "  a " })) == "a ");
+        REQUIRE(std::string_view(strings::trim_end(string_view{ "  a " })) == "  a");
+        REQUIRE(strings::trim(string_view{ "   " }).is_empty());
+    }
+
+    SECTION("starts_with and ends_with")
+    {
+        string_view str{ "key=value" };
+        REQUIRE(strings::starts_with(str, string_view{ "key" }));
+        REQUIRE(strings::starts_with(str, 'k'));
+        REQUIRE_FALSE(strings::starts_with(str, string_view{ "value" }));
+        REQUIRE(strings::ends_with(str, string_view{ "value" }));
+        REQUIRE(strings::ends_with(str, 'e'));
+        REQUIRE_FALSE(strings::ends_with(string_view{ "" }, 'e'));
+    }
+}
@@ -0,0 +1,73 @@
+module;
+#include "catch2/catch_test_macros.hpp"
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+module atom_core.tests:symbol;
+
+import atom_core;
+
+using namespace atom;
+
+TEST_CASE("atom_core.symbol")
+{
+    SECTION("equal strings intern to the same symbol")
+    {
+        symbol_table table;
+        std::string name = "field_name";
+
+        symbol sym0 = table.intern(string_view{ "field_name" });
+        symbol sym1 = table.intern(name);
+        symbol other = table.intern(string_view{ "other_field" });
+
+        REQUIRE(sym0 == sym1);
+        REQUIRE_FALSE(sym0 == other);
+        REQUIRE(std::string_view(sym0.get_str()) == "field_name");
+        REQUIRE(sym0.get_id() == 0);
+        REQUIRE(other.get_id() == 1);
+        REQUIRE(table.get_count() == 2);
+
+        REQUIRE(sym0.get_hash() == std::hash<std::string_view>()("field_name"));
+        REQUIRE(symbol().is_null());
+        REQUIRE_FALSE(table.intern(string_view{ "" }) == symbol());
+    }
+
+    SECTION("find and intern_all")
+    {
+        symbol_table table;
+        symbol existing = table.intern(string_view{ "b" });
+
+        REQUIRE(table.find(string_view{ "b" }).get() == existing);
+        REQUIRE_FALSE(table.find(string_view{ "a" }).is_value());
+
+        std::vector<std::string> names = { "a", "b", "c", "a" };
+        symbol syms[4];
+        table.intern_all(names, array_slice<symbol>{ create_from_raw, syms, 4 });
+
+        REQUIRE(syms[1] == existing);
+        REQUIRE(syms[0] == syms[3]);
+        REQUIRE(std::string_view(syms[2].get_str()) == "c");
+        REQUIRE(table.get_count() == 3);
+    }
+
+    SECTION("grows past its initial capacity")
+    {
+        symbol_table table;
+        std::vector<symbol> syms;
+        for (usize i = 0; i < 10'000; i++)
+            syms.push_back(table.intern(std::to_string(i)));
+
+        std::unordered_set<symbol> unique{ syms.begin(), syms.end() };
+        REQUIRE(unique.size() == 10'000);
+
+        for (usize i = 0; i < 10'000; i++)
+            REQUIRE(table.intern(std::to_string(i)) == syms[i]);
+    }
+
+    SECTION("global table")
+    {
+        REQUIRE(symbol::intern(string_view{ "global" }) == symbol::intern(string_view{ "global" }));
+    }
+}
@@ -0,0 +1,112 @@
+module;
+#include "catch2/catch_test_macros.hpp"
+#include <string>
+#include <string_view>
+
+module atom_core.tests:utf8;
+
+import atom_core;
+
+using namespace atom;
+
+TEST_CASE("atom_core.utf8")
+{
+    SECTION("is_valid")
+    {
+        REQUIRE(utf8::is_valid(string_view{ "" }));
+        REQUIRE(utf8::is_valid(string_view{ "hello" }));
+        REQUIRE(utf8::is_valid(string_view{ "h\xC3\xA9llo \xE2\x82\xAC \xF0\x9F\x98\x80" }));
+        REQUIRE(utf8::is_valid(string_view{ "\xF4\x8F\xBF\xBF" }));
+
+        REQUIRE_FALSE(utf8::is_valid(string_view{ "\x80" }));
+        REQUIRE_FALSE(utf8::is_valid(string_view{ "\xC3" }));
+        REQUIRE_FALSE(utf8::is_valid(string_view{ "\xC0\x80" }));
+        REQUIRE_FALSE(utf8::is_valid(string_view{ "\xE0\x9F\xBF" }));
+        REQUIRE_FALSE(utf8::is_valid(string_view{ "\xED\xA0\x80" }));
+        REQUIRE_FALSE(utf8::is_valid(string_view{ "\xF4\x90\x80\x80" }));
+        REQUIRE_FALSE(utf8::is_valid(string_view{ "\xF5\x80\x80\x80" }));
+    }
+
+    SECTION("is_valid across blocks")
+    {
+        // places each sequence at every offset around the 32 byte blocks of the simd path.
+        const char* sequences[] = { "\xC3\xA9", "\xE2\x82\xAC", "\xF0\x9F\x98\x80" };
+        for (const char* sequence : sequences)
+        {
+            for (usize pad = 0; pad < 70; pad++)
+            {
+                std::string str(pad, 'a');
+                str += sequence;
+                REQUIRE(utf8::is_valid(str));
+
+                str.pop_back();
+                REQUIRE_FALSE(utf8::is_valid(str));
+            }
+        }
+    }
+
+    SECTION("count_code_points and get_code_points")
+    {
+        string_view str{ "a\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80" };
+        REQUIRE(utf8::count_code_points(str) == 4);
+
+        std::u32string code_points;
+        for (char32_t code_point : utf8::get_code_points(str))
+            code_points += code_point;
+
+        REQUIRE(code_points == U"a\u00E9\u20AC\U0001F600");
+
+        code_points.clear();
+        for (char32_t code_point : utf8::get_code_points(string_view{ "a\xFF" "b" }))
+            code_points += code_point;
+
+        REQUIRE(code_points == U"a\uFFFDb");
+    }
+
+    SECTION("utf-16 transcoding")
+    {
+        string_view str{ "a\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80" };
+        REQUIRE(utf8::get_utf16_count(str) == 5);
+
+        char16_t utf16[5];
+        array_slice<char16_t> utf16_out{ create_from_raw, utf16, 5 };
+        usize count = utf8::to_utf16(str, utf16_out).get_value();
+        REQUIRE(std::u16string_view(utf16, count) == u"a\u00E9\u20AC\U0001F600");
+
+        array_slice<char16_t> small_out{ create_from_raw, utf16, 4 };
+        REQUIRE(utf8::to_utf16(str, small_out).is_error<buffer_too_small_error>());
+        REQUIRE(utf8::to_utf16(string_view{ "\xC3" }, utf16_out).is_error<invalid_utf8_error>());
+
+        std::u16string_view utf16_view{ utf16, count };
+        REQUIRE(utf8::get_utf8_count(utf16_view) == str.get_count());
+
+        char chars[16];
+        array_slice<char> out{ create_from_raw, chars, 16 };
+        count = utf8::from_utf16(utf16_view, out).get_value();
+        REQUIRE(std::string_view(chars, count) == std::string_view(str));
+
+        std::u16string_view lone_surrogate{ u"a\xD800" };
+        REQUIRE(utf8::from_utf16(lone_surrogate, out).is_error<invalid_utf16_error>());
+    }
+
+    SECTION("utf-32 transcoding")
+    {
+        string_view str{ "a\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80" };
+
+        char32_t utf32[4];
+        array_slice<char32_t> utf32_out{ create_from_raw, utf32, 4 };
+        usize count = utf8::to_utf32(str, utf32_out).get_value();
+        REQUIRE(std::u32string_view(utf32, count) == U"a\u00E9\u20AC\U0001F600");
+
+        std::u32string_view utf32_view{ utf32, count };
+        REQUIRE(utf8::get_utf8_count(utf32_view) == str.get_count());
+
+        char chars[16];
+        array_slice<char> out{ create_from_raw, chars, 16 };
+        count = utf8::from_utf32(utf32_view, out).get_value();
+        REQUIRE(std::string_view(chars, count) == std::string_view(str));
+
+        std::u32string_view too_large{ U"\x110000" };
+        REQUIRE(utf8::from_utf32(too_large, out).is_error<invalid_utf32_error>());
+    }
+}
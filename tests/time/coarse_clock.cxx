@@ -0,0 +1,40 @@
+module;
+#include "catch2/catch_test_macros.hpp"
+#include <thread>
+
+module atom_core.tests:coarse_clock;
+
+import atom_core;
+
+using namespace atom;
+
+TEST_CASE("atom_core.coarse_clock")
+{
+    time::coarse_clock::start();
+    REQUIRE(time::coarse_clock::is_running());
+
+    SECTION("monotonic")
+    {
+        u64 last = time::coarse_clock::now();
+        for (usize i = 0; i < 10'000; i++)
+        {
+            u64 now = time::coarse_clock::now();
+            REQUIRE(now >= last);
+            last = now;
+        }
+    }
+
+    SECTION("follows steady_clock")
+    {
+        u64 start = time::coarse_clock::now();
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        u64 end = time::coarse_clock::now();
+        u64 steady = time::steady_clock::now();
+
+        // the ticker updates every 1ms, leave room for a slow scheduler.
+        REQUIRE(end - start >= 25'000'000);
+        REQUIRE(end <= steady);
+        REQUIRE(steady - end < 25'000'000);
+        REQUIRE(time::coarse_clock::ticks_to_ns(end) == end);
+    }
+}
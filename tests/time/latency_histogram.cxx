@@ -0,0 +1,60 @@
+module;
+#include "catch2/catch_test_macros.hpp"
+
+module atom_core.tests:latency_histogram;
+
+import atom_core;
+
+using namespace atom;
+
+TEST_CASE("atom_core.latency_histogram")
+{
+    using histogram_type = time::latency_histogram<>;
+
+    SECTION("bucket bounds")
+    {
+        for (u64 value : { 0ull, 1ull, 127ull, 128ull, 1000ull, 123456789ull, ~0ull })
+        {
+            usize index = histogram_type::get_bucket_index(value);
+
+            REQUIRE(index < histogram_type::bucket_count);
+            REQUIRE(histogram_type::get_bucket_lowest(index) <= value);
+            REQUIRE(histogram_type::get_bucket_highest(index) >= value);
+        }
+    }
+
+    SECTION("percentiles")
+    {
+        histogram_type histogram;
+        for (u64 i = 1; i <= 1000; i++)
+            histogram.record(i);
+
+        REQUIRE(histogram.get_count() == 1000);
+        REQUIRE(histogram.get_min() == 1);
+        REQUIRE(histogram.get_max() == 1000);
+        REQUIRE(histogram.get_percentile(100) == 1000);
+
+        u64 p50 = histogram.get_percentile(50);
+        REQUIRE(p50 >= 500);
+        REQUIRE(p50 <= 508);
+
+        u64 p999 = histogram.get_percentile(99.9);
+        REQUIRE(p999 >= 999);
+        REQUIRE(p999 <= 1000);
+    }
+
+    SECTION("merge")
+    {
+        histogram_type first;
+        histogram_type second;
+        first.record(10);
+        second.record_n(20, 3);
+
+        first.merge(second);
+
+        REQUIRE(first.get_count() == 4);
+        REQUIRE(first.get_min() == 10);
+        REQUIRE(first.get_max() == 20);
+        REQUIRE(first.get_mean() == 17.5);
+    }
+}
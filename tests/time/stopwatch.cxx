@@ -0,0 +1,90 @@
+module;
+#include "catch2/catch_test_macros.hpp"
+
+module atom_core.tests:stopwatch;
+
+import atom_core;
+
+using namespace atom;
+
+namespace
+{
+    // clock advanced by hand, so elapsed times are exact.
+    class test_clock
+    {
+    public:
+        static auto now() -> u64
+        {
+            return ticks;
+        }
+
+        static constexpr auto ticks_to_ns(u64 ticks) -> u64
+        {
+            return ticks * 2;
+        }
+
+    public:
+        static inline u64 ticks = 0;
+    };
+}
+
+TEST_CASE("atom_core.stopwatch")
+{
+    test_clock::ticks = 100;
+    time::stopwatch<test_clock> watch;
+
+    SECTION("start and stop")
+    {
+        REQUIRE(watch.is_running());
+
+        test_clock::ticks += 10;
+        REQUIRE(watch.get_elapsed_ticks() == 10);
+        REQUIRE(watch.get_elapsed_ns() == 20);
+
+        watch.stop();
+        test_clock::ticks += 10;
+        REQUIRE(not watch.is_running());
+        REQUIRE(watch.get_elapsed_ticks() == 10);
+
+        // elapsed time is kept across stop and start.
+        watch.start();
+        test_clock::ticks += 5;
+        REQUIRE(watch.get_elapsed_ticks() == 15);
+    }
+
+    SECTION("reset and restart")
+    {
+        test_clock::ticks += 10;
+        watch.reset();
+        REQUIRE(not watch.is_running());
+        REQUIRE(watch.get_elapsed_ticks() == 0);
+
+        test_clock::ticks += 10;
+        REQUIRE(watch.get_elapsed_ticks() == 0);
+
+        watch.restart();
+        test_clock::ticks += 7;
+        REQUIRE(watch.is_running());
+        REQUIRE(watch.get_elapsed_ticks() == 7);
+    }
+
+    SECTION("lap")
+    {
+        test_clock::ticks += 10;
+        REQUIRE(watch.lap() == 10);
+
+        test_clock::ticks += 3;
+        REQUIRE(watch.lap() == 3);
+        REQUIRE(watch.get_elapsed_ticks() == 0);
+
+        // a stopped stopwatch returns the time until it stopped and starts again.
+        test_clock::ticks += 4;
+        watch.stop();
+        test_clock::ticks += 100;
+        REQUIRE(watch.lap() == 4);
+        REQUIRE(watch.is_running());
+
+        test_clock::ticks += 1;
+        REQUIRE(watch.get_elapsed_ticks() == 1);
+    }
+}
@@ -0,0 +1,42 @@
+module;
+#include "catch2/catch_test_macros.hpp"
+#include <thread>
+
+module atom_core.tests:tsc_clock;
+
+import atom_core;
+
+using namespace atom;
+
+TEST_CASE("atom_core.tsc_clock")
+{
+    SECTION("monotonic")
+    {
+        u64 last = time::tsc_clock::now();
+        for (usize i = 0; i < 10'000; i++)
+        {
+            u64 now = time::tsc_clock::now();
+            REQUIRE(now >= last);
+            last = now;
+        }
+    }
+
+    SECTION("ticks_to_ns is calibrated against steady_clock")
+    {
+        time::tsc_clock::calibrate();
+
+        u64 start_ns = time::steady_clock::now();
+        u64 start_ticks = time::tsc_clock::now();
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        u64 end_ticks = time::tsc_clock::now();
+        u64 end_ns = time::steady_clock::now();
+
+        f64 expected_ns = f64(end_ns - start_ns);
+        f64 ns = f64(time::tsc_clock::ticks_to_ns(end_ticks - start_ticks));
+
+        // within 5%, the reads of both clocks are not taken at the exact same time.
+        REQUIRE(ns > expected_ns * 0.95);
+        REQUIRE(ns < expected_ns * 1.05);
+        REQUIRE(time::tsc_clock::get_ticks_per_second() > 0);
+    }
+}
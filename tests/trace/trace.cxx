@@ -0,0 +1,141 @@
+module;
+#include "catch2/catch_test_macros.hpp"
+
+// test the macros even when the library is built without tracing.
+#if !defined(ATOM_TRACE_ENABLED)
+#    define ATOM_TRACE_ENABLED
+#endif
+#include "atom/core/trace.h"
+
+module atom_core.tests:trace;
+
+import atom_core;
+
+using namespace atom;
+
+namespace
+{
+    auto count_of(std::string_view str, std::string_view part) -> usize
+    {
+        usize count = 0;
+        for (usize pos = str.find(part); pos != std::string_view::npos;
+             pos = str.find(part, pos + part.size()))
+        {
+            count++;
+        }
+
+        return count;
+    }
+
+    auto traced_function() -> void
+    {
+        ATOM_TRACE_FUNCTION();
+    }
+}
+
+TEST_CASE("atom_core.trace")
+{
+    std::string path_str =
+        (std::filesystem::temp_directory_path() / "atom_core_tests_trace.json").string();
+    string_view path{ path_str.c_str() };
+
+    SECTION("records zones and counters")
+    {
+        {
+            trace::zone zone{ "test_zone" };
+            trace::record_counter("test_counter", 7);
+        }
+
+        REQUIRE(trace::write_chrome_json(path).is_value());
+
+        string json = filesystem::read_file_str(path).get_value();
+        std::string_view json_view = string_view{ json };
+
+        REQUIRE(json_view.find("\"name\":\"test_zone\"") != std::string_view::npos);
+        REQUIRE(json_view.find("\"ph\":\"B\"") != std::string_view::npos);
+        REQUIRE(json_view.find("\"ph\":\"E\"") != std::string_view::npos);
+        REQUIRE(json_view.find("\"value\":7") != std::string_view::npos);
+    }
+
+    SECTION("doesn't record when disabled")
+    {
+        trace::set_enabled(false);
+        {
+            trace::zone zone{ "disabled_zone" };
+        }
+        trace::set_enabled(true);
+
+        REQUIRE(trace::write_chrome_json(path).is_value());
+
+        string json = filesystem::read_file_str(path).get_value();
+        std::string_view json_view = string_view{ json };
+
+        REQUIRE(json_view.find("disabled_zone") == std::string_view::npos);
+    }
+
+    SECTION("records zones and counters using macros")
+    {
+        {
+            ATOM_TRACE_ZONE("macro_zone");
+            ATOM_TRACE_COUNTER("macro_counter", 11);
+            traced_function();
+        }
+
+        REQUIRE(trace::write_chrome_json(path).is_value());
+
+        string json = filesystem::read_file_str(path).get_value();
+        std::string_view json_view = string_view{ json };
+
+        REQUIRE(count_of(json_view, "\"ph\":\"B\"") == 2);
+        REQUIRE(count_of(json_view, "\"ph\":\"E\"") == 2);
+        REQUIRE(json_view.find("\"name\":\"macro_zone\"") != std::string_view::npos);
+        REQUIRE(json_view.find("\"name\":\"traced_function\"") != std::string_view::npos);
+        REQUIRE(json_view.find("\"value\":11") != std::string_view::npos);
+    }
+
+    SECTION("keeps zones balanced when the buffer is full")
+    {
+        // drain events left by other tests.
+        REQUIRE(trace::write_chrome_json(path).is_value());
+        usize dropped_count = trace::get_dropped_count();
+
+        {
+            ATOM_TRACE_ZONE("outer_zone");
+
+            // fill the buffer, leaving only the slot reserved for the end of `outer_zone`.
+            for (i64 i = 0; i < 10'000; i++)
+                ATOM_TRACE_COUNTER("fill_counter", i);
+
+            ATOM_TRACE_ZONE("dropped_zone");
+        }
+
+        REQUIRE(trace::get_dropped_count() > dropped_count);
+        REQUIRE(trace::write_chrome_json(path).is_value());
+
+        string json = filesystem::read_file_str(path).get_value();
+        std::string_view json_view = string_view{ json };
+
+        REQUIRE(count_of(json_view, "\"ph\":\"B\"") == 1);
+        REQUIRE(count_of(json_view, "\"ph\":\"E\"") == 1);
+        REQUIRE(json_view.find("dropped_zone") == std::string_view::npos);
+    }
+
+    SECTION("ends zones when recording is disabled in between")
+    {
+        {
+            trace::zone zone{ "toggled_zone" };
+            trace::set_enabled(false);
+        }
+        trace::set_enabled(true);
+
+        REQUIRE(trace::write_chrome_json(path).is_value());
+
+        string json = filesystem::read_file_str(path).get_value();
+        std::string_view json_view = string_view{ json };
+
+        REQUIRE(count_of(json_view, "\"ph\":\"B\"") == 1);
+        REQUIRE(count_of(json_view, "\"ph\":\"E\"") == 1);
+    }
+
+    std::filesystem::remove(path_str);
+}